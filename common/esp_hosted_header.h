@@ -38,6 +38,7 @@ struct esp_payload_header {
 #define FLAG_WAKEUP_PKT                           (1 << 1)
 #define FLAG_POWER_SAVE_STARTED                   (1 << 2)
 #define FLAG_POWER_SAVE_STOPPED                   (1 << 3)
+#define FLAG_AGGR_NEXT_PKT                        (1 << 4) /* another pkt follows in same transport buffer */
 
 #define H_ESP_PAYLOAD_HEADER_OFFSET sizeof(struct esp_payload_header)
 
@@ -10627,6 +10627,276 @@ void   rpc__resp__ext_coex__free_unpacked
   assert(message->base.descriptor == &rpc__resp__ext_coex__descriptor);
   protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
 }
+void   rpc__nw_split_port_rule__init
+                     (RpcNwSplitPortRule         *message)
+{
+  static const RpcNwSplitPortRule init_value = RPC__NW_SPLIT_PORT_RULE__INIT;
+  *message = init_value;
+}
+size_t rpc__nw_split_port_rule__get_packed_size
+                     (const RpcNwSplitPortRule *message)
+{
+  assert(message->base.descriptor == &rpc__nw_split_port_rule__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t rpc__nw_split_port_rule__pack
+                     (const RpcNwSplitPortRule *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &rpc__nw_split_port_rule__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t rpc__nw_split_port_rule__pack_to_buffer
+                     (const RpcNwSplitPortRule *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &rpc__nw_split_port_rule__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+RpcNwSplitPortRule *
+       rpc__nw_split_port_rule__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (RpcNwSplitPortRule *)
+     protobuf_c_message_unpack (&rpc__nw_split_port_rule__descriptor,
+                                allocator, len, data);
+}
+void   rpc__nw_split_port_rule__free_unpacked
+                     (RpcNwSplitPortRule *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &rpc__nw_split_port_rule__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
+void   rpc__req__nw_split_port_rules__init
+                     (RpcReqNwSplitPortRules         *message)
+{
+  static const RpcReqNwSplitPortRules init_value = RPC__REQ__NW_SPLIT_PORT_RULES__INIT;
+  *message = init_value;
+}
+size_t rpc__req__nw_split_port_rules__get_packed_size
+                     (const RpcReqNwSplitPortRules *message)
+{
+  assert(message->base.descriptor == &rpc__req__nw_split_port_rules__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t rpc__req__nw_split_port_rules__pack
+                     (const RpcReqNwSplitPortRules *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &rpc__req__nw_split_port_rules__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t rpc__req__nw_split_port_rules__pack_to_buffer
+                     (const RpcReqNwSplitPortRules *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &rpc__req__nw_split_port_rules__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+RpcReqNwSplitPortRules *
+       rpc__req__nw_split_port_rules__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (RpcReqNwSplitPortRules *)
+     protobuf_c_message_unpack (&rpc__req__nw_split_port_rules__descriptor,
+                                allocator, len, data);
+}
+void   rpc__req__nw_split_port_rules__free_unpacked
+                     (RpcReqNwSplitPortRules *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &rpc__req__nw_split_port_rules__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
+void   rpc__resp__nw_split_port_rules__init
+                     (RpcRespNwSplitPortRules         *message)
+{
+  static const RpcRespNwSplitPortRules init_value = RPC__RESP__NW_SPLIT_PORT_RULES__INIT;
+  *message = init_value;
+}
+size_t rpc__resp__nw_split_port_rules__get_packed_size
+                     (const RpcRespNwSplitPortRules *message)
+{
+  assert(message->base.descriptor == &rpc__resp__nw_split_port_rules__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t rpc__resp__nw_split_port_rules__pack
+                     (const RpcRespNwSplitPortRules *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &rpc__resp__nw_split_port_rules__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t rpc__resp__nw_split_port_rules__pack_to_buffer
+                     (const RpcRespNwSplitPortRules *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &rpc__resp__nw_split_port_rules__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+RpcRespNwSplitPortRules *
+       rpc__resp__nw_split_port_rules__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (RpcRespNwSplitPortRules *)
+     protobuf_c_message_unpack (&rpc__resp__nw_split_port_rules__descriptor,
+                                allocator, len, data);
+}
+void   rpc__resp__nw_split_port_rules__free_unpacked
+                     (RpcRespNwSplitPortRules *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &rpc__resp__nw_split_port_rules__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
+void   rpc__wake_rule__init
+                     (RpcWakeRule         *message)
+{
+  static const RpcWakeRule init_value = RPC__WAKE_RULE__INIT;
+  *message = init_value;
+}
+size_t rpc__wake_rule__get_packed_size
+                     (const RpcWakeRule *message)
+{
+  assert(message->base.descriptor == &rpc__wake_rule__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t rpc__wake_rule__pack
+                     (const RpcWakeRule *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &rpc__wake_rule__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t rpc__wake_rule__pack_to_buffer
+                     (const RpcWakeRule *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &rpc__wake_rule__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+RpcWakeRule *
+       rpc__wake_rule__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (RpcWakeRule *)
+     protobuf_c_message_unpack (&rpc__wake_rule__descriptor,
+                                allocator, len, data);
+}
+void   rpc__wake_rule__free_unpacked
+                     (RpcWakeRule *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &rpc__wake_rule__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
+void   rpc__req__set_wake_rules__init
+                     (RpcReqSetWakeRules         *message)
+{
+  static const RpcReqSetWakeRules init_value = RPC__REQ__SET_WAKE_RULES__INIT;
+  *message = init_value;
+}
+size_t rpc__req__set_wake_rules__get_packed_size
+                     (const RpcReqSetWakeRules *message)
+{
+  assert(message->base.descriptor == &rpc__req__set_wake_rules__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t rpc__req__set_wake_rules__pack
+                     (const RpcReqSetWakeRules *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &rpc__req__set_wake_rules__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t rpc__req__set_wake_rules__pack_to_buffer
+                     (const RpcReqSetWakeRules *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &rpc__req__set_wake_rules__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+RpcReqSetWakeRules *
+       rpc__req__set_wake_rules__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (RpcReqSetWakeRules *)
+     protobuf_c_message_unpack (&rpc__req__set_wake_rules__descriptor,
+                                allocator, len, data);
+}
+void   rpc__req__set_wake_rules__free_unpacked
+                     (RpcReqSetWakeRules *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &rpc__req__set_wake_rules__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
+void   rpc__resp__set_wake_rules__init
+                     (RpcRespSetWakeRules         *message)
+{
+  static const RpcRespSetWakeRules init_value = RPC__RESP__SET_WAKE_RULES__INIT;
+  *message = init_value;
+}
+size_t rpc__resp__set_wake_rules__get_packed_size
+                     (const RpcRespSetWakeRules *message)
+{
+  assert(message->base.descriptor == &rpc__resp__set_wake_rules__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t rpc__resp__set_wake_rules__pack
+                     (const RpcRespSetWakeRules *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &rpc__resp__set_wake_rules__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t rpc__resp__set_wake_rules__pack_to_buffer
+                     (const RpcRespSetWakeRules *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &rpc__resp__set_wake_rules__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+RpcRespSetWakeRules *
+       rpc__resp__set_wake_rules__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (RpcRespSetWakeRules *)
+     protobuf_c_message_unpack (&rpc__resp__set_wake_rules__descriptor,
+                                allocator, len, data);
+}
+void   rpc__resp__set_wake_rules__free_unpacked
+                     (RpcRespSetWakeRules *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &rpc__resp__set_wake_rules__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
 void   rpc__event__dhcp_dns_status__init
                      (RpcEventDhcpDnsStatus         *message)
 {
@@ -26001,6 +26271,390 @@ const ProtobufCMessageDescriptor rpc__resp__ext_coex__descriptor =
   (ProtobufCMessageInit) rpc__resp__ext_coex__init,
   NULL,NULL,NULL    /* reserved[123] */
 };
+static const ProtobufCFieldDescriptor rpc__nw_split_port_rule__field_descriptors[5] =
+{
+  {
+    "proto",
+    1,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT32,
+    0,   /* quantifier_offset */
+    offsetof(RpcNwSplitPortRule, proto),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "match_src",
+    2,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_BOOL,
+    0,   /* quantifier_offset */
+    offsetof(RpcNwSplitPortRule, match_src),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "port_start",
+    3,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT32,
+    0,   /* quantifier_offset */
+    offsetof(RpcNwSplitPortRule, port_start),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "port_end",
+    4,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT32,
+    0,   /* quantifier_offset */
+    offsetof(RpcNwSplitPortRule, port_end),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "action",
+    5,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT32,
+    0,   /* quantifier_offset */
+    offsetof(RpcNwSplitPortRule, action),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned rpc__nw_split_port_rule__field_indices_by_name[] = {
+  4,   /* field[4] = action */
+  1,   /* field[1] = match_src */
+  3,   /* field[3] = port_end */
+  2,   /* field[2] = port_start */
+  0,   /* field[0] = proto */
+};
+static const ProtobufCIntRange rpc__nw_split_port_rule__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 5 }
+};
+const ProtobufCMessageDescriptor rpc__nw_split_port_rule__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "Rpc_NwSplitPortRule",
+  "RpcNwSplitPortRule",
+  "RpcNwSplitPortRule",
+  "",
+  sizeof(RpcNwSplitPortRule),
+  5,
+  rpc__nw_split_port_rule__field_descriptors,
+  rpc__nw_split_port_rule__field_indices_by_name,
+  1,  rpc__nw_split_port_rule__number_ranges,
+  (ProtobufCMessageInit) rpc__nw_split_port_rule__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
+static const ProtobufCFieldDescriptor rpc__req__nw_split_port_rules__field_descriptors[2] =
+{
+  {
+    "replace",
+    1,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_BOOL,
+    0,   /* quantifier_offset */
+    offsetof(RpcReqNwSplitPortRules, replace),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "rules",
+    2,
+    PROTOBUF_C_LABEL_REPEATED,
+    PROTOBUF_C_TYPE_MESSAGE,
+    offsetof(RpcReqNwSplitPortRules, n_rules),
+    offsetof(RpcReqNwSplitPortRules, rules),
+    &rpc__nw_split_port_rule__descriptor,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned rpc__req__nw_split_port_rules__field_indices_by_name[] = {
+  0,   /* field[0] = replace */
+  1,   /* field[1] = rules */
+};
+static const ProtobufCIntRange rpc__req__nw_split_port_rules__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 2 }
+};
+const ProtobufCMessageDescriptor rpc__req__nw_split_port_rules__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "Rpc_Req_NwSplitPortRules",
+  "RpcReqNwSplitPortRules",
+  "RpcReqNwSplitPortRules",
+  "",
+  sizeof(RpcReqNwSplitPortRules),
+  2,
+  rpc__req__nw_split_port_rules__field_descriptors,
+  rpc__req__nw_split_port_rules__field_indices_by_name,
+  1,  rpc__req__nw_split_port_rules__number_ranges,
+  (ProtobufCMessageInit) rpc__req__nw_split_port_rules__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
+static const ProtobufCFieldDescriptor rpc__resp__nw_split_port_rules__field_descriptors[1] =
+{
+  {
+    "resp",
+    1,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_INT32,
+    0,   /* quantifier_offset */
+    offsetof(RpcRespNwSplitPortRules, resp),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned rpc__resp__nw_split_port_rules__field_indices_by_name[] = {
+  0,   /* field[0] = resp */
+};
+static const ProtobufCIntRange rpc__resp__nw_split_port_rules__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 1 }
+};
+const ProtobufCMessageDescriptor rpc__resp__nw_split_port_rules__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "Rpc_Resp_NwSplitPortRules",
+  "RpcRespNwSplitPortRules",
+  "RpcRespNwSplitPortRules",
+  "",
+  sizeof(RpcRespNwSplitPortRules),
+  1,
+  rpc__resp__nw_split_port_rules__field_descriptors,
+  rpc__resp__nw_split_port_rules__field_indices_by_name,
+  1,  rpc__resp__nw_split_port_rules__number_ranges,
+  (ProtobufCMessageInit) rpc__resp__nw_split_port_rules__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
+static const ProtobufCFieldDescriptor rpc__wake_rule__field_descriptors[8] =
+{
+  {
+    "layer",
+    1,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT32,
+    0,   /* quantifier_offset */
+    offsetof(RpcWakeRule, layer),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "ip_proto",
+    2,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT32,
+    0,   /* quantifier_offset */
+    offsetof(RpcWakeRule, ip_proto),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "offset",
+    3,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT32,
+    0,   /* quantifier_offset */
+    offsetof(RpcWakeRule, offset),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "mask",
+    4,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_BYTES,
+    0,   /* quantifier_offset */
+    offsetof(RpcWakeRule, mask),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "value",
+    5,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_BYTES,
+    0,   /* quantifier_offset */
+    offsetof(RpcWakeRule, value),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "rate_limit",
+    6,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT32,
+    0,   /* quantifier_offset */
+    offsetof(RpcWakeRule, rate_limit),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "rate_interval_ms",
+    7,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT32,
+    0,   /* quantifier_offset */
+    offsetof(RpcWakeRule, rate_interval_ms),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "port",
+    8,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT32,
+    0,   /* quantifier_offset */
+    offsetof(RpcWakeRule, port),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned rpc__wake_rule__field_indices_by_name[] = {
+  1,   /* field[1] = ip_proto */
+  0,   /* field[0] = layer */
+  3,   /* field[3] = mask */
+  2,   /* field[2] = offset */
+  7,   /* field[7] = port */
+  6,   /* field[6] = rate_interval_ms */
+  5,   /* field[5] = rate_limit */
+  4,   /* field[4] = value */
+};
+static const ProtobufCIntRange rpc__wake_rule__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 8 }
+};
+const ProtobufCMessageDescriptor rpc__wake_rule__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "Rpc_WakeRule",
+  "RpcWakeRule",
+  "RpcWakeRule",
+  "",
+  sizeof(RpcWakeRule),
+  8,
+  rpc__wake_rule__field_descriptors,
+  rpc__wake_rule__field_indices_by_name,
+  1,  rpc__wake_rule__number_ranges,
+  (ProtobufCMessageInit) rpc__wake_rule__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
+static const ProtobufCFieldDescriptor rpc__req__set_wake_rules__field_descriptors[1] =
+{
+  {
+    "rules",
+    1,
+    PROTOBUF_C_LABEL_REPEATED,
+    PROTOBUF_C_TYPE_MESSAGE,
+    offsetof(RpcReqSetWakeRules, n_rules),
+    offsetof(RpcReqSetWakeRules, rules),
+    &rpc__wake_rule__descriptor,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned rpc__req__set_wake_rules__field_indices_by_name[] = {
+  0,   /* field[0] = rules */
+};
+static const ProtobufCIntRange rpc__req__set_wake_rules__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 1 }
+};
+const ProtobufCMessageDescriptor rpc__req__set_wake_rules__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "Rpc_Req_SetWakeRules",
+  "RpcReqSetWakeRules",
+  "RpcReqSetWakeRules",
+  "",
+  sizeof(RpcReqSetWakeRules),
+  1,
+  rpc__req__set_wake_rules__field_descriptors,
+  rpc__req__set_wake_rules__field_indices_by_name,
+  1,  rpc__req__set_wake_rules__number_ranges,
+  (ProtobufCMessageInit) rpc__req__set_wake_rules__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
+static const ProtobufCFieldDescriptor rpc__resp__set_wake_rules__field_descriptors[1] =
+{
+  {
+    "resp",
+    1,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_INT32,
+    0,   /* quantifier_offset */
+    offsetof(RpcRespSetWakeRules, resp),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned rpc__resp__set_wake_rules__field_indices_by_name[] = {
+  0,   /* field[0] = resp */
+};
+static const ProtobufCIntRange rpc__resp__set_wake_rules__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 1 }
+};
+const ProtobufCMessageDescriptor rpc__resp__set_wake_rules__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "Rpc_Resp_SetWakeRules",
+  "RpcRespSetWakeRules",
+  "RpcRespSetWakeRules",
+  "",
+  sizeof(RpcRespSetWakeRules),
+  1,
+  rpc__resp__set_wake_rules__field_descriptors,
+  rpc__resp__set_wake_rules__field_indices_by_name,
+  1,  rpc__resp__set_wake_rules__number_ranges,
+  (ProtobufCMessageInit) rpc__resp__set_wake_rules__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
 static const ProtobufCFieldDescriptor rpc__event__dhcp_dns_status__field_descriptors[10] =
 {
   {
@@ -28826,7 +29480,7 @@ const ProtobufCMessageDescriptor rpc__event__mem_monitor__descriptor =
   (ProtobufCMessageInit) rpc__event__mem_monitor__init,
   NULL,NULL,NULL    /* reserved[123] */
 };
-static const ProtobufCFieldDescriptor rpc__field_descriptors[248] =
+static const ProtobufCFieldDescriptor rpc__field_descriptors[252] =
 {
   {
     "msg_type",
@@ -30208,6 +30862,30 @@ static const ProtobufCFieldDescriptor rpc__field_descriptors[248] =
     0 | PROTOBUF_C_FIELD_FLAG_ONEOF,             /* flags */
     0,NULL,NULL    /* reserved1,reserved2, etc */
   },
+  {
+    "req_nw_split_port_rules",
+    397,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_MESSAGE,
+    offsetof(Rpc, payload_case),
+    offsetof(Rpc, req_nw_split_port_rules),
+    &rpc__req__nw_split_port_rules__descriptor,
+    NULL,
+    0 | PROTOBUF_C_FIELD_FLAG_ONEOF,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "req_set_wake_rules",
+    398,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_MESSAGE,
+    offsetof(Rpc, payload_case),
+    offsetof(Rpc, req_set_wake_rules),
+    &rpc__req__set_wake_rules__descriptor,
+    NULL,
+    0 | PROTOBUF_C_FIELD_FLAG_ONEOF,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
   {
     "resp_get_mac_address",
     513,
@@ -31552,6 +32230,30 @@ static const ProtobufCFieldDescriptor rpc__field_descriptors[248] =
     0 | PROTOBUF_C_FIELD_FLAG_ONEOF,             /* flags */
     0,NULL,NULL    /* reserved1,reserved2, etc */
   },
+  {
+    "resp_nw_split_port_rules",
+    653,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_MESSAGE,
+    offsetof(Rpc, payload_case),
+    offsetof(Rpc, resp_nw_split_port_rules),
+    &rpc__resp__nw_split_port_rules__descriptor,
+    NULL,
+    0 | PROTOBUF_C_FIELD_FLAG_ONEOF,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "resp_set_wake_rules",
+    654,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_MESSAGE,
+    offsetof(Rpc, payload_case),
+    offsetof(Rpc, resp_set_wake_rules),
+    &rpc__resp__set_wake_rules__descriptor,
+    NULL,
+    0 | PROTOBUF_C_FIELD_FLAG_ONEOF,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
   {
     "event_esp_init",
     769,
@@ -31806,27 +32508,27 @@ static const ProtobufCFieldDescriptor rpc__field_descriptors[248] =
   },
 };
 static const unsigned rpc__field_indices_by_name[] = {
-  229,   /* field[229] = event_ap_sta_connected */
-  230,   /* field[230] = event_ap_sta_disconnected */
-  246,   /* field[246] = event_custom_rpc */
-  235,   /* field[235] = event_dhcp_dns */
-  227,   /* field[227] = event_esp_init */
-  228,   /* field[228] = event_heartbeat */
-  247,   /* field[247] = event_mem_monitor */
-  233,   /* field[233] = event_sta_connected */
-  234,   /* field[234] = event_sta_disconnected */
-  239,   /* field[239] = event_sta_itwt_probe */
-  236,   /* field[236] = event_sta_itwt_setup */
-  238,   /* field[238] = event_sta_itwt_suspend */
-  237,   /* field[237] = event_sta_itwt_teardown */
-  232,   /* field[232] = event_sta_scan_done */
-  241,   /* field[241] = event_supp_dpp_cfg_recvd */
-  242,   /* field[242] = event_supp_dpp_fail */
-  240,   /* field[240] = event_supp_dpp_uri_ready */
-  244,   /* field[244] = event_wifi_dpp_cfg_recvd */
-  245,   /* field[245] = event_wifi_dpp_fail */
-  243,   /* field[243] = event_wifi_dpp_uri_ready */
-  231,   /* field[231] = event_wifi_event_no_args */
+  233,   /* field[233] = event_ap_sta_connected */
+  234,   /* field[234] = event_ap_sta_disconnected */
+  250,   /* field[250] = event_custom_rpc */
+  239,   /* field[239] = event_dhcp_dns */
+  231,   /* field[231] = event_esp_init */
+  232,   /* field[232] = event_heartbeat */
+  251,   /* field[251] = event_mem_monitor */
+  237,   /* field[237] = event_sta_connected */
+  238,   /* field[238] = event_sta_disconnected */
+  243,   /* field[243] = event_sta_itwt_probe */
+  240,   /* field[240] = event_sta_itwt_setup */
+  242,   /* field[242] = event_sta_itwt_suspend */
+  241,   /* field[241] = event_sta_itwt_teardown */
+  236,   /* field[236] = event_sta_scan_done */
+  245,   /* field[245] = event_supp_dpp_cfg_recvd */
+  246,   /* field[246] = event_supp_dpp_fail */
+  244,   /* field[244] = event_supp_dpp_uri_ready */
+  248,   /* field[248] = event_wifi_dpp_cfg_recvd */
+  249,   /* field[249] = event_wifi_dpp_fail */
+  247,   /* field[247] = event_wifi_dpp_uri_ready */
+  235,   /* field[235] = event_wifi_event_no_args */
   1,   /* field[1] = msg_id */
   0,   /* field[0] = msg_type */
   13,   /* field[13] = req_app_get_desc */
@@ -31870,12 +32572,14 @@ static const unsigned rpc__field_indices_by_name[] = {
   104,   /* field[104] = req_iface_mac_addr_len_get */
   103,   /* field[103] = req_iface_mac_addr_set_get */
   14,   /* field[14] = req_mem_monitor */
+  115,   /* field[115] = req_nw_split_port_rules */
   12,   /* field[12] = req_ota_activate */
   18,   /* field[18] = req_ota_begin */
   20,   /* field[20] = req_ota_end */
   19,   /* field[19] = req_ota_write */
   70,   /* field[70] = req_set_dhcp_dns */
   4,   /* field[4] = req_set_mac_address */
+  116,   /* field[116] = req_set_wake_rules */
   21,   /* field[21] = req_set_wifi_max_tx_power */
   6,   /* field[6] = req_set_wifi_mode */
   9,   /* field[9] = req_supp_dpp_bootstrap_gen */
@@ -31941,118 +32645,120 @@ static const unsigned rpc__field_indices_by_name[] = {
   72,   /* field[72] = req_wifi_sta_twt_config */
   26,   /* field[26] = req_wifi_start */
   27,   /* field[27] = req_wifi_stop */
-  125,   /* field[125] = resp_app_get_desc */
-  135,   /* field[135] = resp_config_heartbeat */
-  218,   /* field[218] = resp_custom_rpc */
-  202,   /* field[202] = resp_eap_clear_ca_cert */
-  204,   /* field[204] = resp_eap_clear_certificate_and_key */
-  194,   /* field[194] = resp_eap_clear_identity */
-  200,   /* field[200] = resp_eap_clear_new_password */
-  198,   /* field[198] = resp_eap_clear_password */
-  196,   /* field[196] = resp_eap_clear_username */
-  205,   /* field[205] = resp_eap_get_disable_time_check */
-  201,   /* field[201] = resp_eap_set_ca_cert */
-  203,   /* field[203] = resp_eap_set_certificate_and_key */
-  213,   /* field[213] = resp_eap_set_disable_time_check */
-  212,   /* field[212] = resp_eap_set_domain_name */
-  214,   /* field[214] = resp_eap_set_eap_methods */
-  209,   /* field[209] = resp_eap_set_fast_params */
-  193,   /* field[193] = resp_eap_set_identity */
-  199,   /* field[199] = resp_eap_set_new_password */
-  208,   /* field[208] = resp_eap_set_pac_file */
-  197,   /* field[197] = resp_eap_set_password */
-  207,   /* field[207] = resp_eap_set_suiteb_certification */
-  206,   /* field[206] = resp_eap_set_ttls_phase2_method */
-  195,   /* field[195] = resp_eap_set_username */
-  210,   /* field[210] = resp_eap_use_default_cert_bundle */
-  226,   /* field[226] = resp_ext_coex */
-  217,   /* field[217] = resp_feature_control */
-  180,   /* field[180] = resp_get_coprocessor_fwversion */
-  183,   /* field[183] = resp_get_dhcp_dns */
-  115,   /* field[115] = resp_get_mac_address */
-  134,   /* field[134] = resp_get_wifi_max_tx_power */
-  117,   /* field[117] = resp_get_wifi_mode */
-  219,   /* field[219] = resp_gpio_config */
-  222,   /* field[222] = resp_gpio_get_level */
-  224,   /* field[224] = resp_gpio_input_enable */
-  220,   /* field[220] = resp_gpio_reset */
-  223,   /* field[223] = resp_gpio_set_direction */
-  221,   /* field[221] = resp_gpio_set_level */
-  225,   /* field[225] = resp_gpio_set_pull_mode */
-  216,   /* field[216] = resp_iface_mac_addr_len_get */
-  215,   /* field[215] = resp_iface_mac_addr_set_get */
-  126,   /* field[126] = resp_mem_monitor */
-  124,   /* field[124] = resp_ota_activate */
-  130,   /* field[130] = resp_ota_begin */
-  132,   /* field[132] = resp_ota_end */
-  131,   /* field[131] = resp_ota_write */
-  182,   /* field[182] = resp_set_dhcp_dns */
-  116,   /* field[116] = resp_set_mac_address */
-  133,   /* field[133] = resp_set_wifi_max_tx_power */
-  118,   /* field[118] = resp_set_wifi_mode */
-  121,   /* field[121] = resp_supp_dpp_bootstrap_gen */
-  120,   /* field[120] = resp_supp_dpp_deinit */
-  119,   /* field[119] = resp_supp_dpp_init */
-  122,   /* field[122] = resp_supp_dpp_start_listen */
-  123,   /* field[123] = resp_supp_dpp_stop_listen */
-  162,   /* field[162] = resp_wifi_ap_get_sta_aid */
-  161,   /* field[161] = resp_wifi_ap_get_sta_list */
-  148,   /* field[148] = resp_wifi_clear_ap_list */
-  150,   /* field[150] = resp_wifi_clear_fast_connect */
-  140,   /* field[140] = resp_wifi_connect */
-  151,   /* field[151] = resp_wifi_deauth_sta */
-  137,   /* field[137] = resp_wifi_deinit */
-  168,   /* field[168] = resp_wifi_disable_pmf_config */
-  141,   /* field[141] = resp_wifi_disconnect */
-  177,   /* field[177] = resp_wifi_get_band */
-  179,   /* field[179] = resp_wifi_get_bandmode */
-  156,   /* field[156] = resp_wifi_get_bandwidth */
-  175,   /* field[175] = resp_wifi_get_bandwidths */
-  158,   /* field[158] = resp_wifi_get_channel */
-  143,   /* field[143] = resp_wifi_get_config */
-  160,   /* field[160] = resp_wifi_get_country */
-  167,   /* field[167] = resp_wifi_get_country_code */
-  165,   /* field[165] = resp_wifi_get_inactive_time */
-  154,   /* field[154] = resp_wifi_get_protocol */
-  173,   /* field[173] = resp_wifi_get_protocols */
-  129,   /* field[129] = resp_wifi_get_ps */
-  136,   /* field[136] = resp_wifi_init */
-  149,   /* field[149] = resp_wifi_restore */
-  146,   /* field[146] = resp_wifi_scan_get_ap_num */
-  181,   /* field[181] = resp_wifi_scan_get_ap_record */
-  147,   /* field[147] = resp_wifi_scan_get_ap_records */
-  127,   /* field[127] = resp_wifi_scan_params */
-  144,   /* field[144] = resp_wifi_scan_start */
-  145,   /* field[145] = resp_wifi_scan_stop */
-  176,   /* field[176] = resp_wifi_set_band */
-  178,   /* field[178] = resp_wifi_set_bandmode */
-  155,   /* field[155] = resp_wifi_set_bandwidth */
-  174,   /* field[174] = resp_wifi_set_bandwidths */
-  157,   /* field[157] = resp_wifi_set_channel */
-  142,   /* field[142] = resp_wifi_set_config */
-  159,   /* field[159] = resp_wifi_set_country */
-  166,   /* field[166] = resp_wifi_set_country_code */
-  164,   /* field[164] = resp_wifi_set_inactive_time */
-  211,   /* field[211] = resp_wifi_set_okc_support */
-  153,   /* field[153] = resp_wifi_set_protocol */
-  172,   /* field[172] = resp_wifi_set_protocols */
-  128,   /* field[128] = resp_wifi_set_ps */
-  163,   /* field[163] = resp_wifi_set_storage */
-  192,   /* field[192] = resp_wifi_sta_enterprise_disable */
-  191,   /* field[191] = resp_wifi_sta_enterprise_enable */
-  169,   /* field[169] = resp_wifi_sta_get_aid */
-  152,   /* field[152] = resp_wifi_sta_get_ap_info */
-  170,   /* field[170] = resp_wifi_sta_get_negotiated_phymode */
-  171,   /* field[171] = resp_wifi_sta_get_rssi */
-  188,   /* field[188] = resp_wifi_sta_itwt_get_flow_id_status */
-  189,   /* field[189] = resp_wifi_sta_itwt_send_probe_req */
-  190,   /* field[190] = resp_wifi_sta_itwt_set_target_wake_time_offset */
-  185,   /* field[185] = resp_wifi_sta_itwt_setup */
-  187,   /* field[187] = resp_wifi_sta_itwt_suspend */
-  186,   /* field[186] = resp_wifi_sta_itwt_teardown */
-  184,   /* field[184] = resp_wifi_sta_twt_config */
-  138,   /* field[138] = resp_wifi_start */
-  139,   /* field[139] = resp_wifi_stop */
+  127,   /* field[127] = resp_app_get_desc */
+  137,   /* field[137] = resp_config_heartbeat */
+  220,   /* field[220] = resp_custom_rpc */
+  204,   /* field[204] = resp_eap_clear_ca_cert */
+  206,   /* field[206] = resp_eap_clear_certificate_and_key */
+  196,   /* field[196] = resp_eap_clear_identity */
+  202,   /* field[202] = resp_eap_clear_new_password */
+  200,   /* field[200] = resp_eap_clear_password */
+  198,   /* field[198] = resp_eap_clear_username */
+  207,   /* field[207] = resp_eap_get_disable_time_check */
+  203,   /* field[203] = resp_eap_set_ca_cert */
+  205,   /* field[205] = resp_eap_set_certificate_and_key */
+  215,   /* field[215] = resp_eap_set_disable_time_check */
+  214,   /* field[214] = resp_eap_set_domain_name */
+  216,   /* field[216] = resp_eap_set_eap_methods */
+  211,   /* field[211] = resp_eap_set_fast_params */
+  195,   /* field[195] = resp_eap_set_identity */
+  201,   /* field[201] = resp_eap_set_new_password */
+  210,   /* field[210] = resp_eap_set_pac_file */
+  199,   /* field[199] = resp_eap_set_password */
+  209,   /* field[209] = resp_eap_set_suiteb_certification */
+  208,   /* field[208] = resp_eap_set_ttls_phase2_method */
+  197,   /* field[197] = resp_eap_set_username */
+  212,   /* field[212] = resp_eap_use_default_cert_bundle */
+  228,   /* field[228] = resp_ext_coex */
+  219,   /* field[219] = resp_feature_control */
+  182,   /* field[182] = resp_get_coprocessor_fwversion */
+  185,   /* field[185] = resp_get_dhcp_dns */
+  117,   /* field[117] = resp_get_mac_address */
+  136,   /* field[136] = resp_get_wifi_max_tx_power */
+  119,   /* field[119] = resp_get_wifi_mode */
+  221,   /* field[221] = resp_gpio_config */
+  224,   /* field[224] = resp_gpio_get_level */
+  226,   /* field[226] = resp_gpio_input_enable */
+  222,   /* field[222] = resp_gpio_reset */
+  225,   /* field[225] = resp_gpio_set_direction */
+  223,   /* field[223] = resp_gpio_set_level */
+  227,   /* field[227] = resp_gpio_set_pull_mode */
+  218,   /* field[218] = resp_iface_mac_addr_len_get */
+  217,   /* field[217] = resp_iface_mac_addr_set_get */
+  128,   /* field[128] = resp_mem_monitor */
+  229,   /* field[229] = resp_nw_split_port_rules */
+  126,   /* field[126] = resp_ota_activate */
+  132,   /* field[132] = resp_ota_begin */
+  134,   /* field[134] = resp_ota_end */
+  133,   /* field[133] = resp_ota_write */
+  184,   /* field[184] = resp_set_dhcp_dns */
+  118,   /* field[118] = resp_set_mac_address */
+  230,   /* field[230] = resp_set_wake_rules */
+  135,   /* field[135] = resp_set_wifi_max_tx_power */
+  120,   /* field[120] = resp_set_wifi_mode */
+  123,   /* field[123] = resp_supp_dpp_bootstrap_gen */
+  122,   /* field[122] = resp_supp_dpp_deinit */
+  121,   /* field[121] = resp_supp_dpp_init */
+  124,   /* field[124] = resp_supp_dpp_start_listen */
+  125,   /* field[125] = resp_supp_dpp_stop_listen */
+  164,   /* field[164] = resp_wifi_ap_get_sta_aid */
+  163,   /* field[163] = resp_wifi_ap_get_sta_list */
+  150,   /* field[150] = resp_wifi_clear_ap_list */
+  152,   /* field[152] = resp_wifi_clear_fast_connect */
+  142,   /* field[142] = resp_wifi_connect */
+  153,   /* field[153] = resp_wifi_deauth_sta */
+  139,   /* field[139] = resp_wifi_deinit */
+  170,   /* field[170] = resp_wifi_disable_pmf_config */
+  143,   /* field[143] = resp_wifi_disconnect */
+  179,   /* field[179] = resp_wifi_get_band */
+  181,   /* field[181] = resp_wifi_get_bandmode */
+  158,   /* field[158] = resp_wifi_get_bandwidth */
+  177,   /* field[177] = resp_wifi_get_bandwidths */
+  160,   /* field[160] = resp_wifi_get_channel */
+  145,   /* field[145] = resp_wifi_get_config */
+  162,   /* field[162] = resp_wifi_get_country */
+  169,   /* field[169] = resp_wifi_get_country_code */
+  167,   /* field[167] = resp_wifi_get_inactive_time */
+  156,   /* field[156] = resp_wifi_get_protocol */
+  175,   /* field[175] = resp_wifi_get_protocols */
+  131,   /* field[131] = resp_wifi_get_ps */
+  138,   /* field[138] = resp_wifi_init */
+  151,   /* field[151] = resp_wifi_restore */
+  148,   /* field[148] = resp_wifi_scan_get_ap_num */
+  183,   /* field[183] = resp_wifi_scan_get_ap_record */
+  149,   /* field[149] = resp_wifi_scan_get_ap_records */
+  129,   /* field[129] = resp_wifi_scan_params */
+  146,   /* field[146] = resp_wifi_scan_start */
+  147,   /* field[147] = resp_wifi_scan_stop */
+  178,   /* field[178] = resp_wifi_set_band */
+  180,   /* field[180] = resp_wifi_set_bandmode */
+  157,   /* field[157] = resp_wifi_set_bandwidth */
+  176,   /* field[176] = resp_wifi_set_bandwidths */
+  159,   /* field[159] = resp_wifi_set_channel */
+  144,   /* field[144] = resp_wifi_set_config */
+  161,   /* field[161] = resp_wifi_set_country */
+  168,   /* field[168] = resp_wifi_set_country_code */
+  166,   /* field[166] = resp_wifi_set_inactive_time */
+  213,   /* field[213] = resp_wifi_set_okc_support */
+  155,   /* field[155] = resp_wifi_set_protocol */
+  174,   /* field[174] = resp_wifi_set_protocols */
+  130,   /* field[130] = resp_wifi_set_ps */
+  165,   /* field[165] = resp_wifi_set_storage */
+  194,   /* field[194] = resp_wifi_sta_enterprise_disable */
+  193,   /* field[193] = resp_wifi_sta_enterprise_enable */
+  171,   /* field[171] = resp_wifi_sta_get_aid */
+  154,   /* field[154] = resp_wifi_sta_get_ap_info */
+  172,   /* field[172] = resp_wifi_sta_get_negotiated_phymode */
+  173,   /* field[173] = resp_wifi_sta_get_rssi */
+  190,   /* field[190] = resp_wifi_sta_itwt_get_flow_id_status */
+  191,   /* field[191] = resp_wifi_sta_itwt_send_probe_req */
+  192,   /* field[192] = resp_wifi_sta_itwt_set_target_wake_time_offset */
+  187,   /* field[187] = resp_wifi_sta_itwt_setup */
+  189,   /* field[189] = resp_wifi_sta_itwt_suspend */
+  188,   /* field[188] = resp_wifi_sta_itwt_teardown */
+  186,   /* field[186] = resp_wifi_sta_twt_config */
+  140,   /* field[140] = resp_wifi_start */
+  141,   /* field[141] = resp_wifi_stop */
   2,   /* field[2] = uid */
 };
 static const ProtobufCIntRange rpc__number_ranges[16 + 1] =
@@ -32065,15 +32771,15 @@ static const ProtobufCIntRange rpc__number_ranges[16 + 1] =
   { 334, 54 },
   { 337, 56 },
   { 341, 59 },
-  { 513, 115 },
-  { 553, 153 },
-  { 567, 161 },
-  { 581, 164 },
-  { 590, 166 },
-  { 593, 168 },
-  { 597, 171 },
-  { 769, 227 },
-  { 0, 248 }
+  { 513, 117 },
+  { 553, 155 },
+  { 567, 163 },
+  { 581, 166 },
+  { 590, 168 },
+  { 593, 170 },
+  { 597, 173 },
+  { 769, 231 },
+  { 0, 252 }
 };
 const ProtobufCMessageDescriptor rpc__descriptor =
 {
@@ -32083,7 +32789,7 @@ const ProtobufCMessageDescriptor rpc__descriptor =
   "Rpc",
   "",
   sizeof(Rpc),
-  248,
+  252,
   rpc__field_descriptors,
   rpc__field_indices_by_name,
   16,  rpc__number_ranges,
@@ -32400,7 +33106,7 @@ const ProtobufCEnumDescriptor rpc_feature_option__descriptor =
   rpc_feature_option__value_ranges,
   NULL,NULL,NULL,NULL   /* reserved[1234] */
 };
-static const ProtobufCEnumValue rpc_id__enum_values_by_number[304] =
+static const ProtobufCEnumValue rpc_id__enum_values_by_number[308] =
 {
   { "MsgId_Invalid", "RPC_ID__MsgId_Invalid", 0 },
   { "Req_Base", "RPC_ID__Req_Base", 256 },
@@ -32542,7 +33248,9 @@ static const ProtobufCEnumValue rpc_id__enum_values_by_number[304] =
   { "Req_GpioInputEnable", "RPC_ID__Req_GpioInputEnable", 394 },
   { "Req_GpioSetPullMode", "RPC_ID__Req_GpioSetPullMode", 395 },
   { "Req_ExtCoex", "RPC_ID__Req_ExtCoex", 396 },
-  { "Req_Max", "RPC_ID__Req_Max", 397 },
+  { "Req_NwSplitPortRules", "RPC_ID__Req_NwSplitPortRules", 397 },
+  { "Req_SetWakeRules", "RPC_ID__Req_SetWakeRules", 398 },
+  { "Req_Max", "RPC_ID__Req_Max", 399 },
   { "Resp_Base", "RPC_ID__Resp_Base", 512 },
   { "Resp_GetMACAddress", "RPC_ID__Resp_GetMACAddress", 513 },
   { "Resp_SetMacAddress", "RPC_ID__Resp_SetMacAddress", 514 },
@@ -32682,7 +33390,9 @@ static const ProtobufCEnumValue rpc_id__enum_values_by_number[304] =
   { "Resp_GpioInputEnable", "RPC_ID__Resp_GpioInputEnable", 650 },
   { "Resp_GpioSetPullMode", "RPC_ID__Resp_GpioSetPullMode", 651 },
   { "Resp_ExtCoex", "RPC_ID__Resp_ExtCoex", 652 },
-  { "Resp_Max", "RPC_ID__Resp_Max", 653 },
+  { "Resp_NwSplitPortRules", "RPC_ID__Resp_NwSplitPortRules", 653 },
+  { "Resp_SetWakeRules", "RPC_ID__Resp_SetWakeRules", 654 },
+  { "Resp_Max", "RPC_ID__Resp_Max", 655 },
   { "Event_Base", "RPC_ID__Event_Base", 768 },
   { "Event_ESPInit", "RPC_ID__Event_ESPInit", 769 },
   { "Event_Heartbeat", "RPC_ID__Event_Heartbeat", 770 },
@@ -32708,33 +33418,33 @@ static const ProtobufCEnumValue rpc_id__enum_values_by_number[304] =
   { "Event_Max", "RPC_ID__Event_Max", 790 },
 };
 static const ProtobufCIntRange rpc_id__value_ranges[] = {
-{0, 0},{256, 1},{297, 40},{512, 141},{553, 180},{768, 281},{0, 304}
-};
-static const ProtobufCEnumValueIndex rpc_id__enum_values_by_name[304] =
-{
-  { "Event_AP_StaConnected", 284 },
-  { "Event_AP_StaDisconnected", 285 },
-  { "Event_Base", 281 },
-  { "Event_CustomRpc", 301 },
-  { "Event_DhcpDnsStatus", 290 },
-  { "Event_ESPInit", 282 },
-  { "Event_Heartbeat", 283 },
-  { "Event_Max", 303 },
-  { "Event_MemMonitor", 302 },
-  { "Event_StaConnected", 288 },
-  { "Event_StaDisconnected", 289 },
-  { "Event_StaItwtProbe", 294 },
-  { "Event_StaItwtSetup", 291 },
-  { "Event_StaItwtSuspend", 293 },
-  { "Event_StaItwtTeardown", 292 },
-  { "Event_StaScanDone", 287 },
-  { "Event_SuppDppCfgRecvd", 296 },
-  { "Event_SuppDppFail", 297 },
-  { "Event_SuppDppUriReady", 295 },
-  { "Event_WifiDppCfgRecvd", 299 },
-  { "Event_WifiDppFail", 300 },
-  { "Event_WifiDppUriReady", 298 },
-  { "Event_WifiEventNoArgs", 286 },
+{0, 0},{256, 1},{297, 40},{512, 143},{553, 182},{768, 285},{0, 308}
+};
+static const ProtobufCEnumValueIndex rpc_id__enum_values_by_name[308] =
+{
+  { "Event_AP_StaConnected", 288 },
+  { "Event_AP_StaDisconnected", 289 },
+  { "Event_Base", 285 },
+  { "Event_CustomRpc", 305 },
+  { "Event_DhcpDnsStatus", 294 },
+  { "Event_ESPInit", 286 },
+  { "Event_Heartbeat", 287 },
+  { "Event_Max", 307 },
+  { "Event_MemMonitor", 306 },
+  { "Event_StaConnected", 292 },
+  { "Event_StaDisconnected", 293 },
+  { "Event_StaItwtProbe", 298 },
+  { "Event_StaItwtSetup", 295 },
+  { "Event_StaItwtSuspend", 297 },
+  { "Event_StaItwtTeardown", 296 },
+  { "Event_StaScanDone", 291 },
+  { "Event_SuppDppCfgRecvd", 300 },
+  { "Event_SuppDppFail", 301 },
+  { "Event_SuppDppUriReady", 299 },
+  { "Event_WifiDppCfgRecvd", 303 },
+  { "Event_WifiDppFail", 304 },
+  { "Event_WifiDppUriReady", 302 },
+  { "Event_WifiEventNoArgs", 290 },
   { "MsgId_Invalid", 0 },
   { "Req_AppGetDesc", 12 },
   { "Req_Base", 1 },
@@ -32776,14 +33486,16 @@ static const ProtobufCEnumValueIndex rpc_id__enum_values_by_name[304] =
   { "Req_GpioSetPullMode", 138 },
   { "Req_IfaceMacAddrLenGet", 129 },
   { "Req_IfaceMacAddrSetGet", 128 },
-  { "Req_Max", 140 },
+  { "Req_Max", 142 },
   { "Req_MemMonitor", 13 },
+  { "Req_NwSplitPortRules", 140 },
   { "Req_OTAActivate", 11 },
   { "Req_OTABegin", 17 },
   { "Req_OTAEnd", 19 },
   { "Req_OTAWrite", 18 },
   { "Req_SetDhcpDnsStatus", 95 },
   { "Req_SetMacAddress", 3 },
+  { "Req_SetWakeRules", 141 },
   { "Req_SetWifiMode", 5 },
   { "Req_SuppDppBootstrapGen", 8 },
   { "Req_SuppDppDeinit", 7 },
@@ -32876,146 +33588,148 @@ static const ProtobufCEnumValueIndex rpc_id__enum_values_by_name[304] =
   { "Req_WifiStart", 25 },
   { "Req_WifiStatisDump", 70 },
   { "Req_WifiStop", 26 },
-  { "Resp_AppGetDesc", 152 },
-  { "Resp_Base", 141 },
-  { "Resp_ConfigHeartbeat", 162 },
-  { "Resp_CustomRpc", 271 },
-  { "Resp_EapClearCaCert", 255 },
-  { "Resp_EapClearCertificateAndKey", 257 },
-  { "Resp_EapClearIdentity", 247 },
-  { "Resp_EapClearNewPassword", 253 },
-  { "Resp_EapClearPassword", 251 },
-  { "Resp_EapClearUsername", 249 },
-  { "Resp_EapGetDisableTimeCheck", 258 },
-  { "Resp_EapSetCaCert", 254 },
-  { "Resp_EapSetCertificateAndKey", 256 },
-  { "Resp_EapSetDisableTimeCheck", 266 },
-  { "Resp_EapSetDomainName", 265 },
-  { "Resp_EapSetEapMethods", 267 },
-  { "Resp_EapSetFastParams", 262 },
-  { "Resp_EapSetIdentity", 246 },
-  { "Resp_EapSetNewPassword", 252 },
-  { "Resp_EapSetPacFile", 261 },
-  { "Resp_EapSetPassword", 250 },
-  { "Resp_EapSetSuitebCertification", 260 },
-  { "Resp_EapSetTtlsPhase2Method", 259 },
-  { "Resp_EapSetUsername", 248 },
-  { "Resp_EapUseDefaultCertBundle", 263 },
-  { "Resp_ExtCoex", 279 },
-  { "Resp_FeatureControl", 270 },
-  { "Resp_GetCoprocessorFwVersion", 233 },
-  { "Resp_GetDhcpDnsStatus", 236 },
-  { "Resp_GetMACAddress", 142 },
-  { "Resp_GetWifiMode", 144 },
-  { "Resp_GpioConfig", 272 },
-  { "Resp_GpioGetLevel", 275 },
-  { "Resp_GpioInputEnable", 277 },
-  { "Resp_GpioResetPin", 273 },
-  { "Resp_GpioSetDirection", 276 },
-  { "Resp_GpioSetLevel", 274 },
-  { "Resp_GpioSetPullMode", 278 },
-  { "Resp_IfaceMacAddrLenGet", 269 },
-  { "Resp_IfaceMacAddrSetGet", 268 },
-  { "Resp_Max", 280 },
-  { "Resp_MemMonitor", 153 },
-  { "Resp_OTAActivate", 151 },
-  { "Resp_OTABegin", 157 },
-  { "Resp_OTAEnd", 159 },
-  { "Resp_OTAWrite", 158 },
-  { "Resp_SetDhcpDnsStatus", 235 },
-  { "Resp_SetMacAddress", 143 },
-  { "Resp_SetWifiMode", 145 },
-  { "Resp_SuppDppBootstrapGen", 148 },
-  { "Resp_SuppDppDeinit", 147 },
-  { "Resp_SuppDppInit", 146 },
-  { "Resp_SuppDppStartListen", 149 },
-  { "Resp_SuppDppStopListen", 150 },
-  { "Resp_Wifi80211Tx", 200 },
-  { "Resp_WifiApGetStaAid", 195 },
-  { "Resp_WifiApGetStaList", 194 },
-  { "Resp_WifiClearApList", 175 },
-  { "Resp_WifiClearFastConnect", 177 },
-  { "Resp_WifiConfig11bRate", 215 },
-  { "Resp_WifiConfig80211TxRate", 219 },
-  { "Resp_WifiConnect", 167 },
-  { "Resp_WifiConnectionlessModuleSetWakeInterval", 216 },
-  { "Resp_WifiDeauthSta", 178 },
-  { "Resp_WifiDeinit", 164 },
-  { "Resp_WifiDisablePmfConfig", 220 },
-  { "Resp_WifiDisconnect", 168 },
-  { "Resp_WifiFtmEndSession", 213 },
-  { "Resp_WifiFtmInitiateSession", 212 },
-  { "Resp_WifiFtmRespSetOffset", 214 },
-  { "Resp_WifiGetAnt", 206 },
-  { "Resp_WifiGetAntGpio", 204 },
-  { "Resp_WifiGetBand", 230 },
-  { "Resp_WifiGetBandMode", 232 },
-  { "Resp_WifiGetBandwidth", 183 },
-  { "Resp_WifiGetBandwidths", 228 },
-  { "Resp_WifiGetChannel", 185 },
-  { "Resp_WifiGetConfig", 170 },
-  { "Resp_WifiGetCountry", 187 },
-  { "Resp_WifiGetCountryCode", 218 },
-  { "Resp_WifiGetEventMask", 199 },
-  { "Resp_WifiGetInactiveTime", 209 },
-  { "Resp_WifiGetMaxTxPower", 161 },
-  { "Resp_WifiGetPromiscuous", 189 },
-  { "Resp_WifiGetPromiscuousCtrlFilter", 193 },
-  { "Resp_WifiGetPromiscuousFilter", 191 },
-  { "Resp_WifiGetProtocol", 181 },
-  { "Resp_WifiGetProtocols", 226 },
-  { "Resp_WifiGetPs", 156 },
-  { "Resp_WifiGetTsfTime", 207 },
-  { "Resp_WifiInit", 163 },
-  { "Resp_WifiRestore", 176 },
-  { "Resp_WifiScanGetApNum", 173 },
-  { "Resp_WifiScanGetApRecord", 234 },
-  { "Resp_WifiScanGetApRecords", 174 },
-  { "Resp_WifiScanParams", 154 },
-  { "Resp_WifiScanStart", 171 },
-  { "Resp_WifiScanStop", 172 },
-  { "Resp_WifiSetAnt", 205 },
-  { "Resp_WifiSetAntGpio", 203 },
-  { "Resp_WifiSetBand", 229 },
-  { "Resp_WifiSetBandMode", 231 },
-  { "Resp_WifiSetBandwidth", 182 },
-  { "Resp_WifiSetBandwidths", 227 },
-  { "Resp_WifiSetChannel", 184 },
-  { "Resp_WifiSetConfig", 169 },
-  { "Resp_WifiSetCountry", 186 },
-  { "Resp_WifiSetCountryCode", 217 },
-  { "Resp_WifiSetCsi", 202 },
-  { "Resp_WifiSetCsiConfig", 201 },
-  { "Resp_WifiSetDynamicCs", 223 },
-  { "Resp_WifiSetEventMask", 198 },
-  { "Resp_WifiSetInactiveTime", 208 },
-  { "Resp_WifiSetMaxTxPower", 160 },
-  { "Resp_WifiSetOkcSupport", 264 },
-  { "Resp_WifiSetPromiscuous", 188 },
-  { "Resp_WifiSetPromiscuousCtrlFilter", 192 },
-  { "Resp_WifiSetPromiscuousFilter", 190 },
-  { "Resp_WifiSetProtocol", 180 },
-  { "Resp_WifiSetProtocols", 225 },
-  { "Resp_WifiSetPs", 155 },
-  { "Resp_WifiSetRssiThreshold", 211 },
-  { "Resp_WifiSetStorage", 196 },
-  { "Resp_WifiSetVendorIe", 197 },
-  { "Resp_WifiStaEnterpriseDisable", 245 },
-  { "Resp_WifiStaEnterpriseEnable", 244 },
-  { "Resp_WifiStaGetAid", 221 },
-  { "Resp_WifiStaGetApInfo", 179 },
-  { "Resp_WifiStaGetNegotiatedPhymode", 222 },
-  { "Resp_WifiStaGetRssi", 224 },
-  { "Resp_WifiStaItwtGetFlowIdStatus", 241 },
-  { "Resp_WifiStaItwtSendProbeReq", 242 },
-  { "Resp_WifiStaItwtSetTargetWakeTimeOffset", 243 },
-  { "Resp_WifiStaItwtSetup", 238 },
-  { "Resp_WifiStaItwtSuspend", 240 },
-  { "Resp_WifiStaItwtTeardown", 239 },
-  { "Resp_WifiStaTwtConfig", 237 },
-  { "Resp_WifiStart", 165 },
-  { "Resp_WifiStatisDump", 210 },
-  { "Resp_WifiStop", 166 },
+  { "Resp_AppGetDesc", 154 },
+  { "Resp_Base", 143 },
+  { "Resp_ConfigHeartbeat", 164 },
+  { "Resp_CustomRpc", 273 },
+  { "Resp_EapClearCaCert", 257 },
+  { "Resp_EapClearCertificateAndKey", 259 },
+  { "Resp_EapClearIdentity", 249 },
+  { "Resp_EapClearNewPassword", 255 },
+  { "Resp_EapClearPassword", 253 },
+  { "Resp_EapClearUsername", 251 },
+  { "Resp_EapGetDisableTimeCheck", 260 },
+  { "Resp_EapSetCaCert", 256 },
+  { "Resp_EapSetCertificateAndKey", 258 },
+  { "Resp_EapSetDisableTimeCheck", 268 },
+  { "Resp_EapSetDomainName", 267 },
+  { "Resp_EapSetEapMethods", 269 },
+  { "Resp_EapSetFastParams", 264 },
+  { "Resp_EapSetIdentity", 248 },
+  { "Resp_EapSetNewPassword", 254 },
+  { "Resp_EapSetPacFile", 263 },
+  { "Resp_EapSetPassword", 252 },
+  { "Resp_EapSetSuitebCertification", 262 },
+  { "Resp_EapSetTtlsPhase2Method", 261 },
+  { "Resp_EapSetUsername", 250 },
+  { "Resp_EapUseDefaultCertBundle", 265 },
+  { "Resp_ExtCoex", 281 },
+  { "Resp_FeatureControl", 272 },
+  { "Resp_GetCoprocessorFwVersion", 235 },
+  { "Resp_GetDhcpDnsStatus", 238 },
+  { "Resp_GetMACAddress", 144 },
+  { "Resp_GetWifiMode", 146 },
+  { "Resp_GpioConfig", 274 },
+  { "Resp_GpioGetLevel", 277 },
+  { "Resp_GpioInputEnable", 279 },
+  { "Resp_GpioResetPin", 275 },
+  { "Resp_GpioSetDirection", 278 },
+  { "Resp_GpioSetLevel", 276 },
+  { "Resp_GpioSetPullMode", 280 },
+  { "Resp_IfaceMacAddrLenGet", 271 },
+  { "Resp_IfaceMacAddrSetGet", 270 },
+  { "Resp_Max", 284 },
+  { "Resp_MemMonitor", 155 },
+  { "Resp_NwSplitPortRules", 282 },
+  { "Resp_OTAActivate", 153 },
+  { "Resp_OTABegin", 159 },
+  { "Resp_OTAEnd", 161 },
+  { "Resp_OTAWrite", 160 },
+  { "Resp_SetDhcpDnsStatus", 237 },
+  { "Resp_SetMacAddress", 145 },
+  { "Resp_SetWakeRules", 283 },
+  { "Resp_SetWifiMode", 147 },
+  { "Resp_SuppDppBootstrapGen", 150 },
+  { "Resp_SuppDppDeinit", 149 },
+  { "Resp_SuppDppInit", 148 },
+  { "Resp_SuppDppStartListen", 151 },
+  { "Resp_SuppDppStopListen", 152 },
+  { "Resp_Wifi80211Tx", 202 },
+  { "Resp_WifiApGetStaAid", 197 },
+  { "Resp_WifiApGetStaList", 196 },
+  { "Resp_WifiClearApList", 177 },
+  { "Resp_WifiClearFastConnect", 179 },
+  { "Resp_WifiConfig11bRate", 217 },
+  { "Resp_WifiConfig80211TxRate", 221 },
+  { "Resp_WifiConnect", 169 },
+  { "Resp_WifiConnectionlessModuleSetWakeInterval", 218 },
+  { "Resp_WifiDeauthSta", 180 },
+  { "Resp_WifiDeinit", 166 },
+  { "Resp_WifiDisablePmfConfig", 222 },
+  { "Resp_WifiDisconnect", 170 },
+  { "Resp_WifiFtmEndSession", 215 },
+  { "Resp_WifiFtmInitiateSession", 214 },
+  { "Resp_WifiFtmRespSetOffset", 216 },
+  { "Resp_WifiGetAnt", 208 },
+  { "Resp_WifiGetAntGpio", 206 },
+  { "Resp_WifiGetBand", 232 },
+  { "Resp_WifiGetBandMode", 234 },
+  { "Resp_WifiGetBandwidth", 185 },
+  { "Resp_WifiGetBandwidths", 230 },
+  { "Resp_WifiGetChannel", 187 },
+  { "Resp_WifiGetConfig", 172 },
+  { "Resp_WifiGetCountry", 189 },
+  { "Resp_WifiGetCountryCode", 220 },
+  { "Resp_WifiGetEventMask", 201 },
+  { "Resp_WifiGetInactiveTime", 211 },
+  { "Resp_WifiGetMaxTxPower", 163 },
+  { "Resp_WifiGetPromiscuous", 191 },
+  { "Resp_WifiGetPromiscuousCtrlFilter", 195 },
+  { "Resp_WifiGetPromiscuousFilter", 193 },
+  { "Resp_WifiGetProtocol", 183 },
+  { "Resp_WifiGetProtocols", 228 },
+  { "Resp_WifiGetPs", 158 },
+  { "Resp_WifiGetTsfTime", 209 },
+  { "Resp_WifiInit", 165 },
+  { "Resp_WifiRestore", 178 },
+  { "Resp_WifiScanGetApNum", 175 },
+  { "Resp_WifiScanGetApRecord", 236 },
+  { "Resp_WifiScanGetApRecords", 176 },
+  { "Resp_WifiScanParams", 156 },
+  { "Resp_WifiScanStart", 173 },
+  { "Resp_WifiScanStop", 174 },
+  { "Resp_WifiSetAnt", 207 },
+  { "Resp_WifiSetAntGpio", 205 },
+  { "Resp_WifiSetBand", 231 },
+  { "Resp_WifiSetBandMode", 233 },
+  { "Resp_WifiSetBandwidth", 184 },
+  { "Resp_WifiSetBandwidths", 229 },
+  { "Resp_WifiSetChannel", 186 },
+  { "Resp_WifiSetConfig", 171 },
+  { "Resp_WifiSetCountry", 188 },
+  { "Resp_WifiSetCountryCode", 219 },
+  { "Resp_WifiSetCsi", 204 },
+  { "Resp_WifiSetCsiConfig", 203 },
+  { "Resp_WifiSetDynamicCs", 225 },
+  { "Resp_WifiSetEventMask", 200 },
+  { "Resp_WifiSetInactiveTime", 210 },
+  { "Resp_WifiSetMaxTxPower", 162 },
+  { "Resp_WifiSetOkcSupport", 266 },
+  { "Resp_WifiSetPromiscuous", 190 },
+  { "Resp_WifiSetPromiscuousCtrlFilter", 194 },
+  { "Resp_WifiSetPromiscuousFilter", 192 },
+  { "Resp_WifiSetProtocol", 182 },
+  { "Resp_WifiSetProtocols", 227 },
+  { "Resp_WifiSetPs", 157 },
+  { "Resp_WifiSetRssiThreshold", 213 },
+  { "Resp_WifiSetStorage", 198 },
+  { "Resp_WifiSetVendorIe", 199 },
+  { "Resp_WifiStaEnterpriseDisable", 247 },
+  { "Resp_WifiStaEnterpriseEnable", 246 },
+  { "Resp_WifiStaGetAid", 223 },
+  { "Resp_WifiStaGetApInfo", 181 },
+  { "Resp_WifiStaGetNegotiatedPhymode", 224 },
+  { "Resp_WifiStaGetRssi", 226 },
+  { "Resp_WifiStaItwtGetFlowIdStatus", 243 },
+  { "Resp_WifiStaItwtSendProbeReq", 244 },
+  { "Resp_WifiStaItwtSetTargetWakeTimeOffset", 245 },
+  { "Resp_WifiStaItwtSetup", 240 },
+  { "Resp_WifiStaItwtSuspend", 242 },
+  { "Resp_WifiStaItwtTeardown", 241 },
+  { "Resp_WifiStaTwtConfig", 239 },
+  { "Resp_WifiStart", 167 },
+  { "Resp_WifiStatisDump", 212 },
+  { "Resp_WifiStop", 168 },
 };
 const ProtobufCEnumDescriptor rpc_id__descriptor =
 {
@@ -33024,9 +33738,9 @@ const ProtobufCEnumDescriptor rpc_id__descriptor =
   "RpcId",
   "RpcId",
   "",
-  304,
+  308,
   rpc_id__enum_values_by_number,
-  304,
+  308,
   rpc_id__enum_values_by_name,
   6,
   rpc_id__value_ranges,
@@ -33158,3 +33872,35 @@ const ProtobufCEnumDescriptor rpc__ext_coex_cmd__descriptor =
   rpc__ext_coex_cmd__value_ranges,
   NULL,NULL,NULL,NULL   /* reserved[1234] */
 };
+static const ProtobufCEnumValue rpc__nw_split_port_action__enum_values_by_number[4] =
+{
+  { "NwSplitPortAction_Host", "RPC__NW_SPLIT_PORT_ACTION__NwSplitPortAction_Host", 0 },
+  { "NwSplitPortAction_Slave", "RPC__NW_SPLIT_PORT_ACTION__NwSplitPortAction_Slave", 1 },
+  { "NwSplitPortAction_Both", "RPC__NW_SPLIT_PORT_ACTION__NwSplitPortAction_Both", 2 },
+  { "NwSplitPortAction_Drop", "RPC__NW_SPLIT_PORT_ACTION__NwSplitPortAction_Drop", 3 },
+};
+static const ProtobufCIntRange rpc__nw_split_port_action__value_ranges[] = {
+{0, 0},{0, 4}
+};
+static const ProtobufCEnumValueIndex rpc__nw_split_port_action__enum_values_by_name[4] =
+{
+  { "NwSplitPortAction_Both", 2 },
+  { "NwSplitPortAction_Drop", 3 },
+  { "NwSplitPortAction_Host", 0 },
+  { "NwSplitPortAction_Slave", 1 },
+};
+const ProtobufCEnumDescriptor rpc__nw_split_port_action__descriptor =
+{
+  PROTOBUF_C__ENUM_DESCRIPTOR_MAGIC,
+  "Rpc_NwSplitPortAction",
+  "Rpc_NwSplitPortAction",
+  "RpcNwSplitPortAction",
+  "",
+  4,
+  rpc__nw_split_port_action__enum_values_by_number,
+  4,
+  rpc__nw_split_port_action__enum_values_by_name,
+  1,
+  rpc__nw_split_port_action__value_ranges,
+  NULL,NULL,NULL,NULL   /* reserved[1234] */
+};
@@ -251,6 +251,12 @@ typedef struct RpcReqGpioSetPullMode RpcReqGpioSetPullMode;
 typedef struct RpcRespGpioSetPullMode RpcRespGpioSetPullMode;
 typedef struct RpcReqExtCoex RpcReqExtCoex;
 typedef struct RpcRespExtCoex RpcRespExtCoex;
+typedef struct RpcNwSplitPortRule RpcNwSplitPortRule;
+typedef struct RpcReqNwSplitPortRules RpcReqNwSplitPortRules;
+typedef struct RpcRespNwSplitPortRules RpcRespNwSplitPortRules;
+typedef struct RpcWakeRule RpcWakeRule;
+typedef struct RpcReqSetWakeRules RpcReqSetWakeRules;
+typedef struct RpcRespSetWakeRules RpcRespSetWakeRules;
 typedef struct RpcEventDhcpDnsStatus RpcEventDhcpDnsStatus;
 typedef struct RpcEventStaItwtSetup RpcEventStaItwtSetup;
 typedef struct RpcEventStaItwtTeardown RpcEventStaItwtTeardown;
@@ -1019,14 +1025,22 @@ typedef enum _RpcId {
    * 0x18C
    */
   RPC_ID__Req_ExtCoex = 396,
+  /*
+   * 0x18D
+   */
+  RPC_ID__Req_NwSplitPortRules = 397,
+  /*
+   * 0x18E
+   */
+  RPC_ID__Req_SetWakeRules = 398,
   /*
    * Add new control path command response before Req_Max
    * and update Req_Max 
    */
   /*
-   *0x18D
+   *0x18F
    */
-  RPC_ID__Req_Max = 397,
+  RPC_ID__Req_Max = 399,
   /*
    ** Response Msgs *
    */
@@ -1188,11 +1202,13 @@ typedef enum _RpcId {
   RPC_ID__Resp_GpioInputEnable = 650,
   RPC_ID__Resp_GpioSetPullMode = 651,
   RPC_ID__Resp_ExtCoex = 652,
+  RPC_ID__Resp_NwSplitPortRules = 653,
+  RPC_ID__Resp_SetWakeRules = 654,
   /*
    * Add new control path command response before Resp_Max
    * and update Resp_Max 
    */
-  RPC_ID__Resp_Max = 653,
+  RPC_ID__Resp_Max = 655,
   /*
    ** Event Msgs *
    */
@@ -1276,6 +1292,16 @@ typedef enum _RpcExtCoexCmd {
   RPC__EXT_COEX_CMD__SetValidateHigh = 4
     PROTOBUF_C__FORCE_ENUM_TO_BE_INT_SIZE(RPC__EXT_COEX_CMD)
 } RpcExtCoexCmd;
+/*
+ * Network split: port forwarding rules, first matching rule wins 
+ */
+typedef enum _RpcNwSplitPortAction {
+  RPC__NW_SPLIT_PORT_ACTION__NwSplitPortAction_Host = 0,
+  RPC__NW_SPLIT_PORT_ACTION__NwSplitPortAction_Slave = 1,
+  RPC__NW_SPLIT_PORT_ACTION__NwSplitPortAction_Both = 2,
+  RPC__NW_SPLIT_PORT_ACTION__NwSplitPortAction_Drop = 3
+    PROTOBUF_C__FORCE_ENUM_TO_BE_INT_SIZE(RPC__NW_SPLIT_PORT_ACTION)
+} RpcNwSplitPortAction;
 
 /* --- messages --- */
 
@@ -4815,6 +4841,119 @@ struct  RpcRespExtCoex
     , 0 }
 
 
+struct  RpcNwSplitPortRule
+{
+  ProtobufCMessage base;
+  /*
+   * IP protocol number, TCP (6) or UDP (17)
+   */
+  uint32_t proto;
+  /*
+   * match source port instead of destination port
+   */
+  protobuf_c_boolean match_src;
+  uint32_t port_start;
+  /*
+   * inclusive
+   */
+  uint32_t port_end;
+  /*
+   * Rpc_NwSplitPortAction
+   */
+  uint32_t action;
+};
+#define RPC__NW_SPLIT_PORT_RULE__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&rpc__nw_split_port_rule__descriptor) \
+    , 0, 0, 0, 0, 0 }
+
+
+struct  RpcReqNwSplitPortRules
+{
+  ProtobufCMessage base;
+  /*
+   * drop the rules in place before adding these
+   */
+  protobuf_c_boolean replace;
+  size_t n_rules;
+  RpcNwSplitPortRule **rules;
+};
+#define RPC__REQ__NW_SPLIT_PORT_RULES__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&rpc__req__nw_split_port_rules__descriptor) \
+    , 0, 0,NULL }
+
+
+struct  RpcRespNwSplitPortRules
+{
+  ProtobufCMessage base;
+  int32_t resp;
+};
+#define RPC__RESP__NW_SPLIT_PORT_RULES__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&rpc__resp__nw_split_port_rules__descriptor) \
+    , 0 }
+
+
+/*
+ * Host wake up: packet pattern rules, a packet matching any rule wakes the host 
+ */
+struct  RpcWakeRule
+{
+  ProtobufCMessage base;
+  /*
+   * 0: L2 frame, 1: L3 header, 2: L4 header, 3: L4 payload
+   */
+  uint32_t layer;
+  /*
+   * IP protocol number to match, 0 for any
+   */
+  uint32_t ip_proto;
+  /*
+   * byte offset from the start of the layer
+   */
+  uint32_t offset;
+  /*
+   * same length as value, up to 16 bytes
+   */
+  ProtobufCBinaryData mask;
+  ProtobufCBinaryData value;
+  /*
+   * max wake ups per interval, 0 for no limit
+   */
+  uint32_t rate_limit;
+  uint32_t rate_interval_ms;
+  /*
+   * TCP/UDP source or destination port to match, 0 for any
+   */
+  uint32_t port;
+};
+#define RPC__WAKE_RULE__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&rpc__wake_rule__descriptor) \
+    , 0, 0, 0, {0,NULL}, {0,NULL}, 0, 0, 0 }
+
+
+struct  RpcReqSetWakeRules
+{
+  ProtobufCMessage base;
+  /*
+   * empty: restore the default wake up behaviour
+   */
+  size_t n_rules;
+  RpcWakeRule **rules;
+};
+#define RPC__REQ__SET_WAKE_RULES__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&rpc__req__set_wake_rules__descriptor) \
+    , 0,NULL }
+
+
+struct  RpcRespSetWakeRules
+{
+  ProtobufCMessage base;
+  int32_t resp;
+};
+#define RPC__RESP__SET_WAKE_RULES__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&rpc__resp__set_wake_rules__descriptor) \
+    , 0 }
+
+
 struct  RpcEventDhcpDnsStatus
 {
   ProtobufCMessage base;
@@ -5655,6 +5794,8 @@ typedef enum {
   RPC__PAYLOAD_REQ_GPIO_INPUT_ENABLE = 394,
   RPC__PAYLOAD_REQ_GPIO_SET_PULL_MODE = 395,
   RPC__PAYLOAD_REQ_EXT_COEX = 396,
+  RPC__PAYLOAD_REQ_NW_SPLIT_PORT_RULES = 397,
+  RPC__PAYLOAD_REQ_SET_WAKE_RULES = 398,
   RPC__PAYLOAD_RESP_GET_MAC_ADDRESS = 513,
   RPC__PAYLOAD_RESP_SET_MAC_ADDRESS = 514,
   RPC__PAYLOAD_RESP_GET_WIFI_MODE = 515,
@@ -5767,6 +5908,8 @@ typedef enum {
   RPC__PAYLOAD_RESP_GPIO_INPUT_ENABLE = 650,
   RPC__PAYLOAD_RESP_GPIO_SET_PULL_MODE = 651,
   RPC__PAYLOAD_RESP_EXT_COEX = 652,
+  RPC__PAYLOAD_RESP_NW_SPLIT_PORT_RULES = 653,
+  RPC__PAYLOAD_RESP_SET_WAKE_RULES = 654,
   RPC__PAYLOAD_EVENT_ESP_INIT = 769,
   RPC__PAYLOAD_EVENT_HEARTBEAT = 770,
   RPC__PAYLOAD_EVENT_AP_STA_CONNECTED = 771,
@@ -5923,6 +6066,8 @@ struct  Rpc
     RpcReqGpioInputEnable *req_gpio_input_enable;
     RpcReqGpioSetPullMode *req_gpio_set_pull_mode;
     RpcReqExtCoex *req_ext_coex;
+    RpcReqNwSplitPortRules *req_nw_split_port_rules;
+    RpcReqSetWakeRules *req_set_wake_rules;
     /*
      ** Responses *
      */
@@ -6038,6 +6183,8 @@ struct  Rpc
     RpcRespGpioInputEnable *resp_gpio_input_enable;
     RpcRespGpioSetPullMode *resp_gpio_set_pull_mode;
     RpcRespExtCoex *resp_ext_coex;
+    RpcRespNwSplitPortRules *resp_nw_split_port_rules;
+    RpcRespSetWakeRules *resp_set_wake_rules;
     /*
      ** Notifications *
      */
@@ -10553,6 +10700,120 @@ RpcRespExtCoex *
 void   rpc__resp__ext_coex__free_unpacked
                      (RpcRespExtCoex *message,
                       ProtobufCAllocator *allocator);
+/* RpcNwSplitPortRule methods */
+void   rpc__nw_split_port_rule__init
+                     (RpcNwSplitPortRule         *message);
+size_t rpc__nw_split_port_rule__get_packed_size
+                     (const RpcNwSplitPortRule   *message);
+size_t rpc__nw_split_port_rule__pack
+                     (const RpcNwSplitPortRule   *message,
+                      uint8_t             *out);
+size_t rpc__nw_split_port_rule__pack_to_buffer
+                     (const RpcNwSplitPortRule   *message,
+                      ProtobufCBuffer     *buffer);
+RpcNwSplitPortRule *
+       rpc__nw_split_port_rule__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   rpc__nw_split_port_rule__free_unpacked
+                     (RpcNwSplitPortRule *message,
+                      ProtobufCAllocator *allocator);
+/* RpcReqNwSplitPortRules methods */
+void   rpc__req__nw_split_port_rules__init
+                     (RpcReqNwSplitPortRules         *message);
+size_t rpc__req__nw_split_port_rules__get_packed_size
+                     (const RpcReqNwSplitPortRules   *message);
+size_t rpc__req__nw_split_port_rules__pack
+                     (const RpcReqNwSplitPortRules   *message,
+                      uint8_t             *out);
+size_t rpc__req__nw_split_port_rules__pack_to_buffer
+                     (const RpcReqNwSplitPortRules   *message,
+                      ProtobufCBuffer     *buffer);
+RpcReqNwSplitPortRules *
+       rpc__req__nw_split_port_rules__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   rpc__req__nw_split_port_rules__free_unpacked
+                     (RpcReqNwSplitPortRules *message,
+                      ProtobufCAllocator *allocator);
+/* RpcRespNwSplitPortRules methods */
+void   rpc__resp__nw_split_port_rules__init
+                     (RpcRespNwSplitPortRules         *message);
+size_t rpc__resp__nw_split_port_rules__get_packed_size
+                     (const RpcRespNwSplitPortRules   *message);
+size_t rpc__resp__nw_split_port_rules__pack
+                     (const RpcRespNwSplitPortRules   *message,
+                      uint8_t             *out);
+size_t rpc__resp__nw_split_port_rules__pack_to_buffer
+                     (const RpcRespNwSplitPortRules   *message,
+                      ProtobufCBuffer     *buffer);
+RpcRespNwSplitPortRules *
+       rpc__resp__nw_split_port_rules__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   rpc__resp__nw_split_port_rules__free_unpacked
+                     (RpcRespNwSplitPortRules *message,
+                      ProtobufCAllocator *allocator);
+/* RpcWakeRule methods */
+void   rpc__wake_rule__init
+                     (RpcWakeRule         *message);
+size_t rpc__wake_rule__get_packed_size
+                     (const RpcWakeRule   *message);
+size_t rpc__wake_rule__pack
+                     (const RpcWakeRule   *message,
+                      uint8_t             *out);
+size_t rpc__wake_rule__pack_to_buffer
+                     (const RpcWakeRule   *message,
+                      ProtobufCBuffer     *buffer);
+RpcWakeRule *
+       rpc__wake_rule__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   rpc__wake_rule__free_unpacked
+                     (RpcWakeRule *message,
+                      ProtobufCAllocator *allocator);
+/* RpcReqSetWakeRules methods */
+void   rpc__req__set_wake_rules__init
+                     (RpcReqSetWakeRules         *message);
+size_t rpc__req__set_wake_rules__get_packed_size
+                     (const RpcReqSetWakeRules   *message);
+size_t rpc__req__set_wake_rules__pack
+                     (const RpcReqSetWakeRules   *message,
+                      uint8_t             *out);
+size_t rpc__req__set_wake_rules__pack_to_buffer
+                     (const RpcReqSetWakeRules   *message,
+                      ProtobufCBuffer     *buffer);
+RpcReqSetWakeRules *
+       rpc__req__set_wake_rules__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   rpc__req__set_wake_rules__free_unpacked
+                     (RpcReqSetWakeRules *message,
+                      ProtobufCAllocator *allocator);
+/* RpcRespSetWakeRules methods */
+void   rpc__resp__set_wake_rules__init
+                     (RpcRespSetWakeRules         *message);
+size_t rpc__resp__set_wake_rules__get_packed_size
+                     (const RpcRespSetWakeRules   *message);
+size_t rpc__resp__set_wake_rules__pack
+                     (const RpcRespSetWakeRules   *message,
+                      uint8_t             *out);
+size_t rpc__resp__set_wake_rules__pack_to_buffer
+                     (const RpcRespSetWakeRules   *message,
+                      ProtobufCBuffer     *buffer);
+RpcRespSetWakeRules *
+       rpc__resp__set_wake_rules__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   rpc__resp__set_wake_rules__free_unpacked
+                     (RpcRespSetWakeRules *message,
+                      ProtobufCAllocator *allocator);
 /* RpcEventDhcpDnsStatus methods */
 void   rpc__event__dhcp_dns_status__init
                      (RpcEventDhcpDnsStatus         *message);
@@ -12479,6 +12740,24 @@ typedef void (*RpcReqExtCoex_Closure)
 typedef void (*RpcRespExtCoex_Closure)
                  (const RpcRespExtCoex *message,
                   void *closure_data);
+typedef void (*RpcNwSplitPortRule_Closure)
+                 (const RpcNwSplitPortRule *message,
+                  void *closure_data);
+typedef void (*RpcReqNwSplitPortRules_Closure)
+                 (const RpcReqNwSplitPortRules *message,
+                  void *closure_data);
+typedef void (*RpcRespNwSplitPortRules_Closure)
+                 (const RpcRespNwSplitPortRules *message,
+                  void *closure_data);
+typedef void (*RpcWakeRule_Closure)
+                 (const RpcWakeRule *message,
+                  void *closure_data);
+typedef void (*RpcReqSetWakeRules_Closure)
+                 (const RpcReqSetWakeRules *message,
+                  void *closure_data);
+typedef void (*RpcRespSetWakeRules_Closure)
+                 (const RpcRespSetWakeRules *message,
+                  void *closure_data);
 typedef void (*RpcEventDhcpDnsStatus_Closure)
                  (const RpcEventDhcpDnsStatus *message,
                   void *closure_data);
@@ -12691,6 +12970,7 @@ extern const ProtobufCEnumDescriptor    rpc__gpio_mode__descriptor;
 extern const ProtobufCEnumDescriptor    rpc__gpio_pull_mode__descriptor;
 extern const ProtobufCEnumDescriptor    rpc__mem_monitor_config__descriptor;
 extern const ProtobufCEnumDescriptor    rpc__ext_coex_cmd__descriptor;
+extern const ProtobufCEnumDescriptor    rpc__nw_split_port_action__descriptor;
 extern const ProtobufCMessageDescriptor wifi_init_config__descriptor;
 extern const ProtobufCMessageDescriptor wifi_country__descriptor;
 extern const ProtobufCMessageDescriptor wifi_active_scan_time__descriptor;
@@ -12927,6 +13207,12 @@ extern const ProtobufCMessageDescriptor rpc__req__gpio_set_pull_mode__descriptor
 extern const ProtobufCMessageDescriptor rpc__resp__gpio_set_pull_mode__descriptor;
 extern const ProtobufCMessageDescriptor rpc__req__ext_coex__descriptor;
 extern const ProtobufCMessageDescriptor rpc__resp__ext_coex__descriptor;
+extern const ProtobufCMessageDescriptor rpc__nw_split_port_rule__descriptor;
+extern const ProtobufCMessageDescriptor rpc__req__nw_split_port_rules__descriptor;
+extern const ProtobufCMessageDescriptor rpc__resp__nw_split_port_rules__descriptor;
+extern const ProtobufCMessageDescriptor rpc__wake_rule__descriptor;
+extern const ProtobufCMessageDescriptor rpc__req__set_wake_rules__descriptor;
+extern const ProtobufCMessageDescriptor rpc__resp__set_wake_rules__descriptor;
 extern const ProtobufCMessageDescriptor rpc__event__dhcp_dns_status__descriptor;
 extern const ProtobufCMessageDescriptor rpc__event__sta_itwt_setup__descriptor;
 extern const ProtobufCMessageDescriptor rpc__event__sta_itwt_teardown__descriptor;
@@ -46,6 +46,9 @@ typedef enum {
 	// Hosted UART interface
 	ESP_WLAN_UART_SUPPORT = (1 << 8),
 	ESP_BT_VHCI_UART_SUPPORT = (1 << 9), // VHCI over UART
+
+	// Hosted SDIO interface
+	ESP_SDIO_RX_DEAGGREGATION_SUPPORT = (1 << 10), // multiple host Tx pkts per SDIO transfer
 } ESP_EXTENDED_CAPABILITIES;
 
 typedef enum {
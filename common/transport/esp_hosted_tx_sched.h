@@ -0,0 +1,116 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Tx priority queue scheduler, shared by host transports and co-processor.
+ *
+ * Queues whose bit is set in strict_mask are always served first, in
+ * queue index order (PRIO_Q_SERIAL first). Remaining queues are served
+ * with deficit round robin: each visit adds the queue's quantum (bytes)
+ * to its deficit and the queue is served while the deficit is positive.
+ * The packet length is charged after dequeue, so no queue peek is needed.
+ *
+ * With strict_mask covering all queues the scheduler behaves like the
+ * original strict priority order SERIAL > BT > OTHERS.
+ */
+
+#ifndef __ESP_HOSTED_TX_SCHED__H
+#define __ESP_HOSTED_TX_SCHED__H
+
+#include <stdint.h>
+#include "esp_hosted_transport.h"
+
+#define ESP_HOSTED_TX_SCHED_ALL_STRICT  ((1 << MAX_PRIORITY_QUEUES) - 1)
+
+/* Smallest quantum accepted: one maximum sized transport buffer, so a
+ * single visit always makes the deficit positive again */
+#define ESP_HOSTED_TX_SCHED_MIN_QUANTUM ESP_TRANSPORT_MAX_BUF_SIZE
+
+/* Try to dequeue one item from queue q_idx without blocking.
+ * Returns 0 on success and fills item and len (bytes to charge) */
+typedef int (*esp_hosted_tx_sched_deq_fn_t)(void *ctx, uint8_t q_idx, void *item, uint16_t *len);
+
+typedef struct {
+	int32_t quantum[MAX_PRIORITY_QUEUES];
+	int32_t deficit[MAX_PRIORITY_QUEUES];
+	uint8_t strict_mask;
+	uint8_t next;
+} esp_hosted_tx_sched_t;
+
+struct esp_hosted_tx_sched_q_stats {
+	uint32_t pkts;
+	uint32_t bytes;
+	uint32_t wait_max_ms;
+	uint32_t wait_total_ms;
+};
+
+static inline void esp_hosted_tx_sched_init(esp_hosted_tx_sched_t *s,
+		const uint16_t quantum[MAX_PRIORITY_QUEUES], uint8_t strict_mask)
+{
+	uint8_t i = 0;
+
+	for (i = 0; i < MAX_PRIORITY_QUEUES; i++) {
+		s->quantum[i] = quantum[i];
+		if (s->quantum[i] < ESP_HOSTED_TX_SCHED_MIN_QUANTUM)
+			s->quantum[i] = ESP_HOSTED_TX_SCHED_MIN_QUANTUM;
+		s->deficit[i] = 0;
+	}
+	s->strict_mask = strict_mask & ESP_HOSTED_TX_SCHED_ALL_STRICT;
+	s->next = 0;
+}
+
+/* Dequeue the next item to transmit.
+ * Returns the queue index served, or -1 if all queues are empty.
+ * Not thread safe: call from the single Tx task only */
+static inline int esp_hosted_tx_sched_dequeue(esp_hosted_tx_sched_t *s,
+		esp_hosted_tx_sched_deq_fn_t deq, void *ctx, void *item)
+{
+	uint16_t len = 0;
+	uint8_t q = 0;
+	uint8_t i = 0;
+
+	for (q = 0; q < MAX_PRIORITY_QUEUES; q++) {
+		if ((s->strict_mask & (1 << q)) && !deq(ctx, q, item, &len))
+			return q;
+	}
+
+	if (s->strict_mask == ESP_HOSTED_TX_SCHED_ALL_STRICT)
+		return -1;
+
+	for (i = 0; i < MAX_PRIORITY_QUEUES; i++) {
+		q = s->next;
+
+		if (!(s->strict_mask & (1 << q))) {
+			if (s->deficit[q] <= 0)
+				s->deficit[q] += s->quantum[q];
+
+			if (!deq(ctx, q, item, &len)) {
+				s->deficit[q] -= len;
+				if (s->deficit[q] <= 0)
+					s->next = (q + 1) % MAX_PRIORITY_QUEUES;
+				return q;
+			}
+
+			/* an idle queue does not bank credit */
+			s->deficit[q] = 0;
+		}
+
+		s->next = (q + 1) % MAX_PRIORITY_QUEUES;
+	}
+
+	return -1;
+}
+
+static inline void esp_hosted_tx_sched_stats_update(struct esp_hosted_tx_sched_q_stats *st,
+		uint16_t len, uint32_t wait_ms)
+{
+	st->pkts++;
+	st->bytes += len;
+	st->wait_total_ms += wait_ms;
+	if (wait_ms > st->wait_max_ms)
+		st->wait_max_ms = wait_ms;
+}
+
+#endif
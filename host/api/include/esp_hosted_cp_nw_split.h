@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file esp_hosted_cp_nw_split.h
+ * @brief Network Split port forwarding API for ESP-Hosted Co-Processor
+ *
+ * With Network Split, the co-processor decides per received IP packet
+ * whether it goes to the host network stack, its own or both. Port
+ * forwarding rules take precedence over the default port ranges and
+ * can be changed at runtime, without rebooting the co-processor.
+ */
+
+#ifndef __ESP_HOSTED_CP_NW_SPLIT_H__
+#define __ESP_HOSTED_CP_NW_SPLIT_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_HOSTED_NW_SPLIT_PROTO_TCP 6
+#define ESP_HOSTED_NW_SPLIT_PROTO_UDP 17
+
+typedef enum {
+	ESP_HOSTED_NW_SPLIT_TO_HOST = 0,
+	ESP_HOSTED_NW_SPLIT_TO_SLAVE = 1,
+	ESP_HOSTED_NW_SPLIT_TO_BOTH = 2,
+	ESP_HOSTED_NW_SPLIT_DROP = 3,
+} esp_hosted_nw_split_action_t;
+
+typedef struct {
+	uint8_t proto;                        /* ESP_HOSTED_NW_SPLIT_PROTO_TCP or _UDP */
+	bool match_src;                       /* match source port instead of destination port */
+	uint16_t port_start;
+	uint16_t port_end;                    /* inclusive */
+	esp_hosted_nw_split_action_t action;
+} esp_hosted_nw_split_port_rule_t;
+
+#if defined(CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED) && CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED
+
+/**
+ * @brief Host-side API to set the port forwarding rules
+ *        on the co-processor connected to the host.
+ *
+ * Rules are checked in order, the first matching one decides.
+ * replace also drops the static rules from the co-processor configuration.
+ *
+ * @param rules      Rules to add
+ * @param num_rules  Number of rules
+ * @param replace    Drop the rules in place first, else append
+ *
+ * @return ESP_OK on success, ESP_ERR_NO_MEM if the co-processor rule table
+ *         is full, otherwise an error code
+ */
+esp_err_t esp_hosted_cp_nw_split_set_port_rules(const esp_hosted_nw_split_port_rule_t *rules,
+		uint16_t num_rules, bool replace);
+
+#endif /* CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ESP_HOSTED_CP_NW_SPLIT_H__ */
@@ -7,6 +7,8 @@
 #ifndef ESP_HOSTED_POWER_SAVE_API_H
 #define ESP_HOSTED_POWER_SAVE_API_H
 
+#include <stdint.h>
+
 typedef enum {
     HOSTED_WAKEUP_UNDEFINED = 0,
     HOSTED_WAKEUP_NORMAL_REBOOT,
@@ -19,6 +21,31 @@ typedef enum {
     HOSTED_POWER_SAVE_TYPE_DEEP_SLEEP,
 } esp_hosted_power_save_type_t;
 
+#define HOSTED_WAKE_RULE_MAX_PATTERN_LEN 16
+
+/* Where the pattern offset of a wake up rule starts */
+typedef enum {
+    HOSTED_WAKE_LAYER_L2 = 0,       /* Ethernet header */
+    HOSTED_WAKE_LAYER_L3,           /* IPv4 header */
+    HOSTED_WAKE_LAYER_L4,           /* TCP/UDP/ICMP header */
+    HOSTED_WAKE_LAYER_PAYLOAD,      /* after the TCP/UDP header */
+} esp_hosted_wake_layer_t;
+
+/* Frames for the sleeping host matching the rule wake it up:
+ * (frame[layer + offset + i] & mask[i]) == value[i] for every i < len,
+ * with ip_proto and port checked first when non zero */
+typedef struct {
+    esp_hosted_wake_layer_t layer;
+    uint8_t ip_proto;               /* IP protocol number, 0 for any */
+    uint16_t port;                  /* TCP/UDP source or destination port, 0 for any */
+    uint16_t offset;
+    uint8_t len;                    /* pattern length, up to HOSTED_WAKE_RULE_MAX_PATTERN_LEN */
+    uint8_t mask[HOSTED_WAKE_RULE_MAX_PATTERN_LEN];
+    uint8_t value[HOSTED_WAKE_RULE_MAX_PATTERN_LEN];
+    uint16_t rate_limit;            /* max wake ups per interval, 0 for no limit */
+    uint32_t rate_interval_ms;
+} esp_hosted_wake_rule_t;
+
 /*
  * @brief Initializes the power save driver.
  *        This function is typically called automatically during esp_hosted_init().
@@ -78,5 +105,20 @@ int esp_hosted_power_save_timer_start(uint32_t time_ms);
  */
 int esp_hosted_power_save_timer_stop(void);
 
+/**
+ * @brief Sets the packet rules deciding which Wi-Fi frames wake up the host.
+ *
+ * While the host is power saving, the slave only wakes it up for frames
+ * matching one of the rules. The rules replace any rules set earlier.
+ * Without rules (num_rules 0), the slave default is restored: any frame
+ * for the host wakes it up.
+ *
+ * @param rules Rules, checked in order
+ * @param num_rules Number of rules, up to the slave
+ *                  CONFIG_ESP_HOSTED_HOST_WAKE_FILTER_MAX_RULES
+ * @return int Returns 0 on success or a nonzero value on failure.
+ */
+int esp_hosted_power_save_set_wake_rules(const esp_hosted_wake_rule_t *rules, uint8_t num_rules);
+
 
 #endif
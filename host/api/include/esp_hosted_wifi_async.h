@@ -0,0 +1,108 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Non-blocking variants of esp_wifi_remote APIs
+ *
+ * The calls below queue the request and return without waiting for the
+ * co-processor. Completion is reported through the callback, if given, or
+ * the returned handle can be polled.
+ *
+ * Every request completes exactly once. The callback runs in:
+ * - the RPC Rx task, for a response from the co-processor
+ * - the RPC Tx task, on response timeout or send failure
+ * - the calling task, if the request cannot be queued. The callback then
+ *   runs before the async call returns
+ * - the task calling esp_hosted_deinit(), for requests still in flight
+ *
+ * The callback must not block and must not call blocking esp_wifi_remote
+ * APIs: their response is delivered by the RPC tasks, so they would stall
+ * until their timeout. Submitting another async request is fine.
+ *
+ * A request without response within its RPC timeout (5 s) completes with
+ * ESP_ERR_TIMEOUT. A response arriving after that is dropped, even if a
+ * new request is in flight meanwhile: the request uid carries a
+ * generation that never matches a recycled request.
+ *
+ * Output arguments are written just before completion and must stay valid
+ * until the request completes or is cancelled.
+ *
+ * If a handle is requested, it must be released with
+ * esp_hosted_async_release() once no longer used, also after the callback.
+ * Without a handle, resources are freed right after the callback.
+ */
+
+#ifndef __ESP_HOSTED_WIFI_ASYNC_H__
+#define __ESP_HOSTED_WIFI_ASYNC_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_wifi_types.h"
+
+typedef struct esp_hosted_async_req * esp_hosted_async_handle_t;
+
+/* Completion callback. result is what the blocking API would have returned */
+typedef void (*esp_hosted_async_cb_t)(esp_hosted_async_handle_t handle,
+		esp_err_t result, void *arg);
+
+/**
+ * @brief Check for completion of an async request
+ *
+ * @param handle Handle returned by the async call
+ * @param result Result of the request. ESP_ERR_INVALID_STATE if cancelled
+ * @return ESP_OK if completed or cancelled, ESP_ERR_NOT_FINISHED if in flight
+ */
+esp_err_t esp_hosted_async_poll(esp_hosted_async_handle_t handle, esp_err_t *result);
+
+/**
+ * @brief Cancel an async request
+ *
+ * On success the callback is not called and output arguments are not
+ * written. The request may still be executed by the co-processor.
+ *
+ * @return ESP_OK if cancelled, ESP_ERR_INVALID_STATE if already completed
+ */
+esp_err_t esp_hosted_async_cancel(esp_hosted_async_handle_t handle);
+
+/**
+ * @brief Release a handle returned by an async call
+ *
+ * Releasing a request in flight does not cancel it.
+ */
+void esp_hosted_async_release(esp_hosted_async_handle_t handle);
+
+/* --------- Async Wi-Fi APIs ---------
+ * cb and handle are both optional.
+ * Returns ESP_OK once the request is submitted. Failures after that,
+ * including send failures and timeouts, are reported on completion */
+esp_err_t esp_wifi_remote_set_mode_async(wifi_mode_t mode,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle);
+esp_err_t esp_wifi_remote_get_mode_async(wifi_mode_t *mode,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle);
+esp_err_t esp_wifi_remote_set_config_async(wifi_interface_t interface, const wifi_config_t *conf,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle);
+esp_err_t esp_wifi_remote_get_config_async(wifi_interface_t interface, wifi_config_t *conf,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle);
+esp_err_t esp_wifi_remote_connect_async(
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle);
+esp_err_t esp_wifi_remote_disconnect_async(
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle);
+/* With block, completion is reported once the scan is done */
+esp_err_t esp_wifi_remote_scan_start_async(const wifi_scan_config_t *config, bool block,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle);
+esp_err_t esp_wifi_remote_sta_get_ap_info_async(wifi_ap_record_t *ap_info,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle);
+esp_err_t esp_wifi_remote_sta_get_rssi_async(int *rssi,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ESP_HOSTED_WIFI_ASYNC_H__ */
@@ -12,6 +12,7 @@ extern "C" {
 #include "esp_hosted_transport_config.h"
 #include "esp_hosted_api_priv.h"
 #include "esp_hosted_wifi_remote_glue.h"
+#include "esp_hosted_wifi_async.h"
 #include "port_esp_hosted_host_wifi_config.h"
 #include "port_esp_hosted_host_openthread.h"
 #include "port_esp_hosted_host_os.h"
@@ -453,6 +454,84 @@ esp_err_t esp_wifi_remote_sta_get_rssi(int *rssi)
 	return rpc_wifi_sta_get_rssi(rssi);
 }
 
+esp_err_t esp_hosted_async_poll(esp_hosted_async_handle_t handle, esp_err_t *result)
+{
+	return rpc_async_poll(handle, result);
+}
+
+esp_err_t esp_hosted_async_cancel(esp_hosted_async_handle_t handle)
+{
+	return rpc_async_cancel(handle);
+}
+
+void esp_hosted_async_release(esp_hosted_async_handle_t handle)
+{
+	rpc_async_release(handle);
+}
+
+esp_err_t esp_wifi_remote_set_mode_async(wifi_mode_t mode,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle)
+{
+	check_transport_up();
+	return rpc_async_wifi_set_mode(mode, cb, arg, handle);
+}
+
+esp_err_t esp_wifi_remote_get_mode_async(wifi_mode_t *mode,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle)
+{
+	check_transport_up();
+	return rpc_async_wifi_get_mode(mode, cb, arg, handle);
+}
+
+esp_err_t esp_wifi_remote_set_config_async(wifi_interface_t interface, const wifi_config_t *conf,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle)
+{
+	check_transport_up();
+	return rpc_async_wifi_set_config(interface, conf, cb, arg, handle);
+}
+
+esp_err_t esp_wifi_remote_get_config_async(wifi_interface_t interface, wifi_config_t *conf,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle)
+{
+	check_transport_up();
+	return rpc_async_wifi_get_config(interface, conf, cb, arg, handle);
+}
+
+esp_err_t esp_wifi_remote_connect_async(
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle)
+{
+	check_transport_up();
+	return rpc_async_wifi_connect(cb, arg, handle);
+}
+
+esp_err_t esp_wifi_remote_disconnect_async(
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle)
+{
+	check_transport_up();
+	return rpc_async_wifi_disconnect(cb, arg, handle);
+}
+
+esp_err_t esp_wifi_remote_scan_start_async(const wifi_scan_config_t *config, bool block,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle)
+{
+	check_transport_up();
+	return rpc_async_wifi_scan_start(config, block, cb, arg, handle);
+}
+
+esp_err_t esp_wifi_remote_sta_get_ap_info_async(wifi_ap_record_t *ap_info,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle)
+{
+	check_transport_up();
+	return rpc_async_wifi_sta_get_ap_info(ap_info, cb, arg, handle);
+}
+
+esp_err_t esp_wifi_remote_sta_get_rssi_async(int *rssi,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle)
+{
+	check_transport_up();
+	return rpc_async_wifi_sta_get_rssi(rssi, cb, arg, handle);
+}
+
 esp_err_t esp_wifi_remote_set_protocol(wifi_interface_t ifx, uint8_t protocol_bitmap)
 {
 	check_transport_up();
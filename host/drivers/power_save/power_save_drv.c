@@ -15,6 +15,7 @@
 #include "esp_hosted_power_save.h"
 #include "esp_hosted_transport_config.h"
 #include "esp_hosted_misc.h"
+#include "rpc_wrap.h"
 
 static const char TAG[] = "H_power_save";
 
@@ -385,3 +386,18 @@ int esp_hosted_power_save_timer_stop(void)
 #endif
 	return 0;
 }
+
+int esp_hosted_power_save_set_wake_rules(const esp_hosted_wake_rule_t *rules, uint8_t num_rules)
+{
+#if H_HOST_PS_ALLOWED
+	if (num_rules && !rules) {
+		ESP_LOGE(TAG, "Wake rules missing");
+		return -1;
+	}
+
+	return rpc_set_wake_rules(rules, num_rules);
+#else
+	ESP_LOGW(TAG, "Power save not enabled");
+	return -1;
+#endif
+}
@@ -16,6 +16,8 @@
 #include "port_esp_hosted_host_config.h"
 #include "port_esp_hosted_host_log.h"
 #include "esp_hosted_rpc.pb-c.h"
+#include "rpc_mem.h"
+#include "rpc_slot.h"
 
 static const char *TAG = "rpc_core";
 
@@ -29,36 +31,13 @@ struct rpc_lib_context {
 	int state;
 };
 
-typedef void (*rpc_rx_ind_t)(void);
-typedef void (*rpc_tx_ind_t)(void);
-
-static queue_handle_t rpc_rx_q = NULL;
 static queue_handle_t rpc_tx_q = NULL;
+static void * rpc_tx_sem;       /* counts rpc_tx_q items, waited on with ms timeout */
 
 static void * rpc_rx_thread_hdl;
 static void * rpc_tx_thread_hdl;
-static void * rpc_tx_sem;
 static struct rpc_lib_context rpc_lib_ctxt;
 
-/* uid to link between requests and responses */
-/* uids are incrementing values from 1 onwards.
- * 0 means not a valid id */
-static uint32_t uid = 0;
-
-/* structures used to keep track of response semaphores
- * and callbacks via their uid */
-typedef struct {
-	uint32_t uid;
-	void * sem;
-} sync_rsp_t;
-
-typedef struct {
-	uint32_t uid;
-	rpc_rsp_cb_t cb;
-	void * timer_hdl;
-	ctrl_cmd_t *app_req;  /* Store request so we can free it on response or timeout */
-} async_rsp_t;
-
 /* rpc response callbacks
  * These will be updated per rpc request received
  * 1. If application wants to use synchrounous, i.e. Wait till the response received
@@ -73,8 +52,29 @@ typedef struct {
 #define MAX_SYNC_RPC_TRANSACTIONS  H_MAX_SYNC_RPC_REQUESTS
 #define MAX_ASYNC_RPC_TRANSACTIONS H_MAX_ASYNC_RPC_REQUESTS
 
-static sync_rsp_t sync_rsp_table[MAX_SYNC_RPC_TRANSACTIONS] = { 0 };
-static async_rsp_t async_rsp_table[MAX_ASYNC_RPC_TRANSACTIONS] = { 0 };
+/* Requests in flight are tracked in the slot table of rpc_slot.c.
+ * Slot allocation and completion are lock free, so any number of tasks
+ * can have requests outstanding; rpc_tx_thread only packs and sends, it
+ * never waits for a response.
+ *
+ * With H_RPC_COALESCE, a sync read-only request may join an identical one
+ * in flight instead of being sent. Its slot then has join_uid set and is
+ * completed with a copy of the response of that request */
+
+/* Per slot request state, indexed like rpc_slots */
+typedef struct {
+	rpc_rsp_cb_t cb;        /* async only */
+	ctrl_cmd_t *app_req;    /* async only, freed on completion */
+	ctrl_cmd_t *app_resp;   /* sync only, handed over to the waiting task */
+} rpc_slot_ctx_t;
+
+static rpc_slot_ctx_t rpc_slot_ctx[RPC_MAX_SLOTS];
+
+/* Async response timeouts
+ * The wheel lives in rpc_slot.c and is driven by rpc_tx_thread, which
+ * wakes up for it only while async requests are in flight. Expired
+ * requests are completed with RPC_ERR_REQUEST_TIMEOUT outside the wheel
+ * lock, through the same uid claim as responses */
 
 /* rpc event callbacks
  * These will be updated when user registers event callback
@@ -89,15 +89,9 @@ static rpc_evt_cb_t rpc_evt_cb_table[RPC_ID__Event_Max - RPC_ID__Event_Base] = {
 
 
 static int call_event_callback(ctrl_cmd_t *app_event);
-static int is_async_resp_callback_available(ctrl_cmd_t *app_resp);
-static int is_sync_resp_sem_available(uint32_t uid);
-static int clear_async_resp_callback(async_rsp_t *async_rsp_item);
-static int call_async_resp_callback(ctrl_cmd_t *app_resp);
-static int set_async_resp_callback(ctrl_cmd_t *app_req, rpc_rsp_cb_t resp_cb, void *timer_hdl);
-static int set_sync_resp_sem(ctrl_cmd_t *app_req);
-static int wait_for_sync_response(ctrl_cmd_t *app_req);
+static void rpc_slot_complete(rpc_slot_t *slot, ctrl_cmd_t *app_resp);
 static void rpc_async_timeout_handler(void *arg);
-static int post_sync_resp_sem(ctrl_cmd_t *app_resp);
+static void rpc_tw_expire_due(void);
 
 
 /* Open serial interface
@@ -139,13 +133,6 @@ static inline int is_rpc_lib_inactive(void)
 	return 0;
 }
 
-/* RPC TX indication */
-static void rpc_tx_ind(void)
-{
-	ESP_LOGV(TAG, "posting rpc tx semaphore");
-	g_h.funcs->_h_post_semaphore(rpc_tx_sem);
-}
-
 /* Returns CALLBACK_AVAILABLE if a non NULL RPC event
  * callback is available. It will return failure -
  *     MSG_ID_OUT_OF_ORDER - if request msg id is unsupported
@@ -175,8 +162,9 @@ static int process_rpc_tx_msg(ctrl_cmd_t *app_req)
 	Rpc   req = {0};
 	uint32_t  tx_len = 0;
 	uint8_t  *tx_data = NULL;
-	int       ret = SUCCESS;
 	int32_t   failure_status = 0;
+	rpc_slot_t *slot = NULL;
+	ctrl_cmd_t *app_resp = NULL;
 
 	req.msg_type = RPC_TYPE__Req;
 
@@ -203,34 +191,38 @@ static int process_rpc_tx_msg(ctrl_cmd_t *app_req)
 	}
 
 	/* 4. Allocate protobuf msg */
-	HOSTED_CALLOC(uint8_t, tx_data, tx_len, fail_req0);
+	tx_data = (uint8_t *)rpc_mem_tx_calloc(tx_len);
+	if (!tx_data) {
+		ESP_LOGE(TAG, "%s, Failed to allocate memory", __func__);
+		goto fail_req0;
+	}
 
-	/* 5. Assign response callback, if valid */
-	if (app_req->rpc_rsp_cb) {
+	/* 5. Pack in protobuf */
+	rpc__pack(&req, tx_data);
 
-		/* 5.1 Start timeout for response for async only
-		* For sync procedures, g_h.funcs->_h_get_semaphore takes care to
-		* handle timeout situations */
-		ESP_LOGI(TAG, "starting async resp timer for req[%u]",req.msg_id);
-		void *timer_hdl = g_h.funcs->_h_timer_start("rpc_async_timeout_timer", SEC_TO_MILLISEC(app_req->rsp_timeout_sec), H_TIMER_TYPE_ONESHOT,
-				rpc_async_timeout_handler, app_req);
-		if (!timer_hdl) {
-			ESP_LOGE(TAG, "Failed to start async resp timer");
-			goto fail_req;
-		}
+	/* 6. Free hook for application
+	 * Request contents are packed already. Done before sending, as an
+	 * async app_req is owned by its slot from here on and may be freed
+	 * as soon as the response arrives */
+	H_FREE_PTR_WITH_FUNC(app_req->app_free_buff_func, app_req->app_free_buff_hdl);
+	RPC_FREE_BUFFS();
 
-		/* 5.2 set async resp callback */
-		ESP_LOGD(TAG, "setting async resp callback for req[%u]",req.msg_id);
-		ret = set_async_resp_callback(app_req, app_req->rpc_rsp_cb, timer_hdl);
-		if (ret < 0) {
-			ESP_LOGE(TAG, "could not set callback for req[%u]",req.msg_id);
-			failure_status = RPC_ERR_SET_ASYNC_CB;
-			goto fail_req;
-		}
+	/* 7. Arm timeout for response for async only
+	 * For sync procedures, g_h.funcs->_h_get_semaphore takes care to
+	 * handle timeout situations.
+	 * Async callback is already registered in the slot by rpc_send_req().
+	 * The wheel expires the uid, not app_req, so a late expiry cannot
+	 * touch a completed request */
+	if (app_req->rpc_rsp_cb) {
+		ESP_LOGD(TAG, "arming async resp timeout for req[%u]",req.msg_id);
+		rpc_tw_add(rpc_slot_of(app_req->uid), app_req->uid,
+				SEC_TO_MILLISEC(app_req->rsp_timeout_sec),
+				(uint32_t)g_h.funcs->_h_get_time_ms());
 	}
 
-	/* 7. Pack in protobuf and send the request */
-	rpc__pack(&req, tx_data);
+	/* 8. Send the request
+	 * Do not wait for the response here, so requests of other tasks
+	 * can be sent while this one is in flight */
 	ESP_LOGD(TAG, "sending rpc req[%u]",req.msg_id);
 	if (transport_pserial_send(tx_data, tx_len)) {
 		ESP_LOGE(TAG, "Send RPC req[0x%x] failed",req.msg_id);
@@ -239,108 +231,57 @@ static int process_rpc_tx_msg(ctrl_cmd_t *app_req)
 	}
 
 	ESP_LOGD(TAG, "Sent RPC_Req[0x%x]",req.msg_id);
-
-
-	/* 8. Free hook for application */
-	H_FREE_PTR_WITH_FUNC(app_req->app_free_buff_func, app_req->app_free_buff_hdl);
+	/* the serial layer built the TLV in a heap buffer of its own */
+	rpc_mem_count_serial_alloc();
 
 	/* 9. Cleanup */
-	HOSTED_FREE(tx_data);
-	RPC_FREE_BUFFS();
+	rpc_mem_tx_free(tx_data);
+	tx_data = NULL;
 	return SUCCESS;
 fail_req0:
 	failure_status = RPC_ERR_MEMORY_FAILURE;
 fail_req:
+	/* 10. Cleanup */
+	H_FREE_PTR_WITH_FUNC(app_req->app_free_buff_func, app_req->app_free_buff_hdl);
+	rpc_mem_tx_free(tx_data);
+	tx_data = NULL;
+	RPC_FREE_BUFFS();
 
+	/* 11. Let requester know of the failure using a failed response.
+	 * Prevents timeout waiting for a response that will never come
+	 * as request was never sent.
+	 * If timeout or deinit already completed the request, nothing to do.
+	 * app_req lifecycle on failure:
+	 * - Async requests: freed on completion of the slot
+	 * - Sync requests: NEVER freed here! The calling application is waiting
+	 *   and will free it in rpc_wait_and_parse_sync_resp() */
+	slot = rpc_slot_claim(app_req->uid);
+	if (!slot) {
+		ESP_LOGW(TAG, "RPC req[0x%x] failed, already completed", app_req->msg_id);
+		return FAILURE;
+	}
 
-	ESP_LOGW(TAG, "fail1");
-	if (app_req->rpc_rsp_cb) {
-		/* 11. In case of async procedure,
-		 * Let application know of failure using callback itself
-		 **/
-		ctrl_cmd_t *app_resp = NULL;
-
-		HOSTED_CALLOC(ctrl_cmd_t, app_resp, sizeof(ctrl_cmd_t), fail_req2);
-
+	ESP_LOGW(TAG, "RPC req[0x%x] failed", app_req->msg_id);
+	app_resp = rpc_mem_cmd_alloc();
+	if (app_resp) {
 		app_resp->msg_type = RPC_TYPE__Resp;
 		app_resp->msg_id = (app_req->msg_id - RPC_ID__Req_Base + RPC_ID__Resp_Base);
+		app_resp->uid = app_req->uid;
 		app_resp->resp_event_status = failure_status;
-
-		/* 12. In async procedure, it is important to get
-		 * some kind of acknowledgement to user when
-		 * request is already sent and success return to the caller
-		 */
-		app_req->rpc_rsp_cb(app_resp);
 	} else {
-		/* for sync procedure, put failed response into receive queue
-		 * so application is aware of transmit failure.
-		 * Prevents timeout waiting for a response that will never come
-		 * as request was never sent
-		 */
-		ESP_LOGW(TAG, "RPC Sync proc failed");
-
-		ctrl_cmd_t *app_resp = NULL;
-
-		HOSTED_CALLOC(ctrl_cmd_t, app_resp, sizeof(ctrl_cmd_t), fail_req2);
-
-		app_resp->msg_type = RPC_TYPE__Resp;
-		app_resp->msg_id = (app_req->msg_id - RPC_ID__Req_Base + RPC_ID__Resp_Base);
-		app_resp->resp_event_status = failure_status;
-
-		// same as process_rpc_rx_msg() for failed condition
-		esp_queue_elem_t elem = {0};
-		elem.buf = app_resp;
-		elem.buf_len = sizeof(ctrl_cmd_t);
-
-		if (g_h.funcs->_h_queue_item(rpc_rx_q, &elem, HOSTED_BLOCK_MAX)) {
-			ESP_LOGE(TAG, "RPC Q put fail");
-		} else if (CALLBACK_AVAILABLE == is_sync_resp_sem_available(app_resp->uid)) {
-			ESP_LOGV(TAG, "trigger semaphore to react to failed message uid %ld", app_resp->uid);
-			post_sync_resp_sem(app_resp);
-		} else {
-			ESP_LOGE(TAG, "no sync resp callback to react to failed message uid %ld", app_resp->uid);
-		}
+		ESP_LOGE(TAG, "%s, Failed to allocate memory", __func__);
 	}
 
-fail_req2:
-	ESP_LOGW(TAG, "fail2");
-	/* 13. Cleanup */
-	H_FREE_PTR_WITH_FUNC(app_req->app_free_buff_func, app_req->app_free_buff_hdl);
-
-	HOSTED_FREE(tx_data);
-	RPC_FREE_BUFFS();
-
-	/* app_req lifecycle on failure:
-	 * - Async requests: Check if registered in callback table
-	 *   - If registered: Will be freed on timeout or cleanup
-	 *   - If not registered (early failure): Free here
-	 * - Sync requests: NEVER free here! The calling application is waiting
-	 *   and will free it in rpc_wait_and_parse_sync_resp() after getting
-	 *   the error response we just queued. */
-	if (app_req->rpc_rsp_cb) {
-		/* Async request - check if it was registered */
-		int found = 0;
-		for (int i = 0; i < MAX_ASYNC_RPC_TRANSACTIONS; i++) {
-			if (async_rsp_table[i].uid == app_req->uid) {
-				found = 1;
-				break;
-			}
-		}
-		if (!found) {
-			/* Not registered, free it here */
-			HOSTED_FREE(app_req);
-		}
-		/* If found, it will be freed by timeout or cleanup */
-	}
-	/* Sync requests: Don't free - caller owns it */
+	/* app_req must not be accessed after this */
+	rpc_slot_complete(slot, app_resp);
 
 	return FAILURE;
 }
 
 /* Process RPC msg (response or event) received from ESP32 */
-static int process_rpc_rx_msg(Rpc * proto_msg, rpc_rx_ind_t rpc_rx_func)
+static int process_rpc_rx_msg(Rpc * proto_msg)
 {
-	esp_queue_elem_t elem = {0};
+	rpc_slot_t *slot = NULL;
 	ctrl_cmd_t *app_resp = NULL;
 	ctrl_cmd_t *app_event = NULL;
 
@@ -366,7 +307,11 @@ static int process_rpc_rx_msg(Rpc * proto_msg, rpc_rx_ind_t rpc_rx_func)
 
 			/* Allocate app struct for event */
 
-			HOSTED_CALLOC(ctrl_cmd_t, app_event, sizeof(ctrl_cmd_t), free_buffers);
+			app_event = rpc_mem_cmd_alloc();
+			if (!app_event) {
+				ESP_LOGE(TAG, "%s, Failed to allocate memory", __func__);
+				goto free_buffers;
+			}
 
 			/* Decode protobuf buffer of event and
 			 * copy into app structures */
@@ -387,7 +332,11 @@ static int process_rpc_rx_msg(Rpc * proto_msg, rpc_rx_ind_t rpc_rx_func)
 		 * asynchronpusly */
 
 		/* Allocate app struct for response */
-		HOSTED_CALLOC(ctrl_cmd_t, app_resp, sizeof(ctrl_cmd_t), free_buffers);
+		app_resp = rpc_mem_cmd_alloc();
+		if (!app_resp) {
+			ESP_LOGE(TAG, "%s, Failed to allocate memory", __func__);
+			goto free_buffers;
+		}
 
 		/* Decode protobuf buffer of response and
 		 * copy into app structures */
@@ -396,58 +345,43 @@ static int process_rpc_rx_msg(Rpc * proto_msg, rpc_rx_ind_t rpc_rx_func)
 			goto free_buffers;
 		}
 
-		/* Is callback is available,
-		 * progress as async response */
-		if (CALLBACK_AVAILABLE ==
-			is_async_resp_callback_available(app_resp)) {
-
-			/* User registered RPC async response callback
-			 * function is available for this proto_msg,
-			 * so call to that function should be done and
-			 * return to select
-			 */
-			call_async_resp_callback(app_resp);
-		} else {
-
-			/* as RPC async response callback function is
-			 * NOT available/registered, treat this response as
-			 * synchronous response. forward this response to app
-			 * using 'esp_queue' and help of semaphore
-			 **/
-
-
-			/* User is RESPONSIBLE to free memory from
-			 * app_resp in case of async callbacks NOT provided
-			 * to free memory, please refer CLEANUP_APP_MSG macro
-			 **/
-			elem.buf = app_resp;
-			elem.buf_len = sizeof(ctrl_cmd_t);
-
-			if (g_h.funcs->_h_queue_item(rpc_rx_q, &elem, HOSTED_BLOCK_MAX)) {
-				ESP_LOGE(TAG, "RPC Q put fail");
-				goto free_buffers;
-			}
+		// msg_id of RPC_ID__Resp_Base now means Invalid RPC Request
+		if ((app_resp->msg_id < RPC_ID__Resp_Base) ||
+		    (app_resp->msg_id >= RPC_ID__Resp_Max)) {
+			ESP_LOGE(TAG, "resp id[0x%x] out of range", app_resp->msg_id);
+			goto free_buffers;
+		}
 
-			/* Call up rx ind to unblock caller */
-			if (CALLBACK_AVAILABLE == is_sync_resp_sem_available(app_resp->uid))
-				post_sync_resp_sem(app_resp);
+		/* uid leads directly to the request slot.
+		 * Responses arriving after timeout or for unknown uid are dropped */
+		slot = rpc_slot_claim(app_resp->uid);
+		if (!slot) {
+			ESP_LOGW(TAG, "No pending req for resp [0x%x] uid %" PRIu32 ", drop",
+					app_resp->msg_id, app_resp->uid);
+			goto free_buffers;
 		}
 
+		/* Async: registered callback is called from here.
+		 * Sync: response is handed over to the waiting caller.
+		 * User is RESPONSIBLE to free memory from app_resp,
+		 * please refer CLEANUP_APP_MSG macro */
+		rpc_slot_complete(slot, app_resp);
+
 	} else {
 		/* 4. some unsupported msg, drop it */
 		ESP_LOGE(TAG, "Incorrect RPC Msg Type[%u]",proto_msg->msg_type);
 		goto free_buffers;
 	}
-	rpc__free_unpacked(proto_msg, NULL);
+	rpc__free_unpacked(proto_msg, &rpc_mem_rx_allocator);
 	proto_msg = NULL;
 	return SUCCESS;
 
 	/* 5. cleanup */
 free_buffers:
-	rpc__free_unpacked(proto_msg, NULL);
+	rpc__free_unpacked(proto_msg, &rpc_mem_rx_allocator);
 	proto_msg = NULL;
-	HOSTED_FREE(app_event);
-	HOSTED_FREE(app_resp);
+	rpc_mem_cmd_free(app_event);
+	rpc_mem_cmd_free(app_resp);
 	return RPC_ERR_PROTOBUF_DECODE;
 }
 
@@ -457,25 +391,16 @@ static void rpc_rx_thread(void const *arg)
 {
 	uint32_t buf_len = 0;
 
-	rpc_rx_ind_t rpc_rx_func;
-	rpc_rx_func = (rpc_rx_ind_t) arg;
-
 	/* If serial interface is not available, exit */
 	if (!serial_drv_open(SERIAL_IF_FILE)) {
 		ESP_LOGE(TAG, "Exiting thread, handle invalid");
 		return;
 	}
 
-	/* This queue should already be created
-	 * if NULL, exit here */
-	if (!rpc_rx_q) {
-		ESP_LOGE(TAG, "Ctrl msg rx Q is not created");
-		return;
-	}
-
 	/* Infinite loop to process incoming msg on serial interface */
 	while (1) {
 		uint8_t *buf = NULL;
+		uint8_t *payload = NULL;
 		Rpc *resp = NULL;
 
 		/* Block on read of protobuf encoded msg */
@@ -483,15 +408,17 @@ static void rpc_rx_thread(void const *arg)
 			g_h.funcs->_h_sleep(1);
 			continue;
 		}
-		buf = transport_pserial_read(&buf_len);
+		buf = transport_pserial_read(&payload, &buf_len);
+		if (buf)
+			rpc_mem_count_serial_alloc();
 
-		if (!buf_len || !buf) {
+		if (!buf_len || !buf || !payload) {
 			ESP_LOGE(TAG, "buf_len read = 0");
 			goto free_bufs;
 		}
 
 		/* Decode protobuf */
-		resp = rpc__unpack(NULL, buf_len, buf);
+		resp = rpc__unpack(&rpc_mem_rx_allocator, buf_len, payload);
 		if (!resp) {
 			goto free_bufs;
 		}
@@ -500,7 +427,7 @@ static void rpc_rx_thread(void const *arg)
 
 		/* Send for further processing as event or response */
 		ESP_LOGV(TAG, "Before process_rpc_rx_msg");
-		process_rpc_rx_msg(resp, rpc_rx_func);
+		process_rpc_rx_msg(resp);
 		ESP_LOGV(TAG, "after process_rpc_rx_msg");
 		continue;
 
@@ -508,18 +435,21 @@ static void rpc_rx_thread(void const *arg)
 free_bufs:
 		HOSTED_FREE(buf);
 		if (resp) {
-			rpc__free_unpacked(resp, NULL);
+			rpc__free_unpacked(resp, &rpc_mem_rx_allocator);
 			resp = NULL;
 		}
 	}
 }
 
 /* Async and sync request sends the rpc msg through this thread.
- * Async thread will register callback, which will be invoked in rpc_rx_thread, once received the response.
- * Sync thread will block for response (in its own context) after submission of ctrl_msg to rpc_tx_q */
+ * Async request registers callback, which will be invoked in rpc_rx_thread, once received the response.
+ * Sync thread will block for response (in its own context) after submission of ctrl_msg to rpc_tx_q.
+ * This thread never waits for responses, so several requests may be in flight.
+ * It also completes timed out async requests, so their callbacks run here */
 static void rpc_tx_thread(void const *arg)
 {
 	ctrl_cmd_t *app_req = NULL;
+	int wait_ms = 0;
 
 	ESP_LOGD(TAG, "Starting tx thread");
 	/* If serial interface is not available, exit */
@@ -546,12 +476,17 @@ static void rpc_tx_thread(void const *arg)
 			continue;
 		}
 
-		ESP_LOGV(TAG, "Waiting for RPC TX semaphore");
-		g_h.funcs->_h_get_semaphore(rpc_tx_sem, HOSTED_BLOCKING);
-		ESP_LOGV(TAG, "RPC TX semaphore acquired");
+		/* Block until a request is queued, or the next wheel tick is
+		 * due while async requests are in flight */
+		wait_ms = rpc_tw_wait_ms((uint32_t)g_h.funcs->_h_get_time_ms());
+		if (g_h.funcs->_h_get_semaphore(rpc_tx_sem, wait_ms)) {
+			rpc_tw_expire_due();
+			continue;
+		}
+		rpc_tw_expire_due();
 
 		ESP_LOGV(TAG, "Dequeueing RPC TX Q");
-		if (g_h.funcs->_h_dequeue_item(rpc_tx_q, &app_req, HOSTED_BLOCK_MAX)) {
+		if (g_h.funcs->_h_dequeue_item(rpc_tx_q, &app_req, 0)) {
 			ESP_LOGE(TAG, "RPC TX Q Failed to dequeue");
 			continue;
 		}
@@ -560,9 +495,8 @@ static void rpc_tx_thread(void const *arg)
 			ESP_LOGV(TAG, "Processing RPC TX msg");
 			process_rpc_tx_msg(app_req);
 			/* app_req lifecycle:
-			 * - Async requests: Stored in async_rsp_table, freed when response arrives or timeout
+			 * - Async requests: Owned by request slot, freed when response arrives, on timeout or failure
 			 * - Sync requests: Freed by caller in rpc_wait_and_parse_sync_resp() after response
-			 * - Failed requests: Freed in process_rpc_tx_msg() failure path
 			 * So we don't free anything here. */
 		} else {
 			ESP_LOGE(TAG, "RPC Tx Q empty or uninitialised");
@@ -615,124 +549,193 @@ static const char *rpc_id_name(int id)
 }
 
 
-/* This function will be only invoked in synchrounous rpc response path,
- * i.e. if rpc response callbcak is not available i.e. NULL
- * This function is called after sending synchrounous rpc request to wait
- * for the response using semaphores and esp_queue
- **/
-static ctrl_cmd_t * get_response(int *read_len, ctrl_cmd_t *app_req)
-{
-	uint8_t * buf = NULL;
-	esp_queue_elem_t elem = {0};
-	int ret = 0;
+#if H_RPC_COALESCE
+/* Read-only requests without arguments.
+ * A sync request of these kinds, sent while an identical sync request is
+ * waiting for its response, joins it instead of being sent again, and
+ * gets a copy of that response */
+static const uint8_t rpc_req_idempotent[RPC_ID__Req_Max - RPC_ID__Req_Base] = {
+	[RPC_ID__Req_GetWifiMode - RPC_ID__Req_Base]                  = 1,
+	[RPC_ID__Req_WifiGetPs - RPC_ID__Req_Base]                    = 1,
+	[RPC_ID__Req_WifiGetMaxTxPower - RPC_ID__Req_Base]            = 1,
+	[RPC_ID__Req_WifiGetCountry - RPC_ID__Req_Base]               = 1,
+	[RPC_ID__Req_WifiGetCountryCode - RPC_ID__Req_Base]           = 1,
+	[RPC_ID__Req_WifiGetChannel - RPC_ID__Req_Base]               = 1,
+	[RPC_ID__Req_WifiGetBand - RPC_ID__Req_Base]                  = 1,
+	[RPC_ID__Req_WifiGetBandMode - RPC_ID__Req_Base]              = 1,
+	[RPC_ID__Req_WifiStaGetRssi - RPC_ID__Req_Base]               = 1,
+	[RPC_ID__Req_WifiStaGetApInfo - RPC_ID__Req_Base]             = 1,
+	[RPC_ID__Req_WifiStaGetNegotiatedPhymode - RPC_ID__Req_Base]  = 1,
+	[RPC_ID__Req_WifiStaGetAid - RPC_ID__Req_Base]                = 1,
+	[RPC_ID__Req_WifiScanGetApNum - RPC_ID__Req_Base]             = 1,
+	[RPC_ID__Req_GetCoprocessorFwVersion - RPC_ID__Req_Base]      = 1,
+};
 
-	/* Any problems in response, return NULL */
-	if (!read_len || !app_req) {
-		ESP_LOGE(TAG, "Invalid input parameter");
-		return NULL;
-	}
+static inline int rpc_req_is_idempotent(uint16_t msg_id)
+{
+	return (msg_id > RPC_ID__Req_Base) && (msg_id < RPC_ID__Req_Max) &&
+		rpc_req_idempotent[msg_id - RPC_ID__Req_Base];
+}
 
+/* Copy of a response for a joined request. NULL on failure */
+static ctrl_cmd_t *rpc_rsp_dup(const ctrl_cmd_t *app_resp, uint32_t uid)
+{
+	ctrl_cmd_t *dup = NULL;
+	wifi_scan_ap_list_t *p_a = NULL;
 
-	/* Wait for response */
-	ret = wait_for_sync_response(app_req);
-	if (ret) {
-		if ((ret == RET_FAIL_TIMEOUT) || (errno == ETIMEDOUT))
-			ESP_LOGW(TAG, "Timeout waiting for Resp for [0x%x](%s)", app_req->msg_id, rpc_id_name(app_req->msg_id));
-		else
-			ESP_LOGE(TAG, "ERR [%u] ret[%d] for [0x%x](%s)", errno, ret, app_req->msg_id, rpc_id_name(app_req->msg_id));
+	if (!app_resp)
 		return NULL;
-	}
 
-	/* Fetch response from `esp_queue` */
-	if (g_h.funcs->_h_dequeue_item(rpc_rx_q, &elem, HOSTED_BLOCK_MAX)) {
-		ESP_LOGE(TAG, "rpc Rx Q Failed to dequeue");
+	dup = rpc_mem_cmd_alloc();
+	if (!dup)
 		return NULL;
-	}
-
-	if (elem.buf_len) {
-
-		*read_len = elem.buf_len;
-		buf = elem.buf;
-		return (ctrl_cmd_t*)buf;
 
-	} else {
-		ESP_LOGE(TAG, "rpc Q empty or uninitialised");
-		return NULL;
+	g_h.funcs->_h_memcpy(dup, app_resp, sizeof(ctrl_cmd_t));
+	dup->uid = uid;
+	dup->rx_sem = NULL;
+	dup->app_free_buff_func = NULL;
+	dup->app_free_buff_hdl = NULL;
+
+	/* only response of the table owning memory */
+	p_a = &dup->u.wifi_scan_ap_list;
+	if ((app_resp->msg_id == RPC_ID__Resp_WifiStaGetApInfo) && p_a->out_list) {
+		p_a->out_list = g_h.funcs->_h_malloc(p_a->number * sizeof(wifi_ap_record_t));
+		if (!p_a->out_list) {
+			rpc_mem_cmd_free(dup);
+			return NULL;
+		}
+		g_h.funcs->_h_memcpy(p_a->out_list, app_resp->u.wifi_scan_ap_list.out_list,
+				p_a->number * sizeof(wifi_ap_record_t));
+		dup->app_free_buff_func = g_h.funcs->_h_free;
+		dup->app_free_buff_hdl = p_a->out_list;
 	}
 
-	return NULL;
+	return dup;
 }
 
-static int clear_async_resp_callback(async_rsp_t *async_rsp_item)
+/* Complete the sync requests joined to leader, which is claimed already.
+ * app_resp stays with the leader, joined requests get a copy */
+static void rpc_slot_serve_joined(rpc_slot_t *leader, ctrl_cmd_t *app_resp)
 {
-	if (async_rsp_item->uid != 0) {
+	uint32_t leader_uid = rpc_slot_uid(leader);
+	uint32_t req_uid = 0;
+	rpc_slot_t *slot = NULL;
+	int i;
 
-		if (async_rsp_item->timer_hdl) {
-			g_h.funcs->_h_timer_stop(async_rsp_item->timer_hdl);
-			async_rsp_item->timer_hdl = NULL;
-		}
+	if (leader->join_uid)
+		return;
 
-		/* Free the request structure that was allocated by RPC_DEFAULT_REQ */
-		HOSTED_FREE(async_rsp_item->app_req);
+	for (i = 0; i < MAX_SYNC_RPC_TRANSACTIONS; i++) {
+		if (__atomic_load_n(&rpc_slots[i].join_uid, __ATOMIC_SEQ_CST) != leader_uid)
+			continue;
 
-		async_rsp_item->uid = 0;
-		async_rsp_item->cb = NULL;
-		return SUCCESS;
-	} else {
-		ESP_LOGW(TAG, "async_rsp_item to be cleared already has uid 0");
+		req_uid = __atomic_load_n(&rpc_slots[i].uid, __ATOMIC_SEQ_CST);
+		slot = rpc_slot_claim(req_uid);
+		if (!slot)
+			continue;
+
+		ESP_LOGD(TAG, "resp [0x%x] shared with uid %" PRIu32,
+				app_resp ? app_resp->msg_id : 0, req_uid);
+		rpc_slot_ctx[rpc_slot_idx(slot)].app_resp = rpc_rsp_dup(app_resp, req_uid);
+		g_h.funcs->_h_post_semaphore(slot->sem);
 	}
-	return FAILURE;
 }
 
-/* Check and call rpc response asynchronous callback if available
- * else flag error
- *     MSG_ID_OUT_OF_ORDER - if response id is not understandable
- *     CALLBACK_NOT_REGISTERED - callback is not registered
- **/
-static int call_async_resp_callback(ctrl_cmd_t *app_resp)
+/* Try to join an identical sync request in flight, instead of sending.
+ * Returns 1 if joined: completion comes with the other request.
+ * Returns 0 if app_req has to be sent; slot uid is then not published */
+static int rpc_req_join(ctrl_cmd_t *app_req, rpc_slot_t *slot)
 {
+	uint32_t leader_uid = 0;
+	rpc_slot_t *leader = NULL;
 	int i;
 
-	// msg_id of RPC_ID__Resp_Base now means Invalid RPC Request
-	if ((app_resp->msg_id < RPC_ID__Resp_Base) ||
-	    (app_resp->msg_id >= RPC_ID__Resp_Max)) {
-		return MSG_ID_OUT_OF_ORDER;
-	}
+	if (app_req->rpc_rsp_cb || !rpc_req_is_idempotent(app_req->msg_id))
+		return 0;
 
-	for (i = 0; i < MAX_ASYNC_RPC_TRANSACTIONS; i++) {
-		if (async_rsp_table[i].uid == app_resp->uid) {
-			int ret = async_rsp_table[i].cb(app_resp);
+	for (i = 0; i < MAX_SYNC_RPC_TRANSACTIONS; i++) {
+		leader = &rpc_slots[i];
+		if (leader == slot)
+			continue;
 
-			clear_async_resp_callback(&async_rsp_table[i]);
+		leader_uid = __atomic_load_n(&leader->uid, __ATOMIC_SEQ_CST);
+		if (!leader_uid || leader->join_uid || (leader->msg_id != app_req->msg_id))
+			continue;
 
-			return ret;
+		/* Publish as joined, then make sure the leader is still pending.
+		 * Leader completion claims its uid before scanning for joined
+		 * requests, so either it sees this one or the check below fails */
+		__atomic_store_n(&slot->join_uid, leader_uid, __ATOMIC_SEQ_CST);
+		__atomic_store_n(&slot->uid, app_req->uid, __ATOMIC_SEQ_CST);
+
+		if (__atomic_load_n(&leader->uid, __ATOMIC_SEQ_CST) == leader_uid) {
+			ESP_LOGD(TAG, "req [0x%x] uid %" PRIu32 " joined uid %" PRIu32,
+					app_req->msg_id, app_req->uid, leader_uid);
+			H_FREE_PTR_WITH_FUNC(app_req->app_free_buff_func, app_req->app_free_buff_hdl);
+			return 1;
 		}
+
+		/* Leader completed meanwhile. If it did not serve us, send */
+		if (!rpc_slot_claim(app_req->uid))
+			return 1;
+
+		__atomic_store_n(&slot->join_uid, 0, __ATOMIC_RELAXED);
+		return 0;
 	}
 
-	return CALLBACK_NOT_REGISTERED;
+	return 0;
+}
+#else
+static inline void rpc_slot_serve_joined(rpc_slot_t *leader, ctrl_cmd_t *app_resp) { }
+static inline int rpc_req_join(ctrl_cmd_t *app_req, rpc_slot_t *slot) { return 0; }
+#endif
+
+/* Fail an async request without a response from ESP32.
+ * app_req is turned into a failed response in place and handed to the
+ * callback, which frees it. This way the callback of an async request
+ * always runs exactly once */
+static void rpc_async_req_fail(rpc_rsp_cb_t func, ctrl_cmd_t *app_req, int status)
+{
+	app_req->msg_type = RPC_TYPE__Resp;
+	app_req->msg_id = (app_req->msg_id - RPC_ID__Req_Base + RPC_ID__Resp_Base);
+	app_req->resp_event_status = status;
+	func(app_req);
 }
 
-
-static int post_sync_resp_sem(ctrl_cmd_t *app_resp)
+/* Complete a claimed request.
+ * Async: disarm timeout, free request and slot, then call the response callback
+ * Sync: hand over response (NULL on failure) and wake up the waiting caller,
+ * which frees the slot */
+static void rpc_slot_complete(rpc_slot_t *slot, ctrl_cmd_t *app_resp)
 {
-	int i;
+	rpc_slot_ctx_t *ctx = &rpc_slot_ctx[rpc_slot_idx(slot)];
 
-	// msg_id of RPC_ID__Resp_Base now means Invalid RPC Request
-	if ((app_resp->msg_id < RPC_ID__Resp_Base) ||
-	    (app_resp->msg_id >= RPC_ID__Resp_Max)) {
-		return MSG_ID_OUT_OF_ORDER;
-	}
+	if (ctx->cb) {
+		rpc_rsp_cb_t func = ctx->cb;
+		ctrl_cmd_t *app_req = ctx->app_req;
 
-	for (i = 0; i < MAX_SYNC_RPC_TRANSACTIONS; i++) {
-		if (sync_rsp_table[i].uid == app_resp->uid) {
-			return g_h.funcs->_h_post_semaphore(sync_rsp_table[i].sem);
+		/* wheel tick may expire it concurrently, but it cannot claim
+		 * the slot any more */
+		rpc_tw_del(slot);
+
+		ctx->app_req = NULL;
+		rpc_slot_free(slot);
+
+		if (app_resp) {
+			app_resp->rpc_rsp_cb_arg = app_req->rpc_rsp_cb_arg;
+			/* Free the request structure that was allocated by RPC_DEFAULT_REQ */
+			rpc_mem_cmd_free(app_req);
+			func(app_resp);
+		} else {
+			rpc_async_req_fail(func, app_req, FAILURE);
 		}
+	} else {
+		rpc_slot_serve_joined(slot, app_resp);
+		ctx->app_resp = app_resp;
+		g_h.funcs->_h_post_semaphore(slot->sem);
 	}
-
-	return CALLBACK_NOT_REGISTERED;
 }
 
-
 /* Check and call rpc event asynchronous callback if available
  * else flag error
  *     MSG_ID_OUT_OF_ORDER - if event id is not understandable
@@ -752,77 +755,25 @@ static int call_event_callback(ctrl_cmd_t *app_event)
 	return CALLBACK_NOT_REGISTERED;
 }
 
-/* Set asynchronous rpc response callback from rpc **request**
- */
-static int set_async_resp_callback(ctrl_cmd_t *app_req, rpc_rsp_cb_t resp_cb, void *timer_hdl)
-{
-	int i;
-
-	int exp_resp_msg_id = (app_req->msg_id - RPC_ID__Req_Base + RPC_ID__Resp_Base);
-	if (exp_resp_msg_id >= RPC_ID__Resp_Max) {
-		ESP_LOGW(TAG, "Not able to map new request to resp id");
-		return MSG_ID_OUT_OF_ORDER;
-	}
-
-	for (i = 0; i < MAX_ASYNC_RPC_TRANSACTIONS; i++) {
-		if (!async_rsp_table[i].uid) {
-			async_rsp_table[i].uid = app_req->uid;
-			async_rsp_table[i].cb = resp_cb;
-			async_rsp_table[i].timer_hdl = timer_hdl;
-			async_rsp_table[i].app_req = app_req;  /* Store request for later cleanup */
-			return CALLBACK_SET_SUCCESS;
-		}
-	}
-
-	ESP_LOGE(TAG, "Async cb not registered: out of buffer space");
-	return CALLBACK_NOT_REGISTERED;
-}
-
-/* Set synchronous rpc response semaphore
- * In case of asynchronous request, `rx_sem` will be NULL or disregarded
- * `rpc_rsp_cb_sem_table` will be updated with NULL for async
- * In case of synchronous request, valid callback will be cached
- * This sem will posted after receiving the mapping response
+/* This function will be only invoked in synchrounous rpc response path,
+ * i.e. if rpc response callbcak is not available i.e. NULL
+ * This function is called after sending synchrounous rpc request to wait
+ * for the response handed over in its slot
  **/
-static int set_sync_resp_sem(ctrl_cmd_t *app_req)
+static ctrl_cmd_t * get_response(ctrl_cmd_t *app_req)
 {
-	int exp_resp_msg_id = (app_req->msg_id - RPC_ID__Req_Base + RPC_ID__Resp_Base);
-	int i;
-
-	if (app_req->rx_sem)
-		g_h.funcs->_h_destroy_semaphore(app_req->rx_sem);
+	rpc_slot_t *slot = NULL;
+	ctrl_cmd_t *app_resp = NULL;
+	int timeout_sec = 0;
+	int ret = 0;
 
-	if (exp_resp_msg_id >= RPC_ID__Resp_Max) {
-		ESP_LOGW(TAG, "Not able to map new request to resp id");
-		return MSG_ID_OUT_OF_ORDER;
-	} else if (!app_req->rpc_rsp_cb) {
-		/* For sync, set sem */
-		app_req->rx_sem = g_h.funcs->_h_create_semaphore(1);
-		g_h.funcs->_h_get_semaphore(app_req->rx_sem, 0);
-
-		for (i = 0; i < MAX_SYNC_RPC_TRANSACTIONS; i++) {
-			if (!sync_rsp_table[i].uid) {
-				ESP_LOGD(TAG, "Register sync sem %p for uid %ld", app_req->rx_sem, app_req->uid);
-				sync_rsp_table[i].uid = app_req->uid;
-				sync_rsp_table[i].sem = app_req->rx_sem;
-				return CALLBACK_SET_SUCCESS;
-			}
-		}
-		ESP_LOGE(TAG, "Symc sem not registered: out of buffer space");
-		return CALLBACK_NOT_REGISTERED;
-	} else {
-		/* For async, nothing to be done */
-		ESP_LOGD(TAG, "NOT Register sync sem for resp[0x%x]", exp_resp_msg_id);
-		return CALLBACK_NOT_REGISTERED;
+	/* Any problems in response, return NULL */
+	if (!app_req || !app_req->uid) {
+		ESP_LOGE(TAG, "Invalid input parameter");
+		return NULL;
 	}
-}
 
-static int wait_for_sync_response(ctrl_cmd_t *app_req)
-{
-	int timeout_sec = 0;
-	int exp_resp_msg_id = 0;
-	int ret = 0;
-	int i;
+	slot = rpc_slot_of(app_req->uid);
 
 	/* If timeout not specified, use default */
 	if (!app_req->rsp_timeout_sec)
@@ -830,61 +781,32 @@ static int wait_for_sync_response(ctrl_cmd_t *app_req)
 	else
 		timeout_sec = app_req->rsp_timeout_sec;
 
-	exp_resp_msg_id = (app_req->msg_id - RPC_ID__Req_Base + RPC_ID__Resp_Base);
-
-	if (exp_resp_msg_id >= RPC_ID__Resp_Max) {
-		ESP_LOGW(TAG, "Not able to map new request to resp id");
-		return MSG_ID_OUT_OF_ORDER;
-	}
-
 	ESP_LOGV(TAG, "Wait for sync resp for Req[0x%x] with timer of %u sec",
 			app_req->msg_id, timeout_sec);
-	for (i = 0; i < MAX_SYNC_RPC_TRANSACTIONS; i++) {
-		if (sync_rsp_table[i].uid == app_req->uid) {
-			ret = g_h.funcs->_h_get_semaphore(sync_rsp_table[i].sem, SEC_TO_MILLISEC(timeout_sec));
-			if (g_h.funcs->_h_destroy_semaphore(sync_rsp_table[i].sem)) {
-				ESP_LOGE(TAG, "read sem rx for resp[0x%x] destroy failed", exp_resp_msg_id);
-			}
-			// clear table entry
-			sync_rsp_table[i].uid = 0;
-			sync_rsp_table[i].sem = NULL;
-			return ret;
-		}
-	}
-	ESP_LOGW(TAG, "Not able to map new request to resp id");
-	return MSG_ID_OUT_OF_ORDER;
-}
 
-/* Is asynchronous rpc response callback from rpc response */
-static int is_async_resp_callback_available(ctrl_cmd_t *app_resp)
-{
-	int i;
-
-	// msg_id of RPC_ID__Resp_Base now means Invalid RPC Request
-	if ((app_resp->msg_id < RPC_ID__Resp_Base) || (app_resp->msg_id >= RPC_ID__Resp_Max)) {
-		ESP_LOGE(TAG, "resp id[0x%x] out of range", app_resp->msg_id);
-		return MSG_ID_OUT_OF_ORDER;
-	}
-
-	for (i = 0; i < MAX_ASYNC_RPC_TRANSACTIONS; i++) {
-		if (async_rsp_table[i].uid == app_resp->uid) {
-			return CALLBACK_AVAILABLE;
+	/* Wait for response */
+	ret = g_h.funcs->_h_get_semaphore(slot->sem, SEC_TO_MILLISEC(timeout_sec));
+	if (ret) {
+		if (rpc_slot_claim(app_req->uid)) {
+			if ((ret == RET_FAIL_TIMEOUT) || (errno == ETIMEDOUT))
+				ESP_LOGW(TAG, "Timeout waiting for Resp for [0x%x](%s)", app_req->msg_id, rpc_id_name(app_req->msg_id));
+			else
+				ESP_LOGE(TAG, "ERR [%u] ret[%d] for [0x%x](%s)", errno, ret, app_req->msg_id, rpc_id_name(app_req->msg_id));
+			/* requests joined to this one fail as well */
+			rpc_slot_serve_joined(slot, NULL);
+			goto free_slot;
 		}
+		/* Response claimed the slot just now, sem is about to be posted */
+		g_h.funcs->_h_get_semaphore(slot->sem, HOSTED_BLOCKING);
 	}
 
-	return CALLBACK_NOT_REGISTERED;
-}
+	app_resp = rpc_slot_ctx[rpc_slot_idx(slot)].app_resp;
 
-static int is_sync_resp_sem_available(uint32_t uid)
-{
-	int i;
+free_slot:
+	/* The semaphore stays with the slot for its next request */
+	rpc_slot_free(slot);
 
-	for (i = 0; i < MAX_SYNC_RPC_TRANSACTIONS; i++) {
-		if (sync_rsp_table[i].uid == uid) {
-			return CALLBACK_AVAILABLE;
-		}
-	}
-	return CALLBACK_NOT_REGISTERED;
+	return app_resp;
 }
 
 /* Set rpc event callback
@@ -919,65 +841,67 @@ int reset_event_callback(int event)
 ctrl_cmd_t * rpc_wait_and_parse_sync_resp(ctrl_cmd_t *app_req)
 {
 	ctrl_cmd_t * rx_buf = NULL;
-	int rx_buf_len = 0;
 
-	rx_buf = get_response(&rx_buf_len, app_req);
-	if (!rx_buf || !rx_buf_len) {
+	rx_buf = get_response(app_req);
+	if (!rx_buf) {
 		ESP_LOGE(TAG, "Response not received for [0x%x](%s)", app_req->msg_id, rpc_id_name(app_req->msg_id));
-		if (rx_buf) {
-			HOSTED_FREE(rx_buf);
-		}
 	}
-	HOSTED_FREE(app_req);
+	rpc_mem_cmd_free(app_req);
 	return rx_buf;
 }
 
 
+/* Expire async requests whose timeout passed, called from rpc_tx_thread.
+ * Completion calls back into the application, so it is done after the
+ * wheel lock is released */
+static void rpc_tw_expire_due(void)
+{
+	uint32_t expired[RPC_SLOT_MAX_ASYNC];
+	uint32_t now_ms = (uint32_t)g_h.funcs->_h_get_time_ms();
+	int n = 0, k = 0;
+
+	if (rpc_tw_wait_ms(now_ms))
+		return;
+
+	n = rpc_tw_expire(now_ms, expired, RPC_SLOT_MAX_ASYNC);
+	for (k = 0; k < n; k++)
+		rpc_async_timeout_handler((void *)(uintptr_t)expired[k]);
+}
+
 /* This function is called for async procedure
- * Timer started when async rpc req is received
+ * Timeout armed in the timer wheel when async rpc req is sent
  * But there was no response in due time, this function will
  * be called to send error to application
  * */
-//static void rpc_async_timeout_handler(void const *arg)
 static void rpc_async_timeout_handler(void *arg)
 {
-	/* Please Note: Be careful while porting this to MCU.
-	 * rpc_async_timeout_handler should only be invoked after the timer has expired.
-	 * timer should not expire incorrect duration (Check os_wrapper layer for
-	 * correct seconds to milliseconds or ticks etc depending upon the platform
-	 * */
-	ctrl_cmd_t *app_req = (ctrl_cmd_t *)arg;
-
-	if (!app_req || !app_req->rpc_rsp_cb) {
-	  if (!app_req)
-		ESP_LOGE(TAG, "NULL app_req");
-
-	  if (!app_req->rpc_rsp_cb)
-		ESP_LOGE(TAG, "NULL app_req->resp_cb");
-	  return;
+	uint32_t req_uid = (uint32_t)(uintptr_t)arg;
+	rpc_slot_t *slot = NULL;
+	ctrl_cmd_t *app_resp = NULL;
+	int msg_id = 0;
+
+	/* Response may have won the race, nothing to do then */
+	slot = rpc_slot_claim(req_uid);
+	if (!slot) {
+		ESP_LOGD(TAG, "ASYNC Timeout for completed uid %" PRIu32, req_uid);
+		return;
 	}
 
-	ESP_LOGW(TAG, "ASYNC Timeout for req [0x%x](%s)", app_req->msg_id, rpc_id_name(app_req->msg_id));
-	rpc_rsp_cb_t func = app_req->rpc_rsp_cb;
-	uint32_t req_uid = app_req->uid;
-	ctrl_cmd_t *app_resp = NULL;
-	HOSTED_CALLOC(ctrl_cmd_t, app_resp, sizeof(ctrl_cmd_t), free_buffers);
-	app_resp->msg_id = app_req->msg_id - RPC_ID__Req_Base + RPC_ID__Resp_Base;
-	app_resp->msg_type = RPC_TYPE__Resp;
-	app_resp->resp_event_status = RPC_ERR_REQUEST_TIMEOUT;
-
-	/* Clear the async callback table entry (this frees app_req) */
-	for (int i = 0; i < MAX_ASYNC_RPC_TRANSACTIONS; i++) {
-		if (async_rsp_table[i].uid == req_uid) {
-			clear_async_resp_callback(&async_rsp_table[i]);
-			break;
-		}
+	msg_id = rpc_slot_ctx[rpc_slot_idx(slot)].app_req->msg_id;
+	ESP_LOGW(TAG, "ASYNC Timeout for req [0x%x](%s)", msg_id, rpc_id_name(msg_id));
+
+	app_resp = rpc_mem_cmd_alloc();
+	if (app_resp) {
+		app_resp->msg_id = msg_id - RPC_ID__Req_Base + RPC_ID__Resp_Base;
+		app_resp->msg_type = RPC_TYPE__Resp;
+		app_resp->uid = req_uid;
+		app_resp->resp_event_status = RPC_ERR_REQUEST_TIMEOUT;
+	} else {
+		ESP_LOGE(TAG, "%s, Failed to allocate memory", __func__);
 	}
 
-	/* call func pointer to notify failure */
-	func(app_resp);
-free_buffers:
-	return;
+	/* This frees app_req and calls func pointer to notify failure */
+	rpc_slot_complete(slot, app_resp);
 }
 
 /* This is entry level function when rpc request APIs are used
@@ -994,73 +918,86 @@ int rpc_send_req(ctrl_cmd_t *app_req)
 
 	if (!rpc_tx_q) {
 		ESP_LOGW(TAG, "RPC not initialized or transport down, failing fast");
-		return FAILURE;
+		goto fail_req;
 	}
 
 
-	uid++;
-	// handle rollover in uid value
-	if (!uid)
-		uid++;
-	app_req->uid = uid;
+	int exp_resp_msg_id = (app_req->msg_id - RPC_ID__Req_Base + RPC_ID__Resp_Base);
+	rpc_slot_t *slot = NULL;
 
-	ESP_LOGD(TAG, "app_req msgid[0x%x] with uid %" PRIu32, app_req->msg_id, app_req->uid);
-	if (!app_req->rpc_rsp_cb) {
-		/* sync proc only */
-		if (set_sync_resp_sem(app_req)) {
-			ESP_LOGE(TAG, "could not set sync resp sem for req[0x%x]",app_req->msg_id);
-			goto fail_req;
-		}
+	if (exp_resp_msg_id >= RPC_ID__Resp_Max) {
+		ESP_LOGW(TAG, "Not able to map new request to resp id");
+		goto fail_req;
 	}
 
+	slot = rpc_slot_alloc(app_req->rpc_rsp_cb ? 1 : 0);
+	if (!slot) {
+		ESP_LOGE(TAG, "%s rpc req[0x%x] not sent: too many requests in flight",
+				app_req->rpc_rsp_cb ? "Async" : "Sync", app_req->msg_id);
+		goto fail_req;
+	}
+
+	app_req->uid = rpc_slot_uid(slot);
+	slot->msg_id = app_req->msg_id;
+
+	ESP_LOGD(TAG, "app_req msgid[0x%x] with uid %" PRIu32, app_req->msg_id, app_req->uid);
+	/* sync: response is handed over through the slot, woken by slot->sem
+	 * async: slot owns app_req until completion */
+	rpc_slot_ctx[rpc_slot_idx(slot)].cb = app_req->rpc_rsp_cb;
+	rpc_slot_ctx[rpc_slot_idx(slot)].app_req = app_req->rpc_rsp_cb ? app_req : NULL;
+	rpc_slot_ctx[rpc_slot_idx(slot)].app_resp = NULL;
+
 	app_req->msg_type = RPC_TYPE__Req;
 
+	/* Identical request in flight: its response is shared, nothing to send */
+	if (rpc_req_join(app_req, slot))
+		return SUCCESS;
+
+	/* Publish: from now on response, timeout or failure may complete it */
+	rpc_slot_publish(slot, app_req->uid);
+
 	ESP_LOGV(TAG, "queueing rpc tx q with uid %" PRIu32, app_req->uid);
 	if (g_h.funcs->_h_queue_item(rpc_tx_q, &app_req, HOSTED_BLOCK_MAX)) {
-	  ESP_LOGE(TAG, "Failed to new app rpc req[0x%x] in tx queue", app_req->msg_id);
-	  goto fail_req;
+		ESP_LOGE(TAG, "Failed to new app rpc req[0x%x] in tx queue", app_req->msg_id);
+		/* Not queued, so nothing else can complete it */
+		rpc_slot_claim(app_req->uid);
+		goto fail_slot;
 	}
-
-	rpc_tx_ind();
+	g_h.funcs->_h_post_semaphore(rpc_tx_sem);
 
 	/* TODO : commenting, Review again to avoid duable free */
 	//H_FREE_PTR_WITH_FUNC(app_req->app_free_buff_func, app_req->app_free_buff_hdl);
 
 	return SUCCESS;
 
+fail_slot:
+	rpc_slot_free(slot);
 fail_req:
-	if (app_req->rx_sem)
-		g_h.funcs->_h_destroy_semaphore(app_req->rx_sem);
-
 	H_FREE_PTR_WITH_FUNC(app_req->app_free_buff_func, app_req->app_free_buff_hdl);
-	HOSTED_FREE(app_req);
+	if (app_req->rpc_rsp_cb)
+		rpc_async_req_fail(app_req->rpc_rsp_cb, app_req, FAILURE);
+	else
+		rpc_mem_cmd_free(app_req);
 
 	return FAILURE;
 }
 
+/* Complete all requests in flight.
+ * Async callbacks get a failed response,
+ * sync callers are woken up with NULL response */
 static int cleanup_sync_async_timer_table(void)
 {
-	for (int i = 0; i < MAX_ASYNC_RPC_TRANSACTIONS; i++) {
-		if (async_rsp_table[i].timer_hdl) {
-			g_h.funcs->_h_timer_stop(async_rsp_table[i].timer_hdl);
-		}
-		/* Free any pending async request structures */
-		if (async_rsp_table[i].app_req) {
-			HOSTED_FREE(async_rsp_table[i].app_req);
-		}
-		async_rsp_table[i].timer_hdl = NULL;
-		async_rsp_table[i].uid = 0;
-		async_rsp_table[i].cb = NULL;
-		async_rsp_table[i].app_req = NULL;
-	}
+	rpc_slot_t *slot = NULL;
+	int i;
 
-	for (int i = 0; i < MAX_SYNC_RPC_TRANSACTIONS; i++) {
-		if (sync_rsp_table[i].sem) {
-			g_h.funcs->_h_get_semaphore(sync_rsp_table[i].sem, 0);
-			g_h.funcs->_h_destroy_semaphore(sync_rsp_table[i].sem);
-		}
-		sync_rsp_table[i].uid = 0;
-		sync_rsp_table[i].sem = NULL;
+	for (i = 0; i < RPC_MAX_SLOTS; i++) {
+		uint32_t req_uid = __atomic_load_n(&rpc_slots[i].uid, __ATOMIC_ACQUIRE);
+
+		slot = rpc_slot_claim(req_uid);
+		if (!slot)
+			continue;
+
+		rpc_slot_complete(slot, NULL);
 	}
 
 	return SUCCESS;
@@ -1076,40 +1013,16 @@ int rpc_core_deinit(void)
 
 	set_rpc_lib_state(RPC_LIB_STATE_INACTIVE);
 
-	/* Drain rpc_rx_q before destroying to prevent buffer leaks */
-	if (rpc_rx_q) {
-		esp_queue_elem_t elem;
-		/* Flush all remaining items and free their buffers */
-		while (g_h.funcs->_h_dequeue_item(rpc_rx_q, &elem, 0) == 0) {
-			if (elem.buf) {
-				g_h.funcs->_h_free(elem.buf);
-			}
-		}
-		g_h.funcs->_h_destroy_queue(rpc_rx_q);
-		rpc_rx_q = NULL;
-	}
-
-	/* Drain rpc_tx_q before destroying to prevent buffer leaks */
+	/* Drain rpc_tx_q before destroying.
+	 * Queued requests are not freed here: each one holds a slot and is
+	 * released by cleanup_sync_async_timer_table() or its sync caller */
 	if (rpc_tx_q) {
 		void *buf_ptr;
-		/* Flush all remaining items and free their buffers */
-		while (g_h.funcs->_h_dequeue_item(rpc_tx_q, &buf_ptr, 0) == 0) {
-			if (buf_ptr) {
-				g_h.funcs->_h_free(buf_ptr);
-			}
-		}
+		while (g_h.funcs->_h_dequeue_item(rpc_tx_q, &buf_ptr, 0) == 0);
 		g_h.funcs->_h_destroy_queue(rpc_tx_q);
 		rpc_tx_q = NULL;
 	}
 
-	if (rpc_tx_sem) {
-		if (g_h.funcs->_h_destroy_semaphore(rpc_tx_sem)) {
-			ret = FAILURE;
-			ESP_LOGE(TAG, "read sem tx deinit failed");
-		}
-		rpc_tx_sem = NULL;
-	}
-
 	cleanup_sync_async_timer_table();
 
 	if (cancel_rpc_threads()) {
@@ -1117,6 +1030,11 @@ int rpc_core_deinit(void)
 		ESP_LOGE(TAG, "cancel rpc rx thread failed");
 	}
 
+	if (rpc_tx_sem) {
+		g_h.funcs->_h_destroy_semaphore(rpc_tx_sem);
+		rpc_tx_sem = NULL;
+	}
+
 	if (serial_deinit()) {
 		ret = FAILURE;
 		ESP_LOGE(TAG, "Serial de-init failed");
@@ -1129,33 +1047,34 @@ int rpc_core_init(void)
 {
 	int ret = SUCCESS;
 
-	/* semaphore init */
-	rpc_tx_sem = g_h.funcs->_h_create_semaphore(MAX_SYNC_RPC_TRANSACTIONS +
-			MAX_ASYNC_RPC_TRANSACTIONS);
-	if (!rpc_tx_sem) {
-		ESP_LOGE(TAG, "sem init failed, exiting");
-		goto free_bufs;
+	/* sync response semaphores and async response timeouts */
+	if (rpc_slot_init()) {
+		ESP_LOGE(TAG, "Failed to init rpc slots");
+		return FAILURE;
 	}
 
-	/* Get semaphore for first time */
-	g_h.funcs->_h_get_semaphore(rpc_tx_sem, 0);
-
 	/* serial init */
 	if (serial_init()) {
 		ESP_LOGE(TAG, "Failed to serial_init");
 		goto free_bufs;
 	}
 
-	rpc_rx_q = g_h.funcs->_h_create_queue(RPC_RX_QUEUE_SIZE,
-			sizeof(esp_queue_elem_t));
-
-	rpc_tx_q = g_h.funcs->_h_create_queue(RPC_TX_QUEUE_SIZE,
+	/* Every queued request holds a slot, so queueing never blocks */
+	rpc_tx_q = g_h.funcs->_h_create_queue(RPC_MAX_SLOTS,
 			sizeof(void *));
-	if (!rpc_rx_q || !rpc_tx_q) {
+	if (!rpc_tx_q) {
 		ESP_LOGE(TAG, "Failed to create app rpc msg Q");
 		goto free_bufs;
 	}
 
+	/* Counting, created given once */
+	rpc_tx_sem = g_h.funcs->_h_create_semaphore(RPC_MAX_SLOTS);
+	if (!rpc_tx_sem) {
+		ESP_LOGE(TAG, "Failed to create rpc tx sem");
+		goto free_bufs;
+	}
+	g_h.funcs->_h_get_semaphore(rpc_tx_sem, 0);
+
 	/* thread init */
 	if (spawn_rpc_threads())
 		goto free_bufs;
@@ -1165,6 +1084,11 @@ int rpc_core_init(void)
 	return ret;
 
 free_bufs:
+	/* deinit is a no-op while the lib is still inactive */
+	if (rpc_tx_sem) {
+		g_h.funcs->_h_destroy_semaphore(rpc_tx_sem);
+		rpc_tx_sem = NULL;
+	}
 	rpc_core_deinit();
 	return FAILURE;
 }
@@ -13,6 +13,7 @@
 #include <string.h>
 #include "transport_drv.h"
 #include "rpc_slave_if.h"
+#include "rpc_mem.h"
 #include "port_esp_hosted_host_log.h"
 #include "port_esp_hosted_host_config.h"
 
@@ -36,7 +37,8 @@
         app_msg->app_free_buff_hdl = NULL;                                    \
       }                                                                       \
     }                                                                         \
-    HOSTED_FREE(app_msg);                                                     \
+    rpc_mem_cmd_free(app_msg);                                                \
+    app_msg = NULL;                                                           \
   }                                                                           \
 } while(0);
 
@@ -55,8 +57,10 @@
 
 #define RPC_FREE_BUFFS() {                                                    \
   uint8_t idx = 0;                                                            \
-  for (idx=0;idx<app_req->n_rpc_free_buff_hdls; idx++)                        \
-    HOSTED_FREE(app_req->rpc_free_buff_hdls[idx]);                            \
+  for (idx=0;idx<app_req->n_rpc_free_buff_hdls; idx++) {                      \
+    rpc_mem_tx_free(app_req->rpc_free_buff_hdls[idx]);                        \
+    app_req->rpc_free_buff_hdls[idx] = NULL;                                  \
+  }                                                                           \
 }
 
 typedef struct q_element {
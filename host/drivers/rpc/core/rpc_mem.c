@@ -0,0 +1,192 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "rpc_mem.h"
+#include "esp_hosted_os_abstraction.h"
+#include "port_esp_hosted_host_config.h"
+
+static struct rpc_mem_stats rpc_mem_stats;
+
+#define RPC_MEM_COUNT(x) __atomic_fetch_add(&rpc_mem_stats.x, 1, __ATOMIC_RELAXED)
+
+static void *rpc_mem_heap_calloc(size_t size)
+{
+	void *ptr = g_h.funcs->_h_calloc(1, size);
+
+	if (ptr)
+		RPC_MEM_COUNT(heap_allocs);
+	return ptr;
+}
+
+static void rpc_mem_heap_free(void *ptr)
+{
+	if (ptr)
+		g_h.funcs->_h_free(ptr);
+}
+
+#if H_RPC_PREALLOC
+
+#define RPC_MEM_ALIGN(x)            (((x) + 7) & ~((size_t)7))
+
+typedef struct {
+	uint8_t *buf;
+	size_t size;
+	size_t used;
+	uint32_t live;              /* allocations not freed yet */
+} rpc_mem_arena_t;
+
+static ctrl_cmd_t rpc_cmd_pool[H_RPC_CMD_POOL_SIZE];
+static uint8_t rpc_cmd_in_use[H_RPC_CMD_POOL_SIZE];
+
+static uint8_t rpc_tx_arena_buf[H_RPC_TX_ARENA_SIZE] __attribute__((aligned(8)));
+static uint8_t rpc_rx_arena_buf[H_RPC_RX_ARENA_SIZE] __attribute__((aligned(8)));
+
+static rpc_mem_arena_t rpc_tx_arena = {
+	.buf = rpc_tx_arena_buf,
+	.size = sizeof(rpc_tx_arena_buf),
+};
+static rpc_mem_arena_t rpc_rx_arena = {
+	.buf = rpc_rx_arena_buf,
+	.size = sizeof(rpc_rx_arena_buf),
+};
+
+ctrl_cmd_t *rpc_mem_cmd_alloc(void)
+{
+	uint8_t expected = 0;
+	int i;
+
+	for (i = 0; i < H_RPC_CMD_POOL_SIZE; i++) {
+		expected = 0;
+		if (__atomic_compare_exchange_n(&rpc_cmd_in_use[i], &expected, 1,
+				false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+			memset(&rpc_cmd_pool[i], 0, sizeof(ctrl_cmd_t));
+			RPC_MEM_COUNT(pool_allocs);
+			return &rpc_cmd_pool[i];
+		}
+	}
+
+	return rpc_mem_heap_calloc(sizeof(ctrl_cmd_t));
+}
+
+void rpc_mem_cmd_free(void *cmd)
+{
+	ctrl_cmd_t *p = (ctrl_cmd_t *)cmd;
+
+	if ((p >= rpc_cmd_pool) && (p < rpc_cmd_pool + H_RPC_CMD_POOL_SIZE))
+		__atomic_store_n(&rpc_cmd_in_use[p - rpc_cmd_pool], 0, __ATOMIC_RELEASE);
+	else
+		rpc_mem_heap_free(cmd);
+}
+
+static void *rpc_mem_arena_alloc(rpc_mem_arena_t *a, size_t size)
+{
+	size_t len = RPC_MEM_ALIGN(size);
+	void *ptr = NULL;
+
+	if (!size || (len > a->size - a->used))
+		return rpc_mem_heap_calloc(size);
+
+	ptr = a->buf + a->used;
+	memset(ptr, 0, size);
+	a->used += len;
+	a->live++;
+	RPC_MEM_COUNT(pool_allocs);
+	return ptr;
+}
+
+static void rpc_mem_arena_free(rpc_mem_arena_t *a, void *ptr)
+{
+	uint8_t *p = (uint8_t *)ptr;
+
+	if ((p >= a->buf) && (p < a->buf + a->size)) {
+		/* rewind once the whole message is released */
+		if (a->live && !--a->live)
+			a->used = 0;
+	} else {
+		rpc_mem_heap_free(ptr);
+	}
+}
+
+void *rpc_mem_tx_calloc(size_t size)
+{
+	return rpc_mem_arena_alloc(&rpc_tx_arena, size);
+}
+
+void rpc_mem_tx_free(void *ptr)
+{
+	rpc_mem_arena_free(&rpc_tx_arena, ptr);
+}
+
+static void *rpc_mem_rx_alloc(void *allocator_data, size_t size)
+{
+	return rpc_mem_arena_alloc((rpc_mem_arena_t *)allocator_data, size);
+}
+
+static void rpc_mem_rx_free(void *allocator_data, void *ptr)
+{
+	rpc_mem_arena_free((rpc_mem_arena_t *)allocator_data, ptr);
+}
+
+ProtobufCAllocator rpc_mem_rx_allocator = {
+	.alloc = rpc_mem_rx_alloc,
+	.free = rpc_mem_rx_free,
+	.allocator_data = &rpc_rx_arena,
+};
+
+#else
+
+ctrl_cmd_t *rpc_mem_cmd_alloc(void)
+{
+	return rpc_mem_heap_calloc(sizeof(ctrl_cmd_t));
+}
+
+void rpc_mem_cmd_free(void *cmd)
+{
+	rpc_mem_heap_free(cmd);
+}
+
+void *rpc_mem_tx_calloc(size_t size)
+{
+	return rpc_mem_heap_calloc(size);
+}
+
+void rpc_mem_tx_free(void *ptr)
+{
+	rpc_mem_heap_free(ptr);
+}
+
+static void *rpc_mem_rx_alloc(void *allocator_data, size_t size)
+{
+	return rpc_mem_heap_calloc(size);
+}
+
+static void rpc_mem_rx_free(void *allocator_data, void *ptr)
+{
+	rpc_mem_heap_free(ptr);
+}
+
+ProtobufCAllocator rpc_mem_rx_allocator = {
+	.alloc = rpc_mem_rx_alloc,
+	.free = rpc_mem_rx_free,
+	.allocator_data = NULL,
+};
+
+#endif
+
+void rpc_mem_count_serial_alloc(void)
+{
+	RPC_MEM_COUNT(serial_allocs);
+}
+
+void rpc_mem_get_stats(struct rpc_mem_stats *stats)
+{
+	stats->pool_allocs = __atomic_load_n(&rpc_mem_stats.pool_allocs, __ATOMIC_RELAXED);
+	stats->heap_allocs = __atomic_load_n(&rpc_mem_stats.heap_allocs, __ATOMIC_RELAXED);
+	stats->serial_allocs = __atomic_load_n(&rpc_mem_stats.serial_allocs, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,55 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Memory for RPC messages
+ *
+ * With H_RPC_PREALLOC, ctrl_cmd_t comes from a fixed pool and protobuf
+ * structures and buffers from two arenas: one used by the RPC Tx task to
+ * compose and encode requests, one used by the RPC Rx task to decode
+ * responses and events. An arena is rewound once everything allocated
+ * from it is freed again, which happens at the end of every message.
+ * Anything not fitting falls back to the heap and is counted.
+ *
+ * Without H_RPC_PREALLOC all calls go to the heap.
+ *
+ * The TLV buffer of every request sent and the buffer of every message
+ * received are allocated by the serial layer, on the heap in any case.
+ * rpc_core counts them separately as serial_allocs.
+ */
+
+#ifndef __RPC_MEM_H
+#define __RPC_MEM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <protobuf-c/protobuf-c.h>
+
+#include "rpc_slave_if.h"
+
+struct rpc_mem_stats {
+	uint32_t pool_allocs;   /* served from pool or arena */
+	uint32_t heap_allocs;   /* general heap allocations */
+	uint32_t serial_allocs; /* serial Tx TLV and Rx buffers, always heap */
+};
+
+/* Zeroed ctrl_cmd_t. Free with rpc_mem_cmd_free() */
+ctrl_cmd_t *rpc_mem_cmd_alloc(void);
+void rpc_mem_cmd_free(void *cmd);
+
+/* Request arena. RPC Tx task only */
+void *rpc_mem_tx_calloc(size_t size);
+void rpc_mem_tx_free(void *ptr);
+
+/* Allocator for rpc__unpack() / rpc__free_unpacked(). RPC Rx task only */
+extern ProtobufCAllocator rpc_mem_rx_allocator;
+
+/* Count a heap buffer the serial layer allocated for an RPC message.
+ * Called by rpc_core for every request sent and message received */
+void rpc_mem_count_serial_alloc(void);
+
+void rpc_mem_get_stats(struct rpc_mem_stats *stats);
+
+#endif
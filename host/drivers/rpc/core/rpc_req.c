@@ -13,6 +13,7 @@
 #include "esp_idf_version.h"
 #include "port_esp_hosted_host_log.h"
 #include "esp_hosted_os_abstraction.h"
+#include "rpc_mem.h"
 
 DEFINE_LOG_TAG(rpc_req);
 
@@ -23,7 +24,7 @@ DEFINE_LOG_TAG(rpc_req);
 
 #define RPC_ALLOC_ASSIGN(TyPe,MsG_StRuCt,InItFuNc)                            \
     TyPe *req_payload = (TyPe *)                                              \
-        g_h.funcs->_h_calloc(1, sizeof(TyPe));                                \
+        rpc_mem_tx_calloc(sizeof(TyPe));                                      \
     if (!req_payload) {                                                       \
         ESP_LOGE(TAG, "Failed to allocate memory for req->%s\n",#MsG_StRuCt);     \
         *failure_status = RPC_ERR_MEMORY_FAILURE;                              \
@@ -35,7 +36,7 @@ DEFINE_LOG_TAG(rpc_req);
 
 //TODO: How this is different in slave_control.c
 #define RPC_ALLOC_ELEMENT(TyPe,MsG_StRuCt,InIt_FuN) {                         \
-    TyPe *NeW_AllocN = (TyPe *) g_h.funcs->_h_calloc(1, sizeof(TyPe));        \
+    TyPe *NeW_AllocN = (TyPe *) rpc_mem_tx_calloc(sizeof(TyPe));              \
     if (!NeW_AllocN) {                                                        \
         ESP_LOGE(TAG, "Failed to allocate memory for req->%s\n",#MsG_StRuCt);     \
         *failure_status = RPC_ERR_MEMORY_FAILURE;                              \
@@ -980,6 +981,83 @@ int compose_rpc_req(Rpc *req, ctrl_cmd_t *app_req, int32_t *failure_status)
 		req_payload->set_grant_delay_us = app_req->u.ext_coex.set_grant_delay_us;
 		req_payload->set_validate_high = app_req->u.ext_coex.set_validate_high;
 		break;
+#endif
+#if H_NETWORK_SPLIT_ENABLED
+	} case RPC_ID__Req_NwSplitPortRules: {
+		rpc_nw_split_port_rules_t *p_a = &app_req->u.nw_split_port_rules;
+		RpcNwSplitPortRule *p_c = NULL;
+		uint16_t i = 0;
+
+		RPC_ALLOC_ASSIGN(RpcReqNwSplitPortRules, req_nw_split_port_rules,
+				rpc__req__nw_split_port_rules__init);
+
+		req_payload->replace = p_a->replace;
+		if (!p_a->n_rules)
+			break;
+
+		/* pointer array and rules in one buffer, to use one free handle */
+		req_payload->rules = (RpcNwSplitPortRule **)rpc_mem_tx_calloc(
+				p_a->n_rules * (sizeof(RpcNwSplitPortRule *) + sizeof(RpcNwSplitPortRule)));
+		if (!req_payload->rules) {
+			ESP_LOGE(TAG, "Failed to allocate memory for port rules");
+			*failure_status = RPC_ERR_MEMORY_FAILURE;
+			return FAILURE;
+		}
+		ADD_RPC_BUFF_TO_FREE_LATER((uint8_t *)req_payload->rules);
+		p_c = (RpcNwSplitPortRule *)(req_payload->rules + p_a->n_rules);
+
+		for (i = 0; i < p_a->n_rules; i++) {
+			rpc__nw_split_port_rule__init(&p_c[i]);
+			p_c[i].proto = p_a->rules[i].proto;
+			p_c[i].match_src = p_a->rules[i].match_src;
+			p_c[i].port_start = p_a->rules[i].port_start;
+			p_c[i].port_end = p_a->rules[i].port_end;
+			p_c[i].action = p_a->rules[i].action;
+			req_payload->rules[i] = &p_c[i];
+		}
+		req_payload->n_rules = p_a->n_rules;
+		break;
+#endif
+#if H_HOST_PS_ALLOWED
+	} case RPC_ID__Req_SetWakeRules: {
+		rpc_set_wake_rules_t *p_a = &app_req->u.set_wake_rules;
+		RpcWakeRule *p_c = NULL;
+		uint8_t i = 0;
+
+		RPC_ALLOC_ASSIGN(RpcReqSetWakeRules, req_set_wake_rules,
+				rpc__req__set_wake_rules__init);
+
+		if (!p_a->n_rules)
+			break;
+
+		/* pointer array and rules in one buffer, to use one free handle.
+		 * mask and value point into the app rules, valid until the response */
+		req_payload->rules = (RpcWakeRule **)rpc_mem_tx_calloc(
+				p_a->n_rules * (sizeof(RpcWakeRule *) + sizeof(RpcWakeRule)));
+		if (!req_payload->rules) {
+			ESP_LOGE(TAG, "Failed to allocate memory for wake rules");
+			*failure_status = RPC_ERR_MEMORY_FAILURE;
+			return FAILURE;
+		}
+		ADD_RPC_BUFF_TO_FREE_LATER((uint8_t *)req_payload->rules);
+		p_c = (RpcWakeRule *)(req_payload->rules + p_a->n_rules);
+
+		for (i = 0; i < p_a->n_rules; i++) {
+			rpc__wake_rule__init(&p_c[i]);
+			p_c[i].layer = p_a->rules[i].layer;
+			p_c[i].ip_proto = p_a->rules[i].ip_proto;
+			p_c[i].port = p_a->rules[i].port;
+			p_c[i].offset = p_a->rules[i].offset;
+			p_c[i].mask.len = p_a->rules[i].len;
+			p_c[i].mask.data = (uint8_t *)p_a->rules[i].mask;
+			p_c[i].value.len = p_a->rules[i].len;
+			p_c[i].value.data = (uint8_t *)p_a->rules[i].value;
+			p_c[i].rate_limit = p_a->rules[i].rate_limit;
+			p_c[i].rate_interval_ms = p_a->rules[i].rate_interval_ms;
+			req_payload->rules[i] = &p_c[i];
+		}
+		req_payload->n_rules = p_a->n_rules;
+		break;
 #endif
 	} default: {
 		*failure_status = RPC_ERR_UNSUPPORTED_MSG;
@@ -900,6 +900,18 @@ int rpc_parse_rsp(Rpc *rpc_msg, ctrl_cmd_t *app_resp)
 		RPC_FAIL_ON_NULL(resp_ext_coex);
 		RPC_ERR_IN_RESP(resp_ext_coex);
 		break;
+#endif
+#if H_NETWORK_SPLIT_ENABLED
+	} case RPC_ID__Resp_NwSplitPortRules: {
+		RPC_FAIL_ON_NULL(resp_nw_split_port_rules);
+		RPC_ERR_IN_RESP(resp_nw_split_port_rules);
+		break;
+#endif
+#if H_HOST_PS_ALLOWED
+	} case RPC_ID__Resp_SetWakeRules: {
+		RPC_FAIL_ON_NULL(resp_set_wake_rules);
+		RPC_ERR_IN_RESP(resp_set_wake_rules);
+		break;
 #endif
 	} default: {
 		ESP_LOGE(TAG, "Unsupported rpc Resp[%u]", rpc_msg->msg_id);
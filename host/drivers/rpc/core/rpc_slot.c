@@ -0,0 +1,207 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "rpc_slot.h"
+#include "port_esp_hosted_host_os.h"
+#include "port_esp_hosted_host_log.h"
+
+static const char *TAG = "rpc_slot";
+
+#define SUCCESS                    0
+#define FAILURE                    -1
+
+#define RPC_TW_NIL                 -1
+
+rpc_slot_t rpc_slots[RPC_MAX_SLOTS] = { 0 };
+
+static int16_t rpc_tw_head[RPC_TW_BUCKETS];
+static uint32_t rpc_tw_now;     /* last tick walked */
+static uint32_t rpc_tw_count;   /* requests linked */
+static void *rpc_tw_lock;
+
+int rpc_slot_init(void)
+{
+	int i = 0;
+
+	if (!rpc_tw_lock) {
+		rpc_tw_lock = g_h.funcs->_h_create_mutex();
+		if (!rpc_tw_lock) {
+			ESP_LOGE(TAG, "Failed to create timer wheel lock");
+			return FAILURE;
+		}
+	}
+	for (i = 0; i < RPC_TW_BUCKETS; i++)
+		rpc_tw_head[i] = RPC_TW_NIL;
+	rpc_tw_count = 0;
+
+	/* A sync slot semaphore is only posted by the completion that claimed
+	 * the slot and always taken by its caller, so it is empty once the
+	 * slot is free and can be reused for the next request */
+	for (i = 0; i < RPC_SLOT_MAX_SYNC; i++) {
+		if (rpc_slots[i].sem)
+			continue;
+
+		rpc_slots[i].sem = g_h.funcs->_h_create_semaphore(1);
+		if (!rpc_slots[i].sem) {
+			ESP_LOGE(TAG, "Failed to create sync resp sem");
+			return FAILURE;
+		}
+		g_h.funcs->_h_get_semaphore(rpc_slots[i].sem, 0);
+	}
+
+	return SUCCESS;
+}
+
+rpc_slot_t *rpc_slot_alloc(uint8_t is_async)
+{
+	uint8_t expected = 0;
+	rpc_slot_t *slot = NULL;
+	int start = is_async ? RPC_SLOT_MAX_SYNC : 0;
+	int end = is_async ? RPC_MAX_SLOTS : RPC_SLOT_MAX_SYNC;
+	int i;
+
+	for (i = start; i < end; i++) {
+		expected = 0;
+		if (__atomic_compare_exchange_n(&rpc_slots[i].in_use, &expected, 1,
+				false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+			slot = &rpc_slots[i];
+			slot->gen++;
+			if (!slot->gen || slot->gen > RPC_SLOT_GEN_MAX)
+				slot->gen = 1;
+			slot->tw_linked = 0;
+			slot->msg_id = 0;
+			slot->join_uid = 0;
+			return slot;
+		}
+	}
+	return NULL;
+}
+
+void rpc_slot_publish(rpc_slot_t *slot, uint32_t req_uid)
+{
+	__atomic_store_n(&slot->uid, req_uid, __ATOMIC_RELEASE);
+}
+
+rpc_slot_t *rpc_slot_claim(uint32_t req_uid)
+{
+	uint32_t idx = req_uid & RPC_SLOT_IDX_MASK;
+	uint32_t expected = req_uid;
+
+	if (!req_uid || idx >= RPC_MAX_SLOTS)
+		return NULL;
+
+	/* seq_cst: pairs with joining in rpc_req_join() */
+	if (!__atomic_compare_exchange_n(&rpc_slots[idx].uid, &expected, 0,
+			false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+		return NULL;
+
+	return &rpc_slots[idx];
+}
+
+void rpc_slot_free(rpc_slot_t *slot)
+{
+	__atomic_store_n(&slot->uid, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&slot->in_use, 0, __ATOMIC_RELEASE);
+}
+
+void rpc_tw_add(rpc_slot_t *slot, uint32_t req_uid, uint32_t timeout_ms,
+		uint32_t now_ms)
+{
+	/* round up and add one, as the current tick is partly over */
+	uint32_t ticks = (timeout_ms + RPC_TW_TICK_MS - 1) / RPC_TW_TICK_MS + 1;
+	int16_t idx = (int16_t)rpc_slot_idx(slot);
+	uint32_t bucket = 0;
+
+	g_h.funcs->_h_lock_mutex(rpc_tw_lock, HOSTED_BLOCK_MAX);
+	if (__atomic_load_n(&slot->uid, __ATOMIC_ACQUIRE) == req_uid) {
+		/* Idle wheel is not walked, so catch up with the clock */
+		if (!rpc_tw_count)
+			rpc_tw_now = now_ms / RPC_TW_TICK_MS;
+		slot->tw_expiry = rpc_tw_now + ticks;
+		bucket = slot->tw_expiry & (RPC_TW_BUCKETS - 1);
+		slot->tw_prev = RPC_TW_NIL;
+		slot->tw_next = rpc_tw_head[bucket];
+		if (slot->tw_next != RPC_TW_NIL)
+			rpc_slots[slot->tw_next].tw_prev = idx;
+		rpc_tw_head[bucket] = idx;
+		slot->tw_linked = 1;
+		rpc_tw_count++;
+	}
+	g_h.funcs->_h_unlock_mutex(rpc_tw_lock);
+}
+
+/* Unlink, caller holds rpc_tw_lock */
+static void rpc_tw_unlink(rpc_slot_t *slot)
+{
+	uint32_t bucket = slot->tw_expiry & (RPC_TW_BUCKETS - 1);
+
+	if (slot->tw_prev != RPC_TW_NIL)
+		rpc_slots[slot->tw_prev].tw_next = slot->tw_next;
+	else
+		rpc_tw_head[bucket] = slot->tw_next;
+	if (slot->tw_next != RPC_TW_NIL)
+		rpc_slots[slot->tw_next].tw_prev = slot->tw_prev;
+	slot->tw_linked = 0;
+	rpc_tw_count--;
+}
+
+void rpc_tw_del(rpc_slot_t *slot)
+{
+	g_h.funcs->_h_lock_mutex(rpc_tw_lock, HOSTED_BLOCK_MAX);
+	if (slot->tw_linked)
+		rpc_tw_unlink(slot);
+	g_h.funcs->_h_unlock_mutex(rpc_tw_lock);
+}
+
+int rpc_tw_wait_ms(uint32_t now_ms)
+{
+	/* Unlocked: only the owning task links and walks, others just unlink.
+	 * A stale count costs one early wake up at most */
+	if (!__atomic_load_n(&rpc_tw_count, __ATOMIC_RELAXED))
+		return -1;
+
+	if (now_ms / RPC_TW_TICK_MS != __atomic_load_n(&rpc_tw_now, __ATOMIC_RELAXED))
+		return 0;
+
+	return RPC_TW_TICK_MS - (now_ms % RPC_TW_TICK_MS);
+}
+
+int rpc_tw_expire(uint32_t now_ms, uint32_t *expired, int max_expired)
+{
+	uint32_t now = now_ms / RPC_TW_TICK_MS;
+	uint32_t tick = 0;
+	int16_t i = 0, next = 0;
+	int n = 0;
+
+	g_h.funcs->_h_lock_mutex(rpc_tw_lock, HOSTED_BLOCK_MAX);
+	/* Walk every tick passed since the last call, but each bucket once */
+	if ((int32_t)(now - rpc_tw_now) > RPC_TW_BUCKETS)
+		rpc_tw_now = now - RPC_TW_BUCKETS;
+
+	while (rpc_tw_count && (int32_t)(now - rpc_tw_now) > 0) {
+		tick = ++rpc_tw_now;
+		for (i = rpc_tw_head[tick & (RPC_TW_BUCKETS - 1)]; i != RPC_TW_NIL; i = next) {
+			rpc_slot_t *slot = &rpc_slots[i];
+			uint32_t req_uid = 0;
+
+			next = slot->tw_next;
+			if ((int32_t)(slot->tw_expiry - now) > 0)
+				continue;
+
+			rpc_tw_unlink(slot);
+			req_uid = __atomic_load_n(&slot->uid, __ATOMIC_ACQUIRE);
+			if (req_uid && n < max_expired)
+				expired[n++] = req_uid;
+		}
+	}
+	rpc_tw_now = now;
+	g_h.funcs->_h_unlock_mutex(rpc_tw_lock);
+
+	return n;
+}
@@ -0,0 +1,116 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Slot table of RPC requests in flight
+ *
+ * The uid sent with a request carries its slot index in the low bits and
+ * a per slot generation in the high bits. A response or timeout therefore
+ * finds its request directly, and a late response for a recycled slot
+ * does not match. uid 0 is never used.
+ * Slots [0, RPC_SLOT_MAX_SYNC) are used by sync requests, the rest by
+ * async ones. Every sync slot owns a semaphore for its waiting caller.
+ *
+ * Completion is claimed by atomically swapping slot uid to 0, so exactly
+ * one of response, timeout, Tx failure or deinit completes a request.
+ *
+ * Only depends on the OS abstraction, so that it also builds on a Linux
+ * host, see tools/bench/rpc_slot_stress.c
+ */
+
+#ifndef __RPC_SLOT_H
+#define __RPC_SLOT_H
+
+#include <stdint.h>
+
+#include "port_esp_hosted_host_config.h"
+
+#define RPC_SLOT_MAX_SYNC          H_MAX_SYNC_RPC_REQUESTS
+#define RPC_SLOT_MAX_ASYNC         H_MAX_ASYNC_RPC_REQUESTS
+#define RPC_MAX_SLOTS              (RPC_SLOT_MAX_SYNC + RPC_SLOT_MAX_ASYNC)
+
+#define RPC_SLOT_IDX_BITS          8
+#define RPC_SLOT_IDX_MASK          ((1 << RPC_SLOT_IDX_BITS) - 1)
+#define RPC_SLOT_GEN_MAX           (UINT32_MAX >> RPC_SLOT_IDX_BITS)
+
+#if RPC_MAX_SLOTS > (1 << RPC_SLOT_IDX_BITS)
+#error "Too many simultaneous RPC requests configured"
+#endif
+
+typedef struct {
+	uint8_t in_use;
+	uint32_t gen;
+	uint32_t uid;           /* uid awaiting completion, 0 once claimed */
+	void * sem;             /* sync only, posted on completion */
+	uint16_t msg_id;
+	uint32_t join_uid;      /* sync only, uid of the identical request joined */
+	uint32_t tw_expiry;     /* async only, timer wheel tick of timeout */
+	int16_t tw_next;        /* async only, timer wheel bucket links */
+	int16_t tw_prev;
+	uint8_t tw_linked;
+} rpc_slot_t;
+
+extern rpc_slot_t rpc_slots[RPC_MAX_SLOTS];
+
+/* Create the sync slot semaphores and the timer wheel lock.
+ * Kept over deinit, so calling it again is cheap */
+int rpc_slot_init(void);
+
+/* Reserve a free slot for a new request.
+ * Returns NULL if all slots of the kind are in use */
+rpc_slot_t *rpc_slot_alloc(uint8_t is_async);
+
+static inline uint32_t rpc_slot_idx(rpc_slot_t *slot)
+{
+	return (uint32_t)(slot - rpc_slots);
+}
+
+static inline uint32_t rpc_slot_uid(rpc_slot_t *slot)
+{
+	return (slot->gen << RPC_SLOT_IDX_BITS) | rpc_slot_idx(slot);
+}
+
+/* Slot a uid maps to, whether or not that request is still pending */
+static inline rpc_slot_t *rpc_slot_of(uint32_t req_uid)
+{
+	return &rpc_slots[req_uid & RPC_SLOT_IDX_MASK];
+}
+
+/* Make the request completable by response, timeout or failure */
+void rpc_slot_publish(rpc_slot_t *slot, uint32_t req_uid);
+
+/* Claim the right to complete the request with this uid.
+ * Returns NULL if uid is unknown or the request is already completed */
+rpc_slot_t *rpc_slot_claim(uint32_t req_uid);
+
+void rpc_slot_free(rpc_slot_t *slot);
+
+/* Async response timeouts
+ * A hashed timer wheel of RPC_TW_TICK_MS ticks. An async slot is linked
+ * into bucket (expiry tick % RPC_TW_BUCKETS) once its request is sent and
+ * unlinked on completion, both in O(1). There is no timer behind it: the
+ * task owning the wheel calls rpc_tw_expire() when rpc_tw_wait_ms() is up,
+ * so nothing runs while no async request is in flight. Only the buckets of
+ * the ticks passed are walked; entries due in a later revolution stay */
+#define RPC_TW_TICK_MS             100
+#define RPC_TW_BUCKETS             32   /* power of 2 */
+
+/* Link a sent async request into the timer wheel.
+ * Skipped if the request got completed already, e.g. by deinit */
+void rpc_tw_add(rpc_slot_t *slot, uint32_t req_uid, uint32_t timeout_ms,
+		uint32_t now_ms);
+
+void rpc_tw_del(rpc_slot_t *slot);
+
+/* Time until rpc_tw_expire() is due, -1 if the wheel is empty */
+int rpc_tw_wait_ms(uint32_t now_ms);
+
+/* Advance the wheel up to now_ms.
+ * Fills expired with up to max_expired uids of requests that timed out
+ * and returns their number. They are not claimed yet, so the caller can
+ * complete them outside the wheel lock */
+int rpc_tw_expire(uint32_t now_ms, uint32_t *expired, int max_expired);
+
+#endif
@@ -11,20 +11,29 @@
 
 DEFINE_LOG_TAG(rpc_api);
 
-#define RPC_SEND_REQ(msGiD) do {                                                \
-    assert(req);                                                                \
-    req->msg_id = msGiD;                                                        \
-    if(SUCCESS != rpc_send_req(req)) {                                          \
-        ESP_LOGE(TAG,"Failed to send control req 0x%x\n", req->msg_id);         \
-        return NULL;                                                            \
-    }                                                                           \
-} while(0);
-
-#define RPC_DECODE_RSP_IF_NOT_ASYNC() do {                                      \
-  if (req->rpc_rsp_cb)                                                          \
-    return NULL;                                                                \
-  return rpc_wait_and_parse_sync_resp(req);                                     \
-} while(0);
+/* An async request belongs to the RPC core once sent: it may be completed,
+ * freed and even reused for another request before rpc_send_req() returns.
+ * So whether to wait is decided before sending, and req is not touched
+ * after an async send */
+static ctrl_cmd_t * rpc_slaveif_send_req(ctrl_cmd_t *req, int msg_id)
+{
+	bool is_async = false;
+
+	assert(req);
+	req->msg_id = msg_id;
+	is_async = req->rpc_rsp_cb != NULL;
+	if (SUCCESS != rpc_send_req(req)) {
+		ESP_LOGE(TAG, "Failed to send control req 0x%x\n", msg_id);
+		return NULL;
+	}
+
+	if (is_async)
+		return NULL;
+	return rpc_wait_and_parse_sync_resp(req);
+}
+
+#define RPC_SEND_REQ_AND_DECODE_RSP(msGiD)                                      \
+  return rpc_slaveif_send_req(req, msGiD)
 
 
 int rpc_slaveif_init(void)
@@ -54,625 +63,523 @@ int rpc_slaveif_deinit(void)
 /** Control Req->Resp APIs **/
 ctrl_cmd_t * rpc_slaveif_wifi_get_mac(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_GetMACAddress);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_GetMACAddress);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_set_mac(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_SetMacAddress);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_SetMacAddress);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_get_mode(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_GetWifiMode);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_GetWifiMode);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_set_mode(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_SetWifiMode);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_SetWifiMode);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_set_ps(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiSetPs);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiSetPs);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_get_ps(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiGetPs);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiGetPs);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_set_max_tx_power(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiSetMaxTxPower);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiSetMaxTxPower);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_get_max_tx_power(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiGetMaxTxPower);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiGetMaxTxPower);
 }
 
 ctrl_cmd_t * rpc_slaveif_config_heartbeat(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_ConfigHeartbeat);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_ConfigHeartbeat);
 }
 
 ctrl_cmd_t * rpc_slaveif_ota_begin(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_OTABegin);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_OTABegin);
 }
 
 ctrl_cmd_t * rpc_slaveif_ota_write(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_OTAWrite);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_OTAWrite);
 }
 
 ctrl_cmd_t * rpc_slaveif_ota_end(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_OTAEnd);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_OTAEnd);
 }
 
 ctrl_cmd_t * rpc_slaveif_ota_activate(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_OTAActivate);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_OTAActivate);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_init(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiInit);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiInit);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_deinit(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiDeinit);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiDeinit);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_start(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiStart);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiStart);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_stop(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiStop);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiStop);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_connect(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiConnect);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiConnect);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_disconnect(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiDisconnect);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiDisconnect);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_get_config(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiGetConfig);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiGetConfig);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_set_config(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiSetConfig);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiSetConfig);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_scan_params(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiScanParams);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiScanParams);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_scan_start(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiScanStart);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiScanStart);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_scan_stop(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiScanStop);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiScanStop);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_scan_get_ap_num(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiScanGetApNum);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiScanGetApNum);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_scan_get_ap_record(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiScanGetApRecord);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiScanGetApRecord);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_scan_get_ap_records(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiScanGetApRecords);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiScanGetApRecords);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_clear_ap_list(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiClearApList);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiClearApList);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_restore(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiRestore);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiRestore);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_clear_fast_connect(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiClearFastConnect);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiClearFastConnect);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_deauth_sta(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiDeauthSta);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiDeauthSta);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_sta_get_ap_info(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiStaGetApInfo);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiStaGetApInfo);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_set_storage(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiSetStorage);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiSetStorage);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_set_bandwidth(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiSetBandwidth);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiSetBandwidth);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_get_bandwidth(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiGetBandwidth);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiGetBandwidth);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_set_channel(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiSetChannel);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiSetChannel);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_get_channel(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiGetChannel);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiGetChannel);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_set_country_code(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiSetCountryCode);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiSetCountryCode);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_get_country_code(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiGetCountryCode);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiGetCountryCode);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_set_country(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiSetCountry);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiSetCountry);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_get_country(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiGetCountry);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiGetCountry);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_ap_get_sta_list(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiApGetStaList);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiApGetStaList);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_ap_get_sta_aid(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiApGetStaAid);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiApGetStaAid);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_sta_get_rssi(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiStaGetRssi);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiStaGetRssi);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_set_protocol(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiSetProtocol);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiSetProtocol);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_get_protocol(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiGetProtocol);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiGetProtocol);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_sta_get_negotiated_phymode(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiStaGetNegotiatedPhymode);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiStaGetNegotiatedPhymode);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_sta_get_aid(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiStaGetAid);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiStaGetAid);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_set_protocols(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiSetProtocols);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiSetProtocols);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_set_inactive_time(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiSetInactiveTime);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiSetInactiveTime);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_get_inactive_time(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiGetInactiveTime);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiGetInactiveTime);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_disable_pmf_config(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiDisablePmfConfig);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiDisablePmfConfig);
 }
 
 #if H_WIFI_HE_SUPPORT
 ctrl_cmd_t * rpc_slaveif_wifi_sta_twt_config(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiStaTwtConfig);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiStaTwtConfig);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_sta_itwt_setup(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiStaItwtSetup);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiStaItwtSetup);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_sta_itwt_teardown(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiStaItwtTeardown);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiStaItwtTeardown);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_sta_itwt_suspend(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiStaItwtSuspend);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiStaItwtSuspend);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_sta_itwt_get_flow_id_status(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiStaItwtGetFlowIdStatus);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiStaItwtGetFlowIdStatus);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_sta_itwt_send_probe_req(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiStaItwtSendProbeReq);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiStaItwtSendProbeReq);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_sta_itwt_set_target_wake_time_offset(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiStaItwtSetTargetWakeTimeOffset);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiStaItwtSetTargetWakeTimeOffset);
 }
 #endif
 
 ctrl_cmd_t * rpc_slaveif_get_coprocessor_fwversion(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_GetCoprocessorFwVersion);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_GetCoprocessorFwVersion);
 }
 
 ctrl_cmd_t * rpc_slaveif_iface_mac_addr_set_get(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_IfaceMacAddrSetGet);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_IfaceMacAddrSetGet);
 }
 
 ctrl_cmd_t * rpc_slaveif_feature_control(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_FeatureControl);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_FeatureControl);
 }
 
 ctrl_cmd_t * rpc_slaveif_get_coprocessor_app_desc(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_AppGetDesc);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_AppGetDesc);
 }
 
 ctrl_cmd_t * rpc_slaveif_iface_mac_addr_len_get(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_IfaceMacAddrLenGet);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_IfaceMacAddrLenGet);
 }
 
 #if H_WIFI_DUALBAND_SUPPORT
 ctrl_cmd_t * rpc_slaveif_wifi_get_protocols(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiGetProtocols);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiGetProtocols);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_set_bandwidths(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiSetBandwidths);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiSetBandwidths);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_get_bandwidths(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiGetBandwidths);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiGetBandwidths);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_set_band(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiSetBand);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiSetBand);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_get_band(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiGetBand);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiGetBand);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_set_band_mode(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiSetBandMode);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiSetBandMode);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_get_band_mode(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiGetBandMode);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiGetBandMode);
 }
 #endif
 
 ctrl_cmd_t * rpc_slaveif_set_slave_dhcp_dns_status(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_SetDhcpDnsStatus);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_SetDhcpDnsStatus);
 }
 
 
 #if H_WIFI_ENTERPRISE_SUPPORT
 ctrl_cmd_t * rpc_slaveif_wifi_sta_enterprise_enable(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiStaEnterpriseEnable);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiStaEnterpriseEnable);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_sta_enterprise_disable(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiStaEnterpriseDisable);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiStaEnterpriseDisable);
 }
 
 ctrl_cmd_t * rpc_slaveif_eap_set_identity(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_EapSetIdentity);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_EapSetIdentity);
 }
 
 ctrl_cmd_t * rpc_slaveif_eap_clear_identity(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_EapClearIdentity);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_EapClearIdentity);
 }
 
 ctrl_cmd_t * rpc_slaveif_eap_set_username(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_EapSetUsername);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_EapSetUsername);
 }
 
 ctrl_cmd_t * rpc_slaveif_eap_clear_username(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_EapClearUsername);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_EapClearUsername);
 }
 
 ctrl_cmd_t * rpc_slaveif_eap_set_password(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_EapSetPassword);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_EapSetPassword);
 }
 
 ctrl_cmd_t * rpc_slaveif_eap_clear_password(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_EapClearPassword);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_EapClearPassword);
 }
 
 ctrl_cmd_t * rpc_slaveif_eap_set_new_password(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_EapSetNewPassword);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_EapSetNewPassword);
 }
 
 ctrl_cmd_t * rpc_slaveif_eap_clear_new_password(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_EapClearNewPassword);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_EapClearNewPassword);
 }
 
 ctrl_cmd_t * rpc_slaveif_eap_set_ca_cert(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_EapSetCaCert);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_EapSetCaCert);
 }
 
 ctrl_cmd_t * rpc_slaveif_eap_clear_ca_cert(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_EapClearCaCert);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_EapClearCaCert);
 }
 
 ctrl_cmd_t * rpc_slaveif_eap_set_certificate_and_key(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_EapSetCertificateAndKey);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_EapSetCertificateAndKey);
 }
 
 ctrl_cmd_t * rpc_slaveif_eap_clear_certificate_and_key(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_EapClearCertificateAndKey);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_EapClearCertificateAndKey);
 }
 
 ctrl_cmd_t * rpc_slaveif_eap_get_disable_time_check(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_EapGetDisableTimeCheck);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_EapGetDisableTimeCheck);
 }
 
 ctrl_cmd_t * rpc_slaveif_eap_set_ttls_phase2_method(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_EapSetTtlsPhase2Method);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_EapSetTtlsPhase2Method);
 }
 
 ctrl_cmd_t * rpc_slaveif_eap_set_suiteb_certification(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_EapSetSuitebCertification);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_EapSetSuitebCertification);
 }
 
 ctrl_cmd_t * rpc_slaveif_eap_set_pac_file(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_EapSetPacFile);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_EapSetPacFile);
 }
 
 ctrl_cmd_t * rpc_slaveif_eap_set_fast_params(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_EapSetFastParams);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_EapSetFastParams);
 }
 
 ctrl_cmd_t * rpc_slaveif_eap_use_default_cert_bundle(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_EapUseDefaultCertBundle);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_EapUseDefaultCertBundle);
 }
 
 ctrl_cmd_t * rpc_slaveif_wifi_set_okc_support(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_WifiSetOkcSupport);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_WifiSetOkcSupport);
 }
 
 ctrl_cmd_t * rpc_slaveif_eap_set_domain_name(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_EapSetDomainName);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_EapSetDomainName);
 }
 
 ctrl_cmd_t * rpc_slaveif_eap_set_disable_time_check(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_EapSetDisableTimeCheck);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_EapSetDisableTimeCheck);
 }
 
 #if H_GOT_SET_EAP_METHODS_API
 ctrl_cmd_t * rpc_slaveif_eap_set_eap_methods(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_EapSetEapMethods);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_EapSetEapMethods);
 }
 #endif
 #endif
 #if H_DPP_SUPPORT
 ctrl_cmd_t * rpc_slaveif_supp_dpp_init(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_SuppDppInit);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_SuppDppInit);
 }
 
 ctrl_cmd_t * rpc_slaveif_supp_dpp_deinit(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_SuppDppDeinit);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_SuppDppDeinit);
 }
 
 ctrl_cmd_t * rpc_slaveif_supp_dpp_bootstrap_gen(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_SuppDppBootstrapGen);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_SuppDppBootstrapGen);
 }
 
 ctrl_cmd_t * rpc_slaveif_supp_dpp_start_listen(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_SuppDppStartListen);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_SuppDppStartListen);
 }
 
 ctrl_cmd_t * rpc_slaveif_supp_dpp_stop_listen(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_SuppDppStopListen);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_SuppDppStopListen);
 }
 #endif
 
 #if H_MEM_MONITOR
 ctrl_cmd_t * rpc_slave_iface_set_mem_monitor(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_MemMonitor);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_MemMonitor);
 }
 #endif
 
@@ -686,59 +593,64 @@ int rpc_slaveif_register_custom_callback(uint32_t msg_id_exp,
 
 ctrl_cmd_t * rpc_slaveif_custom_rpc(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_CustomRpc);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_CustomRpc);
 }
 #endif
 
 #if H_GPIO_EXPANDER_SUPPORT
 ctrl_cmd_t * rpc_slaveif_gpio_config(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_GpioConfig);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_GpioConfig);
 }
 
 ctrl_cmd_t * rpc_slaveif_gpio_reset_pin(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_GpioResetPin);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_GpioResetPin);
 }
 
 ctrl_cmd_t * rpc_slaveif_gpio_set_level(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_GpioSetLevel);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_GpioSetLevel);
 }
 
 ctrl_cmd_t * rpc_slaveif_gpio_get_level(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_GpioGetLevel);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_GpioGetLevel);
 }
 
 ctrl_cmd_t * rpc_slaveif_gpio_set_direction(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_GpioSetDirection);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_GpioSetDirection);
 }
 
 ctrl_cmd_t * rpc_slaveif_gpio_input_enable(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_GpioInputEnable);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_GpioInputEnable);
 }
 
 ctrl_cmd_t * rpc_slaveif_gpio_set_pull_mode(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_GpioSetPullMode);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_GpioSetPullMode);
 }
 #endif
 
 #if H_EXT_COEX_SUPPORT
 ctrl_cmd_t * rpc_slaveif_ext_coex(ctrl_cmd_t *req)
 {
-	RPC_SEND_REQ(RPC_ID__Req_ExtCoex);
-	RPC_DECODE_RSP_IF_NOT_ASYNC();
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_ExtCoex);
+}
+#endif
+
+#if H_NETWORK_SPLIT_ENABLED
+ctrl_cmd_t * rpc_slaveif_nw_split_port_rules(ctrl_cmd_t *req)
+{
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_NwSplitPortRules);
+}
+#endif
+
+#if H_HOST_PS_ALLOWED
+ctrl_cmd_t * rpc_slaveif_set_wake_rules(ctrl_cmd_t *req)
+{
+	RPC_SEND_REQ_AND_DECODE_RSP(RPC_ID__Req_SetWakeRules);
 }
 #endif
@@ -17,6 +17,8 @@
 #include "esp_hosted_misc_types.h"
 #include "port_esp_hosted_host_config.h"
 #include "port_esp_hosted_host_wifi_config.h"
+#include "esp_hosted_cp_nw_split.h"
+#include "esp_hosted_power_save.h"
 
 #if H_WIFI_ENTERPRISE_SUPPORT
 #include "esp_eap_client.h"
@@ -65,8 +67,6 @@ extern "C" {
 #define FAILURE_STR                          "failure"
 #define NOT_CONNECTED_STR                    "not_connected"
 
-#define RPC_RX_QUEUE_SIZE 3
-#define RPC_TX_QUEUE_SIZE 5
 
 typedef enum {
 	FEATURE_NONE,
@@ -412,6 +412,21 @@ typedef struct {
 } rpc_gpio_set_pull_mode_t;
 #endif
 
+#if H_NETWORK_SPLIT_ENABLED
+typedef struct {
+	bool replace;
+	uint16_t n_rules;
+	const esp_hosted_nw_split_port_rule_t *rules;
+} rpc_nw_split_port_rules_t;
+#endif
+
+#if H_HOST_PS_ALLOWED
+typedef struct {
+	uint8_t n_rules;
+	const esp_hosted_wake_rule_t *rules;
+} rpc_set_wake_rules_t;
+#endif
+
 #if H_EXT_COEX_SUPPORT
 typedef struct {
 	uint32_t cmd;
@@ -630,6 +645,12 @@ typedef struct Ctrl_cmd_t {
 #endif
 #if H_EXT_COEX_SUPPORT
 		rpc_ext_coex_t              ext_coex;
+#endif
+#if H_NETWORK_SPLIT_ENABLED
+		rpc_nw_split_port_rules_t   nw_split_port_rules;
+#endif
+#if H_HOST_PS_ALLOWED
+		rpc_set_wake_rules_t        set_wake_rules;
 #endif
 	}u;
 
@@ -645,6 +666,10 @@ typedef struct Ctrl_cmd_t {
 	 */
 	int (*rpc_rsp_cb)(struct Ctrl_cmd_t *data);
 
+	/* Opaque argument of rpc_rsp_cb.
+	 * Copied from the async request into the response handed to rpc_rsp_cb */
+	void *rpc_rsp_cb_arg;
+
 	/* Wait for timeout duration, if response not received,
 	 * it will send timeout response.
 	 * Default value for this time out is DEFAULT_RPC_RESP_TIMEOUT */
@@ -917,6 +942,12 @@ ctrl_cmd_t * rpc_slaveif_gpio_set_pull_mode(ctrl_cmd_t *req);
 #if H_EXT_COEX_SUPPORT
 ctrl_cmd_t * rpc_slaveif_ext_coex(ctrl_cmd_t *req);
 #endif
+#if H_NETWORK_SPLIT_ENABLED
+ctrl_cmd_t * rpc_slaveif_nw_split_port_rules(ctrl_cmd_t *req);
+#endif
+#if H_HOST_PS_ALLOWED
+ctrl_cmd_t * rpc_slaveif_set_wake_rules(ctrl_cmd_t *req);
+#endif
 #ifdef __cplusplus
 }
 #endif
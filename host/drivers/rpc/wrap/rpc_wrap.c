@@ -19,6 +19,7 @@
 #include "port_esp_hosted_host_log.h"
 #include "transport_drv.h"
 #include "esp_hosted_event.h"
+#include "rpc_mem.h"
 
 #if H_DPP_SUPPORT
 #include "esp_dpp.h"
@@ -53,7 +54,7 @@ static esp_err_t rpc_iface_feature_control(rcp_feature_control_t *feature_contro
 
 static ctrl_cmd_t * RPC_DEFAULT_REQ(void)
 {
-  ctrl_cmd_t *new_req = (ctrl_cmd_t*)g_h.funcs->_h_calloc(1, sizeof(ctrl_cmd_t));
+  ctrl_cmd_t *new_req = rpc_mem_cmd_alloc();
   assert(new_req);
   new_req->msg_type = RPC_TYPE__Req;
   new_req->rpc_rsp_cb = NULL;
@@ -71,7 +72,7 @@ static ctrl_cmd_t * RPC_DEFAULT_REQ(void)
         msg->app_free_buff_hdl = NULL;                   \
       }                                                  \
     }                                                    \
-    g_h.funcs->_h_free(msg);                             \
+    rpc_mem_cmd_free(msg);                               \
     msg = NULL;                                          \
   }                                                      \
 } while(0);
@@ -104,6 +105,160 @@ static esp_supp_dpp_event_cb_t dpp_evt_cb = NULL;
 static volatile bool netif_started = false;
 static volatile bool netif_connected = false;
 
+/* Host side cache of co-processor Wi-Fi settings
+ * Getters are served locally once a value is known. Values come from getter
+ * responses and from setters whose value reads back unchanged. Anything
+ * that may change a value on the co-processor invalidates it instead.
+ * gen is bumped on every invalidation and setter update, so a getter
+ * response racing with one of them is not stored */
+#define RPC_WIFI_CACHE_IFS                                2 /* WIFI_IF_STA, WIFI_IF_AP */
+
+enum {
+	RPC_WIFI_CACHE_MODE,
+	RPC_WIFI_CACHE_PS,
+	RPC_WIFI_CACHE_COUNTRY,
+	RPC_WIFI_CACHE_MAX_TX_POWER,
+	/* per interface entries */
+	RPC_WIFI_CACHE_MAC,
+	RPC_WIFI_CACHE_CONFIG = RPC_WIFI_CACHE_MAC + RPC_WIFI_CACHE_IFS,
+	RPC_WIFI_CACHE_BANDWIDTH = RPC_WIFI_CACHE_CONFIG + RPC_WIFI_CACHE_IFS,
+	RPC_WIFI_CACHE_PROTOCOL = RPC_WIFI_CACHE_BANDWIDTH + RPC_WIFI_CACHE_IFS,
+	RPC_WIFI_CACHE_MAX = RPC_WIFI_CACHE_PROTOCOL + RPC_WIFI_CACHE_IFS,
+};
+
+#define RPC_WIFI_CACHE_BIT(e)                             (1UL << (e))
+#define RPC_WIFI_CACHE_IF_BITS(e)                         (RPC_WIFI_CACHE_BIT(e) | RPC_WIFI_CACHE_BIT((e) + 1))
+#define RPC_WIFI_CACHE_ALL                                (RPC_WIFI_CACHE_BIT(RPC_WIFI_CACHE_MAX) - 1)
+/* values that may change with association or channel */
+#define RPC_WIFI_CACHE_LINK                               (RPC_WIFI_CACHE_BIT(RPC_WIFI_CACHE_COUNTRY) |      \
+                                                           RPC_WIFI_CACHE_BIT(RPC_WIFI_CACHE_MAX_TX_POWER) | \
+                                                           RPC_WIFI_CACHE_BIT(RPC_WIFI_CACHE_CONFIG + WIFI_IF_STA) | \
+                                                           RPC_WIFI_CACHE_IF_BITS(RPC_WIFI_CACHE_BANDWIDTH))
+/* values depending on band, protocol and bandwidth settings */
+#define RPC_WIFI_CACHE_PHY                                (RPC_WIFI_CACHE_IF_BITS(RPC_WIFI_CACHE_BANDWIDTH) | \
+                                                           RPC_WIFI_CACHE_IF_BITS(RPC_WIFI_CACHE_PROTOCOL))
+
+/* entry for interface ifx, -1 if not cached */
+static inline int rpc_wifi_cache_if(int entry, wifi_interface_t ifx)
+{
+	return ((int)ifx >= 0 && (int)ifx < RPC_WIFI_CACHE_IFS) ? entry + (int)ifx : -1;
+}
+
+#if H_RPC_WIFI_CACHE
+static struct {
+	void *lock;
+	uint32_t valid;
+	uint32_t gen;
+	uint32_t hits;
+	uint32_t misses;
+	wifi_mode_t mode;
+	wifi_ps_type_t ps;
+	wifi_country_t country;
+	int8_t max_tx_power;
+	uint8_t mac[RPC_WIFI_CACHE_IFS][BSSID_BYTES_SIZE];
+	wifi_config_t config[RPC_WIFI_CACHE_IFS];
+	wifi_bandwidth_t bandwidth[RPC_WIFI_CACHE_IFS];
+	uint8_t protocol[RPC_WIFI_CACHE_IFS];
+} rpc_wifi_cache;
+
+#define RPC_WIFI_CACHE_VAL(field)                         { &rpc_wifi_cache.field, sizeof(rpc_wifi_cache.field) }
+
+static const struct {
+	void *val;
+	size_t len;
+} rpc_wifi_cache_vals[RPC_WIFI_CACHE_MAX] = {
+	[RPC_WIFI_CACHE_MODE]                     = RPC_WIFI_CACHE_VAL(mode),
+	[RPC_WIFI_CACHE_PS]                       = RPC_WIFI_CACHE_VAL(ps),
+	[RPC_WIFI_CACHE_COUNTRY]                  = RPC_WIFI_CACHE_VAL(country),
+	[RPC_WIFI_CACHE_MAX_TX_POWER]             = RPC_WIFI_CACHE_VAL(max_tx_power),
+	[RPC_WIFI_CACHE_MAC + WIFI_IF_STA]        = RPC_WIFI_CACHE_VAL(mac[WIFI_IF_STA]),
+	[RPC_WIFI_CACHE_MAC + WIFI_IF_AP]         = RPC_WIFI_CACHE_VAL(mac[WIFI_IF_AP]),
+	[RPC_WIFI_CACHE_CONFIG + WIFI_IF_STA]     = RPC_WIFI_CACHE_VAL(config[WIFI_IF_STA]),
+	[RPC_WIFI_CACHE_CONFIG + WIFI_IF_AP]      = RPC_WIFI_CACHE_VAL(config[WIFI_IF_AP]),
+	[RPC_WIFI_CACHE_BANDWIDTH + WIFI_IF_STA]  = RPC_WIFI_CACHE_VAL(bandwidth[WIFI_IF_STA]),
+	[RPC_WIFI_CACHE_BANDWIDTH + WIFI_IF_AP]   = RPC_WIFI_CACHE_VAL(bandwidth[WIFI_IF_AP]),
+	[RPC_WIFI_CACHE_PROTOCOL + WIFI_IF_STA]   = RPC_WIFI_CACHE_VAL(protocol[WIFI_IF_STA]),
+	[RPC_WIFI_CACHE_PROTOCOL + WIFI_IF_AP]    = RPC_WIFI_CACHE_VAL(protocol[WIFI_IF_AP]),
+};
+
+/* Copy cached value of entry to val. Returns true on hit */
+static bool rpc_wifi_cache_get(int entry, void *val)
+{
+	bool hit = false;
+
+	if ((entry < 0) || !rpc_wifi_cache.lock)
+		return false;
+
+	g_h.funcs->_h_lock_mutex(rpc_wifi_cache.lock, HOSTED_BLOCK_MAX);
+	if (rpc_wifi_cache.valid & RPC_WIFI_CACHE_BIT(entry)) {
+		g_h.funcs->_h_memcpy(val, rpc_wifi_cache_vals[entry].val, rpc_wifi_cache_vals[entry].len);
+		hit = true;
+		rpc_wifi_cache.hits++;
+	} else {
+		rpc_wifi_cache.misses++;
+	}
+	g_h.funcs->_h_unlock_mutex(rpc_wifi_cache.lock);
+
+	return hit;
+}
+
+/* Read before sending a getter request, pass to rpc_wifi_cache_put() */
+static uint32_t rpc_wifi_cache_gen(void)
+{
+	return __atomic_load_n(&rpc_wifi_cache.gen, __ATOMIC_ACQUIRE);
+}
+
+/* Store a getter response, unless the cache changed since gen was read */
+static void rpc_wifi_cache_put(int entry, const void *val, uint32_t gen)
+{
+	if ((entry < 0) || !rpc_wifi_cache.lock)
+		return;
+
+	g_h.funcs->_h_lock_mutex(rpc_wifi_cache.lock, HOSTED_BLOCK_MAX);
+	if (rpc_wifi_cache.gen == gen) {
+		g_h.funcs->_h_memcpy(rpc_wifi_cache_vals[entry].val, val, rpc_wifi_cache_vals[entry].len);
+		rpc_wifi_cache.valid |= RPC_WIFI_CACHE_BIT(entry);
+	}
+	g_h.funcs->_h_unlock_mutex(rpc_wifi_cache.lock);
+}
+
+/* Store the value of a successful setter */
+static void rpc_wifi_cache_set(int entry, const void *val)
+{
+	if ((entry < 0) || !rpc_wifi_cache.lock)
+		return;
+
+	g_h.funcs->_h_lock_mutex(rpc_wifi_cache.lock, HOSTED_BLOCK_MAX);
+	g_h.funcs->_h_memcpy(rpc_wifi_cache_vals[entry].val, val, rpc_wifi_cache_vals[entry].len);
+	rpc_wifi_cache.valid |= RPC_WIFI_CACHE_BIT(entry);
+	__atomic_add_fetch(&rpc_wifi_cache.gen, 1, __ATOMIC_RELEASE);
+	g_h.funcs->_h_unlock_mutex(rpc_wifi_cache.lock);
+}
+
+static void rpc_wifi_cache_invalidate(uint32_t mask)
+{
+	if (!rpc_wifi_cache.lock)
+		return;
+
+	g_h.funcs->_h_lock_mutex(rpc_wifi_cache.lock, HOSTED_BLOCK_MAX);
+	rpc_wifi_cache.valid &= ~mask;
+	__atomic_add_fetch(&rpc_wifi_cache.gen, 1, __ATOMIC_RELEASE);
+	g_h.funcs->_h_unlock_mutex(rpc_wifi_cache.lock);
+}
+
+void rpc_wifi_cache_get_stats(struct rpc_wifi_cache_stats *stats)
+{
+	stats->hits = rpc_wifi_cache.hits;
+	stats->misses = rpc_wifi_cache.misses;
+}
+#else
+static inline bool rpc_wifi_cache_get(int entry, void *val) { return false; }
+static inline uint32_t rpc_wifi_cache_gen(void) { return 0; }
+static inline void rpc_wifi_cache_put(int entry, const void *val, uint32_t gen) { }
+static inline void rpc_wifi_cache_set(int entry, const void *val) { }
+static inline void rpc_wifi_cache_invalidate(uint32_t mask) { }
+#endif
+
 typedef struct {
 	int event;
 	rpc_rsp_cb_t fun;
@@ -112,6 +267,13 @@ typedef struct {
 int rpc_init(void)
 {
 	ESP_LOGD(TAG, "%s", __func__);
+#if H_RPC_WIFI_CACHE
+	if (!rpc_wifi_cache.lock) {
+		rpc_wifi_cache.lock = g_h.funcs->_h_create_mutex();
+		if (!rpc_wifi_cache.lock)
+			ESP_LOGW(TAG, "Failed to create Wi-Fi cache mutex, cache disabled");
+	}
+#endif
 	return rpc_slaveif_init();
 }
 
@@ -120,18 +282,29 @@ int rpc_start(void)
 	ESP_LOGD(TAG, "%s", __func__);
 	netif_started = false;
 	netif_connected = false;
+	rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_ALL);
 	return rpc_slaveif_start();
 }
 
 int rpc_stop(void)
 {
 	ESP_LOGD(TAG, "%s", __func__);
+	rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_ALL);
 	return rpc_slaveif_stop();
 }
 
 int rpc_deinit(void)
 {
 	ESP_LOGD(TAG, "%s", __func__);
+#if H_RPC_WIFI_CACHE
+	if (rpc_wifi_cache.lock) {
+		void *lock = rpc_wifi_cache.lock;
+
+		rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_ALL);
+		rpc_wifi_cache.lock = NULL;
+		g_h.funcs->_h_destroy_mutex(lock);
+	}
+#endif
 	return rpc_slaveif_deinit();
 }
 
@@ -163,6 +336,7 @@ static int rpc_event_callback(ctrl_cmd_t * app_event)
 
 		case RPC_ID__Event_ESPInit: {
 			ESP_LOGI(TAG, "Coprocessor Boot-up");
+			rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_ALL);
 			esp_hosted_event_init_t event = { 0 };
 			event.reason = app_event->u.e_init.cp_reset_reason;
 			g_h.funcs->_h_event_post(ESP_HOSTED_EVENT, ESP_HOSTED_EVENT_CP_INIT,
@@ -195,6 +369,7 @@ static int rpc_event_callback(ctrl_cmd_t * app_event)
 
 			wifi_event_sta_connected_t *p_e = &app_event->u.e_wifi_sta_connected;
 
+			rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_LINK);
 			if (!netif_connected && netif_started) {
 				g_h.funcs->_h_event_wifi_post(WIFI_EVENT_STA_CONNECTED,
 					p_e, sizeof(wifi_event_sta_connected_t), HOSTED_BLOCK_MAX);
@@ -204,6 +379,7 @@ static int rpc_event_callback(ctrl_cmd_t * app_event)
 		} case RPC_ID__Event_StaDisconnected: {
 			ESP_LOGI(TAG, "ESP Event: Station mode: Disconnected");
 			wifi_event_sta_disconnected_t *p_e = &app_event->u.e_wifi_sta_disconnected;
+			rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_LINK);
 			g_h.funcs->_h_event_wifi_post(WIFI_EVENT_STA_DISCONNECTED,
 				p_e, sizeof(wifi_event_sta_disconnected_t), HOSTED_BLOCK_MAX);
 			netif_connected = false;
@@ -306,6 +482,12 @@ static int rpc_event_callback(ctrl_cmd_t * app_event)
 		} case RPC_ID__Event_WifiEventNoArgs: {
 			int wifi_event_id = app_event->u.e_wifi_simple.wifi_event_id;
 
+			if ((wifi_event_id == WIFI_EVENT_STA_START) || (wifi_event_id == WIFI_EVENT_STA_STOP) ||
+			    (wifi_event_id == WIFI_EVENT_AP_START) || (wifi_event_id == WIFI_EVENT_AP_STOP))
+				rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_ALL);
+			else if (wifi_event_id == WIFI_EVENT_HOME_CHANNEL_CHANGE)
+				rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_LINK);
+
 			switch (wifi_event_id) {
 
 			case WIFI_EVENT_STA_START:
@@ -754,6 +936,12 @@ int rpc_rsp_callback(ctrl_cmd_t * app_resp)
 #if H_EXT_COEX_SUPPORT
 	case RPC_ID__Resp_ExtCoex:
 #endif
+#if H_NETWORK_SPLIT_ENABLED
+	case RPC_ID__Resp_NwSplitPortRules:
+#endif
+#if H_HOST_PS_ALLOWED
+	case RPC_ID__Resp_SetWakeRules:
+#endif
 
 	case RPC_ID__Resp_GetCoprocessorFwVersion:
 									 {
@@ -800,6 +988,9 @@ int rpc_set_wifi_mode(wifi_mode_t mode)
 	req->u.wifi_mode.mode = mode;
 	resp = rpc_slaveif_wifi_set_mode(req);
 
+	if (resp && resp->resp_event_status == SUCCESS)
+		rpc_wifi_cache_set(RPC_WIFI_CACHE_MODE, &mode);
+
 	return rpc_rsp_callback(resp);
 }
 
@@ -829,7 +1020,11 @@ int rpc_wifi_get_mac(wifi_interface_t mode, uint8_t out_mac[6])
 		return ESP_ERR_INVALID_ARG;
 	}
 
+	if (rpc_wifi_cache_get(rpc_wifi_cache_if(RPC_WIFI_CACHE_MAC, mode), out_mac))
+		return ESP_OK;
+
 	ctrl_cmd_t *resp = NULL;
+	uint32_t cache_gen = rpc_wifi_cache_gen();
 
 	/* implemented synchronous */
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
@@ -840,6 +1035,7 @@ int rpc_wifi_get_mac(wifi_interface_t mode, uint8_t out_mac[6])
 	if (resp && resp->resp_event_status == SUCCESS) {
 
 		g_h.funcs->_h_memcpy(out_mac, resp->u.wifi_mac.mac, BSSID_BYTES_SIZE);
+		rpc_wifi_cache_put(rpc_wifi_cache_if(RPC_WIFI_CACHE_MAC, mode), out_mac, cache_gen);
 		ESP_LOGD(TAG, "%s mac address is [" MACSTR "]",
 			mode==WIFI_IF_STA? "sta":"ap", MAC2STR(out_mac));
 	}
@@ -870,6 +1066,8 @@ int rpc_wifi_set_mac(wifi_interface_t mode, const uint8_t mac[6])
 	g_h.funcs->_h_memcpy(req->u.wifi_mac.mac, mac, BSSID_BYTES_SIZE);
 
 	resp = rpc_slaveif_wifi_set_mac(req);
+	if (resp && resp->resp_event_status == SUCCESS)
+		rpc_wifi_cache_set(rpc_wifi_cache_if(RPC_WIFI_CACHE_MAC, mode), mac);
 	return rpc_rsp_callback(resp);
 }
 
@@ -996,6 +1194,9 @@ int rpc_wifi_set_max_tx_power(int8_t in_power)
 	req->u.wifi_tx_power.power = in_power;
 	resp = rpc_slaveif_wifi_set_max_tx_power(req);
 
+	/* co-processor rounds the power: read back on next get */
+	rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_BIT(RPC_WIFI_CACHE_MAX_TX_POWER));
+
 	return rpc_rsp_callback(resp);
 }
 
@@ -1004,13 +1205,18 @@ int rpc_wifi_get_max_tx_power(int8_t *power)
 	if (!power)
 		return ESP_ERR_INVALID_ARG;
 
+	if (rpc_wifi_cache_get(RPC_WIFI_CACHE_MAX_TX_POWER, power))
+		return ESP_OK;
+
 	/* implemented synchronous */
+	uint32_t cache_gen = rpc_wifi_cache_gen();
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
 	resp = rpc_slaveif_wifi_get_max_tx_power(req);
 	if (resp && resp->resp_event_status == SUCCESS) {
 		*power = resp->u.wifi_tx_power.power;
+		rpc_wifi_cache_put(RPC_WIFI_CACHE_MAX_TX_POWER, power, cache_gen);
 	}
 	return rpc_rsp_callback(resp);
 }
@@ -1197,6 +1403,7 @@ esp_err_t rpc_wifi_set_band(wifi_band_t band)
 
 	req->u.wifi_band = band;
 	resp = rpc_slaveif_wifi_set_band(req);
+	rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_PHY);
 
 	return rpc_rsp_callback(resp);
 }
@@ -1225,6 +1432,7 @@ esp_err_t rpc_wifi_set_band_mode(wifi_band_mode_t band_mode)
 
 	req->u.wifi_band_mode = band_mode;
 	resp = rpc_slaveif_wifi_set_band_mode(req);
+	rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_PHY);
 
 	return rpc_rsp_callback(resp);
 }
@@ -1259,6 +1467,7 @@ esp_err_t rpc_wifi_set_protocols(wifi_interface_t ifx, wifi_protocols_t *protoco
 	req->u.wifi_protocols.ghz_5g = protocols->ghz_5g;
 
 	resp = rpc_slaveif_wifi_set_protocols(req);
+	rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_PHY);
 	return rpc_rsp_callback(resp);
 }
 
@@ -1295,6 +1504,7 @@ esp_err_t rpc_wifi_set_bandwidths(wifi_interface_t ifx, wifi_bandwidths_t *bw)
 	req->u.wifi_bandwidths.ghz_5g = bw->ghz_5g;
 
 	resp = rpc_slaveif_wifi_set_bandwidths(req);
+	rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_PHY);
 	return rpc_rsp_callback(resp);
 }
 
@@ -1360,6 +1570,7 @@ int rpc_wifi_init(const wifi_init_config_t *arg)
 	req->u.wifi_init_config.nvs_enable = YES;
 #endif
 	resp = rpc_slaveif_wifi_init(req);
+	rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_ALL);
 
 	return rpc_rsp_callback(resp);
 }
@@ -1371,6 +1582,7 @@ int rpc_wifi_deinit(void)
 	ctrl_cmd_t *resp = NULL;
 
 	resp = rpc_slaveif_wifi_deinit(req);
+	rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_ALL);
 	return rpc_rsp_callback(resp);
 }
 
@@ -1384,7 +1596,11 @@ int rpc_wifi_get_mode(wifi_mode_t* mode)
 	if (!mode)
 		return ESP_ERR_INVALID_ARG;
 
+	if (rpc_wifi_cache_get(RPC_WIFI_CACHE_MODE, mode))
+		return ESP_OK;
+
 	/* implemented synchronous */
+	uint32_t cache_gen = rpc_wifi_cache_gen();
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
@@ -1392,6 +1608,7 @@ int rpc_wifi_get_mode(wifi_mode_t* mode)
 
 	if (resp && resp->resp_event_status == SUCCESS) {
 		*mode = resp->u.wifi_mode.mode;
+		rpc_wifi_cache_put(RPC_WIFI_CACHE_MODE, mode, cache_gen);
 	}
 
 	return rpc_rsp_callback(resp);
@@ -1467,6 +1684,9 @@ int rpc_wifi_set_config(wifi_interface_t interface, wifi_config_t *conf)
 
 	req->u.wifi_config.iface = interface;
 	resp = rpc_slaveif_wifi_set_config(req);
+
+	/* co-processor may adjust the config: read back on next get */
+	rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_IF_BITS(RPC_WIFI_CACHE_CONFIG));
 	return rpc_rsp_callback(resp);
 }
 
@@ -1475,7 +1695,11 @@ int rpc_wifi_get_config(wifi_interface_t interface, wifi_config_t *conf)
 	if (!conf)
 		return ESP_ERR_INVALID_ARG;
 
+	if (rpc_wifi_cache_get(rpc_wifi_cache_if(RPC_WIFI_CACHE_CONFIG, interface), conf))
+		return ESP_OK;
+
 	/* implemented synchronous */
+	uint32_t cache_gen = rpc_wifi_cache_gen();
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
@@ -1485,6 +1709,7 @@ int rpc_wifi_get_config(wifi_interface_t interface, wifi_config_t *conf)
 
 	if (resp && resp->resp_event_status == SUCCESS) {
 		g_h.funcs->_h_memcpy(conf, &resp->u.wifi_config.u, sizeof(wifi_config_t));
+		rpc_wifi_cache_put(rpc_wifi_cache_if(RPC_WIFI_CACHE_CONFIG, interface), conf, cache_gen);
 	}
 
 	return rpc_rsp_callback(resp);
@@ -1636,6 +1861,7 @@ int rpc_wifi_restore(void)
 	ctrl_cmd_t *resp = NULL;
 
 	resp = rpc_slaveif_wifi_restore(req);
+	rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_ALL);
 	return rpc_rsp_callback(resp);
 }
 
@@ -1691,6 +1917,9 @@ int rpc_wifi_set_ps(wifi_ps_type_t type)
 
 	resp = rpc_slaveif_wifi_set_ps(req);
 
+	if (resp && resp->resp_event_status == SUCCESS)
+		rpc_wifi_cache_set(RPC_WIFI_CACHE_PS, &type);
+
 	return rpc_rsp_callback(resp);
 }
 
@@ -1699,13 +1928,20 @@ int rpc_wifi_get_ps(wifi_ps_type_t *type)
 	if (!type)
 		return ESP_ERR_INVALID_ARG;
 
+	if (rpc_wifi_cache_get(RPC_WIFI_CACHE_PS, type))
+		return ESP_OK;
+
 	/* implemented synchronous */
+	uint32_t cache_gen = rpc_wifi_cache_gen();
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
 	resp = rpc_slaveif_wifi_get_ps(req);
 
-	*type = resp->u.wifi_ps.ps_mode;
+	if (resp && resp->resp_event_status == SUCCESS) {
+		*type = resp->u.wifi_ps.ps_mode;
+		rpc_wifi_cache_put(RPC_WIFI_CACHE_PS, type, cache_gen);
+	}
 
 	return rpc_rsp_callback(resp);
 }
@@ -1730,6 +1966,8 @@ int rpc_wifi_set_bandwidth(wifi_interface_t ifx, wifi_bandwidth_t bw)
 	req->u.wifi_bandwidth.ifx = ifx;
 	req->u.wifi_bandwidth.bw = bw;
 	resp = rpc_slaveif_wifi_set_bandwidth(req);
+	if (resp && resp->resp_event_status == SUCCESS)
+		rpc_wifi_cache_set(rpc_wifi_cache_if(RPC_WIFI_CACHE_BANDWIDTH, ifx), &bw);
 	return rpc_rsp_callback(resp);
 }
 
@@ -1738,7 +1976,11 @@ int rpc_wifi_get_bandwidth(wifi_interface_t ifx, wifi_bandwidth_t *bw)
 	if (!bw)
 		return ESP_ERR_INVALID_ARG;
 
+	if (rpc_wifi_cache_get(rpc_wifi_cache_if(RPC_WIFI_CACHE_BANDWIDTH, ifx), bw))
+		return ESP_OK;
+
 	/* implemented synchronous */
+	uint32_t cache_gen = rpc_wifi_cache_gen();
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
@@ -1747,6 +1989,7 @@ int rpc_wifi_get_bandwidth(wifi_interface_t ifx, wifi_bandwidth_t *bw)
 
 	if (resp && resp->resp_event_status == SUCCESS) {
 		*bw = resp->u.wifi_bandwidth.bw;
+		rpc_wifi_cache_put(rpc_wifi_cache_if(RPC_WIFI_CACHE_BANDWIDTH, ifx), bw, cache_gen);
 	}
 	return rpc_rsp_callback(resp);
 }
@@ -1793,6 +2036,8 @@ int rpc_wifi_set_country_code(const char *country, bool ieee80211d_enabled)
 	memcpy(&req->u.wifi_country_code.cc[0], country, sizeof(req->u.wifi_country_code.cc));
 	req->u.wifi_country_code.ieee80211d_enabled = ieee80211d_enabled;
 	resp = rpc_slaveif_wifi_set_country_code(req);
+	rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_BIT(RPC_WIFI_CACHE_COUNTRY) |
+			RPC_WIFI_CACHE_BIT(RPC_WIFI_CACHE_MAX_TX_POWER));
 	return rpc_rsp_callback(resp);
 }
 
@@ -1829,6 +2074,8 @@ int rpc_wifi_set_country(const wifi_country_t *country)
 	req->u.wifi_country.policy       = country->policy;
 
 	resp = rpc_slaveif_wifi_set_country(req);
+	rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_BIT(RPC_WIFI_CACHE_COUNTRY) |
+			RPC_WIFI_CACHE_BIT(RPC_WIFI_CACHE_MAX_TX_POWER));
 	return rpc_rsp_callback(resp);
 }
 
@@ -1837,7 +2084,11 @@ int rpc_wifi_get_country(wifi_country_t *country)
 	if (!country)
 		return ESP_ERR_INVALID_ARG;
 
+	if (rpc_wifi_cache_get(RPC_WIFI_CACHE_COUNTRY, country))
+		return ESP_OK;
+
 	/* implemented synchronous */
+	uint32_t cache_gen = rpc_wifi_cache_gen();
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
@@ -1848,6 +2099,7 @@ int rpc_wifi_get_country(wifi_country_t *country)
 		country->nchan        = resp->u.wifi_country.nchan;
 		country->max_tx_power = resp->u.wifi_country.max_tx_power;
 		country->policy       = resp->u.wifi_country.policy;
+		rpc_wifi_cache_put(RPC_WIFI_CACHE_COUNTRY, country, cache_gen);
 	}
 	return rpc_rsp_callback(resp);
 }
@@ -1917,6 +2169,311 @@ int rpc_wifi_sta_get_rssi(int *rssi)
 	return rpc_rsp_callback(resp);
 }
 
+/* Async requests
+ * A completion record is attached to the request through rpc_rsp_cb_arg.
+ * RPC core calls rpc_async_rsp_handler exactly once per request, with the
+ * response or a failed response on timeout, send failure or deinit.
+ * state decides between completion and cancellation, refs keeps the record
+ * alive for the completion path and the application handle, if any */
+#define RPC_ASYNC_PENDING                                 0
+#define RPC_ASYNC_COMPLETING                              1
+#define RPC_ASYNC_DONE                                    2
+#define RPC_ASYNC_CANCELLED                               3
+
+struct esp_hosted_async_req {
+	uint8_t state;
+	uint8_t refs;
+	esp_err_t result;
+	void *out;
+	esp_hosted_async_cb_t cb;
+	void *cb_arg;
+};
+
+static void rpc_async_put(esp_hosted_async_handle_t h)
+{
+	if (!__atomic_sub_fetch(&h->refs, 1, __ATOMIC_ACQ_REL))
+		g_h.funcs->_h_free(h);
+}
+
+static void rpc_async_copy_out(ctrl_cmd_t *resp, void *out)
+{
+	if (resp->resp_event_status != SUCCESS)
+		return;
+
+	switch (resp->msg_id) {
+	case RPC_ID__Resp_SetWifiMode:
+		rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_BIT(RPC_WIFI_CACHE_MODE));
+		break;
+	case RPC_ID__Resp_WifiSetConfig:
+		rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_IF_BITS(RPC_WIFI_CACHE_CONFIG));
+		break;
+	case RPC_ID__Resp_GetWifiMode:
+		if (out)
+			*(wifi_mode_t *)out = resp->u.wifi_mode.mode;
+		break;
+	case RPC_ID__Resp_WifiGetConfig:
+		if (out)
+			g_h.funcs->_h_memcpy(out, &resp->u.wifi_config.u, sizeof(wifi_config_t));
+		break;
+	case RPC_ID__Resp_WifiStaGetApInfo:
+		if (out)
+			g_h.funcs->_h_memcpy(out, resp->u.wifi_scan_ap_list.out_list,
+					sizeof(wifi_ap_record_t));
+		break;
+	case RPC_ID__Resp_WifiStaGetRssi:
+		if (out)
+			*(int *)out = resp->u.wifi_sta_get_rssi.rssi;
+		break;
+	default:
+		break;
+	}
+}
+
+static int rpc_async_rsp_handler(ctrl_cmd_t *app_resp)
+{
+	esp_hosted_async_handle_t h = app_resp->rpc_rsp_cb_arg;
+	uint8_t expected = RPC_ASYNC_PENDING;
+	esp_err_t result = ESP_FAIL;
+
+	if (!__atomic_compare_exchange_n(&h->state, &expected, RPC_ASYNC_COMPLETING,
+			false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+		/* cancelled: application no longer expects anything */
+		CLEANUP_RPC(app_resp);
+		rpc_async_put(h);
+		return SUCCESS;
+	}
+
+	rpc_async_copy_out(app_resp, h->out);
+	if (app_resp->resp_event_status == RPC_ERR_REQUEST_TIMEOUT) {
+		CLEANUP_RPC(app_resp);
+		result = ESP_ERR_TIMEOUT;
+	} else {
+		result = rpc_rsp_callback(app_resp);
+	}
+
+	h->result = result;
+	__atomic_store_n(&h->state, RPC_ASYNC_DONE, __ATOMIC_RELEASE);
+
+	if (h->cb)
+		h->cb(h, result, h->cb_arg);
+
+	rpc_async_put(h);
+	return SUCCESS;
+}
+
+/* Make req async. Frees req if out of memory */
+static esp_err_t rpc_async_attach(ctrl_cmd_t *req, void *out,
+		esp_hosted_async_cb_t cb, void *cb_arg, esp_hosted_async_handle_t *handle)
+{
+	esp_hosted_async_handle_t h = g_h.funcs->_h_calloc(1, sizeof(struct esp_hosted_async_req));
+
+	if (!h) {
+		ESP_LOGE(TAG, "%s, Failed to allocate memory", __func__);
+		CLEANUP_RPC(req);
+		return ESP_ERR_NO_MEM;
+	}
+
+	h->state = RPC_ASYNC_PENDING;
+	h->refs = handle ? 2 : 1;
+	h->out = out;
+	h->cb = cb;
+	h->cb_arg = cb_arg;
+
+	/* set before sending: completion may run before the send returns */
+	if (handle)
+		*handle = h;
+
+	req->rpc_rsp_cb = rpc_async_rsp_handler;
+	req->rpc_rsp_cb_arg = h;
+	return ESP_OK;
+}
+
+esp_err_t rpc_async_poll(esp_hosted_async_handle_t handle, esp_err_t *result)
+{
+	if (!handle)
+		return ESP_ERR_INVALID_ARG;
+
+	switch (__atomic_load_n(&handle->state, __ATOMIC_ACQUIRE)) {
+	case RPC_ASYNC_DONE:
+		if (result)
+			*result = handle->result;
+		return ESP_OK;
+	case RPC_ASYNC_CANCELLED:
+		if (result)
+			*result = ESP_ERR_INVALID_STATE;
+		return ESP_OK;
+	default:
+		return ESP_ERR_NOT_FINISHED;
+	}
+}
+
+esp_err_t rpc_async_cancel(esp_hosted_async_handle_t handle)
+{
+	uint8_t expected = RPC_ASYNC_PENDING;
+
+	if (!handle)
+		return ESP_ERR_INVALID_ARG;
+
+	if (!__atomic_compare_exchange_n(&handle->state, &expected, RPC_ASYNC_CANCELLED,
+			false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+		return ESP_ERR_INVALID_STATE;
+
+	return ESP_OK;
+}
+
+void rpc_async_release(esp_hosted_async_handle_t handle)
+{
+	if (handle)
+		rpc_async_put(handle);
+}
+
+esp_err_t rpc_async_wifi_set_mode(wifi_mode_t mode,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle)
+{
+	/* implemented asynchronous */
+	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
+
+	if (rpc_async_attach(req, NULL, cb, arg, handle))
+		return ESP_ERR_NO_MEM;
+
+	req->u.wifi_mode.mode = mode;
+	rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_BIT(RPC_WIFI_CACHE_MODE));
+	rpc_slaveif_wifi_set_mode(req);
+	return ESP_OK;
+}
+
+esp_err_t rpc_async_wifi_get_mode(wifi_mode_t *mode,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle)
+{
+	if (!mode)
+		return ESP_ERR_INVALID_ARG;
+
+	/* implemented asynchronous */
+	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
+
+	if (rpc_async_attach(req, mode, cb, arg, handle))
+		return ESP_ERR_NO_MEM;
+
+	rpc_slaveif_wifi_get_mode(req);
+	return ESP_OK;
+}
+
+esp_err_t rpc_async_wifi_set_config(wifi_interface_t interface, const wifi_config_t *conf,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle)
+{
+	if (!conf)
+		return ESP_ERR_INVALID_ARG;
+
+	/* implemented asynchronous */
+	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
+
+	if (rpc_async_attach(req, NULL, cb, arg, handle))
+		return ESP_ERR_NO_MEM;
+
+	g_h.funcs->_h_memcpy(&req->u.wifi_config.u, conf, sizeof(wifi_config_t));
+	req->u.wifi_config.iface = interface;
+	rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_IF_BITS(RPC_WIFI_CACHE_CONFIG));
+	rpc_slaveif_wifi_set_config(req);
+	return ESP_OK;
+}
+
+esp_err_t rpc_async_wifi_get_config(wifi_interface_t interface, wifi_config_t *conf,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle)
+{
+	if (!conf)
+		return ESP_ERR_INVALID_ARG;
+
+	/* implemented asynchronous */
+	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
+
+	if (rpc_async_attach(req, conf, cb, arg, handle))
+		return ESP_ERR_NO_MEM;
+
+	req->u.wifi_config.iface = interface;
+	rpc_slaveif_wifi_get_config(req);
+	return ESP_OK;
+}
+
+esp_err_t rpc_async_wifi_connect(esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle)
+{
+	/* implemented asynchronous */
+	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
+
+	if (rpc_async_attach(req, NULL, cb, arg, handle))
+		return ESP_ERR_NO_MEM;
+
+	rpc_slaveif_wifi_connect(req);
+	return ESP_OK;
+}
+
+esp_err_t rpc_async_wifi_disconnect(esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle)
+{
+	/* implemented asynchronous */
+	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
+
+	if (rpc_async_attach(req, NULL, cb, arg, handle))
+		return ESP_ERR_NO_MEM;
+
+	rpc_slaveif_wifi_disconnect(req);
+	return ESP_OK;
+}
+
+esp_err_t rpc_async_wifi_scan_start(const wifi_scan_config_t *config, bool block,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle)
+{
+	// don't check: config can be NULL
+
+	/* implemented asynchronous */
+	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
+
+	if (rpc_async_attach(req, NULL, cb, arg, handle))
+		return ESP_ERR_NO_MEM;
+
+	if (config) {
+		g_h.funcs->_h_memcpy(&req->u.wifi_scan_config.cfg, config, sizeof(wifi_scan_config_t));
+		req->u.wifi_scan_config.cfg_set = 1;
+	}
+
+	req->u.wifi_scan_config.block = block;
+	if (req->u.wifi_scan_config.block)
+		req->rsp_timeout_sec = DEFAULT_RPC_RSP_SCAN_TIMEOUT;
+
+	rpc_slaveif_wifi_scan_start(req);
+	return ESP_OK;
+}
+
+esp_err_t rpc_async_wifi_sta_get_ap_info(wifi_ap_record_t *ap_info,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle)
+{
+	if (!ap_info)
+		return ESP_ERR_INVALID_ARG;
+
+	/* implemented asynchronous */
+	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
+
+	if (rpc_async_attach(req, ap_info, cb, arg, handle))
+		return ESP_ERR_NO_MEM;
+
+	rpc_slaveif_wifi_sta_get_ap_info(req);
+	return ESP_OK;
+}
+
+esp_err_t rpc_async_wifi_sta_get_rssi(int *rssi,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle)
+{
+	if (!rssi)
+		return ESP_ERR_INVALID_ARG;
+
+	/* implemented asynchronous */
+	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
+
+	if (rpc_async_attach(req, rssi, cb, arg, handle))
+		return ESP_ERR_NO_MEM;
+
+	rpc_slaveif_wifi_sta_get_rssi(req);
+	return ESP_OK;
+}
+
 int rpc_wifi_set_protocol(wifi_interface_t ifx, uint8_t protocol_bitmap)
 {
 	/* implemented synchronous */
@@ -1927,6 +2484,11 @@ int rpc_wifi_set_protocol(wifi_interface_t ifx, uint8_t protocol_bitmap)
 	req->u.wifi_protocol.protocol_bitmap = protocol_bitmap;
 
 	resp = rpc_slaveif_wifi_set_protocol(req);
+	if (resp && resp->resp_event_status == SUCCESS) {
+		/* protocol limits the bandwidth */
+		rpc_wifi_cache_invalidate(RPC_WIFI_CACHE_IF_BITS(RPC_WIFI_CACHE_BANDWIDTH));
+		rpc_wifi_cache_set(rpc_wifi_cache_if(RPC_WIFI_CACHE_PROTOCOL, ifx), &protocol_bitmap);
+	}
 	return rpc_rsp_callback(resp);
 }
 
@@ -1935,13 +2497,19 @@ int rpc_wifi_get_protocol(wifi_interface_t ifx, uint8_t *protocol_bitmap)
 	if (!protocol_bitmap)
 		return ESP_ERR_INVALID_ARG;
 
+	if (rpc_wifi_cache_get(rpc_wifi_cache_if(RPC_WIFI_CACHE_PROTOCOL, ifx), protocol_bitmap))
+		return ESP_OK;
+
 	/* implemented synchronous */
+	uint32_t cache_gen = rpc_wifi_cache_gen();
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
+	req->u.wifi_protocol.ifx = ifx;
 	resp = rpc_slaveif_wifi_get_protocol(req);
 	if (resp && resp->resp_event_status == SUCCESS) {
 		*protocol_bitmap = resp->u.wifi_protocol.protocol_bitmap;
+		rpc_wifi_cache_put(rpc_wifi_cache_if(RPC_WIFI_CACHE_PROTOCOL, ifx), protocol_bitmap, cache_gen);
 	}
 
 	return rpc_rsp_callback(resp);
@@ -2857,6 +3425,47 @@ esp_err_t esp_hosted_cp_ext_coex_disable(void)
 
 #endif
 
+#if H_NETWORK_SPLIT_ENABLED
+esp_err_t esp_hosted_cp_nw_split_set_port_rules(const esp_hosted_nw_split_port_rule_t *rules,
+		uint16_t num_rules, bool replace)
+{
+	if (num_rules && !rules)
+		return ESP_ERR_INVALID_ARG;
+
+	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
+	ctrl_cmd_t *resp = NULL;
+
+	req->u.nw_split_port_rules.replace = replace;
+	req->u.nw_split_port_rules.n_rules = num_rules;
+	req->u.nw_split_port_rules.rules = rules;
+	resp = rpc_slaveif_nw_split_port_rules(req);
+	return rpc_rsp_callback(resp);
+}
+#endif
+
+#if H_HOST_PS_ALLOWED
+esp_err_t rpc_set_wake_rules(const esp_hosted_wake_rule_t *rules, uint8_t num_rules)
+{
+	uint8_t i = 0;
+
+	if (num_rules && !rules)
+		return ESP_ERR_INVALID_ARG;
+
+	for (i = 0; i < num_rules; i++) {
+		if (rules[i].len > HOSTED_WAKE_RULE_MAX_PATTERN_LEN)
+			return ESP_ERR_INVALID_ARG;
+	}
+
+	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
+	ctrl_cmd_t *resp = NULL;
+
+	req->u.set_wake_rules.n_rules = num_rules;
+	req->u.set_wake_rules.rules = rules;
+	resp = rpc_slaveif_set_wake_rules(req);
+	return rpc_rsp_callback(resp);
+}
+#endif
+
 #if H_HOST_OT_ENABLE
 esp_err_t rpc_iface_openthread_rcp_init(void)
 {
@@ -19,6 +19,7 @@ extern "C" {
 #include "port_esp_hosted_host_openthread.h"
 #include "esp_mac.h"
 #include "esp_hosted_api_types.h"
+#include "esp_hosted_wifi_async.h"
 #include "esp_hosted_misc.h"
 #include "esp_hosted_misc_types.h"
 
@@ -34,6 +35,12 @@ extern "C" {
 #if H_EXT_COEX_SUPPORT
 #include "esp_hosted_cp_ext_coex.h"
 #endif
+#if H_NETWORK_SPLIT_ENABLED
+#include "esp_hosted_cp_nw_split.h"
+#endif
+#if H_HOST_PS_ALLOWED
+#include "esp_hosted_power_save.h"
+#endif
 #if H_HOST_OT_ENABLE
 #include "esp_hosted_openthread.h"
 #endif
@@ -41,6 +48,13 @@ extern "C" {
 
 /** Inline functions **/
 
+#if H_RPC_WIFI_CACHE
+struct rpc_wifi_cache_stats {
+	uint32_t hits;      /* getters served from host cache */
+	uint32_t misses;    /* getters sent to co-processor */
+};
+#endif
+
 /** Exported Functions **/
 esp_err_t rpc_init(void);
 esp_err_t rpc_start(void);
@@ -48,6 +62,9 @@ esp_err_t rpc_stop(void);
 esp_err_t rpc_deinit(void);
 esp_err_t rpc_unregister_event_callbacks(void);
 esp_err_t rpc_register_event_callbacks(void);
+#if H_RPC_WIFI_CACHE
+void rpc_wifi_cache_get_stats(struct rpc_wifi_cache_stats *stats);
+#endif
 
 esp_err_t rpc_wifi_init(const wifi_init_config_t *arg);
 esp_err_t rpc_wifi_deinit(void);
@@ -97,6 +114,27 @@ esp_err_t rpc_wifi_sta_get_aid(uint16_t *aid);
 esp_err_t rpc_wifi_set_inactive_time(wifi_interface_t ifx, uint16_t sec);
 esp_err_t rpc_wifi_get_inactive_time(wifi_interface_t ifx, uint16_t *sec);
 esp_err_t rpc_wifi_disable_pmf_config(wifi_interface_t ifx);
+
+esp_err_t rpc_async_poll(esp_hosted_async_handle_t handle, esp_err_t *result);
+esp_err_t rpc_async_cancel(esp_hosted_async_handle_t handle);
+void rpc_async_release(esp_hosted_async_handle_t handle);
+esp_err_t rpc_async_wifi_set_mode(wifi_mode_t mode,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle);
+esp_err_t rpc_async_wifi_get_mode(wifi_mode_t *mode,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle);
+esp_err_t rpc_async_wifi_set_config(wifi_interface_t interface, const wifi_config_t *conf,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle);
+esp_err_t rpc_async_wifi_get_config(wifi_interface_t interface, wifi_config_t *conf,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle);
+esp_err_t rpc_async_wifi_connect(esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle);
+esp_err_t rpc_async_wifi_disconnect(esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle);
+esp_err_t rpc_async_wifi_scan_start(const wifi_scan_config_t *config, bool block,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle);
+esp_err_t rpc_async_wifi_sta_get_ap_info(wifi_ap_record_t *ap_info,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle);
+esp_err_t rpc_async_wifi_sta_get_rssi(int *rssi,
+		esp_hosted_async_cb_t cb, void *arg, esp_hosted_async_handle_t *handle);
+
 esp_err_t rpc_get_coprocessor_fwversion(esp_hosted_coprocessor_fwver_t *ver_info);
 esp_err_t rpc_get_cp_info(uint32_t *cp_chip_id, char *cp_target_name, size_t cp_target_name_len);
 
@@ -201,6 +239,9 @@ esp_err_t rpc_supp_dpp_bootstrap_gen(const char *chan_list,
 esp_err_t rpc_supp_dpp_start_listen(void);
 esp_err_t rpc_supp_dpp_stop_listen(void);
 #endif
+#if H_HOST_PS_ALLOWED
+esp_err_t rpc_set_wake_rules(const esp_hosted_wake_rule_t *rules, uint8_t num_rules);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -80,7 +80,7 @@ int serial_drv_write (struct serial_drv_handle_t* serial_drv_handle,
 
 
 uint8_t * serial_drv_read(struct serial_drv_handle_t *serial_drv_handle,
-		uint32_t *out_nbyte)
+		uint8_t **out_payload, uint32_t *out_nbyte)
 {
 	uint16_t init_read_len = 0;
 	uint16_t rx_buf_len = 0;
@@ -89,15 +89,15 @@ uint8_t * serial_drv_read(struct serial_drv_handle_t *serial_drv_handle,
 	/* Any of `RPC_EP_NAME_EVT` and `RPC_EP_NAME_RSP` could be used,
 	 * as both have same strlen in esp_hosted_transport.h */
 	const char* ep_name = RPC_EP_NAME_RSP;
-	uint8_t *buf = NULL;
 	uint32_t buf_len = 0;
 
 
-	if (!serial_drv_handle || !out_nbyte) {
+	if (!serial_drv_handle || !out_payload || !out_nbyte) {
 		ESP_LOGE(TAG,"Invalid parameters in read\n\r");
 		return NULL;
 	}
 
+	*out_payload = NULL;
 	*out_nbyte = 0;
 
 	if(!readSemaphore) {
@@ -153,16 +153,12 @@ uint8_t * serial_drv_read(struct serial_drv_handle_t *serial_drv_handle,
 		return NULL;
 	}
 
-	HOSTED_CALLOC(uint8_t,buf,init_read_len,free_bufs);
-
-	g_h.funcs->_h_memcpy(buf, read_buf, init_read_len);
-
 	/* parse_tlv function returns variable payload length
-	 * of received data in buf_len
+	 * of received data in buf_len.
+	 * Header is parsed in place, rx_buf_len checked above covers it
 	 **/
-	ret = parse_tlv(buf, &buf_len);
+	ret = parse_tlv(read_buf, &buf_len);
 	if (ret || !buf_len) {
-		HOSTED_FREE(buf);
 		ESP_LOGE(TAG,"Failed to parse RX data \n\r");
 		goto free_bufs;
 	}
@@ -170,7 +166,6 @@ uint8_t * serial_drv_read(struct serial_drv_handle_t *serial_drv_handle,
 
 	if (rx_buf_len < (init_read_len + buf_len)) {
 		ESP_LOGE(TAG,"Buf read on serial iface is smaller than expected len\n");
-		HOSTED_FREE(buf);
 		goto free_bufs;
 	}
 
@@ -178,23 +173,18 @@ uint8_t * serial_drv_read(struct serial_drv_handle_t *serial_drv_handle,
 		ESP_LOGE(TAG,"Buf read on serial iface is smaller than expected len\n");
 	}
 
-	HOSTED_FREE(buf);
 /*
- * (2) Read variable length of RX data:
+ * (2) Variable length of RX data:
+ * Payload follows the header in the same buffer, hand it over without copy.
+ * Caller frees read_buf.
  */
-	HOSTED_CALLOC(uint8_t,buf,buf_len,free_bufs);
-
-	g_h.funcs->_h_memcpy((buf), read_buf+init_read_len, buf_len);
-
-	HOSTED_FREE(read_buf);
-
+	*out_payload = read_buf + init_read_len;
 	*out_nbyte = buf_len;
 	ESP_LOGV(TAG, "Serial payload size(after removing TLV): %" PRIu32, *out_nbyte);
-	return buf;
+	return read_buf;
 
 free_bufs:
 	HOSTED_FREE(read_buf);
-	HOSTED_FREE(buf);
 	return NULL;
 }
 
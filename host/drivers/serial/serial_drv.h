@@ -66,19 +66,22 @@ int serial_drv_write (struct serial_drv_handle_t* serial_drv_handle,
 
 /*
  * serial_drv_read function gets buffer from serial driver
- * after TLV parsing. output buffer is protobuf encoded
+ * and parses the TLV in place. Payload is protobuf encoded
  *
  * Input parameter
  *      serial_drv_handle           :   Driver Handle
  * Output parameter
- *      out_nbyte                   :   Size of TLV parsed buffer
+ *      out_payload                 :   Protobuf encoded payload, points
+ *                                      into the returned buffer
+ *      out_nbyte                   :   Size of payload
  * Returns
- *      buf                         :   Protocol encoded data Buffer
- *                                      caller will decode the protobuf
+ *      buf                         :   Buffer holding the payload.
+ *                                      Caller will decode the protobuf
+ *                                      and free this buffer
  */
 
 uint8_t * serial_drv_read(struct serial_drv_handle_t *serial_drv_handle,
-		uint32_t *out_nbyte);
+		uint8_t **out_payload, uint32_t *out_nbyte);
 
 /*
  * serial_drv_close function closes driver interface.
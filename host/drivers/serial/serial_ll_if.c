@@ -25,11 +25,6 @@ typedef enum {
 	DESTROY
 } serial_ll_state_e;
 
-static struct rx_data {
-	int len;
-	uint8_t *data;
-} r;
-
 /* data structures needed for serial driver */
 static queue_handle_t to_serial_ll_intf_queue[MAX_SERIAL_INTF];
 static serial_ll_handle_t * interface_handle_g[MAX_SERIAL_INTF] = {NULL};
@@ -74,6 +69,18 @@ static int serial_ll_open(serial_ll_handle_t *serial_ll_hdl)
 		g_h.funcs->_h_destroy_queue(serial_ll_hdl->queue);
 	}
 
+	/* Reassembly buffer, kept for the life of the interface. A completed
+	 * message is copied out at its exact length */
+	serial_ll_hdl->rx_len = 0;
+	serial_ll_hdl->rx_discard = 0;
+	if (!serial_ll_hdl->rx_buf) {
+		serial_ll_hdl->rx_buf = (uint8_t *)g_h.funcs->_h_malloc(MAX_FRAGMENTABLE_PAYLOAD_SIZE);
+		if (!serial_ll_hdl->rx_buf) {
+			ESP_LOGE(TAG, "Failed to allocate serial rx buffer");
+			return -1;
+		}
+	}
+
 	/* Queue - serial rx */
 	serial_ll_hdl->queue = g_h.funcs->_h_create_queue(TO_SERIAL_INFT_QUEUE_SIZE,
 		sizeof(interface_buffer_handle_t));
@@ -128,6 +135,10 @@ static int serial_ll_close(serial_ll_handle_t * serial_ll_hdl)
 		serial_ll_hdl->queue = NULL;
 	}
 
+	g_h.funcs->_h_free(serial_ll_hdl->rx_buf);
+	serial_ll_hdl->rx_buf = NULL;
+	serial_ll_hdl->rx_len = 0;
+
 	/* reset connection */
 	if (conn_num > 0) {
 		interface_handle_g[--conn_num] = NULL;
@@ -273,22 +284,9 @@ static int serial_ll_write(const serial_ll_handle_t * serial_ll_hdl,
   */
 int serial_ll_rx_handler(interface_buffer_handle_t * buf_handle)
 {
-
-#define SERIAL_ALLOC_REALLOC_RDATA() \
-	do { \
-		if(!r.data) { \
-			r.data = (uint8_t *)g_h.funcs->_h_malloc(buf_handle->payload_len); \
-		} else { \
-			r.data = (uint8_t *)g_h.funcs->_h_realloc(r.data, r.len + buf_handle->payload_len); \
-		} \
-		if (!r.data) { \
-			ESP_LOGE(TAG, "Failed to allocate serial data"); \
-			goto serial_buff_cleanup; \
-		} \
-	} while(0);
-
 	serial_ll_handle_t * serial_ll_hdl = NULL;
 	uint8_t *serial_buf = NULL;
+	uint16_t serial_len = 0;
 	interface_buffer_handle_t new_buf_handle = {0};
 
 	/* Check valid handle and length */
@@ -305,35 +303,60 @@ int serial_ll_rx_handler(interface_buffer_handle_t * buf_handle)
 		goto serial_buff_cleanup_silent;
 	}
 
+	if (serial_ll_hdl->rx_discard) {
+		/* rest of a dropped msg, resync on its last fragment */
+		if (!(buf_handle->flag & MORE_FRAGMENT))
+			serial_ll_hdl->rx_discard = 0;
+		ESP_LOGD(TAG, "Discard fragment of dropped msg");
+		goto serial_buff_cleanup_silent;
+	}
 
-	/* Accumulate fragments */
-	if (buf_handle->flag & MORE_FRAGMENT) {
-
-		ESP_LOGD(TAG, "Fragment!!!");
-		SERIAL_ALLOC_REALLOC_RDATA();
+	if ((buf_handle->flag & MORE_FRAGMENT) || serial_ll_hdl->rx_len) {
+		/* Fragmented msg: accumulate in reassembly buffer */
+		if (!serial_ll_hdl->rx_buf) {
+			ESP_LOGE(TAG, "No serial rx buffer");
+			goto serial_buff_cleanup;
+		}
 
-		g_h.funcs->_h_memcpy((r.data + r.len), buf_handle->payload, buf_handle->payload_len);
-		r.len += buf_handle->payload_len;
-		return 0;
-	}
+		if (serial_ll_hdl->rx_len + buf_handle->payload_len > MAX_FRAGMENTABLE_PAYLOAD_SIZE) {
+			ESP_LOGE(TAG, "Serial msg exceeds %u bytes, drop", MAX_FRAGMENTABLE_PAYLOAD_SIZE);
+			goto serial_buff_cleanup;
+		}
 
-	SERIAL_ALLOC_REALLOC_RDATA();
+		g_h.funcs->_h_memcpy(serial_ll_hdl->rx_buf + serial_ll_hdl->rx_len,
+				buf_handle->payload, buf_handle->payload_len);
+		serial_ll_hdl->rx_len += buf_handle->payload_len;
 
-	/* No or last fragment */
-	g_h.funcs->_h_memcpy((r.data + r.len), buf_handle->payload, buf_handle->payload_len);
-	r.len += buf_handle->payload_len;
+		if (buf_handle->flag & MORE_FRAGMENT) {
+			ESP_LOGD(TAG, "Fragment!!!");
+			return 0;
+		}
 
-	serial_buf = (uint8_t *)g_h.funcs->_h_malloc(r.len);
-	if(!serial_buf) {
-		ESP_LOGE(TAG, "Malloc failed, drop pkt");
-		goto serial_buff_cleanup;
+		/* Last fragment: copy the msg out, so a queued msg holds only its
+		 * own length and the reassembly buffer is reused as is */
+		serial_len = serial_ll_hdl->rx_len;
+		serial_ll_hdl->rx_len = 0;
+		serial_buf = (uint8_t *)g_h.funcs->_h_malloc(serial_len);
+		if (!serial_buf) {
+			ESP_LOGE(TAG, "Malloc failed, drop pkt");
+			goto serial_buff_cleanup;
+		}
+		g_h.funcs->_h_memcpy(serial_buf, serial_ll_hdl->rx_buf, serial_len);
+	} else {
+		/* Unfragmented msg */
+		serial_buf = (uint8_t *)g_h.funcs->_h_malloc(buf_handle->payload_len);
+		if(!serial_buf) {
+			ESP_LOGE(TAG, "Malloc failed, drop pkt");
+			goto serial_buff_cleanup;
+		}
+		g_h.funcs->_h_memcpy(serial_buf, buf_handle->payload, buf_handle->payload_len);
+		serial_len = buf_handle->payload_len;
 	}
-	g_h.funcs->_h_memcpy(serial_buf, r.data, r.len);
 
 	/* form new buf handle for processing of serial msg */
 	new_buf_handle.if_type = ESP_SERIAL_IF;
 	new_buf_handle.if_num = buf_handle->if_num;
-	new_buf_handle.payload_len = r.len;
+	new_buf_handle.payload_len = serial_len;
 	new_buf_handle.payload = serial_buf;
 	new_buf_handle.priv_buffer_handle = serial_buf;
 	new_buf_handle.free_buf_handle = g_h.funcs->_h_free;
@@ -341,11 +364,6 @@ int serial_ll_rx_handler(interface_buffer_handle_t * buf_handle)
 	/* clear old buf handle */
 	//H_FREE_PTR_WITH_FUNC(buf_handle->free_buf_handle, buf_handle->priv_buffer_handle);
 
-
-	r.len = 0;
-	g_h.funcs->_h_free(r.data);
-	r.data = NULL;
-
 	ESP_LOGV(TAG, "before ENQ for ll_read");
 	/* send to serial queue */
 	if (g_h.funcs->_h_queue_item(serial_ll_hdl->queue,
@@ -368,14 +386,19 @@ serial_buff_cleanup:
 	ESP_LOGE(TAG, "Err occurred, discard current buffer");
 
 serial_buff_cleanup_silent:
+	/* drop partially reassembled msg, keep buffer for reuse.
+	 * Fragments still to come of a failed msg must not start a new one */
+	if (serial_ll_hdl && buf_handle) {
+		serial_ll_hdl->rx_len = 0;
+		if (buf_handle->flag & MORE_FRAGMENT)
+			serial_ll_hdl->rx_discard = 1;
+	}
+
 	/* Common cleanup path - used for both errors and expected shutdown */
 	H_FREE_PTR_WITH_FUNC(buf_handle->free_buf_handle, buf_handle->priv_buffer_handle);
 
-	r.len = 0;
-
 	H_FREE_PTR_WITH_FUNC(new_buf_handle.free_buf_handle, new_buf_handle.priv_buffer_handle);
 
-	g_h.funcs->_h_free(r.data);
 	return -1;
 }
 
@@ -405,6 +428,9 @@ serial_ll_handle_t * serial_ll_init(void(*serial_rx_callback)(void))
 		serial_ll_hdl->state   = INIT;
 		serial_ll_hdl->fops    = &serial_ll_fops;
 		serial_ll_hdl->serial_rx_callback   = serial_rx_callback;
+		serial_ll_hdl->rx_buf  = NULL;
+		serial_ll_hdl->rx_len  = 0;
+		serial_ll_hdl->rx_discard = 0;
 		interface_handle_g[conn_num] = serial_ll_hdl;
 		conn_num++;
 
@@ -26,6 +26,10 @@ typedef struct serial_handle_s {
 	struct serial_ll_operations *fops;
 	uint8_t state;
 	void (*serial_rx_callback) (void);
+	/* fragment reassembly, MAX_FRAGMENTABLE_PAYLOAD_SIZE bytes */
+	uint8_t *rx_buf;
+	uint16_t rx_len;
+	uint8_t rx_discard;     /* drop fragments until the last one of a msg */
 } serial_ll_handle_t;
 
 /* serial interface */
@@ -163,13 +163,15 @@ static void * sdio_bus_lock;
 #endif
 
 #if DO_COMBINED_REG_READ
-// read data from ESP_SLAVE_INT_RAW_REG to ESP_SLAVE_PACKET_LEN_REG
+// read data from ESP_SLAVE_TOKEN_RDATA to ESP_SLAVE_PACKET_LEN_REG
 // plus 4 for the len of the register
-#define REG_BUF_LEN (ESP_SLAVE_PACKET_LEN_REG - ESP_SLAVE_INT_RAW_REG + 4)
+// Token register comes along for free, to refresh Tx credits on every Rx
+#define REG_BUF_LEN (ESP_SLAVE_PACKET_LEN_REG - ESP_SLAVE_TOKEN_RDATA + 4)
 
 // byte index into the buffer to locate the register
-#define INT_RAW_INDEX (0)
-#define PACKET_LEN_INDEX (ESP_SLAVE_PACKET_LEN_REG - ESP_SLAVE_INT_RAW_REG)
+#define TOKEN_RDATA_INDEX (0)
+#define INT_RAW_INDEX (ESP_SLAVE_INT_RAW_REG - ESP_SLAVE_TOKEN_RDATA)
+#define PACKET_LEN_INDEX (ESP_SLAVE_PACKET_LEN_REG - ESP_SLAVE_TOKEN_RDATA)
 
 static uint8_t *reg_buf = NULL;
 #endif
@@ -186,14 +188,20 @@ static void * sdio_read_thread;
 static void * sdio_process_rx_thread;
 static void * sdio_write_thread;
 
-static queue_handle_t to_slave_queue[MAX_PRIORITY_QUEUES];
+static void *to_slave_queue[MAX_PRIORITY_QUEUES];
 semaphore_handle_t sem_to_slave_queue;
-static queue_handle_t from_slave_queue[MAX_PRIORITY_QUEUES];
+static void *from_slave_queue[MAX_PRIORITY_QUEUES];
 semaphore_handle_t sem_from_slave_queue;
 
 /* Counter to hold the amount of buffers already sent to sdio slave */
 static uint32_t sdio_tx_buf_count = 0;
 
+/* Cached number of free slave Rx buffers (Tx credits).
+ * Consumed on every Tx, refreshed from slave token register only
+ * when exhausted, or when it comes along with Rx register read.
+ * Protected by SDIO_DRV_LOCK */
+static uint32_t sdio_tx_credits = 0;
+
 /* Counter to hold the amount of bytes already received from sdio slave */
 static uint32_t sdio_rx_byte_count = 0;
 
@@ -206,29 +214,40 @@ static bool mempool_oom_logged = false;
 // one-time trigger to start write thread
 static bool sdio_start_write_thread = false;
 
-/** structs to do double buffering
- * sdio_read_task() writes Rx SDIO data to one buffer while
+#if H_SDIO_TX_AGGREGATION
+/* Tx aggregation is used only if slave supports it,
+ * see sdio_drv_set_tx_aggregation() */
+static bool sdio_tx_aggr_enabled = false;
+static uint32_t sdio_tx_aggr_max_bufs = H_SDIO_TX_AGGR_MAX_BUFS;
+static uint8_t *sdio_tx_aggr_buf = NULL;
+#endif
+
+/** structs for the Rx buffer ring
+ * sdio_read_task() writes Rx SDIO data to the buffer at 'head' while
  * sdio_data_to_rx_buf_task() transfers previously received data
- * to the rx queue
+ * from the buffer at 'tail' to the rx queue.
+ * Single producer, single consumer: each index is only written by
+ * one task, the semaphores count filled and free entries.
  */
 typedef struct {
 	uint8_t * buf;
 	uint32_t buf_size;
+	uint32_t data_len;
 } buf_info_t;
 
 typedef struct {
-	buf_info_t buffer[2];
-	int read_index; // -1 means not in use
-	uint32_t read_data_len;
-	int write_index;
-} double_buf_t;
+	buf_info_t buffer[H_SDIO_RX_RING_SIZE];
+	uint32_t head; // next entry to read from slave into
+	uint32_t tail; // next entry to push to rx queue
+	bool reserved; // sdio_read_task() holds a free entry at head
+} rx_ring_t;
 
-static double_buf_t double_buf = {
-	.read_index = -1,
-};
+static rx_ring_t rx_ring;
 
 // sem to trigger sdio_data_to_rx_buf_task()
-static semaphore_handle_t sem_double_buf_xfer_data;
+static semaphore_handle_t sem_rx_ring_data;
+// sem counting entries free for sdio_read_task()
+static semaphore_handle_t sem_rx_ring_free;
 
 static void * sdio_rx_buf_thread;
 static void sdio_data_to_rx_buf_task(void const* pvParameters);
@@ -322,7 +341,7 @@ void bus_deinit_internal(void *bus_handle)
 			/* Drain from_slave_queue before destroying to prevent buffer leaks */
 			interface_buffer_handle_t buf_handle;
 			int count = 0;
-			while (g_h.funcs->_h_dequeue_item(from_slave_queue[prio_q_idx], &buf_handle, 0) == 0) {
+			while (transport_rx_dequeue_item(from_slave_queue[prio_q_idx], &buf_handle) == 0) {
 				/* Free buffer using the provided free function */
 				if (buf_handle.priv_buffer_handle && buf_handle.free_buf_handle) {
 					buf_handle.free_buf_handle(buf_handle.priv_buffer_handle);
@@ -330,7 +349,7 @@ void bus_deinit_internal(void *bus_handle)
 				}
 			}
 			ESP_LOGD(TAG, "Drained %d buffers from from_slave_queue[%d]", count, prio_q_idx);
-			g_h.funcs->_h_destroy_queue(from_slave_queue[prio_q_idx]);
+			transport_rx_queue_destroy(from_slave_queue[prio_q_idx]);
 			from_slave_queue[prio_q_idx] = NULL;
 		}
 	}
@@ -343,9 +362,13 @@ void bus_deinit_internal(void *bus_handle)
 		g_h.funcs->_h_destroy_semaphore(sem_from_slave_queue);
 		sem_from_slave_queue = NULL;
 	}
-	if (sem_double_buf_xfer_data) {
-		g_h.funcs->_h_destroy_semaphore(sem_double_buf_xfer_data);
-		sem_double_buf_xfer_data = NULL;
+	if (sem_rx_ring_data) {
+		g_h.funcs->_h_destroy_semaphore(sem_rx_ring_data);
+		sem_rx_ring_data = NULL;
+	}
+	if (sem_rx_ring_free) {
+		g_h.funcs->_h_destroy_semaphore(sem_rx_ring_free);
+		sem_rx_ring_free = NULL;
 	}
 
 #if DO_COMBINED_REG_READ
@@ -362,32 +385,37 @@ void bus_deinit_internal(void *bus_handle)
 	}
 #endif
 
-	// free memory allocated in double buffering structs
+	// free memory allocated in rx ring structs
 #if H_SDIO_HOST_RX_MODE != H_SDIO_HOST_STREAMING_MODE
-#  define H_DOUBLE_BUF_FREE(p)  sdio_buffer_free(p)
+#  define H_RX_RING_BUF_FREE(p)  sdio_buffer_free(p)
 #else
-#  define H_DOUBLE_BUF_FREE(p)  g_h.funcs->_h_free_align(p)
+#  define H_RX_RING_BUF_FREE(p)  g_h.funcs->_h_free_align(p)
 #endif
-	if (double_buf.buffer[0].buf) {
-		ESP_LOGI(TAG, "free buffer[0] %p", double_buf.buffer[0].buf);
-		H_DOUBLE_BUF_FREE(double_buf.buffer[0].buf);
-		double_buf.buffer[0].buf = NULL;
-		double_buf.buffer[0].buf_size = 0;
+	for (int i = 0; i < H_SDIO_RX_RING_SIZE; i++) {
+		if (rx_ring.buffer[i].buf) {
+			ESP_LOGI(TAG, "free buffer[%d] %p", i, rx_ring.buffer[i].buf);
+			H_RX_RING_BUF_FREE(rx_ring.buffer[i].buf);
+			rx_ring.buffer[i].buf = NULL;
+			rx_ring.buffer[i].buf_size = 0;
+		}
 	}
-	if (double_buf.buffer[1].buf) {
-		ESP_LOGI(TAG, "free buffer[1] %p", double_buf.buffer[1].buf);
-		H_DOUBLE_BUF_FREE(double_buf.buffer[1].buf);
-		double_buf.buffer[1].buf = NULL;
-		double_buf.buffer[1].buf_size = 0;
+#undef H_RX_RING_BUF_FREE
+	/* Reset rx_ring state for clean reinitialization */
+	rx_ring.head = 0;
+	rx_ring.tail = 0;
+	rx_ring.reserved = false;
+
+#if H_SDIO_TX_AGGREGATION
+	sdio_tx_aggr_enabled = false;
+	if (sdio_tx_aggr_buf) {
+		g_h.funcs->_h_free_align(sdio_tx_aggr_buf);
+		sdio_tx_aggr_buf = NULL;
 	}
-#undef H_DOUBLE_BUF_FREE
-	/* Reset double_buf state for clean reinitialization */
-	double_buf.read_index = -1;
-	double_buf.read_data_len = 0;
-	double_buf.write_index = 0;
+#endif
 
 	/* Reset SDIO counters */
 	sdio_tx_buf_count = 0;
+	sdio_tx_credits = 0;
 	sdio_rx_byte_count = 0;
 	mempool_oom_logged = false;
 	sdio_start_write_thread = false;
@@ -426,6 +454,14 @@ static inline int sdio_clear_intr(uint32_t interrupts)
 		sizeof(uint32_t), ACQUIRE_LOCK);
 }
 
+// get the free slave Rx buffers from the token register value
+static inline uint32_t sdio_tx_buffer_num_from_reg(uint32_t reg_val)
+{
+	uint32_t len = (reg_val >> 16) & ESP_TX_BUFFER_MASK;
+
+	return (len + ESP_TX_BUFFER_MAX - sdio_tx_buf_count) % ESP_TX_BUFFER_MAX;
+}
+
 static int sdio_get_tx_buffer_num(uint32_t *tx_num, bool is_lock_needed)
 {
 	uint32_t len = 0;
@@ -439,10 +475,10 @@ static int sdio_get_tx_buffer_num(uint32_t *tx_num, bool is_lock_needed)
 		return ret;
 	}
 
-	len = (len >> 16) & ESP_TX_BUFFER_MASK;
-	len = (len + ESP_TX_BUFFER_MAX - sdio_tx_buf_count) % ESP_TX_BUFFER_MAX;
-
-	*tx_num = len;
+#if ESP_PKT_STATS
+	pkt_stats.sdio_tx_credit_reg_reads++;
+#endif
+	*tx_num = sdio_tx_buffer_num_from_reg(len);
 
 	return ret;
 }
@@ -450,7 +486,7 @@ static int sdio_get_tx_buffer_num(uint32_t *tx_num, bool is_lock_needed)
 #if DO_COMBINED_REG_READ
 static int sdio_read_regs(uint8_t * buf)
 {
-	return g_h.funcs->_h_sdio_read_reg(sdio_handle, ESP_SLAVE_INT_RAW_REG, buf, REG_BUF_LEN, ACQUIRE_LOCK);
+	return g_h.funcs->_h_sdio_read_reg(sdio_handle, ESP_SLAVE_TOKEN_RDATA, buf, REG_BUF_LEN, ACQUIRE_LOCK);
 }
 #endif
 
@@ -553,18 +589,22 @@ static int sdio_get_len_from_slave(uint32_t *rx_size, bool is_lock_needed)
 
 #define MAX_BUFF_FETCH_PERIODICITY 30000
 
+/* Caller holds SDIO_DRV_LOCK */
 static int sdio_is_write_buffer_available(uint32_t buf_needed)
 {
-	static uint32_t buf_available = 0;
 	uint8_t retry = MAX_WRITE_BUF_RETRIES;
 	uint32_t max_retry_sdio_not_responding = 2;
 	uint32_t interval_us = 400;
 
-	/*If buffer needed are less than buffer available
+	/*If buffer needed are less than cached credits
 	  then only read for available buffer number from slave*/
-	if (buf_available < buf_needed) {
+	if (sdio_tx_credits >= buf_needed) {
+#if ESP_PKT_STATS
+		pkt_stats.sdio_tx_credit_hits++;
+#endif
+	} else {
 		while (retry) {
-			if (sdio_get_tx_buffer_num(&buf_available, ACQUIRE_LOCK) ==
+			if (sdio_get_tx_buffer_num(&sdio_tx_credits, ACQUIRE_LOCK) ==
 					ESP_HOSTED_SDIO_UNRESPONSIVE_CODE) {
 				max_retry_sdio_not_responding--;
 				/* restart the host to avoid the sdio locked out state */
@@ -582,7 +622,7 @@ static int sdio_is_write_buffer_available(uint32_t buf_needed)
 				continue;
 			}
 
-			if (buf_available < buf_needed) {
+			if (sdio_tx_credits < buf_needed) {
 
 				ESP_LOGV(TAG, "Retry get write buffers %d", retry);
 				retry--;
@@ -597,8 +637,8 @@ static int sdio_is_write_buffer_available(uint32_t buf_needed)
 		}
 	}
 
-	if (buf_available >= buf_needed)
-		buf_available -= buf_needed;
+	if (sdio_tx_credits >= buf_needed)
+		sdio_tx_credits -= buf_needed;
 
 	if (!retry) {
 		/* No buffer available at slave */
@@ -608,23 +648,292 @@ static int sdio_is_write_buffer_available(uint32_t buf_needed)
 	return BUFFER_AVAILABLE;
 }
 
+static inline int sdio_tx_dequeue(interface_buffer_handle_t *buf_handle)
+{
+	return transport_tx_dequeue(to_slave_queue, buf_handle);
+}
+
+/* Length of the packet on the bus, including the payload header */
+static inline uint16_t sdio_tx_frame_len(interface_buffer_handle_t *buf_handle)
+{
+	uint16_t len = buf_handle->payload_len;
+
+	/* first byte of non-zerocopy HCI payload is carried in the header */
+	if ((buf_handle->if_type == ESP_HCI_IF) && !buf_handle->payload_zcopy && len)
+		len -= 1;
+
+	return len + sizeof(struct esp_payload_header);
+}
+
+/* Form Tx header at 'frame' and copy the payload after it, if needed.
+ * For zerocopy buffers, 'frame' may be the buffer itself, as it already
+ * has headroom for the header.
+ * Checksum is left to the caller.
+ */
+static void sdio_tx_fill_frame(uint8_t *frame, interface_buffer_handle_t *buf_handle)
+{
+	struct esp_payload_header *payload_header = (struct esp_payload_header *) frame;
+	uint8_t *payload = frame + sizeof(struct esp_payload_header);
+	uint16_t len = buf_handle->payload_len;
+
+	if (buf_handle->payload_zcopy && (frame != buf_handle->payload)) {
+		/* zerocopy payload is already placed after header room */
+		g_h.funcs->_h_memcpy(payload,
+				buf_handle->payload + sizeof(struct esp_payload_header), len);
+	}
+
+	g_h.funcs->_h_memset(payload_header, 0, sizeof(struct esp_payload_header));
+
+	payload_header->len = htole16(len);
+	payload_header->offset = htole16(sizeof(struct esp_payload_header));
+	payload_header->if_type = buf_handle->if_type;
+	payload_header->if_num = buf_handle->if_num;
+	payload_header->seq_num = htole16(buf_handle->seq_num);
+	payload_header->flags = buf_handle->flag;
+
+	UPDATE_HEADER_TX_PKT_NO(payload_header);
+
+	if (payload_header->if_type == ESP_HCI_IF) {
+		// special handling for HCI
+		if (!buf_handle->payload_zcopy && len) {
+			// copy first byte of payload into header
+			payload_header->hci_pkt_type = buf_handle->payload[0];
+			// adjust actual payload len
+			len -= 1;
+			payload_header->len = htole16(len);
+			g_h.funcs->_h_memcpy(payload, &buf_handle->payload[1], len);
+		}
+	} else
+	if (!buf_handle->payload_zcopy)
+		g_h.funcs->_h_memcpy(payload, buf_handle->payload, len);
+}
+
+/* Write Tx data to slave, occupying 'buf_needed' slave Rx buffers
+ * Returns SUCCESS, or FAILURE if data could not be sent
+ */
+static int sdio_tx_xfer(uint8_t *sendbuf, uint32_t xfer_len, uint32_t buf_needed)
+{
+	uint8_t *pos = sendbuf;
+	uint32_t data_left = xfer_len;
+	uint32_t len_to_send = 0;
+	int retries = 0;
+	int ret = 0;
+
+	SDIO_DRV_LOCK();
+
+	ret = sdio_is_write_buffer_available(buf_needed);
+	if (ret != BUFFER_AVAILABLE) {
+		ESP_LOGV(TAG, "no SDIO write buffers on slave device");
+		SDIO_DRV_UNLOCK();
+		return FAILURE;
+	}
+
+	ESP_HEXLOGV("bus_TX", sendbuf, data_left, 32);
+
+	do {
+		len_to_send = data_left;
+
+#if H_SDIO_TX_BLOCK_ONLY_XFER
+		/* Extend the transfer length to do block only transfers.
+		 * This is safe as slave only reads up to data_left, which
+		 * is not changed here. Rest of data is discarded by
+		 * slave.
+		 */
+		uint32_t block_send_len = ((len_to_send + ESP_BLOCK_SIZE - 1) / ESP_BLOCK_SIZE) * ESP_BLOCK_SIZE;
+
+		ret = g_h.funcs->_h_sdio_write_block(sdio_handle, ESP_SLAVE_CMD53_END_ADDR - data_left,
+			pos, block_send_len, ACQUIRE_LOCK);
+#else
+		ret = g_h.funcs->_h_sdio_write_block(sdio_handle, ESP_SLAVE_CMD53_END_ADDR - data_left,
+			pos, len_to_send, ACQUIRE_LOCK);
+#endif
+		if (ret) {
+			ESP_LOGE(TAG, "%s: %d: Failed to send data: %d %ld %ld", __func__,
+				retries, ret, len_to_send, data_left);
+			retries++;
+			if (retries < MAX_SDIO_WRITE_RETRY) {
+				ESP_LOGD(TAG, "retry");
+				continue;
+			} else {
+				SDIO_DRV_UNLOCK();
+				ESP_LOGE(TAG, "Unrecoverable host sdio state");
+				g_h.funcs->_h_event_post(ESP_HOSTED_EVENT,
+						ESP_HOSTED_EVENT_TRANSPORT_FAILURE,
+						NULL, 0, HOSTED_BLOCK_MAX);
+#if H_TRANSPORT_RESTART_ON_FAILURE
+				g_h.funcs->_h_restart_host();
+#endif
+				return FAILURE;
+			}
+		}
+
+		data_left -= len_to_send;
+		pos += len_to_send;
+	} while (data_left);
+
+	sdio_tx_buf_count += buf_needed;
+	sdio_tx_buf_count = sdio_tx_buf_count % ESP_TX_BUFFER_MAX;
+
+	SDIO_DRV_UNLOCK();
+
+	return SUCCESS;
+}
+
+#if H_SDIO_TX_AGGREGATION
+/* Compute checksum of an aggregated frame, once it is known whether
+ * another frame follows it in the same slave Rx buffer
+ */
+static inline void sdio_tx_aggr_seal_frame(uint8_t *frame, bool next_pkt)
+{
+	struct esp_payload_header *payload_header = (struct esp_payload_header *) frame;
+
+	if (next_pkt)
+		payload_header->flags |= FLAG_AGGR_NEXT_PKT;
+
+#if H_SDIO_CHECKSUM
+	payload_header->checksum = htole16(compute_checksum(frame,
+		sizeof(struct esp_payload_header) + le16toh(payload_header->len)));
+#endif
+}
+
+static void sdio_tx_aggr_flush(uint32_t xfer_len, uint8_t num_pkts, uint8_t num_sta_pkts)
+{
+	uint32_t buf_needed = (xfer_len + ESP_RX_BUFFER_SIZE - 1) / ESP_RX_BUFFER_SIZE;
+	int ret = sdio_tx_xfer(sdio_tx_aggr_buf, xfer_len, buf_needed);
+
+#if ESP_PKT_STATS
+	if (ret == SUCCESS) {
+		pkt_stats.sdio_tx_aggr_xfers++;
+		pkt_stats.sdio_tx_aggr_pkts += num_pkts;
+		pkt_stats.sta_tx_out += num_sta_pkts;
+	} else {
+		pkt_stats.sta_tx_out_drop += num_sta_pkts;
+	}
+#else
+	(void)ret;
+	(void)num_pkts;
+	(void)num_sta_pkts;
+#endif
+}
+
+/* Pack 'first' and any further Tx packets already queued back-to-back
+ * into sdio_tx_aggr_buf, and write them to the slave in a single transfer.
+ *
+ * Slave parses each of its Rx buffers (ESP_RX_BUFFER_SIZE) independently,
+ * so a packet never straddles two slave Rx buffers: it is moved to the
+ * start of the next one instead. FLAG_AGGR_NEXT_PKT tells the slave that
+ * another packet follows in the same Rx buffer.
+ */
+static void sdio_tx_aggr_send(interface_buffer_handle_t *first)
+{
+	interface_buffer_handle_t buf_handle = *first;
+	uint32_t max_len = sdio_tx_aggr_max_bufs * ESP_RX_BUFFER_SIZE;
+	uint32_t offset = 0;
+	uint32_t pos = 0;
+	uint32_t room = 0;
+	uint16_t frame_len = 0;
+	uint8_t *last_frame = NULL;
+	uint8_t num_pkts = 0;
+	uint8_t num_sta_pkts = 0;
+
+	for (;;) {
+#if ESP_PKT_STATS
+		if (buf_handle.if_type == ESP_STA_IF)
+			pkt_stats.sta_tx_trans_in++;
+#endif
+		frame_len = sdio_tx_frame_len(&buf_handle);
+
+		if (!buf_handle.flag && !buf_handle.payload_len) {
+			ESP_LOGE(TAG, "%s: Empty len", __func__);
+		} else if (frame_len > MAX_SDIO_BUFFER_SIZE) {
+			ESP_LOGE(TAG, "Pkt len [%u] > Max [%u]. Drop",
+					buf_handle.payload_len, MAX_SDIO_BUFFER_SIZE - sizeof(struct esp_payload_header));
+		} else {
+			/* do not let the packet straddle a slave Rx buffer */
+			pos = offset;
+			room = ESP_RX_BUFFER_SIZE - (pos % ESP_RX_BUFFER_SIZE);
+			if (frame_len > room)
+				pos += room;
+
+			if (pos + frame_len > max_len) {
+				/* no room left in this transfer: send it and start a new one */
+				sdio_tx_aggr_seal_frame(last_frame, false);
+				sdio_tx_aggr_flush(offset, num_pkts, num_sta_pkts);
+				offset = pos = 0;
+				last_frame = NULL;
+				num_pkts = num_sta_pkts = 0;
+			}
+
+			if (last_frame)
+				sdio_tx_aggr_seal_frame(last_frame,
+						(pos == offset) && (pos % ESP_RX_BUFFER_SIZE));
+
+			last_frame = sdio_tx_aggr_buf + pos;
+			sdio_tx_fill_frame(last_frame, &buf_handle);
+			offset = pos + frame_len;
+			num_pkts++;
+			if (buf_handle.if_type == ESP_STA_IF)
+				num_sta_pkts++;
+		}
+
+		/* payload copied (or dropped): release the original buffer */
+		if (buf_handle.payload_zcopy) {
+			H_FREE_PTR_WITH_FUNC(buf_handle.free_buf_handle, buf_handle.payload);
+		} else {
+			H_FREE_PTR_WITH_FUNC(buf_handle.free_buf_handle, buf_handle.priv_buffer_handle);
+		}
+
+		if (num_pkts >= H_SDIO_TX_AGGR_MAX_PKTS)
+			break;
+
+		/* only pick up packets already waiting, never block here */
+		if (g_h.funcs->_h_get_semaphore(sem_to_slave_queue, 0))
+			break;
+
+		if (sdio_tx_dequeue(&buf_handle))
+			break;
+	}
+
+	if (last_frame) {
+		sdio_tx_aggr_seal_frame(last_frame, false);
+		sdio_tx_aggr_flush(offset, num_pkts, num_sta_pkts);
+	}
+}
+#endif
+
+void sdio_drv_set_tx_aggregation(bool enable, uint8_t slave_rx_q_size)
+{
+#if H_SDIO_TX_AGGREGATION
+	uint32_t max_bufs = H_SDIO_TX_AGGR_MAX_BUFS;
+
+	/* keep at least half of the slave Rx buffers free for other transfers */
+	if (slave_rx_q_size && (max_bufs > slave_rx_q_size / 2))
+		max_bufs = slave_rx_q_size / 2;
+	if (!max_bufs)
+		max_bufs = 1;
+
+	sdio_tx_aggr_max_bufs = max_bufs;
+	sdio_tx_aggr_enabled = enable && sdio_tx_aggr_buf;
+
+	ESP_LOGI(TAG, "SDIO Tx aggregation: %s (max pkts[%u] slave bufs[%" PRIu32 "])",
+			sdio_tx_aggr_enabled ? "enabled" : "disabled",
+			H_SDIO_TX_AGGR_MAX_PKTS, sdio_tx_aggr_max_bufs);
+#else
+	if (enable)
+		ESP_LOGI(TAG, "Slave supports SDIO Tx aggregation, but disabled on host");
+#endif
+}
+
 static void sdio_write_task(void const* pvParameters)
 {
 	uint16_t len = 0;
 	uint8_t *sendbuf = NULL;
 	void (*free_func)(void* ptr) = NULL;
 	struct esp_payload_header * payload_header = NULL;
-	uint8_t * payload  = NULL;
 	interface_buffer_handle_t buf_handle = {0};
-	int retries = 0;
 
 	int ret = 0;
-	uint8_t *pos = NULL;
-	uint32_t data_left;
-	uint32_t len_to_send;
 	uint32_t buf_needed;
-	uint8_t tx_needed = 1;
-	uint8_t flag = 0;
 
 	while (!sdio_start_write_thread)
 		g_h.funcs->_h_msleep(10);
@@ -634,18 +943,21 @@ static void sdio_write_task(void const* pvParameters)
 		g_h.funcs->_h_get_semaphore(sem_to_slave_queue, HOSTED_BLOCK_MAX);
 
 		/* Tx msg is present as per sem */
-		if (g_h.funcs->_h_dequeue_item(to_slave_queue[PRIO_Q_SERIAL], &buf_handle, 0))
-			if (g_h.funcs->_h_dequeue_item(to_slave_queue[PRIO_Q_BT], &buf_handle, 0))
-				if (g_h.funcs->_h_dequeue_item(to_slave_queue[PRIO_Q_OTHERS], &buf_handle, 0)) {
-					tx_needed = 0; /* No Tx msg */
-				}
+		if (sdio_tx_dequeue(&buf_handle))
+			continue; /* No Tx msg */
 
-		if (tx_needed) {
-			len = buf_handle.payload_len;
-			flag = buf_handle.flag;
+#if H_SDIO_TX_AGGREGATION
+		if (sdio_tx_aggr_enabled) {
+			sdio_tx_aggr_send(&buf_handle);
+			continue;
 		}
+#endif
+
+		len = buf_handle.payload_len;
+		sendbuf = NULL;
+		free_func = NULL;
 
-		if (!flag && !len) {
+		if (!buf_handle.flag && !len) {
 			ESP_LOGE(TAG, "%s: Empty len", __func__);
 			goto done;
 		}
@@ -689,31 +1001,9 @@ static void sdio_write_task(void const* pvParameters)
 		}
 
 		/* Form Tx header */
+		sdio_tx_fill_frame(sendbuf, &buf_handle);
 		payload_header = (struct esp_payload_header *) sendbuf;
-		payload  = sendbuf + sizeof(struct esp_payload_header);
-
-		payload_header->len = htole16(len);
-		payload_header->offset = htole16(sizeof(struct esp_payload_header));
-		payload_header->if_type = buf_handle.if_type;
-		payload_header->if_num = buf_handle.if_num;
-		payload_header->seq_num = htole16(buf_handle.seq_num);
-		payload_header->flags = buf_handle.flag;
-
-		UPDATE_HEADER_TX_PKT_NO(payload_header);
-
-		if (payload_header->if_type == ESP_HCI_IF) {
-			// special handling for HCI
-			if (!buf_handle.payload_zcopy) {
-				// copy first byte of payload into header
-				payload_header->hci_pkt_type = buf_handle.payload[0];
-				// adjust actual payload len
-				len -= 1;
-				payload_header->len = htole16(len);
-				g_h.funcs->_h_memcpy(payload, &buf_handle.payload[1], len);
-			}
-		} else
-		if (!buf_handle.payload_zcopy)
-			g_h.funcs->_h_memcpy(payload, buf_handle.payload, len);
+		len = le16toh(payload_header->len);
 
 #if H_SDIO_CHECKSUM
 		payload_header->checksum = htole16(compute_checksum(sendbuf,
@@ -723,80 +1013,26 @@ static void sdio_write_task(void const* pvParameters)
 		buf_needed = (len + sizeof(struct esp_payload_header) + ESP_RX_BUFFER_SIZE - 1)
 			/ ESP_RX_BUFFER_SIZE;
 
-		SDIO_DRV_LOCK();
+		ret = sdio_tx_xfer(sendbuf, len + sizeof(struct esp_payload_header), buf_needed);
 
-		ret = sdio_is_write_buffer_available(buf_needed);
-		if (ret != BUFFER_AVAILABLE) {
-			ESP_LOGV(TAG, "no SDIO write buffers on slave device");
 #if ESP_PKT_STATS
-			if (payload_header->if_type == ESP_STA_IF)
+		if (buf_handle.if_type == ESP_STA_IF) {
+			if (ret == SUCCESS)
+				pkt_stats.sta_tx_out++;
+			else
 				pkt_stats.sta_tx_out_drop++;
-#endif
-			goto unlock_done;
 		}
-
-		pos = sendbuf;
-		data_left = len + sizeof(struct esp_payload_header);
-
-		ESP_HEXLOGV("bus_TX", sendbuf, data_left, 32);
-
-		len_to_send = 0;
-		retries = 0;
-		do {
-			len_to_send = data_left;
-
-#if H_SDIO_TX_BLOCK_ONLY_XFER
-			/* Extend the transfer length to do block only transfers.
-			 * This is safe as slave only reads up to data_left, which
-			 * is not changed here. Rest of data is discarded by
-			 * slave.
-			 */
-			uint32_t block_send_len = ((len_to_send + ESP_BLOCK_SIZE - 1) / ESP_BLOCK_SIZE) * ESP_BLOCK_SIZE;
-
-			ret = g_h.funcs->_h_sdio_write_block(sdio_handle, ESP_SLAVE_CMD53_END_ADDR - data_left,
-				pos, block_send_len, ACQUIRE_LOCK);
 #else
-			ret = g_h.funcs->_h_sdio_write_block(sdio_handle, ESP_SLAVE_CMD53_END_ADDR - data_left,
-				pos, len_to_send, ACQUIRE_LOCK);
-#endif
-			if (ret) {
-				ESP_LOGE(TAG, "%s: %d: Failed to send data: %d %ld %ld", __func__,
-					retries, ret, len_to_send, data_left);
-				retries++;
-				if (retries < MAX_SDIO_WRITE_RETRY) {
-					ESP_LOGD(TAG, "retry");
-					continue;
-				} else {
-					SDIO_DRV_UNLOCK();
-					ESP_LOGE(TAG, "Unrecoverable host sdio state");
-					g_h.funcs->_h_event_post(ESP_HOSTED_EVENT,
-							ESP_HOSTED_EVENT_TRANSPORT_FAILURE,
-							NULL, 0, HOSTED_BLOCK_MAX);
-#if H_TRANSPORT_RESTART_ON_FAILURE
-					g_h.funcs->_h_restart_host();
-#endif
-					goto done;
-				}
-			}
-
-			data_left -= len_to_send;
-			pos += len_to_send;
-		} while (data_left);
-
-		sdio_tx_buf_count += buf_needed;
-		sdio_tx_buf_count = sdio_tx_buf_count % ESP_TX_BUFFER_MAX;
-
-#if ESP_PKT_STATS
-		if (buf_handle.if_type == ESP_STA_IF)
-			pkt_stats.sta_tx_out++;
+		(void)ret;
 #endif
 
-unlock_done:
-		SDIO_DRV_UNLOCK();
 done:
-		if (len && !buf_handle.payload_zcopy) {
+		if (!buf_handle.payload_zcopy) {
 			/* free allocated buffer, only if zerocopy is not requested */
 			H_FREE_PTR_WITH_FUNC(buf_handle.free_buf_handle, buf_handle.priv_buffer_handle);
+		} else if (!sendbuf) {
+			/* zerocopy buffer not consumed */
+			H_FREE_PTR_WITH_FUNC(buf_handle.free_buf_handle, buf_handle.payload);
 		}
 		H_FREE_PTR_WITH_FUNC(free_func, sendbuf);
 	}
@@ -868,10 +1104,29 @@ static int is_valid_sdio_rx_packet(uint8_t *rxbuff_a, uint16_t *len_a, uint16_t
 	return 1;
 }
 
+static esp_err_t sdio_queue_rx_buf_handle(interface_buffer_handle_t *buf_handle)
+{
+	uint8_t pkt_prio = PRIO_Q_OTHERS;
+
+	if (buf_handle->if_type == ESP_SERIAL_IF)
+		pkt_prio = PRIO_Q_SERIAL;
+	else if (buf_handle->if_type == ESP_HCI_IF)
+		pkt_prio = PRIO_Q_BT;
+	/* else OTHERS by default */
+
+	if( (!from_slave_queue[pkt_prio]) || (!sem_from_slave_queue)) {
+		ESP_LOGI(TAG, "uninitialised from_slave_queue or sem_from_slave_queue");
+		return ESP_FAIL;
+	}
+
+	transport_rx_queue_item(from_slave_queue[pkt_prio], buf_handle, sem_from_slave_queue);
+
+	return ESP_OK;
+}
+
 // pushes received packet data on to rx queue
 static esp_err_t sdio_push_pkt_to_queue(uint8_t * rxbuff, uint16_t len, uint16_t offset)
 {
-	uint8_t pkt_prio = PRIO_Q_OTHERS;
 	struct esp_payload_header *h= NULL;
 	interface_buffer_handle_t buf_handle;
 
@@ -888,21 +1143,7 @@ static esp_err_t sdio_push_pkt_to_queue(uint8_t * rxbuff, uint16_t len, uint16_t
 	buf_handle.seq_num            = le16toh(h->seq_num);
 	buf_handle.flag               = h->flags;
 
-	if (buf_handle.if_type == ESP_SERIAL_IF)
-		pkt_prio = PRIO_Q_SERIAL;
-	else if (buf_handle.if_type == ESP_HCI_IF)
-		pkt_prio = PRIO_Q_BT;
-	/* else OTHERS by default */
-
-	if( (!from_slave_queue[pkt_prio]) || (!sem_from_slave_queue)) {
-		ESP_LOGI(TAG, "uninitialised from_slave_queue or sem_from_slave_queue");
-		return ESP_FAIL;
-	}
-
-	g_h.funcs->_h_queue_item(from_slave_queue[pkt_prio], &buf_handle, HOSTED_BLOCK_MAX);
-	g_h.funcs->_h_post_semaphore(sem_from_slave_queue);
-
-	return ESP_OK;
+	return sdio_queue_rx_buf_handle(&buf_handle);
 }
 
 /**
@@ -914,19 +1155,19 @@ static esp_err_t sdio_push_pkt_to_queue(uint8_t * rxbuff, uint16_t len, uint16_t
 // return a buffer big enough to contain the data
 static inline uint8_t * sdio_rx_get_buffer(uint32_t len)
 {
-	int index = double_buf.write_index;
-	uint8_t ** buf = &double_buf.buffer[index].buf;
+	buf_info_t *entry = &rx_ring.buffer[rx_ring.head % H_SDIO_RX_RING_SIZE];
 
-	*buf = (uint8_t *)sdio_buffer_alloc(MEMSET_REQUIRED);
-	double_buf.buffer[index].buf_size = len;
+	entry->buf = (uint8_t *)sdio_buffer_alloc(MEMSET_REQUIRED);
+	entry->buf_size = len;
 
-	return *buf;
+	return entry->buf;
 }
 
 // this frees the buffer *before* it is queued
 static void sdio_rx_free_buffer(uint8_t * buf)
 {
 	sdio_buffer_free(buf);
+	rx_ring.buffer[rx_ring.head % H_SDIO_RX_RING_SIZE].buf = NULL;
 }
 
 // push buffer on to the queue
@@ -966,10 +1207,10 @@ static uint8_t * sdio_rx_get_buffer(uint32_t len)
 #endif
 
 	// (re)allocate a write buffer big enough to contain the data stream
-	int index = double_buf.write_index;
-	uint8_t ** buf = &double_buf.buffer[index].buf;
+	int index = rx_ring.head % H_SDIO_RX_RING_SIZE;
+	uint8_t ** buf = &rx_ring.buffer[index].buf;
 
-	if (len > double_buf.buffer[index].buf_size) {
+	if (len > rx_ring.buffer[index].buf_size) {
 		/* Allocate the larger buffer BEFORE freeing the old one. On a transient
 		 * heap shortage we degrade gracefully — keep the old buffer, leave the
 		 * slot consistent, and return NULL so the caller drops this read (the
@@ -986,8 +1227,8 @@ static uint8_t * sdio_rx_get_buffer(uint32_t len)
 			g_h.funcs->_h_free_align(*buf);
 		}
 		*buf = newbuf;
-		double_buf.buffer[index].buf_size = len;
-		ESP_LOGD(TAG, "buf %d size: %ld", index, double_buf.buffer[index].buf_size);
+		rx_ring.buffer[index].buf_size = len;
+		ESP_LOGD(TAG, "buf %d size: %ld", index, rx_ring.buffer[index].buf_size);
 	}
 	return *buf;
 }
@@ -998,6 +1239,33 @@ static void sdio_rx_free_buffer(uint8_t * buf)
 	// no op - keep the allocated static buffer as it is
 }
 
+/* Network frames are copied out of the stream straight into the buffer
+ * that is handed to the network stack, which then owns and frees it.
+ * This saves the second frame copy in sdio_process_rx_task().
+ */
+static esp_err_t sdio_push_nw_pkt_to_queue(struct esp_payload_header *h,
+		uint8_t *payload, uint16_t len)
+{
+	interface_buffer_handle_t buf_handle = {0};
+
+	buf_handle.priv_buffer_handle = payload;
+	buf_handle.free_buf_handle    = g_h.funcs->_h_free;
+	buf_handle.payload_len        = len;
+	buf_handle.if_type            = h->if_type;
+	buf_handle.if_num             = h->if_num;
+	buf_handle.payload            = payload;
+	buf_handle.seq_num            = le16toh(h->seq_num);
+	buf_handle.flag               = h->flags;
+	buf_handle.payload_zcopy      = H_BUFF_ZEROCOPY;
+
+	if (sdio_queue_rx_buf_handle(&buf_handle)) {
+		g_h.funcs->_h_free(payload);
+		return ESP_FAIL;
+	}
+
+	return ESP_OK;
+}
+
 // extract packets from the stream and push on to the queue
 static esp_err_t sdio_push_data_to_queue(uint8_t * buf, uint32_t buf_len)
 {
@@ -1005,6 +1273,9 @@ static esp_err_t sdio_push_data_to_queue(uint8_t * buf, uint32_t buf_len)
 	uint16_t len = 0;
 	uint16_t offset = 0;
 	uint32_t packet_size;
+	uint8_t if_type = 0;
+	bool is_nw_pkt = false;
+	esp_err_t ret = ESP_OK;
 
 	// break up the data stream into packets to send to the queue
 	do {
@@ -1015,18 +1286,28 @@ static esp_err_t sdio_push_data_to_queue(uint8_t * buf, uint32_t buf_len)
 			/* TODO: Free by caller? */
 			return ESP_FAIL;
 		}
+
+		packet_size = len + offset;
+		if (packet_size > buf_len) {
+			ESP_LOGE(TAG, "packet size[%lu]>[%lu] too big for remaining stream data",
+					packet_size, buf_len);
+			return ESP_FAIL;
+		}
+
+		if_type = ((struct esp_payload_header *)buf)->if_type;
+		is_nw_pkt = (if_type == ESP_STA_IF) || (if_type == ESP_AP_IF);
+
 		/* Allocate rx buffer */
-		pkt_rxbuff = sdio_buffer_alloc(MEMSET_REQUIRED);
+		if (is_nw_pkt)
+			pkt_rxbuff = g_h.funcs->_h_malloc(len);
+		else
+			pkt_rxbuff = sdio_buffer_alloc(MEMSET_REQUIRED);
 		if (!pkt_rxbuff) {
 			if (!mempool_oom_logged) {
 				ESP_LOGW(TAG, "mempool OOM start (RX)");
 				mempool_oom_logged = true;
 			}
 			/* Skip this packet and continue processing remaining stream data */
-			packet_size = len + offset;
-			if (packet_size > buf_len) {
-				return ESP_FAIL;
-			}
 			buf_len -= packet_size;
 			buf     += packet_size;
 			continue;
@@ -1037,16 +1318,15 @@ static esp_err_t sdio_push_data_to_queue(uint8_t * buf, uint32_t buf_len)
 			mempool_oom_logged = false;
 		}
 
-		packet_size = len + offset;
-		if (packet_size > buf_len) {
-			ESP_LOGE(TAG, "packet size[%lu]>[%lu] too big for remaining stream data",
-					packet_size, buf_len);
-			sdio_buffer_free(pkt_rxbuff);
-			return ESP_FAIL;
+		if (is_nw_pkt) {
+			memcpy(pkt_rxbuff, buf + offset, len);
+			ret = sdio_push_nw_pkt_to_queue((struct esp_payload_header *)buf,
+					pkt_rxbuff, len);
+		} else {
+			memcpy(pkt_rxbuff, buf, packet_size);
+			ret = sdio_push_pkt_to_queue(pkt_rxbuff, len, offset);
 		}
-		memcpy(pkt_rxbuff, buf, packet_size);
-
-		if (sdio_push_pkt_to_queue(pkt_rxbuff, len, offset)) {
+		if (ret) {
 			ESP_LOGI(TAG, "Failed to push a packet to queue from stream");
 		}
 
@@ -1059,33 +1339,66 @@ static esp_err_t sdio_push_data_to_queue(uint8_t * buf, uint32_t buf_len)
 }
 #endif
 
-// double buffer task to transfer data from the current buffer to the queue
+// (Re)initialise the rx ring: all entries free, none holding data
+static void sdio_rx_ring_reset(void)
+{
+	int i = 0;
+
+	rx_ring.head = 0;
+	rx_ring.tail = 0;
+	rx_ring.reserved = false;
+
+	while (g_h.funcs->_h_get_semaphore(sem_rx_ring_data, 0) == 0);
+	while (g_h.funcs->_h_get_semaphore(sem_rx_ring_free, 0) == 0);
+	for (i = 0; i < H_SDIO_RX_RING_SIZE; i++)
+		g_h.funcs->_h_post_semaphore(sem_rx_ring_free);
+}
+
+// hand the buffer at head, filled by sdio_read_task(), over to the rx ring consumer
+static void sdio_rx_ring_push(uint32_t data_len)
+{
+	uint32_t used = 0;
+
+	rx_ring.buffer[rx_ring.head % H_SDIO_RX_RING_SIZE].data_len = data_len;
+	rx_ring.head++;
+
+	used = rx_ring.head - rx_ring.tail;
+#if ESP_PKT_STATS
+	if (used > pkt_stats.sdio_rx_ring_hwm)
+		pkt_stats.sdio_rx_ring_hwm = used;
+#else
+	(void)used;
+#endif
+	// trigger task to copy data to queue
+	g_h.funcs->_h_post_semaphore(sem_rx_ring_data);
+}
+
+// rx ring task to transfer data from the filled buffers to the queue
 static void sdio_data_to_rx_buf_task(void const* pvParameters)
 {
-	uint8_t * buf;
-	uint32_t len;
+	buf_info_t *entry = NULL;
 
 	ESP_LOGI(TAG, "sdio_data_to_rx_buf_task started");
 
 	while (1) {
-		g_h.funcs->_h_get_semaphore(sem_double_buf_xfer_data, HOSTED_BLOCK_MAX);
+		g_h.funcs->_h_get_semaphore(sem_rx_ring_data, HOSTED_BLOCK_MAX);
 
-		if (double_buf.read_index < 0) {
-			ESP_LOGE(TAG, "invalid double buf read_index");
+		if (rx_ring.tail == rx_ring.head) {
+			ESP_LOGE(TAG, "rx ring empty");
 			continue;
 		}
 
-		buf = double_buf.buffer[double_buf.read_index].buf;
-		len = double_buf.read_data_len;
+		entry = &rx_ring.buffer[rx_ring.tail % H_SDIO_RX_RING_SIZE];
 
-		if (sdio_push_data_to_queue(buf, len))
+		if (sdio_push_data_to_queue(entry->buf, entry->data_len))
 			ESP_LOGE(TAG, "Failed to push data to rx queue");
 
 #if H_SDIO_HOST_RX_MODE != H_SDIO_HOST_STREAMING_MODE
-		double_buf.buffer[double_buf.read_index].buf = NULL;
+		entry->buf = NULL;
 #endif
-		// finished sending data: reset read_index
-		double_buf.read_index = -1;
+		// finished sending data: release the entry
+		rx_ring.tail++;
+		g_h.funcs->_h_post_semaphore(sem_rx_ring_free);
 	}
 }
 
@@ -1198,6 +1511,18 @@ static void sdio_read_task(void const* pvParameters)
 		}
 		pending = false;
 
+		/* Reserve the rx ring entry to read into. Stall here, leaving the
+		 * data queued on slave, only if all entries are still being split */
+		if (!rx_ring.reserved) {
+			if (g_h.funcs->_h_get_semaphore(sem_rx_ring_free, 0)) {
+#if ESP_PKT_STATS
+				pkt_stats.sdio_rx_ring_full++;
+#endif
+				g_h.funcs->_h_get_semaphore(sem_rx_ring_free, HOSTED_BLOCK_MAX);
+			}
+			rx_ring.reserved = true;
+		}
+
 		SDIO_DRV_LOCK();
 
 #if DO_COMBINED_REG_READ
@@ -1217,6 +1542,13 @@ static void sdio_read_task(void const* pvParameters)
 
 		intr_index = (uint32_t *)&reg_buf[INT_RAW_INDEX];
 		interrupts = *intr_index;
+
+		/* Tx credits read along, saves a token register read on Tx */
+		sdio_tx_credits = sdio_tx_buffer_num_from_reg(
+				*(uint32_t *)&reg_buf[TOKEN_RDATA_INDEX]);
+  #if ESP_PKT_STATS
+		pkt_stats.sdio_tx_credit_piggyback++;
+  #endif
 #else
 		// clear slave interrupts
 		if (sdio_get_intr(&interrupts)) {
@@ -1239,10 +1571,10 @@ static void sdio_read_task(void const* pvParameters)
 
 		/* Check all supported interrupts */
 		if (BIT(SDIO_INT_START_THROTTLE) & interrupts)
-			wifi_tx_throttling = 1;
+			transport_wifi_tx_flow_ctrl(H_FLOW_CTRL_ON);
 
 		if (BIT(SDIO_INT_STOP_THROTTLE) & interrupts)
-			wifi_tx_throttling = 0;
+			transport_wifi_tx_flow_ctrl(H_FLOW_CTRL_OFF);
 
 		if (!(BIT(SDIO_INT_NEW_PACKET) & interrupts)) {
 
@@ -1338,18 +1670,8 @@ static void sdio_read_task(void const* pvParameters)
 		if (unlikely(ret))
 			continue;
 
-		if (double_buf.read_index < 0) {
-			double_buf.read_index = double_buf.write_index;
-			double_buf.read_data_len = len_from_slave;
-			double_buf.write_index = (double_buf.write_index) ? 0 : 1;
-			// trigger task to copy data to queue
-			g_h.funcs->_h_post_semaphore(sem_double_buf_xfer_data);
-		} else {
-			// error: task to copy data to queue still running
-			sdio_rx_free_buffer(rxbuff);
-			ESP_LOGE(TAG, "task still writing Rx data to queue!");
-			// don't send data to task, or update write_index
-		}
+		sdio_rx_ring_push(len_from_slave);
+		rx_ring.reserved = false;
 	}
 }
 
@@ -1370,14 +1692,8 @@ static void sdio_process_rx_task(void const* pvParameters)
 	ESP_LOGI(TAG, "Starting SDIO process rx task");
 
 	while (1) {
-		g_h.funcs->_h_get_semaphore(sem_from_slave_queue, HOSTED_BLOCK_MAX);
-
-		if (g_h.funcs->_h_dequeue_item(from_slave_queue[PRIO_Q_SERIAL], &buf_handle_l, 0))
-			if (g_h.funcs->_h_dequeue_item(from_slave_queue[PRIO_Q_BT], &buf_handle_l, 0))
-				if (g_h.funcs->_h_dequeue_item(from_slave_queue[PRIO_Q_OTHERS], &buf_handle_l, 0)) {
-					ESP_LOGI(TAG, "No element in any queue found");
-					continue;
-				}
+		if (transport_rx_dequeue_wait(from_slave_queue, &buf_handle_l, sem_from_slave_queue))
+			continue;
 
 		buf_handle = &buf_handle_l;
 
@@ -1392,13 +1708,23 @@ static void sdio_process_rx_task(void const* pvParameters)
 				(buf_handle->if_type == ESP_AP_IF)) {
 #if 1
 			if (chan_arr[buf_handle->if_type] && chan_arr[buf_handle->if_type]->rx) {
-				/* TODO : Need to abstract heap_caps_malloc */
-				uint8_t * copy_payload = (uint8_t *)g_h.funcs->_h_malloc(buf_handle->payload_len);
-				assert(copy_payload);
-				assert(buf_handle->payload_len);
-				assert(buf_handle->payload);
-				memcpy(copy_payload, buf_handle->payload, buf_handle->payload_len);
-				H_FREE_PTR_WITH_FUNC(buf_handle->free_buf_handle, buf_handle->priv_buffer_handle);
+				uint8_t * copy_payload = NULL;
+
+				if (buf_handle->payload_zcopy) {
+					/* payload is already a standalone buffer, hand it over */
+					copy_payload = buf_handle->payload;
+#if ESP_PKT_STATS
+					pkt_stats.sdio_rx_nw_direct++;
+#endif
+				} else {
+					/* TODO : Need to abstract heap_caps_malloc */
+					copy_payload = (uint8_t *)g_h.funcs->_h_malloc(buf_handle->payload_len);
+					assert(copy_payload);
+					assert(buf_handle->payload_len);
+					assert(buf_handle->payload);
+					memcpy(copy_payload, buf_handle->payload, buf_handle->payload_len);
+					H_FREE_PTR_WITH_FUNC(buf_handle->free_buf_handle, buf_handle->priv_buffer_handle);
+				}
 
 #if ESP_PKT_STATS
 				if (buf_handle->if_type == ESP_STA_IF)
@@ -1418,6 +1744,9 @@ static void sdio_process_rx_task(void const* pvParameters)
 				(void)ret; // to silence 'unused variable' warning
 #endif
 #endif
+			} else if (buf_handle->payload_zcopy) {
+				/* no channel to take ownership */
+				H_FREE_PTR_WITH_FUNC(buf_handle->free_buf_handle, buf_handle->priv_buffer_handle);
 			}
 #else
 			if (chan_arr[buf_handle->if_type] && chan_arr[buf_handle->if_type]->rx) {
@@ -1472,6 +1801,7 @@ void *bus_init_internal(void)
 
 	// reset sdio tx and rx counters
 	sdio_tx_buf_count = 0;
+	sdio_tx_credits = 0;
 	sdio_rx_byte_count = 0;
 
 	struct esp_hosted_sdio_config *psdio_config;
@@ -1512,7 +1842,7 @@ void *bus_init_internal(void)
 
 	for (prio_q_idx=0; prio_q_idx<MAX_PRIORITY_QUEUES;prio_q_idx++) {
 		/* Queue - rx */
-		from_slave_queue[prio_q_idx] = g_h.funcs->_h_create_queue(rx_queue_size, sizeof(interface_buffer_handle_t));
+		from_slave_queue[prio_q_idx] = transport_rx_queue_create(rx_queue_size);
 		assert(from_slave_queue[prio_q_idx]);
 
 		/* Queue - tx */
@@ -1522,6 +1852,15 @@ void *bus_init_internal(void)
 
 	sdio_mempool_create(tx_queue_size, rx_queue_size);
 
+#if H_SDIO_TX_AGGREGATION
+	/* enabled later, once slave advertises support */
+	sdio_tx_aggr_enabled = false;
+	sdio_tx_aggr_buf = g_h.funcs->_h_malloc_align(
+			H_SDIO_TX_AGGR_MAX_BUFS * ESP_RX_BUFFER_SIZE, HOSTED_MEM_ALIGNMENT_64);
+	if (!sdio_tx_aggr_buf)
+		ESP_LOGW(TAG, "failed to allocate SDIO Tx aggregation buffer, aggregation disabled");
+#endif
+
 	/* initialise SDMMC before starting read/write threads
 	 * which depend on SDMMC*/
 	sdio_handle = g_h.funcs->_h_bus_init();
@@ -1530,14 +1869,14 @@ void *bus_init_internal(void)
 		assert(sdio_handle);
 	}
 
-	// initialise double buffering structs
-	memset(&double_buf, 0, sizeof(double_buf_t));
-	double_buf.read_index = -1; // indicates we are not reading anything
-	double_buf.write_index = 0; // we will write into the first buffer
+	// initialise rx ring structs
+	memset(&rx_ring, 0, sizeof(rx_ring_t));
 
-	sem_double_buf_xfer_data = g_h.funcs->_h_create_semaphore(1);
-	assert(sem_double_buf_xfer_data);
-	g_h.funcs->_h_get_semaphore(sem_double_buf_xfer_data, 0);
+	sem_rx_ring_data = g_h.funcs->_h_create_semaphore(H_SDIO_RX_RING_SIZE);
+	assert(sem_rx_ring_data);
+	sem_rx_ring_free = g_h.funcs->_h_create_semaphore(H_SDIO_RX_RING_SIZE);
+	assert(sem_rx_ring_free);
+	sdio_rx_ring_reset();
 
 	sdio_rx_buf_thread = g_h.funcs->_h_thread_create("sdio_rx_buf",
 		DFLT_TASK_PRIO, RX_BUF_TASK_STACK_SIZE, sdio_data_to_rx_buf_task, NULL);
@@ -1604,6 +1943,9 @@ int esp_hosted_tx(uint8_t iface_type, uint8_t iface_num,
 		pkt_stats.sta_tx_in_pass++;
 #endif
 
+#if ESP_PKT_STATS
+	buf_handle.enq_time_ms = (uint32_t)g_h.funcs->_h_get_time_ms();
+#endif
 	g_h.funcs->_h_queue_item(to_slave_queue[pkt_prio], &buf_handle, HOSTED_BLOCK_MAX);
 	g_h.funcs->_h_post_semaphore(sem_to_slave_queue);
 
@@ -1705,14 +2047,11 @@ int ensure_slave_bus_ready(void *bus_handle)
 	if (esp_hosted_woke_from_power_save()) {
 		ESP_LOGI(TAG, "Host woke up from power save");
 
-		/* Reset double buffer state after wakeup to prevent race conditions */
+		/* Reset rx ring state after wakeup to prevent race conditions */
 		g_h.funcs->_h_msleep(500);
-		/* Reset double buffer state - this ensures clean state after wakeup */
-		double_buf.read_index = -1;
-		double_buf.write_index = 0;
-		double_buf.read_data_len = 0;
-		if (sem_double_buf_xfer_data) {
-			while (g_h.funcs->_h_get_semaphore(sem_double_buf_xfer_data, 0) == ESP_OK);
+		/* Reset rx ring state - this ensures clean state after wakeup */
+		if (sem_rx_ring_data && sem_rx_ring_free) {
+			sdio_rx_ring_reset();
 		}
 
 		res = transport_card_init(bus_handle, CARD_INIT_TIMEOUT_MS);
@@ -9,6 +9,8 @@
 #define __SDIO_DRV_H
 
 /** Includes **/
+#include <stdbool.h>
+#include <stdint.h>
 
 /** Constants/Macros **/
 
@@ -20,4 +22,13 @@
 
 /** Exported Functions **/
 
+/**
+  * @brief  Enable or disable aggregation of multiple Tx packets into a
+  *         single SDIO transfer, based on co-processor capability
+  * @param  enable - co-processor supports Rx de-aggregation
+  *         slave_rx_q_size - number of Rx buffers on co-processor (0 if unknown)
+  * @retval None
+  */
+void sdio_drv_set_tx_aggregation(bool enable, uint8_t slave_rx_q_size);
+
 #endif /* __SDIO_DRV_H */
@@ -65,9 +65,9 @@ static hosted_mempool_t * buf_mp_g;
 static void * spi_bus_lock;
 
 /* Queue declaration */
-static queue_handle_t to_slave_queue[MAX_PRIORITY_QUEUES];
+static void *to_slave_queue[MAX_PRIORITY_QUEUES];
 semaphore_handle_t sem_to_slave_queue;
-static queue_handle_t from_slave_queue[MAX_PRIORITY_QUEUES];
+static void *from_slave_queue[MAX_PRIORITY_QUEUES];
 semaphore_handle_t sem_from_slave_queue;
 
 static void * spi_rx_thread;
@@ -233,20 +233,24 @@ void bus_deinit_internal(void *bus_handle)
 		spi_trans_ready_sem = NULL;
 	}
 
+	/* Free queued Tx buffers before the memory pool goes */
+	for (uint8_t prio_q_idx = 0; prio_q_idx < MAX_PRIORITY_QUEUES; prio_q_idx++) {
+		if (to_slave_queue[prio_q_idx]) {
+			transport_tx_queue_destroy(to_slave_queue[prio_q_idx]);
+			to_slave_queue[prio_q_idx] = NULL;
+		}
+	}
+
 	/* Destroy memory pool */
 	spi_mempool_destroy();
 
 	/* Delete queues */
 	for (uint8_t prio_q_idx = 0; prio_q_idx < MAX_PRIORITY_QUEUES; prio_q_idx++) {
 		if (from_slave_queue[prio_q_idx]) {
-			g_h.funcs->_h_destroy_queue(from_slave_queue[prio_q_idx]);
+			transport_rx_queue_destroy(from_slave_queue[prio_q_idx]);
 			from_slave_queue[prio_q_idx] = NULL;
 		}
 
-		if (to_slave_queue[prio_q_idx]) {
-			g_h.funcs->_h_destroy_queue(to_slave_queue[prio_q_idx]);
-			to_slave_queue[prio_q_idx] = NULL;
-		}
 	}
 
 	/* Delete semaphores for queues */
@@ -291,7 +295,7 @@ void *bus_init_internal(void)
 
 	for (prio_q_idx=0; prio_q_idx<MAX_PRIORITY_QUEUES;prio_q_idx++) {
 		/* Queue - rx */
-		from_slave_queue[prio_q_idx] = g_h.funcs->_h_create_queue(FROM_SLAVE_QUEUE_SIZE, sizeof(interface_buffer_handle_t));
+		from_slave_queue[prio_q_idx] = transport_rx_queue_create(FROM_SLAVE_QUEUE_SIZE);
 		assert(from_slave_queue[prio_q_idx]);
 
 		/* Queue - tx */
@@ -366,7 +370,7 @@ static int process_spi_rx_buf(uint8_t * rxbuff)
 		schedule_dummy_rx = 0;
 
 	if (!len) {
-		wifi_tx_throttling = h->throttle_cmd;
+		transport_wifi_tx_flow_ctrl(h->throttle_cmd ? H_FLOW_CTRL_ON : H_FLOW_CTRL_OFF);
 		ret = -5;
 		goto done;
 	}
@@ -400,7 +404,7 @@ static int process_spi_rx_buf(uint8_t * rxbuff)
 			buf_handle.payload     = rxbuff + offset;
 			buf_handle.seq_num     = le16toh(h->seq_num);
 			buf_handle.flag        = h->flags;
-			wifi_tx_throttling     = h->throttle_cmd;
+			transport_wifi_tx_flow_ctrl(h->throttle_cmd ? H_FLOW_CTRL_ON : H_FLOW_CTRL_OFF);
 #if 0
 #if CONFIG_H_LOWER_MEMCOPY
 			if ((buf_handle.if_type == ESP_STA_IF) ||
@@ -418,8 +422,7 @@ static int process_spi_rx_buf(uint8_t * rxbuff)
 				pkt_prio = PRIO_Q_BT;
 			/* else OTHERS by default */
 
-			g_h.funcs->_h_queue_item(from_slave_queue[pkt_prio], &buf_handle, HOSTED_BLOCK_MAX);
-			g_h.funcs->_h_post_semaphore(sem_from_slave_queue);
+			transport_rx_queue_item(from_slave_queue[pkt_prio], &buf_handle, sem_from_slave_queue);
 
 		} else {
 			ESP_LOGI(TAG, "rcvd_crc[%u] != exp_crc[%u], drop pkt\n",checksum, rx_checksum);
@@ -591,6 +594,9 @@ int esp_hosted_tx(uint8_t iface_type, uint8_t iface_num,
 		pkt_prio = PRIO_Q_BT;
 	/* else OTHERS by default */
 
+#if ESP_PKT_STATS
+	buf_handle.enq_time_ms = (uint32_t)g_h.funcs->_h_get_time_ms();
+#endif
 	g_h.funcs->_h_queue_item(to_slave_queue[pkt_prio], &buf_handle, HOSTED_BLOCK_MAX);
 	g_h.funcs->_h_post_semaphore(sem_to_slave_queue);
 
@@ -669,14 +675,8 @@ static void spi_process_rx_task(void const* pvParameters)
 
 	while (1) {
 
-		g_h.funcs->_h_get_semaphore(sem_from_slave_queue, HOSTED_BLOCK_MAX);
-
-		if (g_h.funcs->_h_dequeue_item(from_slave_queue[PRIO_Q_SERIAL], &buf_handle_l, 0))
-			if (g_h.funcs->_h_dequeue_item(from_slave_queue[PRIO_Q_BT], &buf_handle_l, 0))
-				if (g_h.funcs->_h_dequeue_item(from_slave_queue[PRIO_Q_OTHERS], &buf_handle_l, 0)) {
-					ESP_LOGI(TAG, "No element in any queue found");
-					continue;
-				}
+		if (transport_rx_dequeue_wait(from_slave_queue, &buf_handle_l, sem_from_slave_queue))
+			continue;
 
 		buf_handle = &buf_handle_l;
 
@@ -795,11 +795,9 @@ static uint8_t * get_next_tx_buffer(uint8_t *is_valid_tx_buf, void (**free_func)
 	if (!g_h.funcs->_h_get_semaphore(sem_to_slave_queue, 0)) {
 
 		/* Tx msg is present as per sem */
-		if (g_h.funcs->_h_dequeue_item(to_slave_queue[PRIO_Q_SERIAL], &buf_handle, 0))
-			if (g_h.funcs->_h_dequeue_item(to_slave_queue[PRIO_Q_BT], &buf_handle, 0))
-				if (g_h.funcs->_h_dequeue_item(to_slave_queue[PRIO_Q_OTHERS], &buf_handle, 0)) {
-					tx_needed = 0; /* No Tx msg */
-				}
+		if (transport_tx_dequeue(to_slave_queue, &buf_handle)) {
+			tx_needed = 0; /* No Tx msg */
+		}
 
 		if (tx_needed)
 			len = buf_handle.payload_len;
@@ -857,6 +855,14 @@ static uint8_t * get_next_tx_buffer(uint8_t *is_valid_tx_buf, void (**free_func)
 				g_h.funcs->_h_memcpy(payload, buf_handle.payload, H_MIN(len, MAX_PAYLOAD_SIZE));
 		}
 
+		/* Full duplex clocks out the whole buffer. A zero copy buffer is
+		 * not cleared on alloc, so clear what follows the payload, else
+		 * bytes of earlier frames go to the slave */
+		if (buf_handle.payload_zcopy &&
+		    sizeof(struct esp_payload_header) + len < MAX_SPI_BUFFER_SIZE)
+			g_h.funcs->_h_memset(payload + len, 0, MAX_SPI_BUFFER_SIZE -
+					sizeof(struct esp_payload_header) - len);
+
 		//TODO: checksum should be configurable from menuconfig
 		payload_header->checksum = htole16(compute_checksum(sendbuf,
 				sizeof(struct esp_payload_header)+len));
@@ -979,16 +985,18 @@ int bus_inform_slave_host_power_save_start(void)
 		spi_trans.tx_buf_size = MAX_SPI_BUFFER_SIZE;
 		spi_trans.rx_buf = rxbuff;
 
-		/* Execute direct SPI transaction - bypass all queues */
+		/* Execute direct SPI transaction - bypass all queues.
+		 * Rx is queued under the bus lock too: the Rx queues take a
+		 * single producer at a time, and the SPI transaction thread may
+		 * already be running */
 		g_h.funcs->_h_lock_mutex(spi_bus_lock, HOSTED_BLOCK_MAX);
 		ret = g_h.funcs->_h_do_bus_transfer(&spi_trans);
+		if (!ret)
+			process_spi_rx_buf(spi_trans.rx_buf);
 		g_h.funcs->_h_unlock_mutex(spi_bus_lock);
 
 		/* Free buffers */
 		spi_buffer_free(txbuff);
-		if (!ret) {
-			process_spi_rx_buf(spi_trans.rx_buf);
-		}
 	} else {
 		/* Use normal queue mechanism */
 		ret = esp_hosted_tx(ESP_SERIAL_IF, 0, NULL, 0,
@@ -1037,16 +1045,18 @@ int bus_inform_slave_host_power_save_stop(void)
 		spi_trans.tx_buf_size = MAX_SPI_BUFFER_SIZE;
 		spi_trans.rx_buf = rxbuff;
 
-		/* Execute direct SPI transaction - bypass all queues */
+		/* Execute direct SPI transaction - bypass all queues.
+		 * Rx is queued under the bus lock too: the Rx queues take a
+		 * single producer at a time, and the SPI transaction thread may
+		 * already be running */
 		g_h.funcs->_h_lock_mutex(spi_bus_lock, HOSTED_BLOCK_MAX);
 		ret = g_h.funcs->_h_do_bus_transfer(&spi_trans);
+		if (!ret)
+			process_spi_rx_buf(spi_trans.rx_buf);
 		g_h.funcs->_h_unlock_mutex(spi_bus_lock);
 
 		/* Free buffers */
 		spi_buffer_free(txbuff);
-		if (!ret) {
-			process_spi_rx_buf(spi_trans.rx_buf);
-		}
 	} else {
 		/* Use normal queue mechanism */
 		ret = esp_hosted_tx(ESP_SERIAL_IF, 0, NULL, 0,
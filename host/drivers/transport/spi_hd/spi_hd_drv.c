@@ -105,9 +105,9 @@ static void * spi_hd_read_thread;
 static void * spi_hd_process_rx_thread;
 static void * spi_hd_write_thread;
 
-static queue_handle_t to_slave_queue[MAX_PRIORITY_QUEUES];
+static void *to_slave_queue[MAX_PRIORITY_QUEUES];
 static semaphore_handle_t sem_to_slave_queue;
-static queue_handle_t from_slave_queue[MAX_PRIORITY_QUEUES];
+static void *from_slave_queue[MAX_PRIORITY_QUEUES];
 static semaphore_handle_t sem_from_slave_queue;
 static semaphore_handle_t spi_hd_data_ready_sem;
 
@@ -245,11 +245,9 @@ static void spi_hd_write_task(void const* pvParameters)
 		g_h.funcs->_h_get_semaphore(sem_to_slave_queue, HOSTED_BLOCK_MAX);
 
 		/* Tx msg is present as per sem */
-		if (g_h.funcs->_h_dequeue_item(to_slave_queue[PRIO_Q_SERIAL], &buf_handle, 0))
-			if (g_h.funcs->_h_dequeue_item(to_slave_queue[PRIO_Q_BT], &buf_handle, 0))
-				if (g_h.funcs->_h_dequeue_item(to_slave_queue[PRIO_Q_OTHERS], &buf_handle, 0)) {
-					tx_needed = 0; /* No Tx msg */
-				}
+		if (transport_tx_dequeue(to_slave_queue, &buf_handle)) {
+			tx_needed = 0; /* No Tx msg */
+		}
 
 		if (!tx_needed)
 			continue;
@@ -434,12 +432,7 @@ static int update_flow_ctrl(uint8_t *rxbuff)
 {
 	struct esp_payload_header * h = (struct esp_payload_header *)rxbuff;
 	if (h->throttle_cmd) {
-		if (h->throttle_cmd == H_FLOW_CTRL_ON) {
-			wifi_tx_throttling = 1;
-		}
-		if (h->throttle_cmd == H_FLOW_CTRL_OFF) {
-			wifi_tx_throttling = 0;
-		}
+		transport_wifi_tx_flow_ctrl(h->throttle_cmd);
 		return 1;
 	} else {
 		return 0;
@@ -472,8 +465,7 @@ static esp_err_t spi_hd_push_pkt_to_queue(uint8_t * rxbuff, uint16_t len, uint16
 		pkt_prio = PRIO_Q_BT;
 	/* else OTHERS by default */
 
-	g_h.funcs->_h_queue_item(from_slave_queue[pkt_prio], &buf_handle, HOSTED_BLOCK_MAX);
-	g_h.funcs->_h_post_semaphore(sem_from_slave_queue);
+	transport_rx_queue_item(from_slave_queue[pkt_prio], &buf_handle, sem_from_slave_queue);
 
 	return ESP_OK;
 }
@@ -590,10 +582,10 @@ static void spi_hd_read_task(void const* pvParameters)
 		int_mask = curr_rx_value & SPI_HD_INT_MASK;
 
 		if (int_mask & SPI_HD_INT_START_THROTTLE) {
-			wifi_tx_throttling = 1;
+			transport_wifi_tx_flow_ctrl(H_FLOW_CTRL_ON);
 		}
 		if (int_mask & SPI_HD_INT_STOP_THROTTLE) {
-			wifi_tx_throttling = 0;
+			transport_wifi_tx_flow_ctrl(H_FLOW_CTRL_OFF);
 		}
 
 		/**
@@ -683,14 +675,8 @@ static void spi_hd_process_rx_task(void const* pvParameters)
 	ESP_LOGI(TAG, "spi_hd_process_rx_task: transport rx ready");
 
 	while (1) {
-		g_h.funcs->_h_get_semaphore(sem_from_slave_queue, HOSTED_BLOCK_MAX);
-
-		if (g_h.funcs->_h_dequeue_item(from_slave_queue[PRIO_Q_SERIAL], &buf_handle_l, 0))
-			if (g_h.funcs->_h_dequeue_item(from_slave_queue[PRIO_Q_BT], &buf_handle_l, 0))
-				if (g_h.funcs->_h_dequeue_item(from_slave_queue[PRIO_Q_OTHERS], &buf_handle_l, 0)) {
-					ESP_LOGI(TAG, "No element in any queue found");
-					continue;
-				}
+		if (transport_rx_dequeue_wait(from_slave_queue, &buf_handle_l, sem_from_slave_queue))
+			continue;
 
 		buf_handle = &buf_handle_l;
 
@@ -792,7 +778,7 @@ void * bus_init_internal(void)
 	/* cleanup the semaphores */
 	for (prio_q_idx = 0; prio_q_idx < MAX_PRIORITY_QUEUES; prio_q_idx++) {
 		/* Queue - rx */
-		from_slave_queue[prio_q_idx] = g_h.funcs->_h_create_queue(H_SPI_HD_RX_QUEUE_SIZE, sizeof(interface_buffer_handle_t));
+		from_slave_queue[prio_q_idx] = transport_rx_queue_create(H_SPI_HD_RX_QUEUE_SIZE);
 		assert(from_slave_queue[prio_q_idx]);
 
 		/* Queue - tx */
@@ -849,12 +835,12 @@ void bus_deinit_internal(void *bus_handle)
 	/* Clean up queues */
 	for (prio_q_idx = 0; prio_q_idx < MAX_PRIORITY_QUEUES; prio_q_idx++) {
 		if (from_slave_queue[prio_q_idx]) {
-			g_h.funcs->_h_destroy_queue(from_slave_queue[prio_q_idx]);
+			transport_rx_queue_destroy(from_slave_queue[prio_q_idx]);
 			from_slave_queue[prio_q_idx] = NULL;
 		}
 
 		if (to_slave_queue[prio_q_idx]) {
-			g_h.funcs->_h_destroy_queue(to_slave_queue[prio_q_idx]);
+			transport_tx_queue_destroy(to_slave_queue[prio_q_idx]);
 			to_slave_queue[prio_q_idx] = NULL;
 		}
 	}
@@ -939,6 +925,9 @@ int esp_hosted_tx(uint8_t iface_type, uint8_t iface_num,
 	else if (buf_handle.if_type == ESP_HCI_IF)
 		pkt_prio = PRIO_Q_BT;
 
+#if ESP_PKT_STATS
+	buf_handle.enq_time_ms = (uint32_t)g_h.funcs->_h_get_time_ms();
+#endif
 	g_h.funcs->_h_queue_item(to_slave_queue[pkt_prio], &buf_handle, HOSTED_BLOCK_MAX);
 	g_h.funcs->_h_post_semaphore(sem_to_slave_queue);
 
@@ -31,6 +31,10 @@
 #include "rpc_wrap.h"
 #include "esp_private/wifi.h"
 
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SDIO
+#include "sdio_drv.h"
+#endif
+
 /**
  * @brief  Slave capabilities are parsed
  *         Currently no added functionality to that
@@ -47,7 +51,6 @@ DEFINE_LOG_TAG(transport);
 static char chip_type = ESP_PRIV_FIRMWARE_CHIP_UNRECOGNIZED;
 void(*transport_esp_hosted_up_cb)(void) = NULL;
 transport_channel_t *chan_arr[ESP_MAX_IF];
-volatile uint8_t wifi_tx_throttling;
 void *bus_handle = NULL;
 
 
@@ -111,8 +114,113 @@ void set_transport_state(uint8_t state)
 	transport_driver_event_handler(state);
 }
 
+/* Per interface Tx flow control.
+ * paused:  co-processor asked to stop sending on this interface
+ * credits: Tx buffers this interface may still queue towards the
+ *          co-processor; taken on Tx, returned when the buffer is freed
+ *          after it is sent on the bus (or dropped) */
+#if H_WIFI_TX_CREDITS
+  #define WIFI_TX_CREDITS H_WIFI_TX_CREDITS
+#else
+  #define WIFI_TX_CREDITS H_TRANSPORT_QUEUE_SIZE
+#endif
+
+typedef struct {
+	volatile uint8_t paused;
+	int32_t credits;
+	void *wait_sem;   /* posted on resume or when credits come back from zero */
+} transport_tx_flow_t;
+
+static transport_tx_flow_t tx_flow[ESP_MAX_IF];
+
+static void transport_tx_flow_init(void)
+{
+	uint8_t if_type = 0;
+
+	for (if_type = ESP_STA_IF; if_type <= ESP_AP_IF; if_type++) {
+		tx_flow[if_type].paused = 0;
+
+		/* Credits are only set up once: on a transport re-init, Tx
+		 * buffers may still be in flight and give their credit back
+		 * when freed, which would overflow a freshly reset window */
+		if (!tx_flow[if_type].wait_sem) {
+			tx_flow[if_type].wait_sem = g_h.funcs->_h_create_semaphore(1);
+			assert(tx_flow[if_type].wait_sem);
+			__atomic_store_n(&tx_flow[if_type].credits, WIFI_TX_CREDITS, __ATOMIC_RELEASE);
+		}
+		/* start with no pending wakeup */
+		g_h.funcs->_h_get_semaphore(tx_flow[if_type].wait_sem, 0);
+	}
+}
+
+static inline bool transport_tx_credit_try_take(uint8_t if_type)
+{
+	transport_tx_flow_t *flow = &tx_flow[if_type];
+
+	if (flow->paused)
+		return false;
+
+	if (__atomic_sub_fetch(&flow->credits, 1, __ATOMIC_ACQ_REL) >= 0)
+		return true;
+
+	__atomic_add_fetch(&flow->credits, 1, __ATOMIC_RELEASE);
+	return false;
+}
+
+static bool transport_tx_credit_take(uint8_t if_type)
+{
+	if (transport_tx_credit_try_take(if_type))
+		return true;
+
+#if H_WIFI_TX_FLOW_CTRL_WAIT_MS
+	/* Opt-in: this blocks the caller, usually the lwIP tcpip thread */
+	g_h.funcs->_h_get_semaphore(tx_flow[if_type].wait_sem, H_WIFI_TX_FLOW_CTRL_WAIT_MS);
+	return transport_tx_credit_try_take(if_type);
+#else
+	return false;
+#endif
+}
+
+static inline void transport_tx_credit_give(uint8_t if_type)
+{
+	/* wake a waiter only when credits come back from zero */
+	if (!__atomic_fetch_add(&tx_flow[if_type].credits, 1, __ATOMIC_ACQ_REL) &&
+	    !tx_flow[if_type].paused)
+		g_h.funcs->_h_post_semaphore(tx_flow[if_type].wait_sem);
+}
+
+void transport_tx_flow_ctrl(uint8_t if_type, uint8_t pause)
+{
+	if (if_type >= ESP_MAX_IF || tx_flow[if_type].paused == pause)
+		return;
+
+	tx_flow[if_type].paused = pause;
+#if ESP_PKT_STATS
+	if (if_type == ESP_STA_IF) {
+		if (pause)
+			pkt_stats.sta_flow_ctrl_on++;
+		else
+			pkt_stats.sta_flow_ctrl_off++;
+	}
+#endif
+	if (!pause && tx_flow[if_type].wait_sem)
+		g_h.funcs->_h_post_semaphore(tx_flow[if_type].wait_sem);
+}
+
+/* Wi-Fi flow control indication from co-processor (H_FLOW_CTRL_*) */
+void transport_wifi_tx_flow_ctrl(uint8_t flow_ctrl)
+{
+	if (flow_ctrl == H_FLOW_CTRL_NC)
+		return;
+
+	transport_tx_flow_ctrl(ESP_STA_IF, flow_ctrl == H_FLOW_CTRL_ON);
+	transport_tx_flow_ctrl(ESP_AP_IF, flow_ctrl == H_FLOW_CTRL_ON);
+}
+
 static void transport_drv_init(void)
 {
+	transport_tx_sched_init();
+	transport_tx_flow_init();
 	bus_handle = bus_init_internal();
 	ESP_LOGD(TAG, "Bus handle: %p", bus_handle);
 	assert(bus_handle);
@@ -319,11 +427,13 @@ static void transport_drv_common_mempool_deinit(void)
 static void transport_sta_free_cb(void *buf)
 {
 	MEMPOOL_FREE(chan_arr[ESP_STA_IF]->memp, buf);
+	transport_tx_credit_give(ESP_STA_IF);
 }
 
 static void transport_ap_free_cb(void *buf)
 {
 	MEMPOOL_FREE(chan_arr[ESP_AP_IF]->memp, buf);
+	transport_tx_credit_give(ESP_AP_IF);
 }
 
 static void transport_serial_free_cb(void *buf)
@@ -353,24 +463,25 @@ static esp_err_t transport_drv_sta_tx(void *h, void *buffer, size_t len)
 #endif
 	}
 
-	if (unlikely(wifi_tx_throttling)) {
+	/* Interface paused by co-processor or out of credits:
+	 * push back to the network stack instead of dropping */
+	if (unlikely(!transport_tx_credit_take(ESP_STA_IF))) {
 	#if ESP_PKT_STATS
-		pkt_stats.sta_tx_flowctrl_drop++;
+		pkt_stats.sta_tx_flowctrl_busy++;
 	#endif
 		errno = -ENOBUFS;
-		//return ESP_ERR_NO_BUFFS;
-#if defined(ESP_ERR_ESP_NETIF_TX_FAILED)
-		return ESP_ERR_ESP_NETIF_TX_FAILED;
-#else
-		return ESP_ERR_ESP_NETIF_NO_MEM;
-#endif
+		return ESP_ERR_NO_MEM;
 	}
 
 	assert(h && h==chan_arr[ESP_STA_IF]->api_chan);
 
-	/*  Prepare transport buffer directly consumable */
-	copy_buff = mempool_alloc(chan_arr[ESP_STA_IF]->memp, MAX_TRANSPORT_BUFFER_SIZE, true);
+	/*  Prepare transport buffer directly consumable.
+	 *  Payload is fully overwritten and bus drivers send header+len, so
+	 *  only the header needs clearing. SPI clocks the whole buffer and
+	 *  clears the tail itself */
+	copy_buff = mempool_alloc(chan_arr[ESP_STA_IF]->memp, MAX_TRANSPORT_BUFFER_SIZE, false);
 	if (!copy_buff) {
+		transport_tx_credit_give(ESP_STA_IF);
 		ESP_LOGW(TAG, "STA TX: mempool_alloc failed, dropping pkt (len=%u)", len);
 #if defined(ESP_ERR_ESP_NETIF_TX_FAILED)
 		return ESP_ERR_ESP_NETIF_TX_FAILED;
@@ -378,6 +489,7 @@ static esp_err_t transport_drv_sta_tx(void *h, void *buffer, size_t len)
 		return ESP_ERR_ESP_NETIF_NO_MEM;
 #endif
 	}
+	g_h.funcs->_h_memset(copy_buff, 0, H_ESP_PAYLOAD_HEADER_OFFSET);
 	g_h.funcs->_h_memcpy(copy_buff+H_ESP_PAYLOAD_HEADER_OFFSET, buffer, len);
 
 	return esp_hosted_tx(ESP_STA_IF, 0, copy_buff, len, H_BUFF_ZEROCOPY, copy_buff, transport_sta_free_cb, 0);
@@ -401,11 +513,20 @@ static esp_err_t transport_drv_ap_tx(void *h, void *buffer, size_t len)
 #endif
 	}
 
+	if (unlikely(!transport_tx_credit_take(ESP_AP_IF))) {
+		errno = -ENOBUFS;
+		return ESP_ERR_NO_MEM;
+	}
+
 	assert(h && h==chan_arr[ESP_AP_IF]->api_chan);
 
-	/*  Prepare transport buffer directly consumable */
-	copy_buff = mempool_alloc(chan_arr[ESP_AP_IF]->memp, MAX_TRANSPORT_BUFFER_SIZE, true);
+	/*  Prepare transport buffer directly consumable.
+	 *  Payload is fully overwritten and bus drivers send header+len, so
+	 *  only the header needs clearing. SPI clocks the whole buffer and
+	 *  clears the tail itself */
+	copy_buff = mempool_alloc(chan_arr[ESP_AP_IF]->memp, MAX_TRANSPORT_BUFFER_SIZE, false);
 	if (!copy_buff) {
+		transport_tx_credit_give(ESP_AP_IF);
 		ESP_LOGW(TAG, "AP TX: mempool_alloc failed, dropping pkt (len=%u)", len);
 #if defined(ESP_ERR_ESP_NETIF_TX_FAILED)
 		return ESP_ERR_ESP_NETIF_TX_FAILED;
@@ -413,6 +534,7 @@ static esp_err_t transport_drv_ap_tx(void *h, void *buffer, size_t len)
 		return ESP_ERR_ESP_NETIF_NO_MEM;
 #endif
 	}
+	g_h.funcs->_h_memset(copy_buff, 0, H_ESP_PAYLOAD_HEADER_OFFSET);
 	g_h.funcs->_h_memcpy(copy_buff+H_ESP_PAYLOAD_HEADER_OFFSET, buffer, len);
 
 	return esp_hosted_tx(ESP_AP_IF, 0, copy_buff, len, H_BUFF_ZEROCOPY, copy_buff, transport_ap_free_cb, 0);
@@ -569,6 +691,9 @@ static void print_ext_capabilities(uint8_t * ptr)
 		ESP_LOGI(TAG, "\t * WLAN");
 	if (cap & ESP_BT_INTERFACE_SUPPORT)
 		ESP_LOGI(TAG, "\t * BT/BLE");
+#elif H_TRANSPORT_IN_USE == H_TRANSPORT_SDIO
+	if (cap & ESP_SDIO_RX_DEAGGREGATION_SUPPORT)
+		ESP_LOGI(TAG, "\t * SDIO Rx de-aggregation");
 #elif H_UART_HOST_TRANSPORT
 	if (cap & ESP_WLAN_UART_SUPPORT)
 		ESP_LOGI(TAG, "\t * WLAN over UART");
@@ -817,6 +942,7 @@ static int process_init_event(uint8_t *evt_buf, uint16_t len)
 	uint8_t raw_tp_config = H_TEST_RAW_TP_DIR;
 	uint32_t ext_cap = 0;
 	uint32_t slave_fw_version = 0;
+	uint8_t slave_rx_q_size = 0;
 
 	if (!evt_buf)
 		return ESP_FAIL;
@@ -865,6 +991,7 @@ static int process_init_event(uint8_t *evt_buf, uint16_t len)
 #endif
 		} else if (*pos == ESP_PRIV_RX_Q_SIZE) {
 			ESP_LOGD(TAG, "slave rx queue size: %u", *(pos + 2));
+			slave_rx_q_size = *(pos + 2);
 		} else if (*pos == ESP_PRIV_TX_Q_SIZE) {
 			ESP_LOGD(TAG, "slave tx queue size: %u", *(pos + 2));
 		} else if (*pos == ESP_PRIV_FIRMWARE_VERSION) {
@@ -951,6 +1078,13 @@ static int process_init_event(uint8_t *evt_buf, uint16_t len)
 #endif
 	}
 
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SDIO
+	sdio_drv_set_tx_aggregation(!!(ext_cap & ESP_SDIO_RX_DEAGGREGATION_SUPPORT),
+			slave_rx_q_size);
+#else
+	(void)slave_rx_q_size;
+#endif
+
 	transport_driver_event_handler(TRANSPORT_TX_ACTIVE);
 
 	ESP_ERROR_CHECK(send_slave_config(0, chip_type, raw_tp_config,
@@ -966,3 +1100,197 @@ int serial_rx_handler(interface_buffer_handle_t * buf_handle)
 {
 	return serial_ll_rx_handler(buf_handle);
 }
+
+/* Rx queues between the bus read task (single producer) and the Rx
+ * process task (single consumer). Any other producer must be serialized
+ * with the read task, as the SPI direct power save transfers are by the
+ * bus lock. With H_RX_SPSC_QUEUE these are
+ * lock-free rings and the counting semaphore is only posted when a
+ * ring turns non-empty, instead of once per packet */
+#if H_RX_SPSC_QUEUE
+typedef struct {
+	void *ring;
+	/* posted by the consumer when it frees a slot of a full ring */
+	void *space_sem;
+} transport_rx_spsc_t;
+#endif
+
+void *transport_rx_queue_create(uint32_t num_elem)
+{
+#if H_RX_SPSC_QUEUE
+	transport_rx_spsc_t *rx_q = g_h.funcs->_h_calloc(1, sizeof(transport_rx_spsc_t));
+
+	if (!rx_q)
+		return NULL;
+
+	rx_q->ring = g_h.funcs->_h_create_spsc_queue(num_elem, sizeof(interface_buffer_handle_t));
+	rx_q->space_sem = g_h.funcs->_h_create_semaphore(1);
+	if (!rx_q->ring || !rx_q->space_sem) {
+		transport_rx_queue_destroy(rx_q);
+		return NULL;
+	}
+
+	return rx_q;
+#else
+	return g_h.funcs->_h_create_queue(num_elem, sizeof(interface_buffer_handle_t));
+#endif
+}
+
+int transport_rx_queue_destroy(void *rx_q)
+{
+#if H_RX_SPSC_QUEUE
+	transport_rx_spsc_t *q = rx_q;
+
+	if (!q)
+		return FAILURE;
+
+	if (q->ring)
+		g_h.funcs->_h_destroy_spsc_queue(q->ring);
+	if (q->space_sem)
+		g_h.funcs->_h_destroy_semaphore(q->space_sem);
+	HOSTED_FREE(q);
+
+	return SUCCESS;
+#else
+	return g_h.funcs->_h_destroy_queue(rx_q);
+#endif
+}
+
+int transport_rx_queue_item(void *rx_q, interface_buffer_handle_t *buf_handle, void *sem)
+{
+#if H_RX_SPSC_QUEUE
+	transport_rx_spsc_t *q = rx_q;
+	bool was_empty = false;
+
+	/* Ring full: sleep until the consumer frees a slot, the same
+	 * behaviour as a blocking queue send */
+	while (g_h.funcs->_h_spsc_queue_item(q->ring, buf_handle, &was_empty))
+		g_h.funcs->_h_get_semaphore(q->space_sem, HOSTED_BLOCK_MAX);
+
+	if (was_empty)
+		g_h.funcs->_h_post_semaphore(sem);
+#else
+	g_h.funcs->_h_queue_item(rx_q, buf_handle, HOSTED_BLOCK_MAX);
+	g_h.funcs->_h_post_semaphore(sem);
+#endif
+	return SUCCESS;
+}
+
+/* Non blocking */
+int transport_rx_dequeue_item(void *rx_q, interface_buffer_handle_t *buf_handle)
+{
+#if H_RX_SPSC_QUEUE
+	transport_rx_spsc_t *q = rx_q;
+	bool was_full = false;
+
+	if (g_h.funcs->_h_spsc_dequeue_item(q->ring, buf_handle, &was_full))
+		return FAILURE;
+
+	if (was_full)
+		g_h.funcs->_h_post_semaphore(q->space_sem);
+
+	return SUCCESS;
+#else
+	return g_h.funcs->_h_dequeue_item(rx_q, buf_handle, 0);
+#endif
+}
+
+/* Wait for the next Rx buffer, checking queues in priority order */
+int transport_rx_dequeue_wait(void *rx_q[MAX_PRIORITY_QUEUES],
+		interface_buffer_handle_t *buf_handle, void *sem)
+{
+#if H_RX_SPSC_QUEUE
+	while (1) {
+		if (!transport_rx_dequeue_item(rx_q[PRIO_Q_SERIAL], buf_handle) ||
+		    !transport_rx_dequeue_item(rx_q[PRIO_Q_BT], buf_handle) ||
+		    !transport_rx_dequeue_item(rx_q[PRIO_Q_OTHERS], buf_handle))
+			return SUCCESS;
+
+		/* All rings drained: next producer push will post */
+		g_h.funcs->_h_get_semaphore(sem, HOSTED_BLOCK_MAX);
+	}
+#else
+	g_h.funcs->_h_get_semaphore(sem, HOSTED_BLOCK_MAX);
+
+	if (transport_rx_dequeue_item(rx_q[PRIO_Q_SERIAL], buf_handle))
+		if (transport_rx_dequeue_item(rx_q[PRIO_Q_BT], buf_handle))
+			if (transport_rx_dequeue_item(rx_q[PRIO_Q_OTHERS], buf_handle)) {
+				ESP_LOGI(TAG, "No element in any queue found");
+				return FAILURE;
+			}
+
+	return SUCCESS;
+#endif
+}
+
+static esp_hosted_tx_sched_t tx_sched;
+
+void transport_tx_sched_init(void)
+{
+#if H_TX_SCHED_DRR
+	const uint16_t quantum[MAX_PRIORITY_QUEUES] = {
+		[PRIO_Q_SERIAL] = H_TX_SCHED_QUANTUM_SERIAL,
+		[PRIO_Q_BT]     = H_TX_SCHED_QUANTUM_BT,
+		[PRIO_Q_OTHERS] = H_TX_SCHED_QUANTUM_OTHERS,
+	};
+
+	esp_hosted_tx_sched_init(&tx_sched, quantum,
+			H_TX_SCHED_SERIAL_STRICT ? BIT(PRIO_Q_SERIAL) : 0);
+#else
+	const uint16_t quantum[MAX_PRIORITY_QUEUES] = {0};
+
+	esp_hosted_tx_sched_init(&tx_sched, quantum, ESP_HOSTED_TX_SCHED_ALL_STRICT);
+#endif
+}
+
+static int transport_tx_try_dequeue(void *ctx, uint8_t q_idx, void *item, uint16_t *len)
+{
+	void **tx_q = (void **)ctx;
+	interface_buffer_handle_t *buf_handle = (interface_buffer_handle_t *)item;
+
+	if (g_h.funcs->_h_dequeue_item(tx_q[q_idx], buf_handle, 0))
+		return FAILURE;
+
+	*len = buf_handle->payload_len;
+	return SUCCESS;
+}
+
+/* Free the Tx buffers still queued, then destroy the queue.
+ * Freeing through their callback gives their Tx credit back, else every
+ * transport restart would lose credits until Tx stalls. Call once the bus
+ * Tx task is stopped. Returns the number of buffers freed */
+int transport_tx_queue_destroy(void *tx_q)
+{
+	interface_buffer_handle_t buf_handle = {0};
+	int count = 0;
+
+	if (!tx_q)
+		return 0;
+
+	while (g_h.funcs->_h_dequeue_item(tx_q, &buf_handle, 0) == 0) {
+		if (buf_handle.priv_buffer_handle && buf_handle.free_buf_handle) {
+			buf_handle.free_buf_handle(buf_handle.priv_buffer_handle);
+			count++;
+		}
+	}
+	g_h.funcs->_h_destroy_queue(tx_q);
+
+	return count;
+}
+
+/* Non blocking. Picks the next Tx buffer across the priority queues,
+ * as per the configured scheduler. Called only from the bus Tx task */
+int transport_tx_dequeue(void *tx_q[MAX_PRIORITY_QUEUES], interface_buffer_handle_t *buf_handle)
+{
+	int q_idx = esp_hosted_tx_sched_dequeue(&tx_sched, transport_tx_try_dequeue,
+			tx_q, buf_handle);
+
+	if (q_idx < 0)
+		return FAILURE;
+
+#if ESP_PKT_STATS
+	esp_hosted_tx_sched_stats_update(&pkt_stats.tx_sched[q_idx], buf_handle->payload_len,
+			(uint32_t)g_h.funcs->_h_get_time_ms() - buf_handle->enq_time_ms);
+#endif
+	return SUCCESS;
+}
@@ -17,6 +17,7 @@ extern "C" {
 #include "esp_err.h"
 
 #include "esp_hosted_transport.h"
+#include "esp_hosted_tx_sched.h"
 #include "esp_hosted_api_types.h"
 #include "esp_hosted_interface.h"
 #include "esp_hosted_header.h"
@@ -94,6 +95,10 @@ typedef struct {
 	uint16_t seq_num;
 	/* no need of memcpy at different layers */
 	uint8_t payload_zcopy;
+#if ESP_PKT_STATS
+	/* time queued for Tx, for scheduler wait stats */
+	uint32_t enq_time_ms;
+#endif
 
 	void (*free_buf_handle)(void *buf_handle);
 } interface_buffer_handle_t;
@@ -110,7 +115,8 @@ struct hosted_transport_context_t {
 	uint8_t  *rx_buf;
 };
 
-extern volatile uint8_t wifi_tx_throttling;
+void transport_tx_flow_ctrl(uint8_t if_type, uint8_t pause);
+void transport_wifi_tx_flow_ctrl(uint8_t flow_ctrl);
 
 typedef int (*hosted_rxcb_t)(void *buffer, uint16_t len, void *free_buff_hdl);
 
@@ -161,6 +167,17 @@ int esp_hosted_tx(uint8_t iface_type, uint8_t iface_num,
 		uint8_t *buffer_to_free, void (*free_buf_func)(void *ptr), uint8_t flags);
 
 int serial_rx_handler(interface_buffer_handle_t * buf_handle);
+
+void *transport_rx_queue_create(uint32_t num_elem);
+int transport_rx_queue_destroy(void *rx_q);
+int transport_rx_queue_item(void *rx_q, interface_buffer_handle_t *buf_handle, void *sem);
+int transport_rx_dequeue_item(void *rx_q, interface_buffer_handle_t *buf_handle);
+int transport_rx_dequeue_wait(void *rx_q[MAX_PRIORITY_QUEUES],
+		interface_buffer_handle_t *buf_handle, void *sem);
+
+void transport_tx_sched_init(void);
+int transport_tx_dequeue(void *tx_q[MAX_PRIORITY_QUEUES], interface_buffer_handle_t *buf_handle);
+int transport_tx_queue_destroy(void *tx_q);
 void set_transport_state(uint8_t state);
 
 int ensure_slave_bus_ready(void *bus_handle);
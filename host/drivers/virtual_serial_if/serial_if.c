@@ -210,8 +210,8 @@ free_bufs2:
 	return FAILURE;
 }
 
-uint8_t * transport_pserial_read(uint32_t *out_nbyte)
+uint8_t * transport_pserial_read(uint8_t **out_payload, uint32_t *out_nbyte)
 {
 	/* Two step parsing TLV is moved in serial_drv_read */
-	return serial_drv_read(serial_handle, out_nbyte);
+	return serial_drv_read(serial_handle, out_payload, out_nbyte);
 }
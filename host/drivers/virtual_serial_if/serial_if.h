@@ -44,7 +44,9 @@ int transport_pserial_close(void);
  **/
 int transport_pserial_send(uint8_t* data, uint16_t data_length);
 
-/* Read and return number of bytes and buffer from serial interface
+/* Read buffer from serial interface.
+ * Payload and its length are returned in out_payload and out_nbyte.
+ * Returned buffer holds the payload and is to be freed by caller
  **/
-uint8_t * transport_pserial_read(uint32_t *out_nbyte);
+uint8_t * transport_pserial_read(uint8_t **out_payload, uint32_t *out_nbyte);
 #endif
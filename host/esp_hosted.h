@@ -19,6 +19,8 @@ extern "C" {
 #include "esp_hosted_event.h"
 #include "esp_hosted_cp_gpio.h"
 #include "esp_hosted_cp_ext_coex.h"
+#include "esp_hosted_cp_nw_split.h"
+#include "esp_hosted_wifi_async.h"
 
 typedef struct esp_hosted_transport_config esp_hosted_config_t;
 
@@ -56,6 +58,12 @@ int esp_hosted_get_cp_info(uint32_t *cp_chip_id, char *cp_target_name, size_t cp
  * 8. OpenThread RCP API
  *    File : host/api/include/esp_hosted_openthread.h
  *
+ * 9. Non-blocking Wi-Fi API
+ *    File : host/api/include/esp_hosted_wifi_async.h
+ *
+ * 10. Network Split port forwarding API
+ *    File : host/api/include/esp_hosted_cp_nw_split.h
+ *
  */
 
 #ifdef __cplusplus
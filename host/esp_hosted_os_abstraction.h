@@ -114,6 +114,12 @@ typedef struct {
 /* 64 */ int (*_h_config_host_power_save_hal_impl)(uint32_t power_save_type, void* gpio_port, uint32_t gpio_num, int level);
 /* 65 */ int (*_h_start_host_power_save_hal_impl)(uint32_t power_save_type);
 /* 66 */ int (*_h_event_post)(esp_event_base_t event_base, int32_t event_id, void* event_data, size_t event_data_size, uint32_t ticks_to_wait);
+
+         /* Lock-free single producer / single consumer queue */
+/* 67 */ void* (*_h_create_spsc_queue)(uint32_t qnum_elem, uint32_t qitem_size);
+/* 68 */ int (*_h_spsc_queue_item)(void * queue_handle, void *item, bool *was_empty);
+/* 69 */ int (*_h_spsc_dequeue_item)(void * queue_handle, void *item, bool *was_full);
+/* 70 */ int (*_h_destroy_spsc_queue)(void * queue_handle);
 } hosted_osi_funcs_t;
 
 struct hosted_config_t {
@@ -130,9 +130,53 @@ enum {
   #define H_USE_MEMPOOL 0
 #endif
 
+#if CONFIG_ESP_HOSTED_RX_SPSC_QUEUE
+  #define H_RX_SPSC_QUEUE 1
+#else
+  #define H_RX_SPSC_QUEUE 0
+#endif
+
+#define H_WIFI_TX_CREDITS                            CONFIG_ESP_HOSTED_WIFI_TX_CREDITS
+#define H_WIFI_TX_FLOW_CTRL_WAIT_MS                  CONFIG_ESP_HOSTED_WIFI_TX_FLOW_CTRL_WAIT_MS
+
+#if CONFIG_ESP_HOSTED_TX_SCHED_DRR
+  #define H_TX_SCHED_DRR 1
+  #define H_TX_SCHED_QUANTUM_SERIAL                  CONFIG_ESP_HOSTED_TX_SCHED_QUANTUM_SERIAL
+  #define H_TX_SCHED_QUANTUM_BT                      CONFIG_ESP_HOSTED_TX_SCHED_QUANTUM_BT
+  #define H_TX_SCHED_QUANTUM_OTHERS                  CONFIG_ESP_HOSTED_TX_SCHED_QUANTUM_OTHERS
+  #if CONFIG_ESP_HOSTED_TX_SCHED_SERIAL_STRICT
+    #define H_TX_SCHED_SERIAL_STRICT 1
+  #else
+    #define H_TX_SCHED_SERIAL_STRICT 0
+  #endif
+#else
+  #define H_TX_SCHED_DRR 0
+#endif
+
 #define H_MAX_SYNC_RPC_REQUESTS                      CONFIG_ESP_HOSTED_MAX_SIMULTANEOUS_SYNC_RPC_REQUESTS
 #define H_MAX_ASYNC_RPC_REQUESTS                     CONFIG_ESP_HOSTED_MAX_SIMULTANEOUS_ASYNC_RPC_REQUESTS
 
+#if CONFIG_ESP_HOSTED_RPC_PREALLOC
+  #define H_RPC_PREALLOC 1
+  #define H_RPC_CMD_POOL_SIZE                        CONFIG_ESP_HOSTED_RPC_CMD_POOL_SIZE
+  #define H_RPC_TX_ARENA_SIZE                        CONFIG_ESP_HOSTED_RPC_TX_ARENA_SIZE
+  #define H_RPC_RX_ARENA_SIZE                        CONFIG_ESP_HOSTED_RPC_RX_ARENA_SIZE
+#else
+  #define H_RPC_PREALLOC 0
+#endif
+
+#if CONFIG_ESP_HOSTED_RPC_WIFI_CACHE
+  #define H_RPC_WIFI_CACHE 1
+#else
+  #define H_RPC_WIFI_CACHE 0
+#endif
+
+#if CONFIG_ESP_HOSTED_RPC_COALESCE
+  #define H_RPC_COALESCE 1
+#else
+  #define H_RPC_COALESCE 0
+#endif
+
 #undef H_TRANSPORT_IN_USE
 
 #ifdef CONFIG_ESP_HOSTED_SPI_HOST_INTERFACE
@@ -257,6 +301,21 @@ enum {
 
   #define H_SDIO_CHECKSUM                              CONFIG_ESP_HOSTED_SDIO_CHECKSUM
 
+  /* Number of Rx buffers between SDIO read and Rx packet split tasks */
+  #define H_SDIO_RX_RING_SIZE                          CONFIG_ESP_HOSTED_SDIO_RX_RING_SIZE
+
+  /* Aggregate queued Tx packets into a single SDIO transfer
+   * Used only when co-processor advertises ESP_SDIO_RX_DEAGGREGATION_SUPPORT */
+  #ifdef CONFIG_ESP_HOSTED_SDIO_TX_AGGREGATION
+    #define H_SDIO_TX_AGGREGATION                      1
+    #define H_SDIO_TX_AGGR_MAX_PKTS                    CONFIG_ESP_HOSTED_SDIO_TX_AGGR_MAX_PKTS
+    #define H_SDIO_TX_AGGR_MAX_BUFS                    CONFIG_ESP_HOSTED_SDIO_TX_AGGR_MAX_BUFS
+  #else
+    #define H_SDIO_TX_AGGREGATION                      0
+    #define H_SDIO_TX_AGGR_MAX_PKTS                    1
+    #define H_SDIO_TX_AGGR_MAX_BUFS                    1
+  #endif
+
   #define H_SDIO_HOST_STREAMING_MODE 1
   #define H_SDIO_ALWAYS_HOST_RX_MAX_TRANSPORT_SIZE 2
   #define H_SDIO_OPTIMIZATION_RX_NONE 3
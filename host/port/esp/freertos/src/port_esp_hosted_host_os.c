@@ -18,6 +18,7 @@
 #include "port_esp_hosted_host_config.h"
 #include "port_esp_hosted_host_wifi_config.h"
 #include "port_esp_hosted_host_log.h"
+#include "hosted_spsc_ring.h"
 #include "esp_hosted_power_save.h"
 
 #if H_HOST_PS_ALLOWED
@@ -388,6 +389,78 @@ int hosted_reset_queue(void * queue_handle)
 	return xQueueReset(*q_id);
 }
 
+/* -------- SPSC Queue --------------- */
+void * hosted_create_spsc_queue(uint32_t qnum_elem, uint32_t qitem_size)
+{
+	hosted_spsc_ring_t *q = NULL;
+	uint8_t *items = NULL;
+
+	if (!qnum_elem || !qitem_size) {
+		ESP_LOGE(TAG, "Invalid SPSC Q params\n");
+		return NULL;
+	}
+
+	q = (hosted_spsc_ring_t *)hosted_calloc(1, sizeof(hosted_spsc_ring_t));
+	if (!q) {
+		ESP_LOGE(TAG, "SPSC Q allocation failed\n");
+		return NULL;
+	}
+
+	items = (uint8_t *)hosted_malloc(hosted_spsc_ring_capacity(qnum_elem) * qitem_size);
+	if (!items) {
+		ESP_LOGE(TAG, "SPSC Q items allocation failed\n");
+		HOSTED_FREE(q);
+		return NULL;
+	}
+
+	hosted_spsc_ring_init(q, items, qnum_elem, qitem_size);
+
+	return q;
+}
+
+/* Producer side. Never blocks: returns RET_FAIL if the ring is full */
+int hosted_spsc_queue_item(void * queue_handle, void *item, bool *was_empty)
+{
+	if (!queue_handle || !item) {
+		ESP_LOGE(TAG, "Uninitialized SPSC Q id 1\n");
+		return RET_INVALID;
+	}
+
+	if (hosted_spsc_ring_push((hosted_spsc_ring_t *)queue_handle, item, was_empty))
+		return RET_FAIL;
+
+	return RET_OK;
+}
+
+/* Consumer side. Never blocks: returns RET_FAIL if the ring is empty */
+int hosted_spsc_dequeue_item(void * queue_handle, void *item, bool *was_full)
+{
+	if (!queue_handle || !item) {
+		ESP_LOGE(TAG, "Uninitialized SPSC Q id 2\n");
+		return RET_INVALID;
+	}
+
+	if (hosted_spsc_ring_pop((hosted_spsc_ring_t *)queue_handle, item, was_full))
+		return RET_FAIL;
+
+	return RET_OK;
+}
+
+int hosted_destroy_spsc_queue(void * queue_handle)
+{
+	hosted_spsc_ring_t *q = (hosted_spsc_ring_t *)queue_handle;
+
+	if (!q) {
+		ESP_LOGE(TAG, "Uninitialized SPSC Q id 3\n");
+		return RET_INVALID;
+	}
+
+	HOSTED_FREE(q->items);
+	HOSTED_FREE(q);
+
+	return RET_OK;
+}
+
 /* -------- Mutex --------------- */
 
 int hosted_unlock_mutex(void * mutex_handle)
@@ -1026,4 +1099,8 @@ hosted_osi_funcs_t g_hosted_osi_funcs = {
 	._h_config_host_power_save_hal_impl = hosted_config_host_power_save,
 	._h_start_host_power_save_hal_impl = hosted_start_host_power_save,
 	._h_event_post               =  hosted_event_post              ,
+	._h_create_spsc_queue        =  hosted_create_spsc_queue       ,
+	._h_spsc_queue_item          =  hosted_spsc_queue_item         ,
+	._h_spsc_dequeue_item        =  hosted_spsc_dequeue_item       ,
+	._h_destroy_spsc_queue       =  hosted_destroy_spsc_queue      ,
 };
@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __HOSTED_SPSC_RING__H
+#define __HOSTED_SPSC_RING__H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Lock-free ring for exactly one producer task and one consumer task.
+ * head is only written by the producer and tail only by the consumer,
+ * so no lock or critical section is needed. Both indices run freely
+ * and are masked with (capacity - 1), capacity being a power of two.
+ *
+ * Kept free of OS calls so that it also builds on a Linux host,
+ * see tools/bench/spsc_bench.c */
+typedef struct {
+	uint8_t *items;
+	uint32_t item_size;
+	uint32_t mask;
+	uint32_t head;
+	uint32_t tail;
+} hosted_spsc_ring_t;
+
+/* Number of item slots to allocate for at least qnum_elem items */
+static inline uint32_t hosted_spsc_ring_capacity(uint32_t qnum_elem)
+{
+	uint32_t capacity = 1;
+
+	while (capacity < qnum_elem)
+		capacity <<= 1;
+
+	return capacity;
+}
+
+/* items must hold hosted_spsc_ring_capacity(qnum_elem) * item_size bytes */
+static inline void hosted_spsc_ring_init(hosted_spsc_ring_t *r, uint8_t *items,
+		uint32_t qnum_elem, uint32_t item_size)
+{
+	r->items = items;
+	r->item_size = item_size;
+	r->mask = hosted_spsc_ring_capacity(qnum_elem) - 1;
+	r->head = 0;
+	r->tail = 0;
+}
+
+/* Producer side. Never blocks: returns -1 if the ring is full.
+ * was_empty is set when the consumer had drained the ring before this
+ * item got published, i.e. the only case where it may be waiting */
+static inline int hosted_spsc_ring_push(hosted_spsc_ring_t *r, const void *item,
+		bool *was_empty)
+{
+	uint32_t head = __atomic_load_n(&r->head, __ATOMIC_RELAXED);
+	uint32_t tail = __atomic_load_n(&r->tail, __ATOMIC_SEQ_CST);
+
+	if (head - tail > r->mask)
+		return -1;
+
+	memcpy(r->items + (head & r->mask) * r->item_size, item, r->item_size);
+	__atomic_store_n(&r->head, head + 1, __ATOMIC_SEQ_CST);
+
+	if (was_empty) {
+		/* tail re-read after head is published: a consumer that found
+		 * the ring empty is either already counted here or will see
+		 * the new item on its own */
+		tail = __atomic_load_n(&r->tail, __ATOMIC_SEQ_CST);
+		*was_empty = (tail == head);
+	}
+
+	return 0;
+}
+
+/* Consumer side. Never blocks: returns -1 if the ring is empty.
+ * was_full is set when this item freed the slot of a full ring, i.e.
+ * the only case where the producer may be waiting for room */
+static inline int hosted_spsc_ring_pop(hosted_spsc_ring_t *r, void *item,
+		bool *was_full)
+{
+	uint32_t tail = __atomic_load_n(&r->tail, __ATOMIC_RELAXED);
+	uint32_t head = __atomic_load_n(&r->head, __ATOMIC_SEQ_CST);
+
+	if (head == tail)
+		return -1;
+
+	memcpy(item, r->items + (tail & r->mask) * r->item_size, r->item_size);
+	__atomic_store_n(&r->tail, tail + 1, __ATOMIC_SEQ_CST);
+
+	if (was_full) {
+		/* head re-read after tail is published: a producer that found
+		 * the ring full is either already counted here or will see
+		 * the free slot on its own */
+		head = __atomic_load_n(&r->head, __ATOMIC_SEQ_CST);
+		*was_full = (head - tail > r->mask);
+	}
+
+	return 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -14,6 +14,8 @@
 #include "esp_hosted_transport_init.h"
 #include "esp_hosted_os_abstraction.h"
 #include "port_esp_hosted_host_os.h"
+#include "rpc_mem.h"
+#include "rpc_wrap.h"
 
 // use mempool and zero copy for Tx
 #include "mempool.h"
@@ -216,10 +218,45 @@ struct mem_stats h_stats_g;
 #if ESP_PKT_STATS
 void stats_timer_func(void * arg)
 {
-	ESP_LOGI(TAG, "STA: s2h{in[%lu] out[%lu]} h2s{in(flowctrl_drop[%lu] in[%lu or %lu]) out(ok[%lu] drop[%lu])} flwctl{on[%lu] off[%lu]}",
+	struct rpc_mem_stats rpc_mem = {0};
+
+	ESP_LOGI(TAG, "STA: s2h{in[%lu] out[%lu]} h2s{in(flowctrl_busy[%lu] in[%lu or %lu]) out(ok[%lu] drop[%lu])} flwctl{on[%lu] off[%lu]}",
 			pkt_stats.sta_rx_in,pkt_stats.sta_rx_out,
-			pkt_stats.sta_tx_flowctrl_drop, pkt_stats.sta_tx_in_pass, pkt_stats.sta_tx_trans_in,  pkt_stats.sta_tx_out, pkt_stats.sta_tx_out_drop,
+			pkt_stats.sta_tx_flowctrl_busy, pkt_stats.sta_tx_in_pass, pkt_stats.sta_tx_trans_in,  pkt_stats.sta_tx_out, pkt_stats.sta_tx_out_drop,
 			pkt_stats.sta_flow_ctrl_on, pkt_stats.sta_flow_ctrl_off);
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SDIO && H_SDIO_TX_AGGREGATION
+	ESP_LOGI(TAG, "SDIO Tx aggr: xfers[%lu] pkts[%lu]",
+			pkt_stats.sdio_tx_aggr_xfers, pkt_stats.sdio_tx_aggr_pkts);
+#endif
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SDIO
+	ESP_LOGI(TAG, "SDIO Tx credits: cached[%lu] reg_read[%lu] rx_refresh[%lu]",
+			pkt_stats.sdio_tx_credit_hits, pkt_stats.sdio_tx_credit_reg_reads,
+			pkt_stats.sdio_tx_credit_piggyback);
+#if H_SDIO_HOST_RX_MODE == H_SDIO_HOST_STREAMING_MODE
+	ESP_LOGI(TAG, "SDIO Rx nw frames without extra copy[%lu]",
+			pkt_stats.sdio_rx_nw_direct);
+#endif
+	ESP_LOGI(TAG, "SDIO Rx ring[%u]: hwm[%lu] full[%lu]", H_SDIO_RX_RING_SIZE,
+			pkt_stats.sdio_rx_ring_hwm, pkt_stats.sdio_rx_ring_full);
+#endif
+	for (int q = 0; q < MAX_PRIORITY_QUEUES; q++) {
+		struct esp_hosted_tx_sched_q_stats *st = &pkt_stats.tx_sched[q];
+
+		ESP_LOGI(TAG, "Tx sched q[%d]: pkts[%lu] bytes[%lu] wait avg[%lu ms] max[%lu ms]",
+				q, st->pkts, st->bytes,
+				st->pkts ? st->wait_total_ms / st->pkts : 0, st->wait_max_ms);
+	}
+	rpc_mem_get_stats(&rpc_mem);
+	ESP_LOGI(TAG, "RPC mem: pool[%lu] heap[%lu] serial heap[%lu]",
+			rpc_mem.pool_allocs, rpc_mem.heap_allocs, rpc_mem.serial_allocs);
+#if H_RPC_WIFI_CACHE
+	{
+		struct rpc_wifi_cache_stats cache = {0};
+
+		rpc_wifi_cache_get_stats(&cache);
+		ESP_LOGI(TAG, "RPC Wi-Fi cache: hit[%lu] miss[%lu]", cache.hits, cache.misses);
+	}
+#endif
 	ESP_LOGI(TAG, "internal: free %d l-free %d min-free %d, psram: free %d l-free %d min-free %d",
 			heap_caps_get_free_size(MALLOC_CAP_8BIT) - heap_caps_get_free_size(MALLOC_CAP_SPIRAM),
 			heap_caps_get_largest_free_block(MALLOC_CAP_8BIT | MALLOC_CAP_INTERNAL),
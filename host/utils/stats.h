@@ -8,6 +8,7 @@
 #define __STATS__H
 
 #include "port_esp_hosted_host_config.h"
+#include "esp_hosted_tx_sched.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -125,11 +126,20 @@ struct pkt_stats_t {
 	uint32_t sta_rx_out;
 	uint32_t sta_tx_in_pass;
 	uint32_t sta_tx_trans_in;
-	uint32_t sta_tx_flowctrl_drop;
+	uint32_t sta_tx_flowctrl_busy;
 	uint32_t sta_tx_out;
 	uint32_t sta_tx_out_drop;
 	uint32_t sta_flow_ctrl_on;
 	uint32_t sta_flow_ctrl_off;
+	uint32_t sdio_tx_aggr_xfers;
+	uint32_t sdio_tx_aggr_pkts;
+	uint32_t sdio_tx_credit_hits;
+	uint32_t sdio_tx_credit_reg_reads;
+	uint32_t sdio_tx_credit_piggyback;
+	uint32_t sdio_rx_nw_direct;
+	uint32_t sdio_rx_ring_hwm;
+	uint32_t sdio_rx_ring_full;
+	struct esp_hosted_tx_sched_q_stats tx_sched[MAX_PRIORITY_QUEUES];
 };
 
 extern struct pkt_stats_t pkt_stats;
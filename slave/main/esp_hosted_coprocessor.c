@@ -44,6 +44,7 @@
 #include "slave_bt.h"
 #endif
 #include "stats.h"
+#include "esp_hosted_tx_sched.h"
 #include "esp_mac.h"
 #include "esp_timer.h"
 #include "mempool.h"
@@ -51,6 +52,9 @@
 #include "esp_hosted_coprocessor_fw_ver.h"
 #include "esp_hosted_cli.h"
 #include "host_power_save.h"
+#if CONFIG_ESP_SDIO_HOST_INTERFACE
+#include "sdio_slave_api.h"
+#endif
 #ifdef CONFIG_EXAMPLE_PEER_DATA_TRANSFER
 #include "example_peer_data_transfer.h"
 #endif
@@ -61,6 +65,13 @@
 #if CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED
     #include "nw_split_router.h"
 	#include "esp_hosted_rpc.pb-c.h"
+	#include "esp_netif_net_stack.h"
+	#include "lwip/netif.h"
+	#include "lwip/pbuf.h"
+	#include "lwip/def.h"
+	#include "lwip/prot/ethernet.h"
+	#include "lwip/prot/ip.h"
+	#include "lwip/prot/ip4.h"
 	volatile uint8_t station_got_ip = 0;
 	#define H_SLAVE_LWIP_DHCP_AT_SLAVE       1
 #endif
@@ -71,7 +82,11 @@
 
 static const char *TAG = "co-pro-main";
 
+#if CONFIG_ESP_TX_SCHED_BYPASS
 #define BYPASS_TX_PRIORITY_Q 1
+#else
+#define BYPASS_TX_PRIORITY_Q 0
+#endif
 
 #define UNKNOWN_RPC_MSG_ID               0
 
@@ -92,6 +107,7 @@ slave_state_t  slv_state_g;
 #if !BYPASS_TX_PRIORITY_Q
 static QueueHandle_t meta_to_host_queue = NULL;
 static QueueHandle_t to_host_queue[MAX_PRIORITY_QUEUES] = {NULL};
+static esp_hosted_tx_sched_t to_host_sched;
 #endif
 
 esp_netif_t *slave_sta_netif = NULL;
@@ -195,6 +211,11 @@ static uint32_t get_capabilities_ext(void)
 #endif // CONFIG_ESP_HOSTED_CP_WIFI
 #endif
 
+#if CONFIG_ESP_SDIO_HOST_INTERFACE && !SIMPLIFIED_SDIO_SLAVE
+	ESP_LOGI(TAG, "- SDIO Rx de-aggregation");
+	ext_cap |= ESP_SDIO_RX_DEAGGREGATION_SUPPORT;
+#endif
+
 #if CONFIG_ESP_UART_HOST_INTERFACE
 #ifdef CONFIG_ESP_HOSTED_CP_WIFI
 	ESP_LOGI(TAG, "- WLAN over UART");
@@ -242,6 +263,113 @@ static inline esp_err_t populate_buff_handle(interface_buffer_handle_t *buf_hand
 #define populate_wifi_buffer_handle(Buf_hdL, TypE, BuF, LeN) \
 	populate_buff_handle(Buf_hdL, TypE, BuF, LeN, esp_wifi_internal_free_rx_buffer, eb, 0, 0, 0);
 
+#ifdef CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED
+/* Wi-Fi Rx buffer shared by slave lwIP and the host.
+ * The buffer goes back to Wi-Fi once both dropped their reference.
+ * Only few packets (ARP, ICMP and DHCP replies) are shared at a time.
+ * lwIP may write into the input buffer (TCP swaps header fields to host
+ * order, IP reassembly reuses fragment headers), so only frames it
+ * leaves untouched are shared, see sta_rx_can_share() */
+#define STA_RX_SHARED_NUM 8
+
+typedef struct {
+	struct pbuf_custom p;  /* slave lwIP reference, keep first */
+	void *eb;
+	uint8_t refs;
+	uint8_t in_use;
+} sta_rx_shared_t;
+
+static sta_rx_shared_t sta_rx_shared[STA_RX_SHARED_NUM];
+
+static sta_rx_shared_t *sta_rx_shared_get(void *eb)
+{
+	uint8_t expected = 0;
+	int i = 0;
+
+	for (i = 0; i < STA_RX_SHARED_NUM; i++) {
+		expected = 0;
+		if (__atomic_compare_exchange_n(&sta_rx_shared[i].in_use, &expected, 1,
+				false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+			sta_rx_shared[i].eb = eb;
+			sta_rx_shared[i].refs = 2;
+			return &sta_rx_shared[i];
+		}
+	}
+	return NULL;
+}
+
+static void sta_rx_shared_put(void *priv)
+{
+	sta_rx_shared_t *shared = (sta_rx_shared_t *)priv;
+
+	if (__atomic_sub_fetch(&shared->refs, 1, __ATOMIC_ACQ_REL))
+		return;
+
+	esp_wifi_internal_free_rx_buffer(shared->eb);
+	__atomic_store_n(&shared->in_use, 0, __ATOMIC_RELEASE);
+}
+
+static void sta_rx_shared_pbuf_free(struct pbuf *p)
+{
+	sta_rx_shared_put((sta_rx_shared_t *)p);
+}
+
+/* Unfragmented ARP, ICMP and UDP, which slave lwIP only reads */
+static bool sta_rx_can_share(const void *buffer, uint16_t len)
+{
+	const struct eth_hdr *ethhdr = (const struct eth_hdr *)buffer;
+	const struct ip_hdr *iphdr = NULL;
+	uint8_t proto = 0;
+
+	if (len < SIZEOF_ETH_HDR + IP_HLEN)
+		return false;
+
+	if (ethhdr->type == PP_HTONS(ETHTYPE_ARP))
+		return true;
+	if (ethhdr->type != PP_HTONS(ETHTYPE_IP))
+		return false;
+
+	iphdr = (const struct ip_hdr *)((const uint8_t *)buffer + SIZEOF_ETH_HDR);
+	if (IPH_OFFSET(iphdr) & PP_HTONS(IP_MF | IP_OFFMASK))
+		return false;
+
+	proto = IPH_PROTO(iphdr);
+	return (proto == IP_PROTO_ICMP) || (proto == IP_PROTO_UDP);
+}
+
+/* Hand the slave reference to lwIP, like esp_netif_receive() does with eb */
+static void sta_rx_shared_to_slave(sta_rx_shared_t *shared, void *buffer, uint16_t len)
+{
+	struct netif *netif = slave_sta_netif ? esp_netif_get_netif_impl(slave_sta_netif) : NULL;
+	struct pbuf *p = NULL;
+
+	if (!netif || !netif_is_up(netif)) {
+		ESP_LOGW(TAG, "slave_sta_netif not init, drop slave part of packet");
+		sta_rx_shared_put(shared);
+		return;
+	}
+
+#if CONFIG_LWIP_L2_TO_L3_COPY
+	/* lwIP keeps its own copy anyway */
+	p = pbuf_alloc(PBUF_RAW, len, PBUF_RAM);
+	if (p)
+		pbuf_take(p, buffer, len);
+	sta_rx_shared_put(shared);
+#else
+	shared->p.custom_free_function = sta_rx_shared_pbuf_free;
+	p = pbuf_alloced_custom(PBUF_RAW, len, PBUF_REF, &shared->p, buffer, len);
+	if (!p)
+		sta_rx_shared_put(shared);
+#endif
+	if (!p)
+		return;
+
+	/* on error, pbuf_free() drops the reference */
+	if (netif->input(p, netif) != ERR_OK)
+		pbuf_free(p);
+}
+#endif
+
 esp_err_t wlan_ap_rx_callback(void *buffer, uint16_t len, void *eb)
 {
 	interface_buffer_handle_t buf_handle = {0};
@@ -343,32 +471,49 @@ esp_err_t wlan_sta_rx_callback(void *buffer, uint16_t len, void *eb)
     #endif
 			break;
 
-		case BOTH_LWIP_BRIDGE:
+		case BOTH_LWIP_BRIDGE: {
+			sta_rx_shared_t *shared = NULL;
+
 			ESP_LOGV(TAG, "slave & host packet");
 
-			void * copy_buff = malloc(len);
-			assert(copy_buff);
-			memcpy(copy_buff, buffer, len);
+			if (sta_rx_can_share(buffer, len))
+				shared = sta_rx_shared_get(eb);
 
-			/* slave LWIP */
-			if (!slave_sta_netif) {
-				ESP_LOGW(TAG, "slave_sta_netif not init, drop slave part of packet");
-				if (eb) {
+			if (!shared) {
+				/* lwIP may modify it, or all shared buffers in flight:
+				 * the host gets a copy */
+				void *copy_buff = malloc(len);
+
+				if (copy_buff)
+					memcpy(copy_buff, buffer, len);
+
+				if (!slave_sta_netif) {
+					ESP_LOGW(TAG, "slave_sta_netif not init, drop slave part of packet");
 					esp_wifi_internal_free_rx_buffer(eb);
+				} else {
+					esp_netif_receive(slave_sta_netif, buffer, len, eb);
+					//netif would free eb after processing
 				}
-			} else {
-				esp_netif_receive(slave_sta_netif, buffer, len, eb);
-				//netif would free eb after processing
-			}
-
-			ESP_LOGV(TAG, "slave & host packet");
 
-			/* Host LWIP, free up wifi buffers */
-			populate_buff_handle(&buf_handle, ESP_STA_IF, copy_buff, len, free, copy_buff, 0, 0, 0);
-			if (unlikely(send_to_host_queue(&buf_handle, PRIO_Q_OTHERS))) {
-				/* Free copy_buff since we couldn't queue it */
-				free(copy_buff);
-				return ESP_OK;
+				if (!copy_buff) {
+					ESP_LOGW(TAG, "no mem, drop host part of packet");
+					return ESP_OK;
+				}
+				populate_buff_handle(&buf_handle, ESP_STA_IF, copy_buff, len, free, copy_buff, 0, 0, 0);
+				if (unlikely(send_to_host_queue(&buf_handle, PRIO_Q_OTHERS))) {
+					free(copy_buff);
+					return ESP_OK;
+				}
+			} else {
+				sta_rx_shared_to_slave(shared, buffer, len);
+
+				/* Host LWIP, wifi buffer freed with the last reference */
+				populate_buff_handle(&buf_handle, ESP_STA_IF, buffer, len,
+						sta_rx_shared_put, shared, 0, 0, 0);
+				if (unlikely(send_to_host_queue(&buf_handle, PRIO_Q_OTHERS))) {
+					sta_rx_shared_put(shared);
+					return ESP_OK;
+				}
 			}
 
     #if ESP_PKT_STATS
@@ -376,6 +521,13 @@ esp_err_t wlan_sta_rx_callback(void *buffer, uint16_t len, void *eb)
 			pkt_stats.sta_both_lwip_out++;
     #endif
 			break;
+		}
+
+		case HOST_HOLD_BRIDGE:
+		case HOST_HOLD_WAKE_BRIDGE:
+			/* Host power saving, keep a copy till it wakes up */
+			nw_split_host_hold(buffer, len, bridge_to_use == HOST_HOLD_WAKE_BRIDGE);
+			goto DONE;
 
 		default:
 			ESP_LOGV(TAG, "Packet filtering failed, drop packet");
@@ -454,11 +606,43 @@ static void process_tx_pkt(interface_buffer_handle_t *buf_handle)
 }
 
 #if !BYPASS_TX_PRIORITY_Q
+static void to_host_sched_init(void)
+{
+#if CONFIG_ESP_TX_SCHED_DRR
+	const uint16_t quantum[MAX_PRIORITY_QUEUES] = {
+		[PRIO_Q_SERIAL] = CONFIG_ESP_TX_SCHED_QUANTUM_SERIAL,
+		[PRIO_Q_BT]     = CONFIG_ESP_TX_SCHED_QUANTUM_BT,
+		[PRIO_Q_OTHERS] = CONFIG_ESP_TX_SCHED_QUANTUM_OTHERS,
+	};
+#if CONFIG_ESP_TX_SCHED_SERIAL_STRICT
+	esp_hosted_tx_sched_init(&to_host_sched, quantum, BIT(PRIO_Q_SERIAL));
+#else
+	esp_hosted_tx_sched_init(&to_host_sched, quantum, 0);
+#endif
+#else
+	const uint16_t quantum[MAX_PRIORITY_QUEUES] = {0};
+
+	esp_hosted_tx_sched_init(&to_host_sched, quantum, ESP_HOSTED_TX_SCHED_ALL_STRICT);
+#endif
+}
+
+static int to_host_try_dequeue(void *ctx, uint8_t q_idx, void *item, uint16_t *len)
+{
+	interface_buffer_handle_t *buf_handle = item;
+
+	if (pdFALSE == xQueueReceive(to_host_queue[q_idx], buf_handle, 0))
+		return ESP_FAIL;
+
+	*len = buf_handle->payload_len;
+	return ESP_OK;
+}
+
 /* Send data to host */
 static void send_task(void* pvParameters)
 {
 	uint8_t queue_type = 0;
 	interface_buffer_handle_t buf_handle = {0};
+	int q_idx = 0;
 
 	while (1) {
 
@@ -467,9 +651,21 @@ static void send_task(void* pvParameters)
 			continue;
 		}
 
-		if (xQueueReceive(meta_to_host_queue, &queue_type, portMAX_DELAY))
-			if (xQueueReceive(to_host_queue[queue_type], &buf_handle, portMAX_DELAY))
-				process_tx_pkt(&buf_handle);
+		/* One meta entry per queued buffer: it only tells that a buffer
+		 * is pending, the scheduler picks which queue to serve */
+		if (!xQueueReceive(meta_to_host_queue, &queue_type, portMAX_DELAY))
+			continue;
+
+		q_idx = esp_hosted_tx_sched_dequeue(&to_host_sched, to_host_try_dequeue,
+				NULL, &buf_handle);
+		if (q_idx < 0)
+			continue;
+
+#if ESP_PKT_STATS
+		esp_hosted_tx_sched_stats_update(&pkt_stats.tx_sched[q_idx], buf_handle.payload_len,
+				(uint32_t)(esp_timer_get_time() / 1000) - buf_handle.enq_time_ms);
+#endif
+		process_tx_pkt(&buf_handle);
 	}
 }
 #endif
@@ -801,7 +997,12 @@ int send_to_host_queue(interface_buffer_handle_t *buf_handle, uint8_t queue_type
 	process_tx_pkt(buf_handle);
 	return ESP_OK;
 #else
-	int ret = xQueueSend(to_host_queue[queue_type], buf_handle, portMAX_DELAY);
+	int ret = 0;
+
+#if ESP_PKT_STATS
+	buf_handle->enq_time_ms = (uint32_t)(esp_timer_get_time() / 1000);
+#endif
+	ret = xQueueSend(to_host_queue[queue_type], buf_handle, portMAX_DELAY);
 	if (ret != pdTRUE) {
 		ESP_LOGE(TAG, "Failed to send buffer into queue[%u]\n",queue_type);
 		return ESP_FAIL;
@@ -871,12 +1072,21 @@ static esp_err_t serial_write_data(uint8_t* data, ssize_t len)
 static void power_save_alert_task(void *pvParameters)
 {
     uint32_t event = (uint32_t)pvParameters;
+#ifdef CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED
+	/* Keep holding host bound packets until the held ones are sent */
+	if (event == ESP_POWER_SAVE_OFF)
+		nw_split_host_hold_flush_begin();
+#endif
     host_power_save_alert(event);
 	/* The task deletes itself after running. */
 	if (event == ESP_POWER_SAVE_OFF) {
 		if (host_reset_sem) {
 			xSemaphoreGive(host_reset_sem);
 		}
+#ifdef CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED
+		/* Packets held while host was sleeping */
+		nw_split_host_hold_flush();
+#endif
 	}
     vTaskDelete(NULL);
 }
@@ -1207,6 +1417,13 @@ esp_err_t esp_hosted_coprocessor_init(void)
 												CONFIG_ESP_HOSTED_HOST_RESERVED_UDP_DEST_PORTS);
 #endif
 
+#if defined(CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED) && defined(CONFIG_ESP_HOSTED_HOST_POWER_SAVE_ENABLED)
+	nw_split_config_host_ps_hold_rules(CONFIG_ESP_HOSTED_NW_SPLIT_PS_HOLD_TCP_PORTS,
+										CONFIG_ESP_HOSTED_NW_SPLIT_PS_HOLD_UDP_PORTS,
+										CONFIG_ESP_HOSTED_NW_SPLIT_PS_WAKE_TCP_PORTS,
+										CONFIG_ESP_HOSTED_NW_SPLIT_PS_WAKE_UDP_PORTS);
+#endif
+
 	pc_pserial = protocomm_new();
 	if (pc_pserial == NULL) {
 		ESP_LOGE(TAG,"Failed to allocate memory for new instance of protocomm ");
@@ -1230,6 +1447,7 @@ esp_err_t esp_hosted_coprocessor_init(void)
 	protocomm_pserial_start(pc_pserial, serial_write_data, serial_read_data);
 
 #if !BYPASS_TX_PRIORITY_Q
+	to_host_sched_init();
 	meta_to_host_queue = xQueueCreate(TO_HOST_QUEUE_SIZE*3, sizeof(uint8_t));
 	assert(meta_to_host_queue);
 	for (uint8_t prio_q_idx=0; prio_q_idx<MAX_PRIORITY_QUEUES; prio_q_idx++) {
@@ -16,6 +16,8 @@
 #include <string.h>
 #include "esp_timer.h"
 #include "interface.h"
+#include "nw_split_router.h"
+#include "host_wake_filter.h"
 static char *TAG = "host_ps";
 
 #if H_HOST_PS_ALLOWED
@@ -119,20 +121,24 @@ int is_host_wakeup_needed(interface_buffer_handle_t *buf_handle)
 			  break;
 
 		case ESP_STA_IF:
+		case ESP_AP_IF:
 
-			  /* User can parse the incoming Wi-Fi frame here, for any selective wake up, or drop.
+			  /* Without wake up rules from the host, any Wi-Fi frame wakes up the host.
+			   * Else only the frames matching a rule do, see host_wake_filter.c.
 			   * if network split configured, you can also amend function,
 			   * nw_split_filter_and_route_packet() to process at slave or selective forward to host,
 			   * by inspecting frame/packet
 			   **/
-			  strlcpy(reason, "sta tx msg", sizeof(reason));
-			  wakup_needed = 1;
-			  goto end;
-			  break;
-
-		case ESP_AP_IF:
-			  strlcpy(reason, "ap tx msg", sizeof(reason));
-			  wakup_needed = 1;
+			  if (!host_wake_filter_is_set()) {
+				  strlcpy(reason, buf_handle->if_type == ESP_STA_IF ? "sta tx msg" : "ap tx msg", sizeof(reason));
+				  wakup_needed = 1;
+			  } else if (host_wake_filter_match(buf_start, buf_handle->payload_len)) {
+				  strlcpy(reason, "wake rule match", sizeof(reason));
+				  wakup_needed = 1;
+			  } else {
+				  strlcpy(reason, "no wake rule match", sizeof(reason));
+				  wakup_needed = 0;
+			  }
 			  goto end;
 			  break;
 	}
@@ -430,6 +436,10 @@ int host_power_save_alert(uint32_t ps_evt)
 		}
   #endif
 		power_save_on = 1;
+  #if defined(CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED) && defined(CONFIG_LWIP_ENABLE)
+		/* routing of host bound flows depends on the power state */
+		nw_split_flow_cache_flush();
+  #endif
 
 		if (!if_handle || !if_context || if_handle->state < DEACTIVE) {
 			ESP_EARLY_LOGE(TAG, "%s:%u Failed to bring down transport", __func__, __LINE__);
@@ -459,6 +469,9 @@ int host_power_save_alert(uint32_t ps_evt)
 		}
 
 		power_save_on = 0;
+  #if defined(CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED) && defined(CONFIG_LWIP_ENABLE)
+		nw_split_flow_cache_flush();
+  #endif
 
   #if H_HOST_PS_DEEP_SLEEP_ALLOWED
 		if (wakeup_sem) {
@@ -0,0 +1,361 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/* Host wake up filter: byte pattern rules deciding which frames wake up the sleeping host */
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "esp_log.h"
+#include "host_wake_filter.h"
+#if defined(CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED) && defined(CONFIG_LWIP_ENABLE)
+#include "nw_split_router.h"
+#endif
+
+static const char *TAG = "host_wake";
+
+#if H_HOST_WAKE_FILTER_SUPPORT
+#define WAKE_MAX_RULES      CONFIG_ESP_HOSTED_HOST_WAKE_FILTER_MAX_RULES
+
+/* Clock and lock, replaced by tools/bench/wake_filter_replay.c to run the
+ * filter on a Linux host */
+#ifndef WAKE_NOW_MS
+#include "esp_timer.h"
+#define WAKE_NOW_MS()       ((uint32_t)(esp_timer_get_time() / 1000))
+#endif
+
+#ifndef WAKE_LOCK_T
+#include "freertos/FreeRTOS.h"
+#define WAKE_LOCK_T         portMUX_TYPE
+#define WAKE_LOCK_INIT      portMUX_INITIALIZER_UNLOCKED
+#define WAKE_LOCK(l)        portENTER_CRITICAL(l)
+#define WAKE_UNLOCK(l)      portEXIT_CRITICAL(l)
+#endif
+
+#define ETH_HDR_LEN         14
+#define ETH_TYPE_IPV4       0x0800
+#define IPV4_HDR_MIN_LEN    20
+#define TCP_HDR_MIN_LEN     20
+#define UDP_HDR_LEN         8
+#define IP_PROTO_NUM_TCP    6
+#define IP_PROTO_NUM_UDP    17
+
+#define MQTT_PORT           1883
+
+/* Same check the network split router used to hardcode */
+#define MQTT_WAKE_RULE {                                                          \
+	.layer = HOST_WAKE_LAYER_PAYLOAD,                                             \
+	.ip_proto = IP_PROTO_NUM_TCP,                                                 \
+	.port = MQTT_PORT,                                                            \
+	.len = 11,                                                                    \
+	.mask = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }, \
+	.value = "wakeup-host",                                                       \
+}
+
+typedef struct {
+	host_wake_rule_t rule;
+	uint32_t window_start_ms;
+	uint16_t window_count;
+} wake_rule_state_t;
+
+/* Where each layer starts in the frame, -1 if the frame does not have it */
+typedef struct {
+	int32_t start[HOST_WAKE_LAYER_MAX];
+	uint16_t end;
+	uint8_t ip_proto;
+	uint16_t src_port;
+	uint16_t dst_port;
+} frame_info_t;
+
+/* Defaults, used until the host installs its own rules.
+ * With network split, an MQTT message starting with "wakeup-host" wakes up the host */
+static const host_wake_rule_t default_rules[] = {
+#if defined(CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED)
+	MQTT_WAKE_RULE,
+#endif
+};
+
+#define DEFAULT_RULES_COUNT (sizeof(default_rules) / sizeof(default_rules[0]))
+
+_Static_assert(DEFAULT_RULES_COUNT <= WAKE_MAX_RULES, "default wake rules exceed max wake rules");
+
+static wake_rule_state_t wake_rules[WAKE_MAX_RULES] = {
+#if defined(CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED)
+	{ .rule = MQTT_WAKE_RULE },
+#endif
+};
+static uint8_t wake_rules_count = DEFAULT_RULES_COUNT;
+static bool wake_rules_from_host = false;
+
+/* Matching runs in the Wi-Fi Rx and host Tx paths, keep the critical sections short */
+static WAKE_LOCK_T wake_rules_lock = WAKE_LOCK_INIT;
+
+static void parse_frame(const uint8_t *frame, uint16_t len, frame_info_t *fi)
+{
+	uint16_t ip_hdr_len = 0, ip_tot_len = 0, l4 = 0, tcp_hdr_len = 0;
+	int i = 0;
+
+	for (i = 0; i < HOST_WAKE_LAYER_MAX; i++)
+		fi->start[i] = -1;
+	fi->start[HOST_WAKE_LAYER_L2] = 0;
+	fi->end = len;
+	fi->ip_proto = 0;
+	fi->src_port = 0;
+	fi->dst_port = 0;
+
+	if (len < ETH_HDR_LEN + IPV4_HDR_MIN_LEN ||
+			((frame[12] << 8) | frame[13]) != ETH_TYPE_IPV4 ||
+			(frame[ETH_HDR_LEN] >> 4) != 4)
+		return;
+
+	ip_hdr_len = (frame[ETH_HDR_LEN] & 0x0f) * 4;
+	ip_tot_len = (frame[ETH_HDR_LEN + 2] << 8) | frame[ETH_HDR_LEN + 3];
+	if (ip_hdr_len < IPV4_HDR_MIN_LEN || ip_tot_len < ip_hdr_len)
+		return;
+
+	/* leave out the Ethernet padding */
+	if (ETH_HDR_LEN + ip_tot_len < fi->end)
+		fi->end = ETH_HDR_LEN + ip_tot_len;
+
+	fi->start[HOST_WAKE_LAYER_L3] = ETH_HDR_LEN;
+	fi->ip_proto = frame[ETH_HDR_LEN + 9];
+
+	/* only the first fragment has the L4 header */
+	if (((frame[ETH_HDR_LEN + 6] & 0x1f) << 8 | frame[ETH_HDR_LEN + 7]) != 0)
+		return;
+
+	l4 = ETH_HDR_LEN + ip_hdr_len;
+	if (l4 > fi->end)
+		return;
+	fi->start[HOST_WAKE_LAYER_L4] = l4;
+
+	if (fi->ip_proto == IP_PROTO_NUM_TCP && l4 + TCP_HDR_MIN_LEN <= fi->end) {
+		tcp_hdr_len = (frame[l4 + 12] >> 4) * 4;
+		fi->src_port = (frame[l4] << 8) | frame[l4 + 1];
+		fi->dst_port = (frame[l4 + 2] << 8) | frame[l4 + 3];
+		if (tcp_hdr_len >= TCP_HDR_MIN_LEN && l4 + tcp_hdr_len <= fi->end)
+			fi->start[HOST_WAKE_LAYER_PAYLOAD] = l4 + tcp_hdr_len;
+	} else if (fi->ip_proto == IP_PROTO_NUM_UDP && l4 + UDP_HDR_LEN <= fi->end) {
+		fi->src_port = (frame[l4] << 8) | frame[l4 + 1];
+		fi->dst_port = (frame[l4 + 2] << 8) | frame[l4 + 3];
+		fi->start[HOST_WAKE_LAYER_PAYLOAD] = l4 + UDP_HDR_LEN;
+	}
+}
+
+static bool rule_match(const host_wake_rule_t *r, const uint8_t *frame, const frame_info_t *fi)
+{
+	uint32_t pos = 0;
+	uint8_t i = 0;
+
+	if (r->ip_proto && r->ip_proto != fi->ip_proto)
+		return false;
+
+	if (r->port && r->port != fi->src_port && r->port != fi->dst_port)
+		return false;
+
+	if (fi->start[r->layer] < 0)
+		return false;
+
+	pos = fi->start[r->layer] + r->offset;
+	if (pos + r->len > fi->end)
+		return false;
+
+	for (i = 0; i < r->len; i++) {
+		if ((frame[pos + i] & r->mask[i]) != r->value[i])
+			return false;
+	}
+	return true;
+}
+
+/* Fixed window rate limit. Caller holds wake_rules_lock */
+static bool rule_rate_allowed(wake_rule_state_t *s, uint32_t now_ms)
+{
+	if (!s->rule.rate_limit)
+		return true;
+
+	if (now_ms - s->window_start_ms >= s->rule.rate_interval_ms) {
+		s->window_start_ms = now_ms;
+		s->window_count = 0;
+	}
+
+	if (s->window_count >= s->rule.rate_limit)
+		return false;
+
+	s->window_count++;
+	return true;
+}
+
+bool host_wake_filter_match(const uint8_t *frame, uint16_t len)
+{
+	frame_info_t fi = {0};
+	uint32_t now_ms = 0;
+	bool wake = false;
+	int i = 0;
+
+	if (!frame || !len)
+		return false;
+
+	parse_frame(frame, len, &fi);
+	now_ms = WAKE_NOW_MS();
+
+	WAKE_LOCK(&wake_rules_lock);
+	for (i = 0; i < wake_rules_count; i++) {
+		if (!rule_match(&wake_rules[i].rule, frame, &fi))
+			continue;
+		if (rule_rate_allowed(&wake_rules[i], now_ms)) {
+			wake = true;
+			break;
+		}
+		/* rate limited, a later rule may still match */
+	}
+	WAKE_UNLOCK(&wake_rules_lock);
+
+	if (wake)
+		ESP_LOGD(TAG, "wake rule %d matched", i);
+	return wake;
+}
+
+/* Whether the pattern of a rule looks at bytes that can differ between
+ * packets of one flow: anything but the Ethernet header, the IPv4
+ * protocol and addresses and the TCP/UDP ports */
+static bool rule_per_packet(const host_wake_rule_t *r)
+{
+	uint32_t pos = 0;
+	uint8_t i = 0;
+
+	if (r->rate_limit || r->layer == HOST_WAKE_LAYER_PAYLOAD)
+		return true;
+
+	for (i = 0; i < r->len; i++) {
+		if (!r->mask[i])
+			continue;
+
+		pos = r->offset + i;
+		if (r->layer == HOST_WAKE_LAYER_L2 && pos >= ETH_HDR_LEN)
+			return true;
+		if (r->layer == HOST_WAKE_LAYER_L3 && pos != 9 && (pos < 12 || pos >= IPV4_HDR_MIN_LEN))
+			return true;
+		if (r->layer == HOST_WAKE_LAYER_L4 && pos >= 4)
+			return true;
+	}
+	return false;
+}
+
+bool host_wake_filter_flow_constant(uint8_t ip_proto, uint16_t src_port, uint16_t dst_port)
+{
+	const host_wake_rule_t *r = NULL;
+	bool constant = true;
+	int i = 0;
+
+	WAKE_LOCK(&wake_rules_lock);
+	for (i = 0; i < wake_rules_count; i++) {
+		r = &wake_rules[i].rule;
+		if (r->ip_proto && r->ip_proto != ip_proto)
+			continue;
+		if (r->port && r->port != src_port && r->port != dst_port)
+			continue;
+		if (rule_per_packet(r)) {
+			constant = false;
+			break;
+		}
+	}
+	WAKE_UNLOCK(&wake_rules_lock);
+
+	return constant;
+}
+
+bool host_wake_filter_is_set(void)
+{
+	return __atomic_load_n(&wake_rules_from_host, __ATOMIC_ACQUIRE);
+}
+
+static esp_err_t validate_rule(const host_wake_rule_t *r)
+{
+	if (r->layer >= HOST_WAKE_LAYER_MAX || r->len > HOST_WAKE_FILTER_MAX_PATTERN_LEN)
+		return ESP_ERR_INVALID_ARG;
+
+	if (r->rate_limit && !r->rate_interval_ms)
+		return ESP_ERR_INVALID_ARG;
+
+	return ESP_OK;
+}
+
+esp_err_t host_wake_filter_set_rules(const host_wake_rule_t *rules, uint8_t num_rules)
+{
+	wake_rule_state_t *new_rules = NULL;
+	bool from_host = num_rules != 0;
+	uint8_t i = 0, j = 0;
+
+	if (num_rules > WAKE_MAX_RULES) {
+		ESP_LOGE(TAG, "Too many wake rules: %u, max %u", num_rules, WAKE_MAX_RULES);
+		return ESP_ERR_NO_MEM;
+	}
+
+	if (!from_host) {
+		rules = default_rules;
+		num_rules = DEFAULT_RULES_COUNT;
+	}
+
+	if (num_rules && !rules)
+		return ESP_ERR_INVALID_ARG;
+
+	/* prepare outside of the critical section */
+	new_rules = calloc(WAKE_MAX_RULES, sizeof(wake_rule_state_t));
+	if (!new_rules)
+		return ESP_ERR_NO_MEM;
+
+	for (i = 0; i < num_rules; i++) {
+		if (validate_rule(&rules[i]) != ESP_OK) {
+			ESP_LOGE(TAG, "Invalid wake rule %u", i);
+			free(new_rules);
+			return ESP_ERR_INVALID_ARG;
+		}
+		new_rules[i].rule = rules[i];
+		/* bits outside of the mask can never match */
+		for (j = 0; j < new_rules[i].rule.len; j++)
+			new_rules[i].rule.value[j] &= new_rules[i].rule.mask[j];
+	}
+
+	WAKE_LOCK(&wake_rules_lock);
+	memcpy(wake_rules, new_rules, sizeof(wake_rules));
+	wake_rules_count = num_rules;
+	__atomic_store_n(&wake_rules_from_host, from_host, __ATOMIC_RELEASE);
+	WAKE_UNLOCK(&wake_rules_lock);
+
+	free(new_rules);
+
+#if defined(CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED) && defined(CONFIG_LWIP_ENABLE)
+	/* flows cached as constant may no longer be */
+	nw_split_flow_cache_flush();
+#endif
+
+	if (from_host)
+		ESP_LOGI(TAG, "Host wake up rules set: %u", num_rules);
+	else
+		ESP_LOGI(TAG, "Host wake up rules reset to default");
+	return ESP_OK;
+}
+#else
+bool host_wake_filter_match(const uint8_t *frame, uint16_t len)
+{
+	return false;
+}
+
+bool host_wake_filter_flow_constant(uint8_t ip_proto, uint16_t src_port, uint16_t dst_port)
+{
+	return true;
+}
+
+bool host_wake_filter_is_set(void)
+{
+	return false;
+}
+
+esp_err_t host_wake_filter_set_rules(const host_wake_rule_t *rules, uint8_t num_rules)
+{
+	ESP_LOGW(TAG, "Host power save not enabled, wake rules ignored");
+	return ESP_ERR_NOT_SUPPORTED;
+}
+#endif
@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __HOST_WAKE_FILTER_H__
+#define __HOST_WAKE_FILTER_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sdkconfig.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HOST_WAKE_FILTER_MAX_PATTERN_LEN 16
+
+/* Start of the rule offset within the frame */
+typedef enum {
+	HOST_WAKE_LAYER_L2 = 0,       /* Ethernet header */
+	HOST_WAKE_LAYER_L3 = 1,       /* IPv4 header */
+	HOST_WAKE_LAYER_L4 = 2,       /* TCP/UDP/ICMP header */
+	HOST_WAKE_LAYER_PAYLOAD = 3,  /* after the TCP/UDP header */
+	HOST_WAKE_LAYER_MAX,
+} host_wake_layer_t;
+
+/* A frame matches the rule when (frame[layer + offset + i] & mask[i]) == value[i]
+ * for every i < len, and the ip_proto and port qualifiers, when set, match */
+typedef struct {
+	uint8_t layer;                 /* host_wake_layer_t */
+	uint8_t ip_proto;              /* 0 for any */
+	uint16_t port;                 /* TCP/UDP source or destination port, 0 for any */
+	uint16_t offset;
+	uint8_t len;                   /* pattern length, up to HOST_WAKE_FILTER_MAX_PATTERN_LEN */
+	uint8_t mask[HOST_WAKE_FILTER_MAX_PATTERN_LEN];
+	uint8_t value[HOST_WAKE_FILTER_MAX_PATTERN_LEN];
+	uint16_t rate_limit;           /* max wake ups per interval, 0 for no limit */
+	uint32_t rate_interval_ms;
+} host_wake_rule_t;
+
+/* Same as H_HOST_PS_ALLOWED. Kept off host_power_save.h, so that the
+ * filter also builds on a Linux host, see tools/bench/wake_filter_replay.c */
+#if defined(CONFIG_ESP_HOSTED_HOST_POWER_SAVE_ENABLED)
+	#define H_HOST_WAKE_FILTER_SUPPORT (1)
+#else
+	#define H_HOST_WAKE_FILTER_SUPPORT (0)
+#endif
+
+/**
+ * @brief Replace the host wake up rules
+ *
+ * With no rules (num_rules 0), the defaults are restored: any Wi-Fi frame
+ * sent to the sleeping host wakes it up and, with network split, so does
+ * an MQTT message starting with "wakeup-host".
+ *
+ * @return ESP_OK, ESP_ERR_INVALID_ARG for a malformed rule or
+ *         ESP_ERR_NO_MEM if there are more than
+ *         CONFIG_ESP_HOSTED_HOST_WAKE_FILTER_MAX_RULES rules
+ */
+esp_err_t host_wake_filter_set_rules(const host_wake_rule_t *rules, uint8_t num_rules);
+
+/**
+ * @brief Check if the host installed its own wake up rules
+ */
+bool host_wake_filter_is_set(void);
+
+/**
+ * @brief Match an Ethernet frame against the wake up rules
+ *
+ * A match counts towards the rate limit of the matching rule. Once the
+ * limit is reached, the rule stops matching until its interval is over.
+ *
+ * @return true if the frame should wake up the host
+ */
+bool host_wake_filter_match(const uint8_t *frame, uint16_t len);
+
+/**
+ * @brief Check if all packets of a TCP/UDP flow get the same match result
+ *
+ * False if a rule that can match the flow looks at bytes that change from
+ * packet to packet, e.g. the payload or TCP flags, or is rate limited.
+ * Then host_wake_filter_match() has to run for every packet of the flow.
+ * Rule changes flush the network split flow cache.
+ */
+bool host_wake_filter_flow_constant(uint8_t ip_proto, uint16_t src_port, uint16_t dst_port);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
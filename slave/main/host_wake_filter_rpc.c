@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/* RPC to set the host wake up rules, see host_wake_filter.c */
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "esp_log.h"
+#include "host_wake_filter_rpc.h"
+#include "slave_control.h"
+
+#if H_HOST_WAKE_FILTER_SUPPORT
+static const char *TAG = "host_wake_rpc";
+
+esp_err_t req_set_wake_rules(Rpc *req, Rpc *resp, void *priv_data)
+{
+	RPC_TEMPLATE(RpcRespSetWakeRules, resp_set_wake_rules,
+			RpcReqSetWakeRules, req_set_wake_rules,
+			rpc__resp__set_wake_rules__init);
+
+	host_wake_rule_t *rules = NULL;
+	size_t i = 0;
+
+	if (req_payload->n_rules > CONFIG_ESP_HOSTED_HOST_WAKE_FILTER_MAX_RULES) {
+		resp_payload->resp = ESP_ERR_NO_MEM;
+		return ESP_OK;
+	}
+
+	if (req_payload->n_rules) {
+		rules = calloc(req_payload->n_rules, sizeof(host_wake_rule_t));
+		if (!rules) {
+			resp_payload->resp = ESP_ERR_NO_MEM;
+			return ESP_OK;
+		}
+	}
+
+	for (i = 0; i < req_payload->n_rules; i++) {
+		RpcWakeRule *rule = req_payload->rules[i];
+
+		if (!rule || rule->layer >= HOST_WAKE_LAYER_MAX || rule->ip_proto > UINT8_MAX || rule->port > UINT16_MAX ||
+				rule->offset > UINT16_MAX || rule->rate_limit > UINT16_MAX ||
+				rule->value.len > HOST_WAKE_FILTER_MAX_PATTERN_LEN ||
+				(rule->mask.len && rule->mask.len != rule->value.len) ||
+				(rule->value.len && !rule->value.data)) {
+			resp_payload->resp = ESP_ERR_INVALID_ARG;
+			goto done;
+		}
+
+		rules[i].layer = rule->layer;
+		rules[i].ip_proto = rule->ip_proto;
+		rules[i].port = rule->port;
+		rules[i].offset = rule->offset;
+		rules[i].len = rule->value.len;
+		if (rule->value.len)
+			memcpy(rules[i].value, rule->value.data, rule->value.len);
+		/* no mask: match the value exactly */
+		if (rule->mask.len && rule->mask.data)
+			memcpy(rules[i].mask, rule->mask.data, rule->mask.len);
+		else
+			memset(rules[i].mask, 0xff, rule->value.len);
+		rules[i].rate_limit = rule->rate_limit;
+		rules[i].rate_interval_ms = rule->rate_interval_ms;
+	}
+
+	resp_payload->resp = host_wake_filter_set_rules(rules, req_payload->n_rules);
+done:
+	free(rules);
+	return ESP_OK;
+}
+#endif
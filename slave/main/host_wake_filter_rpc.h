@@ -0,0 +1,19 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __HOST_WAKE_FILTER_RPC_H__
+#define __HOST_WAKE_FILTER_RPC_H__
+
+#include "esp_err.h"
+#include "host_wake_filter.h"
+
+#include "esp_hosted_rpc.pb-c.h"
+
+#if H_HOST_WAKE_FILTER_SUPPORT
+	esp_err_t req_set_wake_rules(Rpc *req, Rpc *resp, void *priv_data);
+#endif
+
+#endif
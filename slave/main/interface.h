@@ -71,6 +71,10 @@ typedef struct {
 #if CONFIG_ESP_SPI_HD_HOST_INTERFACE || CONFIG_ESP_UART_HOST_INTERFACE || CONFIG_ESP_SPI_HOST_INTERFACE
 	uint8_t wifi_flow_ctrl_en;
 #endif
+#if CONFIG_ESP_PKT_STATS
+	/* time queued for Tx, for scheduler wait stats */
+	uint32_t enq_time_ms;
+#endif
 
 	void (*free_buf_handle)(void *buf_handle);
 } interface_buffer_handle_t;
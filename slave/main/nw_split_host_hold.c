@@ -0,0 +1,248 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/* Holding queue for host bound packets while the host is power saving */
+
+#include <string.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <sys/queue.h>
+
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "interface.h"
+#include "host_power_save.h"
+#include "nw_split_router.h"
+#include "stats.h"
+
+#if defined(CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED) && defined(CONFIG_LWIP_ENABLE)
+#include "lwip/prot/ethernet.h"
+#include "lwip/prot/ip.h"
+#include "lwip/prot/ip4.h"
+#include "lwip/prot/udp.h"
+
+static const char *TAG = "nw_split_hold";
+
+/* Frames are kept in per flow buckets. When the queue is full, the oldest
+ * frame of the longest bucket is dropped, so a single busy flow cannot push
+ * out the others. On wake up, buckets are drained round robin in one burst */
+#define HOLD_FLOW_BUCKETS 16
+#define HOLD_MAX_PKTS     CONFIG_ESP_HOSTED_NW_SPLIT_PS_HOLD_MAX_PKTS
+#define HOLD_MAX_BYTES    (CONFIG_ESP_HOSTED_NW_SPLIT_PS_HOLD_MAX_KB * 1024)
+
+typedef struct hold_pkt {
+	STAILQ_ENTRY(hold_pkt) next;
+	uint16_t len;
+	uint8_t data[];
+} hold_pkt_t;
+
+STAILQ_HEAD(hold_q, hold_pkt);
+
+static struct hold_q hold_q[HOLD_FLOW_BUCKETS];
+static uint16_t hold_q_len[HOLD_FLOW_BUCKETS];
+static uint32_t hold_pkts = 0;
+static uint32_t hold_bytes = 0;
+static SemaphoreHandle_t hold_lock = NULL;
+static uint8_t hold_wake_pending = 0;
+static uint8_t hold_flushing = 0;
+
+static void hold_init(void)
+{
+	int i = 0;
+
+	for (i = 0; i < HOLD_FLOW_BUCKETS; i++)
+		STAILQ_INIT(&hold_q[i]);
+	hold_lock = xSemaphoreCreateMutex();
+}
+
+/* Bucket from addresses and ports, so frames of one flow stay in order */
+static int hold_bucket(const void *frame, uint16_t len)
+{
+	const struct ip_hdr *iphdr = (const struct ip_hdr *)((const uint8_t *)frame + SIZEOF_ETH_HDR);
+	const struct udp_hdr *l4hdr = NULL;
+	uint32_t h = 0;
+
+	if (len < SIZEOF_ETH_HDR + IP_HLEN)
+		return 0;
+
+	h = iphdr->src.addr * 0x9e3779b1;
+	h ^= iphdr->dest.addr + 0x7f4a7c15 + (h << 6) + (h >> 2);
+	if (len >= SIZEOF_ETH_HDR + IPH_HL(iphdr) * 4 + UDP_HLEN) {
+		/* TCP and UDP headers both start with the ports */
+		l4hdr = (const struct udp_hdr *)((const uint8_t *)iphdr + IPH_HL(iphdr) * 4);
+		h ^= (((uint32_t)l4hdr->src << 16) | l4hdr->dest) * 0x85ebca6b;
+	}
+	h ^= h >> 16;
+	return h % HOLD_FLOW_BUCKETS;
+}
+
+/* Caller holds hold_lock */
+static void hold_drop_from_longest(void)
+{
+	hold_pkt_t *pkt = NULL;
+	int longest = 0, i = 0;
+
+	for (i = 1; i < HOLD_FLOW_BUCKETS; i++) {
+		if (hold_q_len[i] > hold_q_len[longest])
+			longest = i;
+	}
+
+	pkt = STAILQ_FIRST(&hold_q[longest]);
+	if (!pkt)
+		return;
+
+	STAILQ_REMOVE_HEAD(&hold_q[longest], next);
+	hold_q_len[longest]--;
+	hold_pkts--;
+	hold_bytes -= pkt->len;
+	free(pkt);
+#if ESP_PKT_STATS
+	pkt_stats.sta_host_hold_drop++;
+#endif
+}
+
+static void hold_wake_task(void *arg)
+{
+	ESP_LOGI(TAG, "Wake up host for held packets");
+	wakeup_host(portMAX_DELAY);
+	__atomic_store_n(&hold_wake_pending, 0, __ATOMIC_RELEASE);
+	vTaskDelete(NULL);
+}
+
+void nw_split_host_hold(const void *frame, uint16_t len, bool wake_host)
+{
+	hold_pkt_t *pkt = NULL;
+	int bucket = 0;
+
+	if (!hold_lock) {
+		hold_init();
+		if (!hold_lock)
+			return;
+	}
+
+	if (len > HOLD_MAX_BYTES)
+		goto drop;
+
+	pkt = malloc(sizeof(hold_pkt_t) + len);
+	if (!pkt)
+		goto drop;
+	memcpy(pkt->data, frame, len);
+	pkt->len = len;
+	bucket = hold_bucket(frame, len);
+
+	xSemaphoreTake(hold_lock, portMAX_DELAY);
+	while (hold_pkts && (hold_pkts >= HOLD_MAX_PKTS || hold_bytes + len > HOLD_MAX_BYTES))
+		hold_drop_from_longest();
+	STAILQ_INSERT_TAIL(&hold_q[bucket], pkt, next);
+	hold_q_len[bucket]++;
+	hold_pkts++;
+	hold_bytes += len;
+	xSemaphoreGive(hold_lock);
+
+#if ESP_PKT_STATS
+	pkt_stats.sta_host_hold++;
+#endif
+
+	if (!is_host_power_saving()) {
+		/* host woke up meanwhile, the wake up flush may have been missed.
+		 * A flush still running sends this one too */
+		if (!nw_split_host_hold_flushing())
+			nw_split_host_hold_flush();
+		return;
+	}
+
+	if (wake_host && !__atomic_exchange_n(&hold_wake_pending, 1, __ATOMIC_ACQ_REL)) {
+		if (xTaskCreate(hold_wake_task, "hold_wake", 3072, NULL,
+				tskIDLE_PRIORITY + 5, NULL) != pdPASS)
+			__atomic_store_n(&hold_wake_pending, 0, __ATOMIC_RELEASE);
+	}
+	return;
+
+drop:
+	ESP_LOGW(TAG, "host pkt dropped in power save, len %u", len);
+#if ESP_PKT_STATS
+	pkt_stats.sta_host_hold_drop++;
+#endif
+}
+
+void nw_split_host_hold_flush_begin(void)
+{
+	__atomic_store_n(&hold_flushing, 1, __ATOMIC_RELEASE);
+}
+
+bool nw_split_host_hold_flushing(void)
+{
+	return __atomic_load_n(&hold_flushing, __ATOMIC_ACQUIRE);
+}
+
+void nw_split_host_hold_flush(void)
+{
+	interface_buffer_handle_t buf_handle = {0};
+	struct hold_q burst = STAILQ_HEAD_INITIALIZER(burst);
+	hold_pkt_t *pkt = NULL;
+	uint32_t n = 0;
+	int i = 0;
+
+	if (!hold_lock) {
+		__atomic_store_n(&hold_flushing, 0, __ATOMIC_RELEASE);
+		return;
+	}
+
+	for (;;) {
+		/* take all buckets round robin, then send without the lock.
+		 * Packets held meanwhile go out with the next burst. Flushing ends
+		 * under the lock once the queue is empty, so a packet held later
+		 * sees it ended and flushes itself */
+		xSemaphoreTake(hold_lock, portMAX_DELAY);
+		while (hold_pkts) {
+			for (i = 0; i < HOLD_FLOW_BUCKETS; i++) {
+				pkt = STAILQ_FIRST(&hold_q[i]);
+				if (!pkt)
+					continue;
+				STAILQ_REMOVE_HEAD(&hold_q[i], next);
+				hold_q_len[i]--;
+				hold_pkts--;
+				STAILQ_INSERT_TAIL(&burst, pkt, next);
+			}
+		}
+		hold_bytes = 0;
+		if (STAILQ_EMPTY(&burst))
+			__atomic_store_n(&hold_flushing, 0, __ATOMIC_RELEASE);
+		xSemaphoreGive(hold_lock);
+
+		if (STAILQ_EMPTY(&burst))
+			break;
+
+		while ((pkt = STAILQ_FIRST(&burst)) != NULL) {
+			STAILQ_REMOVE_HEAD(&burst, next);
+
+			memset(&buf_handle, 0, sizeof(buf_handle));
+			buf_handle.if_type = ESP_STA_IF;
+			buf_handle.payload = pkt->data;
+			buf_handle.payload_len = pkt->len;
+			buf_handle.priv_buffer_handle = pkt;
+			buf_handle.free_buf_handle = free;
+
+			if (send_to_host_queue(&buf_handle, PRIO_Q_OTHERS)) {
+				free(pkt);
+#if ESP_PKT_STATS
+				pkt_stats.sta_host_hold_drop++;
+#endif
+				continue;
+			}
+			n++;
+		}
+	}
+
+	if (n) {
+		ESP_LOGI(TAG, "Sent %" PRIu32 " held packets to host", n);
+#if ESP_PKT_STATS
+		pkt_stats.sta_host_hold_flush += n;
+#endif
+	}
+}
+#endif
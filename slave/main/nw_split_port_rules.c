@@ -0,0 +1,217 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/* Network split port forwarding rules
+ * Kept apart from nw_split_router.c, as it only needs FreeRTOS and the
+ * lwIP protocol numbers. tools/bench/port_rules_bench.c builds it on a
+ * Linux host */
+
+#include <string.h>
+
+#include "esp_log.h"
+#include "nw_split_port_rules.h"
+
+#if defined(CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED) && defined(CONFIG_LWIP_ENABLE)
+#include "lwip/prot/ip.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+static const char *TAG = "nw_split_rules";
+
+/* Port forwarding rules
+ * The ordered rule list is compiled into one 65536 bit map per protocol and
+ * direction, a bit being set if any rule covers that port. If all rules of
+ * a map share one bridge, a set bit alone decides the packet. Otherwise the
+ * first matching rule in the list does. Ports without a bit skip the list.
+ * The four maps take 32 KB of .bss, whatever the number of rules.
+ *
+ * Rules get replaced from the RPC task while packets are classified in the
+ * Wi-Fi Rx path. The classifier never blocks: a lookup racing an update is
+ * retried a few times, and only then treated as if no rule matched */
+#define PORT_MAP_WORDS ((UINT16_MAX + 1) / 32)
+#define MAX_PORT_RULES CONFIG_ESP_HOSTED_NW_SPLIT_MAX_PORT_RULES
+#define PORT_RULES_READ_RETRIES 4
+
+enum {
+	PORT_MAP_TCP_SRC,
+	PORT_MAP_TCP_DST,
+	PORT_MAP_UDP_SRC,
+	PORT_MAP_UDP_DST,
+	PORT_MAP_MAX,
+};
+
+/* port_map_bridge[] values besides hosted_l2_bridge */
+#define PORT_MAP_EMPTY -1
+#define PORT_MAP_MIXED -2
+
+static nw_split_port_rule_t port_rules[MAX_PORT_RULES];
+static int port_rules_count = 0;
+static uint32_t port_map[PORT_MAP_MAX][PORT_MAP_WORDS];
+static int8_t port_map_bridge[PORT_MAP_MAX] = {
+	[0 ... (PORT_MAP_MAX - 1)] = PORT_MAP_EMPTY
+};
+static uint32_t port_rules_seq = 0; /* odd while rules are updated */
+static SemaphoreHandle_t port_rules_lock = NULL;
+
+static inline int port_map_idx(uint8_t proto, bool match_src)
+{
+	return (proto == IP_PROTO_TCP ? PORT_MAP_TCP_SRC : PORT_MAP_UDP_SRC) + !match_src;
+}
+
+static inline bool port_map_test(const uint32_t *map, uint16_t port)
+{
+	return map[port >> 5] & (1UL << (port & 31));
+}
+
+static void port_map_set_range(uint32_t *map, uint16_t start, uint16_t end)
+{
+	uint32_t port = start;
+
+	while (port <= end) {
+		if (!(port & 31) && (port + 31 <= end)) {
+			map[port >> 5] = UINT32_MAX;
+			port += 32;
+		} else {
+			map[port >> 5] |= 1UL << (port & 31);
+			port++;
+		}
+	}
+}
+
+/* Rebuild the port maps from the rule list. Caller holds port_rules_lock */
+static void port_rules_compile(void)
+{
+	int i = 0, m = 0;
+
+	memset(port_map, 0, sizeof(port_map));
+	for (m = 0; m < PORT_MAP_MAX; m++)
+		port_map_bridge[m] = PORT_MAP_EMPTY;
+
+	for (i = 0; i < port_rules_count; i++) {
+		const nw_split_port_rule_t *rule = &port_rules[i];
+
+		m = port_map_idx(rule->proto, rule->match_src);
+		port_map_set_range(port_map[m], rule->port_start, rule->port_end);
+		if (port_map_bridge[m] == PORT_MAP_EMPTY)
+			port_map_bridge[m] = rule->bridge;
+		else if (port_map_bridge[m] != (int8_t)rule->bridge)
+			port_map_bridge[m] = PORT_MAP_MIXED;
+	}
+}
+
+/* Looks up the bridge without taking the lock. Returns PORT_MAP_EMPTY if no
+ * rule matches */
+static int port_rules_lookup(uint8_t proto, uint16_t src_port, uint16_t dst_port)
+{
+	int src_map = port_map_idx(proto, true);
+	int dst_map = port_map_idx(proto, false);
+	bool src_hit = false, dst_hit = false;
+	int res = PORT_MAP_EMPTY;
+	int i = 0;
+
+	src_hit = port_map_test(port_map[src_map], src_port);
+	dst_hit = port_map_test(port_map[dst_map], dst_port);
+	if (!src_hit && !dst_hit)
+		return PORT_MAP_EMPTY;
+
+	if (src_hit && dst_hit)
+		res = (port_map_bridge[src_map] == port_map_bridge[dst_map]) ?
+			port_map_bridge[src_map] : PORT_MAP_MIXED;
+	else
+		res = port_map_bridge[src_hit ? src_map : dst_map];
+
+	if (res == PORT_MAP_MIXED) {
+		res = PORT_MAP_EMPTY;
+		for (i = 0; i < port_rules_count; i++) {
+			const nw_split_port_rule_t *rule = &port_rules[i];
+			uint16_t port = rule->match_src ? src_port : dst_port;
+
+			if (rule->proto == proto &&
+					port >= rule->port_start && port <= rule->port_end) {
+				res = rule->bridge;
+				break;
+			}
+		}
+	}
+
+	return res;
+}
+
+bool nw_split_port_rules_match(uint8_t proto, uint16_t src_port, uint16_t dst_port,
+		hosted_l2_bridge *bridge)
+{
+	uint32_t seq = 0;
+	int res = PORT_MAP_EMPTY;
+	int retry = 0;
+
+	for (retry = 0; retry < PORT_RULES_READ_RETRIES; retry++) {
+		seq = __atomic_load_n(&port_rules_seq, __ATOMIC_ACQUIRE);
+		if (seq & 1)
+			continue;
+
+		res = port_rules_lookup(proto, src_port, dst_port);
+
+		/* keep the result only if no update ran meanwhile */
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(&port_rules_seq, __ATOMIC_RELAXED) != seq)
+			continue;
+
+		if (res < 0)
+			return false;
+		*bridge = (hosted_l2_bridge)res;
+		return true;
+	}
+
+	return false;
+}
+
+esp_err_t nw_split_set_port_rules(const nw_split_port_rule_t *rules, int num_rules, bool replace)
+{
+	int base = 0, i = 0;
+
+	if (num_rules < 0 || (num_rules && !rules))
+		return ESP_ERR_INVALID_ARG;
+
+	for (i = 0; i < num_rules; i++) {
+		if ((rules[i].proto != IP_PROTO_TCP && rules[i].proto != IP_PROTO_UDP) ||
+				rules[i].port_start > rules[i].port_end ||
+				rules[i].bridge > INVALID_BRIDGE) {
+			ESP_LOGE(TAG, "Invalid port rule[%d]", i);
+			return ESP_ERR_INVALID_ARG;
+		}
+	}
+
+	if (!port_rules_lock) {
+		port_rules_lock = xSemaphoreCreateMutex();
+		if (!port_rules_lock)
+			return ESP_ERR_NO_MEM;
+	}
+	xSemaphoreTake(port_rules_lock, portMAX_DELAY);
+
+	base = replace ? 0 : port_rules_count;
+	if (base + num_rules > MAX_PORT_RULES) {
+		xSemaphoreGive(port_rules_lock);
+		ESP_LOGE(TAG, "Too many port rules (max %d)", MAX_PORT_RULES);
+		return ESP_ERR_NO_MEM;
+	}
+
+	__atomic_store_n(&port_rules_seq, port_rules_seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	if (num_rules)
+		memcpy(&port_rules[base], rules, num_rules * sizeof(nw_split_port_rule_t));
+	port_rules_count = base + num_rules;
+	port_rules_compile();
+
+	__atomic_store_n(&port_rules_seq, port_rules_seq + 1, __ATOMIC_RELEASE);
+	xSemaphoreGive(port_rules_lock);
+
+	nw_split_flow_cache_flush();
+
+	ESP_LOGI(TAG, "%d port forwarding rules in place", base + num_rules);
+	return ESP_OK;
+}
+
+#endif
@@ -0,0 +1,19 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __NW_SPLIT_PORT_RULES_H__
+#define __NW_SPLIT_PORT_RULES_H__
+
+#include "nw_split_router.h"
+
+#if defined(CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED) && defined(CONFIG_LWIP_ENABLE)
+/* Classify a TCP/UDP packet by the port forwarding rules set with
+ * nw_split_set_port_rules(). Never blocks, so it is safe in the Wi-Fi Rx
+ * path. Returns false if no rule matched */
+bool nw_split_port_rules_match(uint8_t proto, uint16_t src_port, uint16_t dst_port,
+		hosted_l2_bridge *bridge);
+#endif
+
+#endif
@@ -12,7 +12,10 @@
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "host_power_save.h"
+#include "host_wake_filter.h"
 #include "nw_split_router.h"
+#include "nw_split_port_rules.h"
+#include "stats.h"
 
 #if defined(CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED) && defined(CONFIG_LWIP_ENABLE)
 #include "lwip/opt.h"
@@ -27,13 +30,14 @@
 #include "lwip/tcp.h"
 #include "lwip/udp.h"
 #include "lwip/priv/tcp_priv.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 
 
 
 static const char *TAG = "nw_split_router";
 
 #define MQTT_PORT 1883
-#define WAKEUP_HOST_STRING "wakeup-host"
 #define DEFAULT_IPERF_PORT 5001
 
 /* Use LWIP's port range macros instead of redefining */
@@ -67,213 +71,314 @@ static struct {
 	uint16_t last_port;
 } udp_cache = {0};
 
-#define MAX_ALLOWED_TCP_SRC_PORTS 10
-#define MAX_ALLOWED_UDP_SRC_PORTS 10
-#define MAX_ALLOWED_TCP_DST_PORTS 10
-#define MAX_ALLOWED_UDP_DST_PORTS 10
-
-/* In the file-scope variables section */
-static uint16_t allowed_tcp_src_ports[MAX_ALLOWED_TCP_SRC_PORTS] = {0};
-static uint16_t allowed_udp_src_ports[MAX_ALLOWED_UDP_SRC_PORTS] = {0};
-static uint16_t allowed_tcp_dst_ports[MAX_ALLOWED_TCP_DST_PORTS] = {0};
-static uint16_t allowed_udp_dst_ports[MAX_ALLOWED_UDP_DST_PORTS] = {0};
-static int allowed_tcp_src_ports_count = 0;
-static int allowed_udp_src_ports_count = 0;
-static int allowed_tcp_dst_ports_count = 0;
-static int allowed_udp_dst_ports_count = 0;
-
-/* Parse a comma-separated list of ports into an array */
-static int init_allowed_ports(const char *ports_str, int *ports_count, uint16_t *ports_array, int max_ports, const char *port_type) {
-    /* Only initialize once */
-    static bool tcp_src_initialized = false;
-    static bool tcp_dst_initialized = false;
-    static bool udp_src_initialized = false;
-    static bool udp_dst_initialized = false;
-
-    /* Check if already initialized for this port type */
-    if ((strcmp(port_type, "tcp_src") == 0 && tcp_src_initialized) ||
-        (strcmp(port_type, "tcp_dst") == 0 && tcp_dst_initialized) ||
-        (strcmp(port_type, "udp_src") == 0 && udp_src_initialized) ||
-        (strcmp(port_type, "udp_dst") == 0 && udp_dst_initialized)) {
-        return 0;
-    }
-
-    /* Reset counter */
-    *ports_count = 0;
-
-    /* If no ports string provided, return */
-    if (!ports_str || !ports_str[0]) {
-        ESP_LOGI(TAG, "No %s ports configured", port_type);
-        return 0;
-    }
-
-    char port_buf[6]; /* Max 5 digits for a port + null terminator */
-    int port_buf_idx = 0;
-
-    for (int i = 0; ports_str[i] != '\0' && *ports_count < max_ports; i++) {
-        if (isdigit((unsigned char)ports_str[i])) {  /* Fix: cast to unsigned char */
-            port_buf[port_buf_idx++] = ports_str[i];
-            if (port_buf_idx >= sizeof(port_buf) - 1) {
-                port_buf_idx = sizeof(port_buf) - 2; /* Prevent overflow */
-            }
-        } else if (ports_str[i] == ',') {
-            if (port_buf_idx > 0) {
-                port_buf[port_buf_idx] = '\0';
-                ports_array[(*ports_count)++] = atoi(port_buf);
-                port_buf_idx = 0;
-            }
-        }
-    }
-
-    /* Process the last port if there's no trailing comma */
-    if (port_buf_idx > 0) {
-        port_buf[port_buf_idx] = '\0';
-        ports_array[(*ports_count)++] = atoi(port_buf);
-    }
-
-    /* Log the results */
-    ESP_LOGI(TAG, "Initialized %d allowed %s ports:", *ports_count, port_type);
-    for (int i = 0; i < *ports_count; i++) {
-        ESP_LOGI(TAG, "  - Port %d", ports_array[i]);
-    }
-
-    /* Mark as initialized */
-    if (strcmp(port_type, "tcp_src") == 0) {
-        tcp_src_initialized = true;
-    } else if (strcmp(port_type, "tcp_dst") == 0) {
-        tcp_dst_initialized = true;
-    } else if (strcmp(port_type, "udp_src") == 0) {
-        udp_src_initialized = true;
-    } else if (strcmp(port_type, "udp_dst") == 0) {
-        udp_dst_initialized = true;
-    }
-
-    return 0;
+/* Flow cache
+ * Remembers the routing decision per IPv4 5-tuple, so packets of a known
+ * flow skip the port rules and local pcb lookups. Entries are chained in
+ * hash buckets and recycled least recently used first.
+ *
+ * Only the Wi-Fi Rx path uses the table. Other contexts invalidate it by
+ * bumping flow_cache_gen, after which older entries no longer hit.
+ * Decisions that looked at the local pcbs expire like the port checks
+ * above, as opening or closing a port does not invalidate the cache */
+#define FLOW_CACHE_SIZE CONFIG_ESP_HOSTED_NW_SPLIT_FLOW_CACHE_SIZE
+#define FLOW_CACHE_PCB_TTL_MS 1000
+
+/* flags from the route_*_packet() decision */
+#define FLOW_F_PCB     (1 << 0) /* depends on local pcbs */
+#define FLOW_F_NOCACHE (1 << 1) /* depends on the packet payload */
+#define FLOW_F_VALID   (1 << 7)
+
+typedef struct {
+	uint32_t src_ip;
+	uint32_t dst_ip;
+	uint16_t src_port;
+	uint16_t dst_port;
+	uint8_t proto;
+} flow_key_t;
+
+#if FLOW_CACHE_SIZE
+#define FLOW_NIL -1
+
+typedef struct {
+	flow_key_t key;
+	uint32_t gen;
+	uint32_t time_ms;
+	int16_t hash_next;
+	int16_t lru_prev;
+	int16_t lru_next;
+	uint8_t bridge;
+	uint8_t flags;
+} flow_entry_t;
+
+static flow_entry_t flows[FLOW_CACHE_SIZE];
+static int16_t flow_hash[FLOW_CACHE_SIZE];
+static int16_t flow_lru_head = FLOW_NIL; /* most recently used */
+static int16_t flow_lru_tail = FLOW_NIL;
+static uint32_t flow_cache_gen = 0;
+
+static void flow_cache_init(void)
+{
+	int16_t i = 0;
+
+	for (i = 0; i < FLOW_CACHE_SIZE; i++) {
+		flow_hash[i] = FLOW_NIL;
+		flows[i].flags = 0;
+		flows[i].hash_next = FLOW_NIL;
+		flows[i].lru_prev = i ? i - 1 : FLOW_NIL;
+		flows[i].lru_next = (i + 1 < FLOW_CACHE_SIZE) ? i + 1 : FLOW_NIL;
+	}
+	flow_lru_head = 0;
+	flow_lru_tail = FLOW_CACHE_SIZE - 1;
 }
 
+static inline uint32_t flow_bucket(const flow_key_t *k)
+{
+	uint32_t h = k->src_ip * 0x9e3779b1;
 
-static int init_allowed_tcp_ports(const char *ports_str_src, const char *ports_str_dst) {
-    int ret1 = 0, ret2 = 0;
-
-    if (ports_str_src && strlen(ports_str_src) > 0) {
-        ESP_LOGI(TAG, "Host reserved TCP src ports: %s", ports_str_src);
-        ret1 = init_allowed_ports(ports_str_src, &allowed_tcp_src_ports_count,
-                                 allowed_tcp_src_ports, MAX_ALLOWED_TCP_SRC_PORTS, "tcp_src");
-    }
-
-    if (ports_str_dst && strlen(ports_str_dst) > 0) {
-        ESP_LOGI(TAG, "Host reserved TCP dst ports: %s", ports_str_dst);
-        ret2 = init_allowed_ports(ports_str_dst, &allowed_tcp_dst_ports_count,
-                                 allowed_tcp_dst_ports, MAX_ALLOWED_TCP_DST_PORTS, "tcp_dst");
-    }
-
-    if (ret1) {
-        ESP_LOGE(TAG, "Failed to initialize allowed TCP src ports");
-        return ret1;
-    }
-    if (ret2) {
-        ESP_LOGE(TAG, "Failed to initialize allowed TCP dst ports");
-        return ret2;
-    }
-    return 0;
+	h ^= k->dst_ip + 0x7f4a7c15 + (h << 6) + (h >> 2);
+	h ^= (((uint32_t)k->src_port << 16) | k->dst_port) * 0x85ebca6b;
+	h ^= k->proto;
+	h ^= h >> 16;
+	return h % FLOW_CACHE_SIZE;
 }
 
-static int init_allowed_udp_ports(const char *ports_str_src, const char *ports_str_dst) {
-    int ret1=0, ret2=0;
-	if (ports_str_src && strlen(ports_str_src) > 0) {
-		ESP_LOGI(TAG, "host reserved udp src ports: %s", ports_str_src);
-		ret1 = init_allowed_ports(ports_str_src, &allowed_udp_src_ports_count, allowed_udp_src_ports, MAX_ALLOWED_UDP_SRC_PORTS, "udp_src");
-	}
-	if (ports_str_dst && strlen(ports_str_dst) > 0) {
-		ESP_LOGI(TAG, "host reserved udp dst ports: %s", ports_str_dst);
-		ret2 = init_allowed_ports(ports_str_dst, &allowed_udp_dst_ports_count, allowed_udp_dst_ports, MAX_ALLOWED_UDP_DST_PORTS, "udp_dst");
-	}
+static inline bool flow_key_eq(const flow_key_t *a, const flow_key_t *b)
+{
+	return a->src_ip == b->src_ip && a->dst_ip == b->dst_ip &&
+		a->src_port == b->src_port && a->dst_port == b->dst_port &&
+		a->proto == b->proto;
+}
 
-	if (ret1) {
-		ESP_LOGE(TAG, "Failed to initialize allowed udp src ports");
-		return ret1;
-	}
-	if (ret2) {
-		ESP_LOGE(TAG, "Failed to initialize allowed udp dst ports");
-		return ret2;
+static int16_t flow_cache_find(const flow_key_t *k, uint32_t bucket)
+{
+	int16_t i = flow_hash[bucket];
+
+	while (i != FLOW_NIL && !flow_key_eq(&flows[i].key, k))
+		i = flows[i].hash_next;
+	return i;
+}
+
+static void flow_lru_to_front(int16_t i)
+{
+	flow_entry_t *e = &flows[i];
+
+	if (flow_lru_head == i)
+		return;
+
+	/* unlink, i is not the head so it has a prev */
+	flows[e->lru_prev].lru_next = e->lru_next;
+	if (e->lru_next != FLOW_NIL)
+		flows[e->lru_next].lru_prev = e->lru_prev;
+	else
+		flow_lru_tail = e->lru_prev;
+
+	e->lru_prev = FLOW_NIL;
+	e->lru_next = flow_lru_head;
+	flows[flow_lru_head].lru_prev = i;
+	flow_lru_head = i;
+}
+
+static void flow_hash_unlink(int16_t i)
+{
+	int16_t *p = &flow_hash[flow_bucket(&flows[i].key)];
+
+	while (*p != FLOW_NIL && *p != i)
+		p = &flows[*p].hash_next;
+	if (*p == i)
+		*p = flows[i].hash_next;
+}
+
+/* Look up the flow. *gen is to be passed to flow_cache_put() on a miss */
+static bool flow_cache_get(const flow_key_t *k, uint32_t *gen, hosted_l2_bridge *bridge)
+{
+	flow_entry_t *e = NULL;
+	int16_t i = FLOW_NIL;
+
+	/* load before classifying, so a flush racing a miss makes the new entry stale */
+	*gen = __atomic_load_n(&flow_cache_gen, __ATOMIC_ACQUIRE);
+
+	if (flow_lru_head == FLOW_NIL)
+		flow_cache_init();
+
+	i = flow_cache_find(k, flow_bucket(k));
+	if (i == FLOW_NIL)
+		goto miss;
+
+	e = &flows[i];
+	if (e->gen != *gen)
+		goto miss;
+	if ((e->flags & FLOW_F_PCB) &&
+			((uint32_t)(esp_timer_get_time() / 1000) - e->time_ms) >= FLOW_CACHE_PCB_TTL_MS)
+		goto miss;
+
+	flow_lru_to_front(i);
+	*bridge = (hosted_l2_bridge)e->bridge;
+#if ESP_PKT_STATS
+	pkt_stats.nw_split_flow_hit++;
+#endif
+	return true;
+
+miss:
+#if ESP_PKT_STATS
+	pkt_stats.nw_split_flow_miss++;
+#endif
+	return false;
+}
+
+static void flow_cache_put(const flow_key_t *k, uint32_t gen, hosted_l2_bridge bridge, uint8_t flags)
+{
+	uint32_t bucket = 0;
+	flow_entry_t *e = NULL;
+	int16_t i = FLOW_NIL;
+
+	if (flags & FLOW_F_NOCACHE)
+		return;
+
+	bucket = flow_bucket(k);
+	i = flow_cache_find(k, bucket);
+	if (i == FLOW_NIL) {
+		/* recycle the least recently used entry */
+		i = flow_lru_tail;
+		e = &flows[i];
+		if (e->flags & FLOW_F_VALID)
+			flow_hash_unlink(i);
+		e->key = *k;
+		e->hash_next = flow_hash[bucket];
+		flow_hash[bucket] = i;
 	}
-    return 0;
+
+	e = &flows[i];
+	e->gen = gen;
+	e->bridge = bridge;
+	e->flags = flags | FLOW_F_VALID;
+	if (flags & FLOW_F_PCB)
+		e->time_ms = (uint32_t)(esp_timer_get_time() / 1000);
+	flow_lru_to_front(i);
 }
 
-static int punch_hole_for_host_ports_from_config(const char *ports_str_tcp_src,
-                                                const char *ports_str_tcp_dst,
-                                                const char *ports_str_udp_src,
-                                                const char *ports_str_udp_dst) {
-    int ret1 = 0, ret2 = 0;
-
-    ESP_LOGI(TAG, "Host reserved TCP src ports: %s",
-             ports_str_tcp_src && strlen(ports_str_tcp_src) > 0 ? ports_str_tcp_src : "none");
-    ESP_LOGI(TAG, "Host reserved TCP dst ports: %s",
-             ports_str_tcp_dst && strlen(ports_str_tcp_dst) > 0 ? ports_str_tcp_dst : "none");
-    ret1 = init_allowed_tcp_ports(ports_str_tcp_src, ports_str_tcp_dst);
-
-    ESP_LOGI(TAG, "Host reserved UDP src ports: %s",
-             ports_str_udp_src && strlen(ports_str_udp_src) > 0 ? ports_str_udp_src : "none");
-    ESP_LOGI(TAG, "Host reserved UDP dst ports: %s",
-             ports_str_udp_dst && strlen(ports_str_udp_dst) > 0 ? ports_str_udp_dst : "none");
-    ret2 = init_allowed_udp_ports(ports_str_udp_src, ports_str_udp_dst);
-
-    if (ret1) {
-        ESP_LOGE(TAG, "Failed to initialize allowed TCP ports");
-        return ret1;
-    }
-    if (ret2) {
-        ESP_LOGE(TAG, "Failed to initialize allowed UDP ports");
-        return ret2;
-    }
-    return 0;
+void nw_split_flow_cache_flush(void)
+{
+	__atomic_add_fetch(&flow_cache_gen, 1, __ATOMIC_RELEASE);
+}
+#else
+static inline bool flow_cache_get(const flow_key_t *k, uint32_t *gen, hosted_l2_bridge *bridge)
+{
+	return false;
 }
 
-/* Port filtering functions */
-static inline bool is_tcp_src_port_allowed(uint16_t port) {
-    for (int i = 0; i < allowed_tcp_src_ports_count; i++) {
-        if (port == allowed_tcp_src_ports[i]) {
-            return true;
-        }
-    }
-    return false;
+static inline void flow_cache_put(const flow_key_t *k, uint32_t gen, hosted_l2_bridge bridge, uint8_t flags)
+{
 }
 
-static inline bool is_tcp_dst_port_allowed(uint16_t port) {
-    for (int i = 0; i < allowed_tcp_dst_ports_count; i++) {
-        if (port == allowed_tcp_dst_ports[i]) {
-            return true;
-        }
-    }
-    return false;
+void nw_split_flow_cache_flush(void)
+{
 }
+#endif
+
+/* Parse a comma separated list of ports or port ranges, e.g. "22,8000-8100",
+ * into rules to the given bridge. Returns the number of rules added, sets
+ * *truncated if ports were left over once max_rules were added */
+static int parse_host_port_list(const char *ports_str, uint8_t proto, bool match_src,
+		hosted_l2_bridge bridge, nw_split_port_rule_t *rules, int max_rules, bool *truncated)
+{
+	const char *p = ports_str;
+	char *end = NULL;
+	unsigned long start = 0, last = 0;
+	int n = 0;
+
+	while (p && *p && n < max_rules) {
+		if (!isdigit((unsigned char)*p)) {
+			p++;
+			continue;
+		}
+
+		start = strtoul(p, &end, 10);
+		last = start;
+		p = end;
+		if (*p == '-' && isdigit((unsigned char)p[1])) {
+			last = strtoul(p + 1, &end, 10);
+			p = end;
+		}
+
+		if (start > UINT16_MAX || last > UINT16_MAX || last < start) {
+			ESP_LOGW(TAG, "Ignoring invalid port range %lu-%lu", start, last);
+			continue;
+		}
 
-static inline bool is_udp_src_port_allowed(uint16_t port) {
-    for (int i = 0; i < allowed_udp_src_ports_count; i++) {
-        if (port == allowed_udp_src_ports[i]) {
-            return true;
-        }
-    }
-    return false;
+		rules[n].proto = proto;
+		rules[n].match_src = match_src;
+		rules[n].port_start = start;
+		rules[n].port_end = last;
+		rules[n].bridge = bridge;
+		ESP_LOGI(TAG, "  - %s %s port %lu-%lu", proto == IP_PROTO_TCP ? "TCP" : "UDP",
+				match_src ? "src" : "dst", start, last);
+		n++;
+	}
+
+	if (p && strpbrk(p, "0123456789")) {
+		ESP_LOGW(TAG, "Port list truncated at \"%s\"", p);
+		*truncated = true;
+	}
+	return n;
 }
 
-static inline bool is_udp_dst_port_allowed(uint16_t port) {
-    for (int i = 0; i < allowed_udp_dst_ports_count; i++) {
-        if (port == allowed_udp_dst_ports[i]) {
-            return true;
-        }
-    }
-    return false;
+/* Host power save policy for host bound TCP/UDP packets:
+ * drop (INVALID_BRIDGE), hold or hold and wake up the host.
+ * Rules are only set up at init, before Wi-Fi Rx */
+#define MAX_PS_HOLD_RULES 16
+
+#if defined(CONFIG_ESP_HOSTED_NW_SPLIT_PS_TCP_HOLD)
+  #define PS_TCP_DEFAULT HOST_HOLD_BRIDGE
+#elif defined(CONFIG_ESP_HOSTED_NW_SPLIT_PS_TCP_HOLD_WAKE)
+  #define PS_TCP_DEFAULT HOST_HOLD_WAKE_BRIDGE
+#else
+  #define PS_TCP_DEFAULT INVALID_BRIDGE
+#endif
+
+#if defined(CONFIG_ESP_HOSTED_NW_SPLIT_PS_UDP_HOLD)
+  #define PS_UDP_DEFAULT HOST_HOLD_BRIDGE
+#elif defined(CONFIG_ESP_HOSTED_NW_SPLIT_PS_UDP_HOLD_WAKE)
+  #define PS_UDP_DEFAULT HOST_HOLD_WAKE_BRIDGE
+#else
+  #define PS_UDP_DEFAULT INVALID_BRIDGE
+#endif
+
+static nw_split_port_rule_t ps_hold_rules[MAX_PS_HOLD_RULES];
+static int ps_hold_rules_count = 0;
+
+static hosted_l2_bridge host_ps_policy(uint8_t proto, uint16_t dst_port)
+{
+	int i = 0;
+
+	for (i = 0; i < ps_hold_rules_count; i++) {
+		if (ps_hold_rules[i].proto == proto &&
+				dst_port >= ps_hold_rules[i].port_start &&
+				dst_port <= ps_hold_rules[i].port_end)
+			return ps_hold_rules[i].bridge;
+	}
+	return (proto == IP_PROTO_TCP) ? PS_TCP_DEFAULT : PS_UDP_DEFAULT;
 }
 
-static bool host_mqtt_wakeup_triggered(const void *payload, uint16_t payload_length)
+/* Host bound packet while the host is power saving: hold it and wake up
+ * the host if it matches a wake up rule, else apply the port policy */
+static hosted_l2_bridge route_host_ps_packet(const void *frame, uint16_t frame_length, uint8_t proto,
+		u16_t src_port, u16_t dst_port, uint8_t *flow_flags)
 {
-	/* Check if payload contains "wakeup-host" string */
-	if (payload_length >= strlen(WAKEUP_HOST_STRING) &&
-			memcmp(payload, WAKEUP_HOST_STRING, strlen(WAKEUP_HOST_STRING)) == 0) {
-		return true;
+	hosted_l2_bridge result = INVALID_BRIDGE;
+
+	/* wake up rules looking at the payload, or rate limited, decide per packet */
+	if (!host_wake_filter_flow_constant(proto, src_port, dst_port))
+		*flow_flags |= FLOW_F_NOCACHE;
+	if (host_wake_filter_match(frame, frame_length)) {
+		ESP_LOGV(TAG, "Wakeup host: wake rule match dst %u src %u", dst_port, src_port);
+		result = HOST_HOLD_WAKE_BRIDGE;
+		return result;
 	}
-	return false;
+
+	result = host_ps_policy(proto, dst_port);
+	if (result == INVALID_BRIDGE)
+		ESP_LOGW(TAG, "host pkt dropped in power save (dst %u src %u)", dst_port, src_port);
+	return result;
 }
 
 static int is_local_tcp_port_open(uint16_t port)
@@ -346,7 +451,95 @@ static int is_local_udp_port_open(uint16_t port)
 	return found;
 }
 
-hosted_l2_bridge nw_split_filter_and_route_packet(void *frame_data, uint16_t frame_length)
+static hosted_l2_bridge route_tcp_packet(const void *frame, uint16_t frame_length,
+		u16_t src_port, u16_t dst_port, uint8_t *flow_flags)
+{
+	hosted_l2_bridge result = DEFAULT_LWIP_TO_SEND;
+
+	/* Check port forwarding rules (SSH, RTSP, etc.) */
+	if (nw_split_port_rules_match(IP_PROTO_TCP, src_port, dst_port, &result)) {
+		ESP_LOGV(TAG, "tcp port rule match => lwip %u", result);
+		return result;
+	}
+
+	/* Check for iperf port */
+	if (dst_port == DEFAULT_IPERF_PORT) {
+		ESP_LOGV(TAG, "iperf pkt %u", DEFAULT_IPERF_PORT);
+		*flow_flags |= FLOW_F_PCB;
+		if (is_local_tcp_port_open(dst_port)) {
+			result = SLAVE_LWIP_BRIDGE;
+			return result;
+		} else if (!is_host_power_saving()) {
+			result = HOST_LWIP_BRIDGE;
+			return result;
+		}
+	}
+
+	if (IS_REMOTE_TCP_PORT(dst_port)) {
+		if (is_host_power_saving()) {
+			result = route_host_ps_packet(frame, frame_length, IP_PROTO_TCP,
+					src_port, dst_port, flow_flags);
+			return result;
+		} else {
+			/* As host is not sleeping, send packets freely */
+			result = HOST_LWIP_BRIDGE;
+			return result;
+		}
+	} else if (IS_LOCAL_TCP_PORT(dst_port)) {
+		result = SLAVE_LWIP_BRIDGE;
+		return result;
+	}
+
+	return result;
+}
+
+static hosted_l2_bridge route_udp_packet(const void *frame, uint16_t frame_length,
+		u16_t src_port, u16_t dst_port, uint8_t *flow_flags)
+{
+	hosted_l2_bridge result = DEFAULT_LWIP_TO_SEND;
+
+	/* Check port forwarding rules */
+	if (nw_split_port_rules_match(IP_PROTO_UDP, src_port, dst_port, &result)) {
+		ESP_LOGV(TAG, "udp port rule match => lwip %u", result);
+		return result;
+	}
+
+	/* Check for iperf UDP port */
+	if (dst_port == DEFAULT_IPERF_PORT) {
+		ESP_LOGV(TAG, "Detected iperf UDP packet on port %u", DEFAULT_IPERF_PORT);
+		*flow_flags |= FLOW_F_PCB;
+		if (is_local_udp_port_open(dst_port)) {
+			result = SLAVE_LWIP_BRIDGE;
+			return result;
+		} else if (!is_host_power_saving()) {
+			result = HOST_LWIP_BRIDGE;
+			return result;
+		}
+	}
+
+	if (dst_port == LWIP_IANA_PORT_DHCP_CLIENT) {
+		result = DHCP_LWIP_BRIDGE;
+		return result;
+	}
+
+	if (IS_REMOTE_UDP_PORT(dst_port)) {
+		if (is_host_power_saving()) {
+			result = route_host_ps_packet(frame, frame_length, IP_PROTO_UDP,
+					src_port, dst_port, flow_flags);
+			return result;
+		} else {
+			result = HOST_LWIP_BRIDGE;
+			return result;
+		}
+	} else if (IS_LOCAL_UDP_PORT(dst_port)) {
+		result = SLAVE_LWIP_BRIDGE;
+		return result;
+	}
+
+	return result;
+}
+
+static hosted_l2_bridge route_packet(void *frame_data, uint16_t frame_length)
 {
 	hosted_l2_bridge result = DEFAULT_LWIP_TO_SEND;
 
@@ -371,113 +564,34 @@ hosted_l2_bridge nw_split_filter_and_route_packet(void *frame_data, uint16_t fra
 		/* Get the protocol from the IP header */
 		proto = IPH_PROTO(iphdr);
 
-		if (proto == IP_PROTO_TCP) {
-			struct tcp_hdr *tcphdr = (struct tcp_hdr *)((u8_t *)iphdr + IPH_HL(iphdr) * 4);
-			dst_port = lwip_ntohs(tcphdr->dest);
-			src_port = lwip_ntohs(tcphdr->src);
-
-			ESP_LOGV(TAG, "dst_port: %u, src_port: %u", dst_port, src_port);
-
-			/* Check for allowed ports (SSH, RTSP, etc.) */
-			if (is_tcp_src_port_allowed(src_port) || is_tcp_dst_port_allowed(dst_port)) {
-				ESP_LOGV(TAG, "Priority tcp port traffic detected, forwarding to host");
-				result = HOST_LWIP_BRIDGE;
-				return result;
-			}
-
-			/* Check for iperf port */
-			if (dst_port == DEFAULT_IPERF_PORT) {
-				ESP_LOGV(TAG, "iperf pkt %u", DEFAULT_IPERF_PORT);
-				if (is_local_tcp_port_open(dst_port)) {
-					result = SLAVE_LWIP_BRIDGE;
-					return result;
-				} else if (!is_host_power_saving()) {
-					result = HOST_LWIP_BRIDGE;
-					return result;
-				}
-			}
-
-			if (IS_REMOTE_TCP_PORT(dst_port)) {
-				if (is_host_power_saving()) {
-					/* filter host destined mqtt packet says 'wake-up-host' */
-					if (src_port == MQTT_PORT) {
-					#define TCP_HDR_LEN(tcphdr) ((TCPH_FLAGS(tcphdr) >> 12) * 4)
-
-						u16_t tcp_hdr_len = TCP_HDR_LEN(tcphdr);
-						u16_t mqtt_payload_length = lwip_ntohs(tcphdr->wnd);
-						u8_t *mqtt_payload = (u8_t *)tcphdr + tcp_hdr_len;
-
-						if (host_mqtt_wakeup_triggered(mqtt_payload, mqtt_payload_length)) {
-							ESP_LOGV(TAG, "Wakeup host: MQTT wakeup pkt");
-							result = HOST_LWIP_BRIDGE;
-							return result;
-						} else {
-							/* drop any other host destined mqtt packet */
-							result = INVALID_BRIDGE;
-							ESP_LOGW(TAG, "mqtt pkt DROPPED dst %u src %u => lwip %u", dst_port, src_port, result);
-							return result;
-						}
-					} else {
-						ESP_LOGV(TAG, "Wakeup host: TCP pkt");
-						result = INVALID_BRIDGE;
-						ESP_LOGW(TAG, "host pkt dropped in power save (dst %u src %u)", dst_port, src_port);
-						return result;
-					}
-				} else {
-					/* As host is not sleeping, send packets freely */
-					result = HOST_LWIP_BRIDGE;
-					return result;
-				}
-			} else if (IS_LOCAL_TCP_PORT(dst_port)) {
-				result = SLAVE_LWIP_BRIDGE;
+		if (proto == IP_PROTO_TCP || proto == IP_PROTO_UDP) {
+			/* TCP and UDP headers both start with the source and destination port */
+			struct udp_hdr *l4hdr = (struct udp_hdr *)((u8_t *)iphdr + IPH_HL(iphdr) * 4);
+			uint8_t flow_flags = 0;
+			uint32_t flow_gen = 0;
+			flow_key_t flow;
+
+			dst_port = lwip_ntohs(l4hdr->dest);
+			src_port = lwip_ntohs(l4hdr->src);
+
+			ESP_LOGV(TAG, "%s dst_port: %u, src_port: %u",
+					proto == IP_PROTO_TCP ? "TCP" : "UDP", dst_port, src_port);
+
+			flow.src_ip = iphdr->src.addr;
+			flow.dst_ip = iphdr->dest.addr;
+			flow.src_port = src_port;
+			flow.dst_port = dst_port;
+			flow.proto = proto;
+			if (flow_cache_get(&flow, &flow_gen, &result))
 				return result;
-			}
 
-		} else if (proto == IP_PROTO_UDP) {
-			ESP_LOGV(TAG, "new udp packet");
-			struct udp_hdr *udphdr = (struct udp_hdr *)((u8_t *)iphdr + IPH_HL(iphdr) * 4);
-			dst_port = lwip_ntohs(udphdr->dest);
-			src_port = lwip_ntohs(udphdr->src);
+			if (proto == IP_PROTO_TCP)
+				result = route_tcp_packet(frame_data, frame_length, src_port, dst_port, &flow_flags);
+			else
+				result = route_udp_packet(frame_data, frame_length, src_port, dst_port, &flow_flags);
 
-			ESP_LOGV(TAG, "UDP dst_port: %u, src_port: %u", dst_port, src_port);
-
-			/* Check for allowed ports */
-			if (is_udp_src_port_allowed(src_port) || is_udp_dst_port_allowed(dst_port)) {
-				ESP_LOGV(TAG, "Priority udp port traffic detected, forwarding to host");
-				result = HOST_LWIP_BRIDGE;
-				return result;
-			}
-
-			/* Check for iperf UDP port */
-			if (dst_port == DEFAULT_IPERF_PORT) {
-				ESP_LOGV(TAG, "Detected iperf UDP packet on port %u", DEFAULT_IPERF_PORT);
-				if (is_local_udp_port_open(dst_port)) {
-					result = SLAVE_LWIP_BRIDGE;
-					return result;
-				} else if (!is_host_power_saving()) {
-					result = HOST_LWIP_BRIDGE;
-					return result;
-				}
-			}
-
-			if (dst_port == LWIP_IANA_PORT_DHCP_CLIENT) {
-				result = DHCP_LWIP_BRIDGE;
-				return result;
-			}
-
-			if (IS_REMOTE_UDP_PORT(dst_port)) {
-				if (is_host_power_saving()) {
-					ESP_LOGW(TAG, "host pkt dropped in power save (dst %u src %u)", dst_port, src_port);
-					result = INVALID_BRIDGE;
-					return result;
-				} else {
-					result = HOST_LWIP_BRIDGE;
-					return result;
-				}
-			} else if (IS_LOCAL_UDP_PORT(dst_port)) {
-				result = SLAVE_LWIP_BRIDGE;
-				return result;
-			}
+			flow_cache_put(&flow, flow_gen, result, flow_flags);
+			return result;
 
 		} else if (proto == IP_PROTO_ICMP) {
 			ESP_LOGV(TAG, "new icmp packet");
@@ -521,7 +635,63 @@ hosted_l2_bridge nw_split_filter_and_route_packet(void *frame_data, uint16_t fra
 	return result;
 }
 
-int nw_split_config_host_static_port_fwd_rules(const char *ports_str_tcp_src, const char *ports_str_tcp_dst, const char *ports_str_udp_src, const char *ports_str_udp_dst) {
-    return punch_hole_for_host_ports_from_config(ports_str_tcp_src, ports_str_tcp_dst, ports_str_udp_src, ports_str_udp_dst);
+hosted_l2_bridge nw_split_filter_and_route_packet(void *frame_data, uint16_t frame_length)
+{
+	hosted_l2_bridge result = route_packet(frame_data, frame_length);
+
+	/* Host just woke up and its held packets are being sent: queue behind
+	 * them, so that no packet of a flow overtakes an older held one.
+	 * Also applies to cached flow decisions */
+	if (result == HOST_LWIP_BRIDGE && nw_split_host_hold_flushing())
+		result = HOST_HOLD_BRIDGE;
+
+	return result;
+}
+
+int nw_split_config_host_static_port_fwd_rules(const char *ports_str_tcp_src, const char *ports_str_tcp_dst,
+                                                const char *ports_str_udp_src, const char *ports_str_udp_dst)
+{
+	nw_split_port_rule_t *rules = calloc(MAX_PORT_RULES, sizeof(nw_split_port_rule_t));
+	bool truncated = false;
+	int n = 0;
+	esp_err_t ret = ESP_OK;
+
+	if (!rules) {
+		ESP_LOGE(TAG, "Failed to allocate static port rules");
+		return ESP_ERR_NO_MEM;
+	}
+
+	ESP_LOGI(TAG, "Host reserved ports:");
+	n += parse_host_port_list(ports_str_tcp_src, IP_PROTO_TCP, true, HOST_LWIP_BRIDGE, rules + n, MAX_PORT_RULES - n, &truncated);
+	n += parse_host_port_list(ports_str_tcp_dst, IP_PROTO_TCP, false, HOST_LWIP_BRIDGE, rules + n, MAX_PORT_RULES - n, &truncated);
+	n += parse_host_port_list(ports_str_udp_src, IP_PROTO_UDP, true, HOST_LWIP_BRIDGE, rules + n, MAX_PORT_RULES - n, &truncated);
+	n += parse_host_port_list(ports_str_udp_dst, IP_PROTO_UDP, false, HOST_LWIP_BRIDGE, rules + n, MAX_PORT_RULES - n, &truncated);
+	if (truncated)
+		ESP_LOGW(TAG, "Host reserved ports: only %d of the configured rules set (max %d)", n, MAX_PORT_RULES);
+
+	ret = nw_split_set_port_rules(rules, n, true);
+	free(rules);
+	return ret;
+}
+
+int nw_split_config_host_ps_hold_rules(const char *ports_str_tcp_hold, const char *ports_str_udp_hold,
+                                       const char *ports_str_tcp_wake, const char *ports_str_udp_wake)
+{
+	nw_split_port_rule_t *rules = ps_hold_rules;
+	bool truncated = false;
+	int n = 0;
+
+	ESP_LOGI(TAG, "Host power save, hold ports:");
+	n += parse_host_port_list(ports_str_tcp_hold, IP_PROTO_TCP, false, HOST_HOLD_BRIDGE, rules + n, MAX_PS_HOLD_RULES - n, &truncated);
+	n += parse_host_port_list(ports_str_udp_hold, IP_PROTO_UDP, false, HOST_HOLD_BRIDGE, rules + n, MAX_PS_HOLD_RULES - n, &truncated);
+	ESP_LOGI(TAG, "Host power save, hold and wake up ports:");
+	n += parse_host_port_list(ports_str_tcp_wake, IP_PROTO_TCP, false, HOST_HOLD_WAKE_BRIDGE, rules + n, MAX_PS_HOLD_RULES - n, &truncated);
+	n += parse_host_port_list(ports_str_udp_wake, IP_PROTO_UDP, false, HOST_HOLD_WAKE_BRIDGE, rules + n, MAX_PS_HOLD_RULES - n, &truncated);
+	if (truncated)
+		ESP_LOGW(TAG, "Host power save: only %d of the configured hold and wake up rules set (max %d), "
+				"other ports follow the protocol default", n, MAX_PS_HOLD_RULES);
+	ps_hold_rules_count = n;
+
+	return n;
 }
 #endif
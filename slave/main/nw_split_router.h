@@ -16,14 +16,55 @@ typedef enum {
 	HOST_LWIP_BRIDGE,
 	BOTH_LWIP_BRIDGE,
 	INVALID_BRIDGE,
+	HOST_HOLD_BRIDGE,       /* host power saving: hold for the host */
+	HOST_HOLD_WAKE_BRIDGE,  /* host power saving: hold and wake up the host */
 } hosted_l2_bridge;
 
+#include "esp_err.h"
 #include "esp_hosted_lwip_src_port_hook.h"
 
+/* Port forwarding rule, matched on IP packets from Wi-Fi */
+typedef struct {
+	uint8_t proto;            /* IP_PROTO_TCP or IP_PROTO_UDP */
+	uint8_t match_src;        /* match source port instead of destination port */
+	uint16_t port_start;
+	uint16_t port_end;        /* inclusive */
+	hosted_l2_bridge bridge;  /* INVALID_BRIDGE drops the packet */
+} nw_split_port_rule_t;
+
 hosted_l2_bridge nw_split_filter_and_route_packet(void *frame_data, uint16_t frame_length);
 
+/* Add port forwarding rules after the ones in place, or instead of them
+ * if replace is set. The first matching rule decides.
+ * Returns ESP_ERR_NO_MEM if CONFIG_ESP_HOSTED_NW_SPLIT_MAX_PORT_RULES is exceeded */
+esp_err_t nw_split_set_port_rules(const nw_split_port_rule_t *rules, int num_rules, bool replace);
+
+/* Drop all cached per flow decisions, e.g. when host power state changes.
+ * Safe to call from any context, including ISR */
+void nw_split_flow_cache_flush(void);
+
 int nw_split_config_host_static_port_fwd_rules(const char *ports_str_tcp_src, const char *ports_str_tcp_dst,
                                                 const char *ports_str_udp_src, const char *ports_str_udp_dst);
+
+/* Destination ports of host bound packets to hold, or hold and wake up the
+ * host for, while the host is power saving. Others follow the protocol default.
+ * At most 16 rules are kept, the rest is dropped with a warning.
+ * Returns the number of rules set */
+int nw_split_config_host_ps_hold_rules(const char *ports_str_tcp_hold, const char *ports_str_udp_hold,
+                                       const char *ports_str_tcp_wake, const char *ports_str_udp_wake);
+
+/* Hold a copy of a host bound frame until the host wakes up */
+void nw_split_host_hold(const void *frame, uint16_t len, bool wake_host);
+
+/* Mark the held frames as about to be flushed. Called before the host is
+ * marked awake: until nw_split_host_hold_flush() has sent all of them,
+ * host bound frames are held too, so that they queue behind */
+void nw_split_host_hold_flush_begin(void);
+
+bool nw_split_host_hold_flushing(void);
+
+/* Send the held frames to the host, once it is awake */
+void nw_split_host_hold_flush(void);
 #endif
 
 #endif
@@ -33,6 +33,11 @@ static const char TAG[] = "protocomm_pserial";
 #define PROTO_PSER_TLV_T_EPNAME       1
 #define PROTO_PSER_TLV_T_DATA         2
 
+/* RPC_EP_NAME_RSP and RPC_EP_NAME_EVT have the same length */
+#define TLV_EP_NAME_LEN               (sizeof(RPC_EP_NAME_RSP) - 1)
+#define TLV_HDR_LEN                   (SIZE_OF_TYPE + SIZE_OF_LENGTH + TLV_EP_NAME_LEN + \
+                                       SIZE_OF_TYPE + SIZE_OF_LENGTH)
+
 struct pserial_config {
 	pserial_xmit    xmit;
 	pserial_recv    recv;
@@ -65,10 +70,30 @@ static esp_err_t parse_tlv(uint8_t **buf, size_t *total_len,
 	return ESP_OK;
 }
 
+uint8_t *protocomm_pserial_alloc_outbuf(size_t len)
+{
+	uint8_t *buf = (uint8_t *)malloc(TLV_HDR_LEN + len);
+
+	if (buf == NULL) {
+		ESP_LOGE(TAG,"%s Mem Alloc Failed [%d]bytes", __func__, (int)(TLV_HDR_LEN + len));
+		return NULL;
+	}
+	return buf + TLV_HDR_LEN;
+}
+
+void protocomm_pserial_free_outbuf(uint8_t *buf)
+{
+	if (buf)
+		free(buf - TLV_HDR_LEN);
+}
+
+/* Fill in TLV header in the room reserved by protocomm_pserial_alloc_outbuf()
+ * in front of *out. *out and *outlen are updated to cover header and data */
 static esp_err_t compose_tlv(char *epname, uint8_t **out, size_t *outlen)
 {
 	uint16_t len = 0;
 	uint16_t ep_len = strlen(epname);
+	uint8_t *buf = NULL;
 	/*
 	 * TLV (Type - Length - Value) structure is as follows:
 	 * --------------------------------------------------------------------------------------------
@@ -80,32 +105,28 @@ static esp_err_t compose_tlv(char *epname, uint8_t **out, size_t *outlen)
 	 *       1        |        2        | Endpoint length |     1     |      2      | Data length |
 	 * --------------------------------------------------------------------------------------------
 	 */
-	uint32_t buf_len = SIZE_OF_TYPE + SIZE_OF_LENGTH +
-		ep_len + SIZE_OF_TYPE + SIZE_OF_LENGTH + *outlen;
-	uint8_t *buf = (uint8_t *)calloc(1, buf_len);
-	if (buf == NULL) {
-		ESP_LOGE(TAG,"%s Mem Alloc Failed [%d]bytes", __func__, (int)buf_len);
+	if (!*out || (ep_len != TLV_EP_NAME_LEN)) {
+		ESP_LOGE(TAG, "%s: invalid out buf or endpoint [%s]", __func__, epname);
 		return ESP_FAIL;
 	}
+
+	buf = *out - TLV_HDR_LEN;
 	buf[len] = PROTO_PSER_TLV_T_EPNAME;
 	len++;
 	buf[len] = (ep_len & 0xFF);
 	len++;
 	buf[len] = ((ep_len >> 8) & 0xFF);
 	len++;
-	memcpy(&buf[len], epname, strlen(epname));
-	len = len + strlen(epname) ;
+	memcpy(&buf[len], epname, ep_len);
+	len = len + ep_len;
 	buf[len] = PROTO_PSER_TLV_T_DATA;
 	len++;
 	buf[len] = (*outlen & 0xFF);
 	len++;
 	buf[len] = ((*outlen >> 8) & 0xFF);
 	len++;
-	buf_len = len + *outlen;
-	memcpy(&buf[len], (*out), *outlen);
-	free(*out);
 	*out = buf;
-	*outlen = buf_len;
+	*outlen = len + *outlen;
 	return ESP_OK;
 }
 
@@ -163,6 +184,7 @@ static esp_err_t rpc_req_handler(protocomm_t *pc,
 	ret = compose_tlv(RPC_EP_NAME_RSP, &out, &outlen);
 	if (ret != ESP_OK) {
 		ESP_LOGE(TAG, "Failed to compose tlv");
+		protocomm_pserial_free_outbuf(out);
 		return ESP_FAIL;
 	}
 
@@ -198,6 +220,7 @@ static esp_err_t rpc_evt_handler(protocomm_t *pc,
 	ret = compose_tlv(RPC_EP_NAME_EVT, &out, &outlen);
 	if (ret != ESP_OK) {
 		ESP_LOGE(TAG, "Failed to compose tlv");
+		protocomm_pserial_free_outbuf(out);
 		return ESP_FAIL;
 	}
 
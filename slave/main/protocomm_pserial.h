@@ -18,6 +18,15 @@ typedef ssize_t (*pserial_recv)(uint8_t *buf, ssize_t len);
 esp_err_t protocomm_pserial_start(protocomm_t *pc, pserial_xmit xmit, pserial_recv recv);
 esp_err_t protocomm_pserial_data_ready(protocomm_t *pc, uint8_t * in, int len, int msg_id);
 
+/* Output buffer for RPC endpoint handlers to pack a response or event into.
+ * Room for the serial TLV header is reserved in front of the returned
+ * pointer, so the packed payload is sent without another copy.
+ * Endpoints are added without protocomm security, so the buffer reaches
+ * the serial layer unchanged. Free with protocomm_pserial_free_outbuf()
+ * if it is not handed back to protocomm */
+uint8_t *protocomm_pserial_alloc_outbuf(size_t len);
+void protocomm_pserial_free_outbuf(uint8_t *buf);
+
 
 #if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
   #define QUEUE_HANDLE QueueHandle_t
@@ -31,7 +31,6 @@
 #define MEM_ALIGNMENT_BYTES          4
 #endif
 
-//#define SIMPLIFIED_SDIO_SLAVE          1
 #define SDIO_DRIVER_TX_QUEUE_SIZE        CONFIG_ESP_SDIO_TX_Q_SIZE
 #define SDIO_RX_BUFFER_SIZE              MAX_TRANSPORT_BUF_SIZE
 #define SDIO_NUM_RX_BUFFERS              CONFIG_ESP_SDIO_RX_Q_SIZE
@@ -44,6 +43,36 @@ static sdio_slave_buf_handle_t sdio_rx_buf_handles[SDIO_NUM_RX_BUFFERS];
 static hosted_mempool_t * buf_mp_tx_g;
 #endif
 
+/* Slave to host coalescing, only in streaming mode where host splits
+ * the frames of one read on its side */
+#if !SIMPLIFIED_SDIO_SLAVE && CONFIG_ESP_SDIO_TX_COALESCE
+#define SDIO_TX_COALESCE                 1
+#define SDIO_TX_COALESCE_BUF_SIZE        CONFIG_ESP_SDIO_TX_COALESCE_BUF_SIZE
+#define SDIO_TX_COALESCE_NUM_BUFS        CONFIG_ESP_SDIO_TX_COALESCE_NUM_BUFS
+#define SDIO_TX_COALESCE_FLUSH_TICKS     (pdMS_TO_TICKS(CONFIG_ESP_SDIO_TX_COALESCE_FLUSH_TIMEOUT_MS) ? \
+                                          pdMS_TO_TICKS(CONFIG_ESP_SDIO_TX_COALESCE_FLUSH_TIMEOUT_MS) : 1)
+
+static uint8_t *sdio_tx_coalesce_bufs[SDIO_TX_COALESCE_NUM_BUFS];
+static QueueHandle_t sdio_tx_coalesce_free_q;
+static SemaphoreHandle_t sdio_tx_coalesce_lock;
+/* buffer being filled, protected by sdio_tx_coalesce_lock.
+ * Stored atomically, as the Tx done task peeks at it without the lock */
+static uint8_t *sdio_tx_coalesce_buf;
+static uint32_t sdio_tx_coalesce_len;
+static uint16_t sdio_tx_coalesce_pkts;
+
+/* Lock free peek, for the Tx done task to pick its wait time.
+ * A buffer started while nothing is in flight is flushed right away by
+ * the writer, else a Tx done follows that flushes it, so a stale read
+ * only costs one extra wake up */
+static inline bool sdio_tx_coalesce_is_pending(void)
+{
+	return __atomic_load_n(&sdio_tx_coalesce_buf, __ATOMIC_RELAXED) != NULL;
+}
+#else
+#define SDIO_TX_COALESCE                 0
+#endif
+
 interface_context_t context;
 interface_handle_t if_handle_g;
 static const char *TAG = "SDIO_SLAVE";
@@ -87,6 +116,9 @@ static void sdio_deinit(interface_handle_t *handle);
 static void sdio_rx_task(void* pvParameters);
 static void sdio_tx_done_task(void* pvParameters);
 #endif
+#if SDIO_TX_COALESCE
+static void sdio_tx_coalesce_flush_pending(void);
+#endif
 
 if_ops_t if_ops = {
 	.init = sdio_init,
@@ -132,6 +164,45 @@ static inline void sdio_buffer_tx_free(void *buf)
 	MEMPOOL_FREE(buf_mp_tx_g, buf);
 }
 
+#if SDIO_TX_COALESCE
+static void sdio_tx_coalesce_create(void)
+{
+	sdio_tx_coalesce_lock = xSemaphoreCreateMutex();
+	assert(sdio_tx_coalesce_lock);
+
+	sdio_tx_coalesce_free_q = xQueueCreate(SDIO_TX_COALESCE_NUM_BUFS, sizeof(uint8_t *));
+	assert(sdio_tx_coalesce_free_q);
+
+	for (int i = 0; i < SDIO_TX_COALESCE_NUM_BUFS; i++) {
+		sdio_tx_coalesce_bufs[i] = heap_caps_malloc(SDIO_TX_COALESCE_BUF_SIZE,
+				MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+		assert(sdio_tx_coalesce_bufs[i]);
+		xQueueSend(sdio_tx_coalesce_free_q, &sdio_tx_coalesce_bufs[i], 0);
+	}
+}
+
+static inline bool sdio_tx_is_coalesce_buf(void *buf)
+{
+	for (int i = 0; i < SDIO_TX_COALESCE_NUM_BUFS; i++) {
+		if (buf == sdio_tx_coalesce_bufs[i])
+			return true;
+	}
+	return false;
+}
+#endif
+
+/* Free a buffer returned by the SDIO driver after send */
+static void sdio_tx_buf_free(void *buf)
+{
+#if SDIO_TX_COALESCE
+	if (sdio_tx_is_coalesce_buf(buf)) {
+		xQueueSend(sdio_tx_coalesce_free_q, &buf, 0);
+		return;
+	}
+#endif
+	sdio_buffer_tx_free(buf);
+}
+
 #if !SIMPLIFIED_SDIO_SLAVE
 static void start_rx_data_throttling_if_needed(void)
 {
@@ -379,6 +450,11 @@ static interface_handle_t * sdio_init(void)
 #if !SIMPLIFIED_SDIO_SLAVE
   #if CONFIG_ESP_SDIO_STREAMING_MODE
 	ESP_LOGI(TAG, "%s: sending mode: SDIO_SLAVE_SEND_STREAM", __func__);
+    #if SDIO_TX_COALESCE
+	ESP_LOGI(TAG, "%s: Tx coalesce: %u x %u bytes, flush timeout %u ms", __func__,
+			SDIO_TX_COALESCE_NUM_BUFS, SDIO_TX_COALESCE_BUF_SIZE,
+			CONFIG_ESP_SDIO_TX_COALESCE_FLUSH_TIMEOUT_MS);
+    #endif
   #else
 	ESP_LOGI(TAG, "%s: sending mode: SDIO_SLAVE_SEND_PACKET", __func__);
   #endif
@@ -390,6 +466,10 @@ static interface_handle_t * sdio_init(void)
 		sdio_send_queue_sem = xSemaphoreCreateCounting(SDIO_DRIVER_TX_QUEUE_SIZE, SDIO_DRIVER_TX_QUEUE_SIZE);
 		assert(sdio_send_queue_sem);
 
+  #if SDIO_TX_COALESCE
+		sdio_tx_coalesce_create();
+  #endif
+
 		sdio_rx_sem = xSemaphoreCreateCounting(SDIO_NUM_RX_BUFFERS* MAX_PRIORITY_QUEUES, 0);
 		assert(sdio_rx_sem != NULL);
 
@@ -475,13 +555,29 @@ static void sdio_tx_done_task(void* pvParameters)
 			continue;
 		}
 
+#if SDIO_TX_COALESCE
+		/* Honour the flush timeout only while a coalesce buffer is pending,
+		 * so that an idle slave is free to enter light sleep */
+		res = sdio_slave_send_get_finished((void**)&sendbuf_p,
+				sdio_tx_coalesce_is_pending() ? SDIO_TX_COALESCE_FLUSH_TICKS : portMAX_DELAY);
+		if (res == ESP_ERR_TIMEOUT) {
+			sdio_tx_coalesce_flush_pending();
+			continue;
+		}
+#else
 		res = sdio_slave_send_get_finished((void**)&sendbuf_p, portMAX_DELAY);
+#endif
 		if (res) {
 			ESP_LOGE(TAG, "sdio_slave_send_get_finished() error");
 			continue;
 		}
 		xSemaphoreGive(sdio_send_queue_sem);
-		sdio_buffer_tx_free(sendbuf_p);
+		sdio_tx_buf_free(sendbuf_p);
+
+#if SDIO_TX_COALESCE
+		/* Host is draining the queue: hand over whatever got coalesced meanwhile */
+		sdio_tx_coalesce_flush_pending();
+#endif
 	}
 }
 #endif
@@ -521,6 +617,104 @@ static inline esp_err_t copy_tx_payload(uint8_t *sendbuf, uint8_t* payload, uint
 	return ESP_OK;
 }
 
+#if SDIO_TX_COALESCE
+/* Queue the buffer being filled to SDIO driver.
+ * Caller holds sdio_tx_coalesce_lock.
+ * Returns ESP_ERR_TIMEOUT, keeping the data pending, if no driver
+ * slot is free within 'wait' ticks */
+static esp_err_t sdio_tx_coalesce_flush(TickType_t wait)
+{
+	uint8_t *sendbuf = sdio_tx_coalesce_buf;
+	uint32_t len = sdio_tx_coalesce_len;
+	uint16_t pkts = sdio_tx_coalesce_pkts;
+	esp_err_t ret = ESP_OK;
+
+	if (!sendbuf)
+		return ESP_OK;
+
+	if (xSemaphoreTake(sdio_send_queue_sem, wait) != pdTRUE)
+		return ESP_ERR_TIMEOUT;
+
+#if ESP_PKT_STATS
+	pkt_stats.sh_bus_coalesce_bufs++;
+	pkt_stats.sh_bus_coalesce_pkts += pkts;
+#endif
+	__atomic_store_n(&sdio_tx_coalesce_buf, NULL, __ATOMIC_RELAXED);
+	sdio_tx_coalesce_len = 0;
+	sdio_tx_coalesce_pkts = 0;
+
+	ESP_HEXLOGV("bus_tx", sendbuf, len, 32);
+
+	ret = sdio_slave_send_queue(sendbuf, len, sendbuf, portMAX_DELAY);
+	if (ret != ESP_OK) {
+		/* every frame packed into the buffer is lost */
+#if ESP_PKT_STATS
+		pkt_stats.sh_bus_coalesce_drops += pkts;
+#endif
+		ESP_LOGW(TAG, "sdio slave transmit error, ret : 0x%x, %u coalesced frames dropped",
+				ret, pkts);
+		xSemaphoreGive(sdio_send_queue_sem);
+		sdio_tx_buf_free(sendbuf);
+		return ESP_FAIL;
+	}
+
+	return ESP_OK;
+}
+
+/* Called from sdio_tx_done_task, which is the only consumer of
+ * finished sends, so it must never block on the lock or on a driver slot */
+static void sdio_tx_coalesce_flush_pending(void)
+{
+	if (xSemaphoreTake(sdio_tx_coalesce_lock, 0) != pdTRUE)
+		return;
+
+	sdio_tx_coalesce_flush(0);
+	xSemaphoreGive(sdio_tx_coalesce_lock);
+}
+
+/* Append one frame to the coalesce buffer.
+ * Returns ESP_ERR_NO_MEM if no coalesce buffer is free, in which case
+ * the caller sends the frame on its own */
+static esp_err_t sdio_tx_coalesce_write(interface_buffer_handle_t *buf_handle,
+		uint32_t total_len)
+{
+	uint8_t *frame = NULL;
+	esp_err_t ret = ESP_OK;
+
+	xSemaphoreTake(sdio_tx_coalesce_lock, portMAX_DELAY);
+
+	if (sdio_tx_coalesce_buf &&
+	    (sdio_tx_coalesce_len + total_len > SDIO_TX_COALESCE_BUF_SIZE)) {
+		/* on failure the earlier frames are dropped, logged and counted */
+		sdio_tx_coalesce_flush(portMAX_DELAY);
+	}
+
+	if (!sdio_tx_coalesce_buf) {
+		uint8_t *buf = NULL;
+
+		if (xQueueReceive(sdio_tx_coalesce_free_q, &buf, 0) != pdTRUE) {
+			xSemaphoreGive(sdio_tx_coalesce_lock);
+			return ESP_ERR_NO_MEM;
+		}
+		__atomic_store_n(&sdio_tx_coalesce_buf, buf, __ATOMIC_RELAXED);
+	}
+
+	/* Frames are packed back to back, as host streaming Rx expects */
+	frame = sdio_tx_coalesce_buf + sdio_tx_coalesce_len;
+	copy_tx_payload(frame, buf_handle->payload, buf_handle->payload_len);
+	update_tx_header(frame, buf_handle);
+	sdio_tx_coalesce_len += total_len;
+	sdio_tx_coalesce_pkts++;
+
+	/* Nothing in flight, so no Tx done would come to flush this: send now */
+	if (uxSemaphoreGetCount(sdio_send_queue_sem) == SDIO_DRIVER_TX_QUEUE_SIZE)
+		ret = sdio_tx_coalesce_flush(portMAX_DELAY);
+
+	xSemaphoreGive(sdio_tx_coalesce_lock);
+	return ret;
+}
+#endif
+
 static int32_t sdio_write(interface_handle_t *handle, interface_buffer_handle_t *buf_handle)
 {
 	uint32_t total_len = 0;
@@ -550,6 +744,15 @@ static int32_t sdio_write(interface_handle_t *handle, interface_buffer_handle_t
 
 	total_len = buf_handle->payload_len + offset;
 
+#if SDIO_TX_COALESCE
+	ret = sdio_tx_coalesce_write(buf_handle, total_len);
+	if (ret == ESP_OK)
+		goto done;
+	else if (ret != ESP_ERR_NO_MEM)
+		return ESP_FAIL;
+	/* All coalesce buffers in flight, send this one separately */
+#endif
+
 	sendbuf = sdio_buffer_tx_alloc(total_len, MEMSET_REQUIRED);
 	if (sendbuf == NULL) {
 		ESP_LOGE(TAG, "send buffer[%"PRIu32"] malloc fail", total_len);
@@ -583,6 +786,9 @@ static int32_t sdio_write(interface_handle_t *handle, interface_buffer_handle_t
 	sdio_buffer_tx_free(sendbuf);
 #endif
 
+#if SDIO_TX_COALESCE
+done:
+#endif
 #if ESP_PKT_STATS
 	if (buf_handle->if_type == ESP_STA_IF)
 		pkt_stats.sta_sh_out++;
@@ -616,6 +822,41 @@ static int sdio_read(interface_handle_t *if_handle, interface_buffer_handle_t *b
 	return buf_handle->payload_len;
 }
 
+/* Rx buffers carrying more than one packet (host Tx aggregation) are
+ * loaded back to the SDIO driver only once all their packets are freed.
+ * sdio_rx_task holds one reference on such a buffer while parsing it.
+ */
+static uint8_t sdio_rx_buf_refcnt[SDIO_NUM_RX_BUFFERS];
+static portMUX_TYPE sdio_rx_buf_refcnt_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static inline uint8_t * sdio_rx_buf_refcnt_of(sdio_slave_buf_handle_t handle)
+{
+	size_t buf_len = 0;
+	uint8_t *buf = sdio_slave_recv_get_buf(handle, &buf_len);
+
+	return &sdio_rx_buf_refcnt[(buf - sdio_slave_rx_buffer[0]) / SDIO_RX_BUFFER_SIZE];
+}
+
+static void sdio_rx_buf_get(uint8_t *refcnt)
+{
+	portENTER_CRITICAL(&sdio_rx_buf_refcnt_lock);
+	(*refcnt)++;
+	portEXIT_CRITICAL(&sdio_rx_buf_refcnt_lock);
+}
+
+static void sdio_rx_buf_put(void *handle)
+{
+	uint8_t *refcnt = sdio_rx_buf_refcnt_of(handle);
+	uint8_t val = 0;
+
+	portENTER_CRITICAL(&sdio_rx_buf_refcnt_lock);
+	val = --(*refcnt);
+	portEXIT_CRITICAL(&sdio_rx_buf_refcnt_lock);
+
+	if (!val)
+		sdio_read_done(handle);
+}
+
 static void sdio_rx_task(void* pvParameters)
 {
 	esp_err_t ret = ESP_OK;
@@ -626,6 +867,13 @@ static void sdio_rx_task(void* pvParameters)
 	uint16_t len = 0, offset = 0;
 	size_t sdio_read_len = 0;
 	interface_buffer_handle_t buf_handle = {0};
+	sdio_slave_buf_handle_t rx_buf_handle = NULL;
+	uint8_t *rx_buf = NULL;
+	size_t rx_buf_pos = 0;
+	uint8_t *refcnt = NULL;
+	bool aggregated = false;
+	bool next_pkt = false;
+	bool queued = false;
 	uint8_t flags = 0;
 	uint32_t recv_timeout = portMAX_DELAY;
 
@@ -641,8 +889,7 @@ static void sdio_rx_task(void* pvParameters)
 		recv_timeout = pdMS_TO_TICKS(10);
 #endif
 
-		ret = sdio_slave_recv(&(buf_handle.sdio_buf_handle), &(buf_handle.payload),
-				&(sdio_read_len), recv_timeout);
+		ret = sdio_slave_recv(&rx_buf_handle, &rx_buf, &(sdio_read_len), recv_timeout);
 		if (ret) {
 			/* Not an error if timed out, just return and let caller try again */
 			if (ret == ESP_ERR_TIMEOUT) {
@@ -652,71 +899,112 @@ static void sdio_rx_task(void* pvParameters)
 			continue;
 		}
 
-		buf_handle.payload_len = sdio_read_len & 0xFFFF;
+		rx_buf_pos = 0;
+		queued = false;
 
-		header = (struct esp_payload_header *) buf_handle.payload;
-		UPDATE_HEADER_RX_PKT_NO(header);
+		/* Host may pack multiple packets in one buffer (Tx aggregation) */
+		header = (struct esp_payload_header *) rx_buf;
+		aggregated = !!(header->flags & FLAG_AGGR_NEXT_PKT);
+		if (aggregated) {
+			refcnt = sdio_rx_buf_refcnt_of(rx_buf_handle);
+			*refcnt = 1;
+  #if ESP_PKT_STATS
+			pkt_stats.hs_bus_aggr_bufs++;
+  #endif
+		}
 
-		flags = header->flags;
-		if (flags & FLAG_POWER_SAVE_STARTED) {
-			if (context.event_handler) {
-				context.event_handler(ESP_POWER_SAVE_ON);
+		do {
+			if (sdio_read_len - rx_buf_pos < sizeof(struct esp_payload_header)) {
+				ESP_LOGE(TAG, "%s: err: no pkt header at [%u] of read_len[%u]", __func__,
+						(unsigned int)rx_buf_pos, (unsigned int)sdio_read_len);
+				break;
 			}
-		} else if (flags & FLAG_POWER_SAVE_STOPPED) {
-			if (context.event_handler) {
-				context.event_handler(ESP_POWER_SAVE_OFF);
+
+			header = (struct esp_payload_header *) (rx_buf + rx_buf_pos);
+			UPDATE_HEADER_RX_PKT_NO(header);
+
+			flags = header->flags;
+			next_pkt = aggregated && (flags & FLAG_AGGR_NEXT_PKT);
+
+			if (flags & FLAG_POWER_SAVE_STARTED) {
+				if (context.event_handler) {
+					context.event_handler(ESP_POWER_SAVE_ON);
+				}
+			} else if (flags & FLAG_POWER_SAVE_STOPPED) {
+				if (context.event_handler) {
+					context.event_handler(ESP_POWER_SAVE_OFF);
+				}
 			}
-		}
 
-		len = le16toh(header->len);
-		if (!len) {
-			ESP_LOGE(TAG, "sdio_slave_recv returned 0 len");
-			sdio_read_done(buf_handle.sdio_buf_handle);
-			continue;
-		}
+			len = le16toh(header->len);
+			offset = le16toh(header->offset);
 
-		offset = le16toh(header->offset);
+			if (sdio_read_len - rx_buf_pos < len+offset) {
+				ESP_LOGE(TAG, "%s: err: read_len[%u] < len[%u]+offset[%u]", __func__,
+						(unsigned int)(sdio_read_len - rx_buf_pos), len, offset);
+				break;
+			}
 
-		if (buf_handle.payload_len < len+offset) {
-			ESP_LOGE(TAG, "%s: err: read_len[%u] < len[%u]+offset[%u]", __func__,
-					buf_handle.payload_len, len, offset);
-			sdio_read_done(buf_handle.sdio_buf_handle);
-			continue;
-		}
+			/* start of next pkt, if any */
+			rx_buf_pos += len+offset;
+
+			if (!len) {
+				ESP_LOGE(TAG, "sdio_slave_recv returned 0 len");
+				continue;
+			}
 
   #if CONFIG_ESP_SDIO_CHECKSUM
-		rx_checksum = le16toh(header->checksum);
-		header->checksum = 0;
+			rx_checksum = le16toh(header->checksum);
+			header->checksum = 0;
 
-		checksum = compute_checksum(buf_handle.payload, len+offset);
+			checksum = compute_checksum((uint8_t *)header, len+offset);
 
-		if (checksum != rx_checksum) {
-			ESP_LOGE(TAG, "sdio rx calc_chksum[%u] != exp_chksum[%u], drop pkt", checksum, rx_checksum);
-			sdio_read_done(buf_handle.sdio_buf_handle);
-			continue;
-		}
+			if (checksum != rx_checksum) {
+				ESP_LOGE(TAG, "sdio rx calc_chksum[%u] != exp_chksum[%u], drop pkt", checksum, rx_checksum);
+				continue;
+			}
   #endif
 
-		buf_handle.if_type = header->if_type;
-		buf_handle.if_num = header->if_num;
-		buf_handle.free_buf_handle = sdio_read_done;
+			buf_handle.sdio_buf_handle = rx_buf_handle;
+			buf_handle.payload = (uint8_t *)header;
+			buf_handle.payload_len = len+offset;
+			buf_handle.if_type = header->if_type;
+			buf_handle.if_num = header->if_num;
+			if (aggregated) {
+				sdio_rx_buf_get(refcnt);
+				buf_handle.free_buf_handle = sdio_rx_buf_put;
+  #if ESP_PKT_STATS
+				pkt_stats.hs_bus_aggr_pkts++;
+  #endif
+			} else {
+				buf_handle.free_buf_handle = sdio_read_done;
+			}
 
   #if ESP_PKT_STATS
-		if (header->if_type == ESP_STA_IF)
-			pkt_stats.hs_bus_sta_in++;
+			if (header->if_type == ESP_STA_IF)
+				pkt_stats.hs_bus_sta_in++;
   #endif
-		start_rx_data_throttling_if_needed();
+			start_rx_data_throttling_if_needed();
 
 
-		if (header->if_type == ESP_SERIAL_IF) {
-			xQueueSend(sdio_rx_queue[PRIO_Q_SERIAL], &buf_handle, portMAX_DELAY);
-		} else if (header->if_type == ESP_HCI_IF) {
-			xQueueSend(sdio_rx_queue[PRIO_Q_BT], &buf_handle, portMAX_DELAY);
-		} else {
-			xQueueSend(sdio_rx_queue[PRIO_Q_OTHERS], &buf_handle, portMAX_DELAY);
-		}
+			if (header->if_type == ESP_SERIAL_IF) {
+				xQueueSend(sdio_rx_queue[PRIO_Q_SERIAL], &buf_handle, portMAX_DELAY);
+			} else if (header->if_type == ESP_HCI_IF) {
+				xQueueSend(sdio_rx_queue[PRIO_Q_BT], &buf_handle, portMAX_DELAY);
+			} else {
+				xQueueSend(sdio_rx_queue[PRIO_Q_OTHERS], &buf_handle, portMAX_DELAY);
+			}
+			queued = true;
 
-		xSemaphoreGive(sdio_rx_sem);
+			xSemaphoreGive(sdio_rx_sem);
+		} while (next_pkt);
+
+		if (aggregated) {
+			/* drop reference held while parsing */
+			sdio_rx_buf_put(rx_buf_handle);
+		} else if (!queued) {
+			sdio_read_done(rx_buf_handle);
+		}
 	}
 }
 #else /* !SIMPLIFIED_SDIO_SLAVE */
@@ -918,10 +1206,22 @@ static void sdio_deinit(interface_handle_t *handle)
 #endif
 
 		if (buf_handle) {
-			sdio_buffer_tx_free(buf_handle);
+			sdio_tx_buf_free(buf_handle);
 		}
 	}
 
+#if SDIO_TX_COALESCE
+	/* Drop frames still waiting to be coalesced */
+	xSemaphoreTake(sdio_tx_coalesce_lock, portMAX_DELAY);
+	if (sdio_tx_coalesce_buf) {
+		xQueueSend(sdio_tx_coalesce_free_q, &sdio_tx_coalesce_buf, 0);
+		sdio_tx_coalesce_buf = NULL;
+		sdio_tx_coalesce_len = 0;
+		sdio_tx_coalesce_pkts = 0;
+	}
+	xSemaphoreGive(sdio_tx_coalesce_lock);
+#endif
+
 	sdio_slave_deinit();
 	if_handle_g.state = DEINIT;
 
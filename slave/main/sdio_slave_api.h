@@ -12,4 +12,7 @@
     #error "SDIO is not supported for this target. Please use SPI"
 #endif
 
+/* Packet mode only: no Rx de-aggregation, no Tx coalescing */
+//#define SIMPLIFIED_SDIO_SLAVE          1
+
 #endif
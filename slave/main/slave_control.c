@@ -38,6 +38,9 @@
 #include "esp_hosted_coprocessor_fw_ver.h"
 #include "slave_gpio_expander.h"
 #include "slave_ext_coex.h"
+#include "host_wake_filter_rpc.h"
+#include <protocomm.h>
+#include "protocomm_pserial.h"
 
 #if CONFIG_ESP_HOSTED_OT_RCP_ENABLED
 #include "slave_openthread.h"
@@ -1023,504 +1026,186 @@ static esp_err_t req_custom_rpc_handler(Rpc *req, Rpc *resp, void *priv_data)
 #endif /* CONFIG_ESP_HOSTED_ENABLE_PEER_DATA_TRANSFER */
 
 
-static esp_rpc_req_t req_table[] = {
-	{
-		.req_num = RPC_ID__Req_OTABegin,
-		.command_handler = req_ota_begin_handler
-	},
-	{
-		.req_num = RPC_ID__Req_OTAWrite,
-		.command_handler = req_ota_write_handler
-	},
-	{
-		.req_num = RPC_ID__Req_OTAEnd,
-		.command_handler = req_ota_end_handler
-	},
-	{
-		.req_num = RPC_ID__Req_OTAActivate,
-		.command_handler = req_ota_activate_handler
-	},
-	{
-		.req_num = RPC_ID__Req_ConfigHeartbeat,
-		.command_handler = req_config_heartbeat
-	},
-	{
-		.req_num = RPC_ID__Req_GetCoprocessorFwVersion,
-		.command_handler = req_get_coprocessor_fw_version
-	},
-	{
-		.req_num = RPC_ID__Req_IfaceMacAddrSetGet,
-		.command_handler = req_iface_mac_addr_set_get
-	},
-	{
-		.req_num = RPC_ID__Req_IfaceMacAddrLenGet,
-		.command_handler = req_iface_mac_addr_len_get
-	},
-	{
-		.req_num = RPC_ID__Req_FeatureControl,
-		.command_handler = req_feature_control
-	},
-
-	{
-		.req_num = RPC_ID__Req_AppGetDesc,
-		.command_handler = req_app_get_desc
-	},
+/* Request handlers, indexed directly by msg_id, so dispatch is O(1).
+ * Ids without handler (not compiled in or not implemented) stay zeroed
+ * and are reported as not supported.
+ * A handler given twice for one id fails the build (-Woverride-init),
+ * and so does an id past RPC_ID__Req_Max, as the table size is fixed */
+#define RPC_REQ_IDX(msg_id)         ((msg_id) - RPC_ID__Req_Base)
+#define RPC_REQ_TABLE_SIZE          RPC_REQ_IDX(RPC_ID__Req_Max)
+#define RPC_REQ_ENTRY(id, fn)       [RPC_REQ_IDX(id)] = { .req_num = id, .command_handler = fn }
+
+/* A request id added to esp_hosted_rpc.proto fails this check until
+ * req_table gets its handler and the check names the new last id */
+_Static_assert(RPC_ID__Req_Max == RPC_ID__Req_SetWakeRules + 1,
+		"new RPC request id without a handler in req_table");
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic error "-Woverride-init"
+static const esp_rpc_req_t req_table[RPC_REQ_TABLE_SIZE] = {
+	RPC_REQ_ENTRY(RPC_ID__Req_OTABegin, req_ota_begin_handler),
+	RPC_REQ_ENTRY(RPC_ID__Req_OTAWrite, req_ota_write_handler),
+	RPC_REQ_ENTRY(RPC_ID__Req_OTAEnd, req_ota_end_handler),
+	RPC_REQ_ENTRY(RPC_ID__Req_OTAActivate, req_ota_activate_handler),
+	RPC_REQ_ENTRY(RPC_ID__Req_ConfigHeartbeat, req_config_heartbeat),
+	RPC_REQ_ENTRY(RPC_ID__Req_GetCoprocessorFwVersion, req_get_coprocessor_fw_version),
+	RPC_REQ_ENTRY(RPC_ID__Req_IfaceMacAddrSetGet, req_iface_mac_addr_set_get),
+	RPC_REQ_ENTRY(RPC_ID__Req_IfaceMacAddrLenGet, req_iface_mac_addr_len_get),
+	RPC_REQ_ENTRY(RPC_ID__Req_FeatureControl, req_feature_control),
+
+	RPC_REQ_ENTRY(RPC_ID__Req_AppGetDesc, req_app_get_desc),
 
 #ifdef CONFIG_ESP_HOSTED_CP_WIFI
-	{
-		.req_num = RPC_ID__Req_GetMACAddress ,
-		.command_handler = req_wifi_get_mac
-	},
-	{
-		.req_num = RPC_ID__Req_GetWifiMode,
-		.command_handler = req_wifi_get_mode
-	},
-	{
-		.req_num = RPC_ID__Req_SetWifiMode,
-		.command_handler = req_wifi_set_mode
-	},
-	{
-		.req_num = RPC_ID__Req_SetMacAddress,
-		.command_handler = req_wifi_set_mac
-	},
-	{
-		.req_num = RPC_ID__Req_WifiSetPs,
-		.command_handler = req_wifi_set_ps
-	},
-	{
-		.req_num = RPC_ID__Req_WifiGetPs,
-		.command_handler = req_wifi_get_ps
-	},
-	{
-		.req_num = RPC_ID__Req_WifiSetMaxTxPower,
-		.command_handler = req_wifi_set_max_tx_power
-	},
-	{
-		.req_num = RPC_ID__Req_WifiGetMaxTxPower,
-		.command_handler = req_wifi_get_max_tx_power
-	},
-	{
-		.req_num = RPC_ID__Req_WifiInit,
-		.command_handler = req_wifi_init
-	},
-	{
-		.req_num = RPC_ID__Req_WifiDeinit,
-		.command_handler = req_wifi_deinit
-	},
-	{
-		.req_num = RPC_ID__Req_WifiStart,
-		.command_handler = req_wifi_start
-	},
-	{
-		.req_num = RPC_ID__Req_WifiStop,
-		.command_handler = req_wifi_stop
-	},
-	{
-		.req_num = RPC_ID__Req_WifiConnect,
-		.command_handler = req_wifi_connect
-	},
-	{
-		.req_num = RPC_ID__Req_WifiDisconnect,
-		.command_handler = req_wifi_disconnect
-	},
-	{
-		.req_num = RPC_ID__Req_WifiSetConfig,
-		.command_handler = req_wifi_set_config
-	},
-	{
-		.req_num = RPC_ID__Req_WifiScanParams,
-		.command_handler = req_wifi_scan_params
-	},
-	{
-		.req_num = RPC_ID__Req_WifiGetConfig,
-		.command_handler = req_wifi_get_config
-	},
-	{
-		.req_num = RPC_ID__Req_WifiScanStart,
-		.command_handler = req_wifi_scan_start
-	},
-	{
-		.req_num = RPC_ID__Req_WifiScanStop,
-		.command_handler = req_wifi_scan_stop
-	},
-	{
-		.req_num = RPC_ID__Req_WifiScanGetApNum,
-		.command_handler = req_wifi_scan_get_ap_num
-	},
-	{
-		.req_num = RPC_ID__Req_WifiScanGetApRecord,
-		.command_handler = req_wifi_scan_get_ap_record
-	},
-	{
-		.req_num = RPC_ID__Req_WifiScanGetApRecords,
-		.command_handler = req_wifi_scan_get_ap_records
-	},
-	{
-		.req_num = RPC_ID__Req_WifiClearApList,
-		.command_handler = req_wifi_clear_ap_list
-	},
-	{
-		.req_num = RPC_ID__Req_WifiRestore,
-		.command_handler = req_wifi_restore
-	},
-	{
-		.req_num = RPC_ID__Req_WifiClearFastConnect,
-		.command_handler = req_wifi_clear_fast_connect
-	},
-	{
-		.req_num = RPC_ID__Req_WifiStaGetApInfo,
-		.command_handler = req_wifi_sta_get_ap_info
-	},
-	{
-		.req_num = RPC_ID__Req_WifiDeauthSta,
-		.command_handler = req_wifi_deauth_sta
-	},
-	{
-		.req_num = RPC_ID__Req_WifiSetStorage,
-		.command_handler = req_wifi_set_storage
-	},
-	{
-		.req_num = RPC_ID__Req_WifiSetProtocol,
-		.command_handler = req_wifi_set_protocol
-	},
-	{
-		.req_num = RPC_ID__Req_WifiGetProtocol,
-		.command_handler = req_wifi_get_protocol
-	},
-	{
-		.req_num = RPC_ID__Req_WifiSetBandwidth,
-		.command_handler = req_wifi_set_bandwidth
-	},
-	{
-		.req_num = RPC_ID__Req_WifiGetBandwidth,
-		.command_handler = req_wifi_get_bandwidth
-	},
-	{
-		.req_num = RPC_ID__Req_WifiSetChannel,
-		.command_handler = req_wifi_set_channel
-	},
-	{
-		.req_num = RPC_ID__Req_WifiGetChannel,
-		.command_handler = req_wifi_get_channel
-	},
-	{
-		.req_num = RPC_ID__Req_WifiSetCountryCode,
-		.command_handler = req_wifi_set_country_code
-	},
-	{
-		.req_num = RPC_ID__Req_WifiGetCountryCode,
-		.command_handler = req_wifi_get_country_code
-	},
-	{
-		.req_num = RPC_ID__Req_WifiSetCountry,
-		.command_handler = req_wifi_set_country
-	},
-	{
-		.req_num = RPC_ID__Req_WifiGetCountry,
-		.command_handler = req_wifi_get_country
-	},
-	{
-		.req_num = RPC_ID__Req_WifiApGetStaList,
-		.command_handler = req_wifi_ap_get_sta_list
-	},
-	{
-		.req_num = RPC_ID__Req_WifiApGetStaAid,
-		.command_handler = req_wifi_ap_get_sta_aid
-	},
-	{
-		.req_num = RPC_ID__Req_WifiStaGetRssi,
-		.command_handler = req_wifi_sta_get_rssi
-	},
-	{
-		.req_num = RPC_ID__Req_WifiStaGetAid,
-		.command_handler = req_wifi_sta_get_aid
-	},
-	{
-		.req_num = RPC_ID__Req_WifiStaGetNegotiatedPhymode,
-		.command_handler = req_wifi_sta_get_negotiated_phymode
-	},
+	RPC_REQ_ENTRY(RPC_ID__Req_GetMACAddress, req_wifi_get_mac),
+	RPC_REQ_ENTRY(RPC_ID__Req_GetWifiMode, req_wifi_get_mode),
+	RPC_REQ_ENTRY(RPC_ID__Req_SetWifiMode, req_wifi_set_mode),
+	RPC_REQ_ENTRY(RPC_ID__Req_SetMacAddress, req_wifi_set_mac),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiSetPs, req_wifi_set_ps),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiGetPs, req_wifi_get_ps),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiSetMaxTxPower, req_wifi_set_max_tx_power),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiGetMaxTxPower, req_wifi_get_max_tx_power),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiInit, req_wifi_init),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiDeinit, req_wifi_deinit),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiStart, req_wifi_start),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiStop, req_wifi_stop),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiConnect, req_wifi_connect),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiDisconnect, req_wifi_disconnect),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiSetConfig, req_wifi_set_config),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiScanParams, req_wifi_scan_params),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiGetConfig, req_wifi_get_config),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiScanStart, req_wifi_scan_start),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiScanStop, req_wifi_scan_stop),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiScanGetApNum, req_wifi_scan_get_ap_num),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiScanGetApRecord, req_wifi_scan_get_ap_record),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiScanGetApRecords, req_wifi_scan_get_ap_records),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiClearApList, req_wifi_clear_ap_list),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiRestore, req_wifi_restore),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiClearFastConnect, req_wifi_clear_fast_connect),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiStaGetApInfo, req_wifi_sta_get_ap_info),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiDeauthSta, req_wifi_deauth_sta),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiSetStorage, req_wifi_set_storage),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiSetProtocol, req_wifi_set_protocol),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiGetProtocol, req_wifi_get_protocol),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiSetBandwidth, req_wifi_set_bandwidth),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiGetBandwidth, req_wifi_get_bandwidth),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiSetChannel, req_wifi_set_channel),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiGetChannel, req_wifi_get_channel),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiSetCountryCode, req_wifi_set_country_code),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiGetCountryCode, req_wifi_get_country_code),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiSetCountry, req_wifi_set_country),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiGetCountry, req_wifi_get_country),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiApGetStaList, req_wifi_ap_get_sta_list),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiApGetStaAid, req_wifi_ap_get_sta_aid),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiStaGetRssi, req_wifi_sta_get_rssi),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiStaGetAid, req_wifi_sta_get_aid),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiStaGetNegotiatedPhymode, req_wifi_sta_get_negotiated_phymode),
 #if H_PRESENT_IN_ESP_IDF_5_4_0
-	{
-		.req_num = RPC_ID__Req_WifiSetProtocols,
-		.command_handler = req_wifi_set_protocols
-	},
-	{
-		.req_num = RPC_ID__Req_WifiGetProtocols,
-		.command_handler = req_wifi_get_protocols
-	},
-	{
-		.req_num = RPC_ID__Req_WifiSetBandwidths,
-		.command_handler = req_wifi_set_bandwidths
-	},
-	{
-		.req_num = RPC_ID__Req_WifiGetBandwidths,
-		.command_handler = req_wifi_get_bandwidths
-	},
-	{
-		.req_num = RPC_ID__Req_WifiSetBand,
-		.command_handler = req_wifi_set_band
-	},
-	{
-		.req_num = RPC_ID__Req_WifiGetBand,
-		.command_handler = req_wifi_get_band
-	},
-	{
-		.req_num = RPC_ID__Req_WifiSetBandMode,
-		.command_handler = req_wifi_set_band_mode
-	},
-	{
-		.req_num = RPC_ID__Req_WifiGetBandMode,
-		.command_handler = req_wifi_get_band_mode
-	},
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiSetProtocols, req_wifi_set_protocols),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiGetProtocols, req_wifi_get_protocols),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiSetBandwidths, req_wifi_set_bandwidths),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiGetBandwidths, req_wifi_get_bandwidths),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiSetBand, req_wifi_set_band),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiGetBand, req_wifi_get_band),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiSetBandMode, req_wifi_set_band_mode),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiGetBandMode, req_wifi_get_band_mode),
 #endif
-	{
-		.req_num = RPC_ID__Req_WifiSetInactiveTime,
-		.command_handler = req_wifi_set_inactive_time
-	},
-	{
-		.req_num = RPC_ID__Req_WifiGetInactiveTime,
-		.command_handler = req_wifi_get_inactive_time
-	},
-	{
-		.req_num = RPC_ID__Req_WifiDisablePmfConfig,
-		.command_handler = req_wifi_disable_pmf_config
-	},
-	{
-		.req_num = RPC_ID__Req_SetDhcpDnsStatus,
-		.command_handler = req_set_dhcp_dns_status
-	},
-	{
-		.req_num = RPC_ID__Req_GetDhcpDnsStatus,
-		.command_handler = req_get_dhcp_dns_status
-	},
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiSetInactiveTime, req_wifi_set_inactive_time),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiGetInactiveTime, req_wifi_get_inactive_time),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiDisablePmfConfig, req_wifi_disable_pmf_config),
+	RPC_REQ_ENTRY(RPC_ID__Req_SetDhcpDnsStatus, req_set_dhcp_dns_status),
+	RPC_REQ_ENTRY(RPC_ID__Req_GetDhcpDnsStatus, req_get_dhcp_dns_status),
+	RPC_REQ_ENTRY(RPC_ID__Req_NwSplitPortRules, req_nw_split_port_rules),
 
 #if CONFIG_SOC_WIFI_HE_SUPPORT
 #if H_WIFI_HE_GREATER_THAN_ESP_IDF_5_3
-	{
-		.req_num = RPC_ID__Req_WifiStaTwtConfig,
-		.command_handler = req_wifi_sta_twt_config
-	},
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiStaTwtConfig, req_wifi_sta_twt_config),
 #endif
-	{
-		.req_num = RPC_ID__Req_WifiStaItwtSetup,
-		.command_handler = req_wifi_sta_itwt_setup
-	},
-	{
-		.req_num = RPC_ID__Req_WifiStaItwtTeardown,
-		.command_handler = req_wifi_sta_itwt_teardown
-	},
-	{
-		.req_num = RPC_ID__Req_WifiStaItwtSuspend,
-		.command_handler = req_wifi_sta_itwt_suspend
-	},
-	{
-		.req_num = RPC_ID__Req_WifiStaItwtGetFlowIdStatus,
-		.command_handler = req_wifi_sta_itwt_get_flow_id_status
-	},
-	{
-		.req_num = RPC_ID__Req_WifiStaItwtSendProbeReq,
-		.command_handler = req_wifi_sta_itwt_send_probe_req
-	},
-	{
-		.req_num = RPC_ID__Req_WifiStaItwtSetTargetWakeTimeOffset,
-		.command_handler = req_wifi_sta_itwt_set_target_wake_time_offset
-	},
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiStaItwtSetup, req_wifi_sta_itwt_setup),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiStaItwtTeardown, req_wifi_sta_itwt_teardown),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiStaItwtSuspend, req_wifi_sta_itwt_suspend),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiStaItwtGetFlowIdStatus, req_wifi_sta_itwt_get_flow_id_status),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiStaItwtSendProbeReq, req_wifi_sta_itwt_send_probe_req),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiStaItwtSetTargetWakeTimeOffset, req_wifi_sta_itwt_set_target_wake_time_offset),
 #endif // CONFIG_SOC_WIFI_HE_SUPPORT
 #endif // CONFIG_ESP_HOSTED_CP_WIFI
 
 #if H_WIFI_ENTERPRISE_SUPPORT
-	{
-		.req_num = RPC_ID__Req_WifiStaEnterpriseEnable,
-		.command_handler = req_wifi_sta_enterprise_enable
-	},
-	{
-		.req_num = RPC_ID__Req_WifiStaEnterpriseDisable,
-		.command_handler = req_wifi_sta_enterprise_disable
-	},
-	{
-		.req_num = RPC_ID__Req_EapSetIdentity,
-		.command_handler = req_eap_set_identity
-	},
-	{
-		.req_num = RPC_ID__Req_EapClearIdentity,
-		.command_handler = req_eap_clear_identity
-	},
-	{
-		.req_num = RPC_ID__Req_EapSetUsername,
-		.command_handler = req_eap_set_username
-	},
-	{
-		.req_num = RPC_ID__Req_EapClearUsername,
-		.command_handler = req_eap_clear_username
-	},
-	{
-		.req_num = RPC_ID__Req_EapSetPassword,
-		.command_handler = req_eap_set_password
-	},
-	{
-		.req_num = RPC_ID__Req_EapClearPassword,
-		.command_handler = req_eap_clear_password
-	},
-	{
-		.req_num = RPC_ID__Req_EapSetNewPassword,
-		.command_handler = req_eap_set_new_password
-	},
-	{
-		.req_num = RPC_ID__Req_EapClearNewPassword,
-		.command_handler = req_eap_clear_new_password
-	},
-	{
-		.req_num = RPC_ID__Req_EapSetCaCert,
-		.command_handler = req_eap_set_ca_cert
-	},
-	{
-		.req_num = RPC_ID__Req_EapClearCaCert,
-		.command_handler = req_eap_clear_ca_cert
-	},
-	{
-		.req_num = RPC_ID__Req_EapSetCertificateAndKey,
-		.command_handler = req_eap_set_certificate_and_key
-	},
-	{
-		.req_num = RPC_ID__Req_EapClearCertificateAndKey,
-		.command_handler = req_eap_clear_certificate_and_key
-	},
-	{
-		.req_num = RPC_ID__Req_EapGetDisableTimeCheck,
-		.command_handler = req_eap_get_disable_time_check
-	},
-	{
-		.req_num = RPC_ID__Req_EapSetTtlsPhase2Method,
-		.command_handler = req_eap_set_ttls_phase2_method
-	},
-	{
-		.req_num = RPC_ID__Req_EapSetSuitebCertification,
-		.command_handler = req_eap_set_suiteb_certification
-	},
-	{
-		.req_num = RPC_ID__Req_EapSetPacFile,
-		.command_handler = req_eap_set_pac_file
-	},
-	{
-		.req_num = RPC_ID__Req_EapSetFastParams,
-		.command_handler = req_eap_set_fast_params
-	},
-	{
-		.req_num = RPC_ID__Req_EapUseDefaultCertBundle,
-		.command_handler = req_eap_use_default_cert_bundle
-	},
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiStaEnterpriseEnable, req_wifi_sta_enterprise_enable),
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiStaEnterpriseDisable, req_wifi_sta_enterprise_disable),
+	RPC_REQ_ENTRY(RPC_ID__Req_EapSetIdentity, req_eap_set_identity),
+	RPC_REQ_ENTRY(RPC_ID__Req_EapClearIdentity, req_eap_clear_identity),
+	RPC_REQ_ENTRY(RPC_ID__Req_EapSetUsername, req_eap_set_username),
+	RPC_REQ_ENTRY(RPC_ID__Req_EapClearUsername, req_eap_clear_username),
+	RPC_REQ_ENTRY(RPC_ID__Req_EapSetPassword, req_eap_set_password),
+	RPC_REQ_ENTRY(RPC_ID__Req_EapClearPassword, req_eap_clear_password),
+	RPC_REQ_ENTRY(RPC_ID__Req_EapSetNewPassword, req_eap_set_new_password),
+	RPC_REQ_ENTRY(RPC_ID__Req_EapClearNewPassword, req_eap_clear_new_password),
+	RPC_REQ_ENTRY(RPC_ID__Req_EapSetCaCert, req_eap_set_ca_cert),
+	RPC_REQ_ENTRY(RPC_ID__Req_EapClearCaCert, req_eap_clear_ca_cert),
+	RPC_REQ_ENTRY(RPC_ID__Req_EapSetCertificateAndKey, req_eap_set_certificate_and_key),
+	RPC_REQ_ENTRY(RPC_ID__Req_EapClearCertificateAndKey, req_eap_clear_certificate_and_key),
+	RPC_REQ_ENTRY(RPC_ID__Req_EapGetDisableTimeCheck, req_eap_get_disable_time_check),
+	RPC_REQ_ENTRY(RPC_ID__Req_EapSetTtlsPhase2Method, req_eap_set_ttls_phase2_method),
+	RPC_REQ_ENTRY(RPC_ID__Req_EapSetSuitebCertification, req_eap_set_suiteb_certification),
+	RPC_REQ_ENTRY(RPC_ID__Req_EapSetPacFile, req_eap_set_pac_file),
+	RPC_REQ_ENTRY(RPC_ID__Req_EapSetFastParams, req_eap_set_fast_params),
+	RPC_REQ_ENTRY(RPC_ID__Req_EapUseDefaultCertBundle, req_eap_use_default_cert_bundle),
 #if H_GOT_EAP_OKC_SUPPORT
-	{
-		.req_num = RPC_ID__Req_WifiSetOkcSupport,
-		.command_handler = req_wifi_set_okc_support
-	},
+	RPC_REQ_ENTRY(RPC_ID__Req_WifiSetOkcSupport, req_wifi_set_okc_support),
 #endif
 #if H_GOT_EAP_SET_DOMAIN_NAME
-	{
-		.req_num = RPC_ID__Req_EapSetDomainName,
-		.command_handler = req_eap_set_domain_name
-	},
+	RPC_REQ_ENTRY(RPC_ID__Req_EapSetDomainName, req_eap_set_domain_name),
 #endif
-	{
-		.req_num = RPC_ID__Req_EapSetDisableTimeCheck,
-		.command_handler = req_eap_set_disable_time_check
-	},
+	RPC_REQ_ENTRY(RPC_ID__Req_EapSetDisableTimeCheck, req_eap_set_disable_time_check),
 #if H_GOT_SET_EAP_METHODS_API
-	{
-		.req_num = RPC_ID__Req_EapSetEapMethods,
-		.command_handler = req_eap_set_eap_methods
-	},
+	RPC_REQ_ENTRY(RPC_ID__Req_EapSetEapMethods, req_eap_set_eap_methods),
 #endif
 #endif // #if H_WIFI_ENTERPRISE_SUPPORT
 
 #if H_DPP_SUPPORT
-	{
-		.req_num = RPC_ID__Req_SuppDppInit,
-		.command_handler = req_supp_dpp_init
-	},
-	{
-		.req_num = RPC_ID__Req_SuppDppDeinit,
-		.command_handler = req_supp_dpp_deinit
-	},
-	{
-		.req_num = RPC_ID__Req_SuppDppDeinit,
-		.command_handler = req_supp_dpp_deinit
-	},
-	{
-		.req_num = RPC_ID__Req_SuppDppBootstrapGen,
-		.command_handler = req_supp_dpp_bootstrap_gen
-	},
-	{
-		.req_num = RPC_ID__Req_SuppDppStartListen,
-		.command_handler = req_supp_dpp_start_listen,
-	},
-	{
-		.req_num = RPC_ID__Req_SuppDppStopListen,
-		.command_handler = req_supp_dpp_stop_listen,
-	},
+	RPC_REQ_ENTRY(RPC_ID__Req_SuppDppInit, req_supp_dpp_init),
+	RPC_REQ_ENTRY(RPC_ID__Req_SuppDppDeinit, req_supp_dpp_deinit),
+	RPC_REQ_ENTRY(RPC_ID__Req_SuppDppBootstrapGen, req_supp_dpp_bootstrap_gen),
+	RPC_REQ_ENTRY(RPC_ID__Req_SuppDppStartListen, req_supp_dpp_start_listen),
+	RPC_REQ_ENTRY(RPC_ID__Req_SuppDppStopListen, req_supp_dpp_stop_listen),
 #endif // H_DPP_SUPPORT
 
 #ifdef CONFIG_ESP_HOSTED_MEM_MONITOR
-	{
-		.req_num = RPC_ID__Req_MemMonitor,
-		.command_handler = req_mem_monitor
-	},
+	RPC_REQ_ENTRY(RPC_ID__Req_MemMonitor, req_mem_monitor),
 #endif
 
 #ifdef CONFIG_ESP_HOSTED_ENABLE_PEER_DATA_TRANSFER
-	{
-		.req_num = RPC_ID__Req_CustomRpc,
-		.command_handler = req_custom_rpc_handler
-	},
+	RPC_REQ_ENTRY(RPC_ID__Req_CustomRpc, req_custom_rpc_handler),
 #endif
 
 #if H_GPIO_EXPANDER_SUPPORT
-	{
-		.req_num = RPC_ID__Req_GpioConfig,
-		.command_handler = req_gpio_config
-	},
-	{
-		.req_num = RPC_ID__Req_GpioResetPin,
-		.command_handler = req_gpio_reset
-	},
-	{
-		.req_num = RPC_ID__Req_GpioSetLevel,
-		.command_handler = req_gpio_set_level
-	},
-	{
-		.req_num = RPC_ID__Req_GpioGetLevel,
-		.command_handler = req_gpio_get_level
-	},
-	{
-		.req_num = RPC_ID__Req_GpioSetDirection,
-		.command_handler = req_gpio_set_direction
-	},
-	{
-		.req_num = RPC_ID__Req_GpioInputEnable,
-		.command_handler = req_gpio_input_enable
-	},
-	{
-		.req_num = RPC_ID__Req_GpioSetPullMode,
-		.command_handler = req_gpio_set_pull_mode
-	},
+	RPC_REQ_ENTRY(RPC_ID__Req_GpioConfig, req_gpio_config),
+	RPC_REQ_ENTRY(RPC_ID__Req_GpioResetPin, req_gpio_reset),
+	RPC_REQ_ENTRY(RPC_ID__Req_GpioSetLevel, req_gpio_set_level),
+	RPC_REQ_ENTRY(RPC_ID__Req_GpioGetLevel, req_gpio_get_level),
+	RPC_REQ_ENTRY(RPC_ID__Req_GpioSetDirection, req_gpio_set_direction),
+	RPC_REQ_ENTRY(RPC_ID__Req_GpioInputEnable, req_gpio_input_enable),
+	RPC_REQ_ENTRY(RPC_ID__Req_GpioSetPullMode, req_gpio_set_pull_mode),
 #endif // H_GPIO_EXPANDER_SUPPORT
 
 #if H_EXT_COEX_SUPPORT
-	{
-		.req_num = RPC_ID__Req_ExtCoex,
-		.command_handler = req_ext_coex
-	},
+	RPC_REQ_ENTRY(RPC_ID__Req_ExtCoex, req_ext_coex),
+#endif
+
+#if H_HOST_WAKE_FILTER_SUPPORT
+	RPC_REQ_ENTRY(RPC_ID__Req_SetWakeRules, req_set_wake_rules),
 #endif
 };
+#pragma GCC diagnostic pop
 
 static int lookup_req_handler(int req_id)
 {
-	for (int i = 0; i < sizeof(req_table)/sizeof(esp_rpc_req_t); i++) {
-		if (req_table[i].req_num == req_id) {
-			return i;
-		}
-	}
-	return -1;
+	int i = RPC_REQ_IDX(req_id);
+
+	if ((i <= 0) || (i >= RPC_REQ_TABLE_SIZE) || !req_table[i].command_handler)
+		return -1;
+
+	return i;
 }
 
 static esp_err_t esp_rpc_command_dispatcher(
@@ -1628,7 +1313,7 @@ esp_err_t data_transfer_handler(uint32_t session_id,const uint8_t *inbuf,
 
 	// ESP_LOGE(TAG, "len %" PRIi16, *outlen);
 
-	*outbuf = (uint8_t *)calloc(1, *outlen);
+	*outbuf = protocomm_pserial_alloc_outbuf(*outlen);
 	if (!*outbuf) {
 		ESP_LOGE(TAG, "No memory allocated for outbuf");
 		esp_rpc_cleanup(resp);
@@ -1882,7 +1567,7 @@ esp_err_t rpc_evt_handler(uint32_t session_id,const uint8_t *inbuf,
 		goto err;
 	}
 
-	*outbuf = (uint8_t *)calloc(1, *outlen);
+	*outbuf = protocomm_pserial_alloc_outbuf(*outlen);
 	if (!*outbuf) {
 		ESP_LOGE(TAG, "No memory allocated for outbuf");
 		esp_rpc_cleanup(ntfy);
@@ -1898,8 +1583,8 @@ esp_err_t rpc_evt_handler(uint32_t session_id,const uint8_t *inbuf,
 	return ESP_OK;
 
 err:
-	if (!*outbuf) {
-		free(*outbuf);
+	if (*outbuf) {
+		protocomm_pserial_free_outbuf(*outbuf);
 		*outbuf = NULL;
 	}
 	esp_rpc_cleanup(ntfy);
@@ -13,6 +13,8 @@
 #include "slave_wifi_std.h"
 #include "slave_network_split.h"
 #include "slave_control.h"
+#include "nw_split_router.h"
+#include "lwip/prot/ip.h"
 
 #include "esp_log.h"
 static const char* TAG = "slave_network_split";
@@ -355,6 +357,78 @@ esp_err_t req_set_dhcp_dns_status(Rpc *req, Rpc *resp, void *priv_data)
 	return ESP_OK;
 }
 
+/* Set port forwarding rules handler */
+esp_err_t req_nw_split_port_rules(Rpc *req, Rpc *resp, void *priv_data)
+{
+	RPC_TEMPLATE(RpcRespNwSplitPortRules, resp_nw_split_port_rules,
+			RpcReqNwSplitPortRules, req_nw_split_port_rules,
+			rpc__resp__nw_split_port_rules__init);
+
+#if defined(CONFIG_LWIP_ENABLE)
+	nw_split_port_rule_t *rules = NULL;
+	size_t i = 0;
+
+	/* bound the allocation before looking at the rules */
+	if (req_payload->n_rules > CONFIG_ESP_HOSTED_NW_SPLIT_MAX_PORT_RULES) {
+		ESP_LOGE(TAG, "Too many port rules: %u (max %d)",
+				(unsigned)req_payload->n_rules, CONFIG_ESP_HOSTED_NW_SPLIT_MAX_PORT_RULES);
+		resp_payload->resp = ESP_ERR_NO_MEM;
+		return ESP_OK;
+	}
+
+	if (req_payload->n_rules) {
+		rules = calloc(req_payload->n_rules, sizeof(nw_split_port_rule_t));
+		if (!rules) {
+			resp_payload->resp = ESP_ERR_NO_MEM;
+			return ESP_OK;
+		}
+	}
+
+	for (i = 0; i < req_payload->n_rules; i++) {
+		RpcNwSplitPortRule *rule = req_payload->rules[i];
+
+		if (!rule || (rule->proto != IP_PROTO_TCP && rule->proto != IP_PROTO_UDP) ||
+				rule->port_start > UINT16_MAX || rule->port_end > UINT16_MAX) {
+			resp_payload->resp = ESP_ERR_INVALID_ARG;
+			goto done;
+		}
+
+		rules[i].proto = rule->proto;
+		rules[i].match_src = rule->match_src;
+		rules[i].port_start = rule->port_start;
+		rules[i].port_end = rule->port_end;
+
+		switch (rule->action) {
+		case RPC__NW_SPLIT_PORT_ACTION__NwSplitPortAction_Host:
+			rules[i].bridge = HOST_LWIP_BRIDGE;
+			break;
+		case RPC__NW_SPLIT_PORT_ACTION__NwSplitPortAction_Slave:
+			rules[i].bridge = SLAVE_LWIP_BRIDGE;
+			break;
+		case RPC__NW_SPLIT_PORT_ACTION__NwSplitPortAction_Both:
+			rules[i].bridge = BOTH_LWIP_BRIDGE;
+			break;
+		case RPC__NW_SPLIT_PORT_ACTION__NwSplitPortAction_Drop:
+			rules[i].bridge = INVALID_BRIDGE;
+			break;
+		default:
+			resp_payload->resp = ESP_ERR_INVALID_ARG;
+			goto done;
+		}
+	}
+
+	ESP_LOGI(TAG, "%s %u port forwarding rules from host",
+			req_payload->replace ? "Set" : "Add", (unsigned)req_payload->n_rules);
+	resp_payload->resp = nw_split_set_port_rules(rules, req_payload->n_rules,
+			req_payload->replace);
+done:
+	free(rules);
+#else
+	resp_payload->resp = ESP_ERR_NOT_SUPPORTED;
+#endif
+	return ESP_OK;
+}
+
 esp_err_t rpc_evt_Event_DhcpDnsStatus(Rpc *ntfy,
 		const uint8_t *data, ssize_t len)
 {
@@ -2785,4 +2785,14 @@ esp_err_t req_set_dhcp_dns_status(Rpc *req, Rpc *resp, void *priv_data)
 	resp_payload->resp = ESP_FAIL;
 	return ESP_OK;
 }
+
+esp_err_t req_nw_split_port_rules(Rpc *req, Rpc *resp, void *priv_data)
+{
+	RPC_TEMPLATE_SIMPLE(RpcRespNwSplitPortRules, resp_nw_split_port_rules,
+			RpcReqNwSplitPortRules, req_nw_split_port_rules,
+			rpc__resp__nw_split_port_rules__init);
+
+	resp_payload->resp = ESP_ERR_NOT_SUPPORTED;
+	return ESP_OK;
+}
 #endif
@@ -120,6 +120,7 @@ esp_err_t req_supp_dpp_stop_listen(Rpc *req, Rpc *resp, void *priv_data);
  */
 esp_err_t req_get_dhcp_dns_status(Rpc *req, Rpc *resp, void *priv_data);
 esp_err_t req_set_dhcp_dns_status(Rpc *req, Rpc *resp, void *priv_data);
+esp_err_t req_nw_split_port_rules(Rpc *req, Rpc *resp, void *priv_data);
 
 esp_err_t rpc_evt_sta_scan_done(Rpc *ntfy, const uint8_t *data, ssize_t len, int event_id);
 esp_err_t rpc_evt_sta_connected(Rpc *ntfy, const uint8_t *data, ssize_t len, int event_id);
@@ -306,6 +306,37 @@ static void stats_timer_func(void* arg)
 	ESP_LOGI(TAG, "Lwip: in[%lu] slave_out[%lu] host_out[%lu] both_out[%lu]",
 			pkt_stats.sta_lwip_in, pkt_stats.sta_slave_lwip_out,
 			pkt_stats.sta_host_lwip_out, pkt_stats.sta_both_lwip_out);
+#if defined(CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED) && CONFIG_ESP_HOSTED_NW_SPLIT_FLOW_CACHE_SIZE
+	{
+		uint32_t lookups = pkt_stats.nw_split_flow_hit + pkt_stats.nw_split_flow_miss;
+
+		ESP_LOGI(TAG, "Nw split flow cache: hit[%lu] miss[%lu] hit rate[%lu%%]",
+				pkt_stats.nw_split_flow_hit, pkt_stats.nw_split_flow_miss,
+				lookups ? (uint32_t)((uint64_t)pkt_stats.nw_split_flow_hit * 100 / lookups) : 0);
+	}
+#endif
+#if defined(CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED) && defined(CONFIG_ESP_HOSTED_HOST_POWER_SAVE_ENABLED)
+	ESP_LOGI(TAG, "Host PS hold: held[%lu] dropped[%lu] flushed[%lu]",
+			pkt_stats.sta_host_hold, pkt_stats.sta_host_hold_drop, pkt_stats.sta_host_hold_flush);
+#endif
+#ifdef CONFIG_ESP_SDIO_HOST_INTERFACE
+	ESP_LOGI(TAG, "SDIO H2S aggr: bufs[%lu] pkts[%lu]",
+			pkt_stats.hs_bus_aggr_bufs, pkt_stats.hs_bus_aggr_pkts);
+#if CONFIG_ESP_SDIO_TX_COALESCE
+	ESP_LOGI(TAG, "SDIO S2H coalesce: bufs[%lu] pkts[%lu] drops[%lu]",
+			pkt_stats.sh_bus_coalesce_bufs, pkt_stats.sh_bus_coalesce_pkts,
+			pkt_stats.sh_bus_coalesce_drops);
+#endif
+#endif
+#if !CONFIG_ESP_TX_SCHED_BYPASS
+	for (int q = 0; q < MAX_PRIORITY_QUEUES; q++) {
+		struct esp_hosted_tx_sched_q_stats *st = &pkt_stats.tx_sched[q];
+
+		ESP_LOGI(TAG, "Tx sched q[%d]: pkts[%lu] bytes[%lu] wait avg[%lu ms] max[%lu ms]",
+				q, st->pkts, st->bytes,
+				st->pkts ? st->wait_total_ms / st->pkts : 0, st->wait_max_ms);
+	}
+#endif
 
 #ifdef ESP_FUNCTION_PROFILING
 	/* Print timing stats for all active entries */
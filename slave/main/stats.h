@@ -17,6 +17,7 @@
 #include "freertos/task.h"
 #include "esp_timer.h"
 #include "esp_hosted_header.h"
+#include "esp_hosted_tx_sched.h"
 
 #define SEC_TO_MSEC(x)                 (x*1000)
 #define MSEC_TO_USEC(x)                (x*1000)
@@ -151,6 +152,17 @@ struct pkt_stats_t {
 	uint32_t sta_slave_lwip_out;
 	uint32_t sta_host_lwip_out;
 	uint32_t sta_both_lwip_out;
+	uint32_t nw_split_flow_hit;
+	uint32_t nw_split_flow_miss;
+	uint32_t sta_host_hold;
+	uint32_t sta_host_hold_drop;
+	uint32_t sta_host_hold_flush;
+	uint32_t hs_bus_aggr_bufs;
+	uint32_t hs_bus_aggr_pkts;
+	uint32_t sh_bus_coalesce_bufs;
+	uint32_t sh_bus_coalesce_pkts;
+	uint32_t sh_bus_coalesce_drops;
+	struct esp_hosted_tx_sched_q_stats tx_sched[MAX_PRIORITY_QUEUES];
 };
 
 extern struct pkt_stats_t pkt_stats;
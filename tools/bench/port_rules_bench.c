@@ -0,0 +1,192 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host side benchmark of the network split port rule classifier
+ * (slave/main/nw_split_port_rules.c) against a linear first match scan of
+ * the same rule list, with a cross check of every result.
+ *
+ * Rule sets:
+ * - uniform: rules of a protocol and direction share one bridge, so a
+ *   port map bit alone decides
+ * - mixed: bridges differ within a map, so hits walk the rule list
+ *
+ * Build and run from the repo root:
+ *   gcc -O2 -pthread -Itools/bench/stub -Islave/main -Icommon \
+ *       tools/bench/port_rules_bench.c slave/main/nw_split_port_rules.c \
+ *       -o port_rules_bench
+ *   ./port_rules_bench [rules] [lookups]
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "nw_split_port_rules.h"
+#include "lwip/prot/ip.h"
+
+#define BENCH_RULES             CONFIG_ESP_HOSTED_NW_SPLIT_MAX_PORT_RULES
+#define BENCH_LOOKUPS           2000000
+
+typedef struct {
+	uint8_t proto;
+	uint16_t src_port;
+	uint16_t dst_port;
+} pkt_t;
+
+/* nw_split_set_port_rules() drops cached flow decisions */
+void nw_split_flow_cache_flush(void)
+{
+}
+
+static nw_split_port_rule_t rules[BENCH_RULES];
+static int num_rules;
+
+/* First match over the rule list, as before the port maps */
+static bool linear_match(uint8_t proto, uint16_t src_port, uint16_t dst_port,
+		hosted_l2_bridge *bridge)
+{
+	int i;
+
+	for (i = 0; i < num_rules; i++) {
+		const nw_split_port_rule_t *rule = &rules[i];
+		uint16_t port = rule->match_src ? src_port : dst_port;
+
+		if (rule->proto == proto &&
+				port >= rule->port_start && port <= rule->port_end) {
+			*bridge = rule->bridge;
+			return true;
+		}
+	}
+	return false;
+}
+
+static double now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void make_rules(int n, bool mixed)
+{
+	int i;
+
+	for (i = 0; i < n; i++) {
+		nw_split_port_rule_t *r = &rules[i];
+		uint16_t start = (uint16_t)(1 + rand() % 60000);
+
+		r->proto = (i & 1) ? IP_PROTO_UDP : IP_PROTO_TCP;
+		r->match_src = (i % 4) >= 2;
+		r->port_start = start;
+		/* mostly single ports, some ranges */
+		r->port_end = (i % 5) ? start : (uint16_t)(start + rand() % 200);
+		if (mixed)
+			r->bridge = (hosted_l2_bridge)(rand() % (INVALID_BRIDGE + 1));
+		else
+			r->bridge = HOST_LWIP_BRIDGE;
+	}
+	num_rules = n;
+}
+
+/* Half of the packets hit a rule port */
+static void make_pkts(pkt_t *pkts, int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++) {
+		pkts[i].proto = (rand() & 1) ? IP_PROTO_UDP : IP_PROTO_TCP;
+		pkts[i].src_port = (uint16_t)rand();
+		pkts[i].dst_port = (uint16_t)rand();
+		if ((rand() & 1) && num_rules) {
+			const nw_split_port_rule_t *r = &rules[rand() % num_rules];
+
+			pkts[i].proto = r->proto;
+			if (r->match_src)
+				pkts[i].src_port = r->port_start;
+			else
+				pkts[i].dst_port = r->port_start;
+		}
+	}
+}
+
+static int run(const char *name, int n, bool mixed, const pkt_t *pkts, int num_pkts)
+{
+	hosted_l2_bridge a = INVALID_BRIDGE, b = INVALID_BRIDGE;
+	volatile uint32_t sink = 0;
+	double t0, t_map, t_lin;
+	int mismatches = 0;
+	int i;
+
+	make_rules(n, mixed);
+	if (nw_split_set_port_rules(rules, num_rules, true) != ESP_OK) {
+		printf("%s: failed to set %d rules\n", name, n);
+		return 1;
+	}
+
+	for (i = 0; i < num_pkts; i++) {
+		bool hit_a = nw_split_port_rules_match(pkts[i].proto, pkts[i].src_port,
+				pkts[i].dst_port, &a);
+		bool hit_b = linear_match(pkts[i].proto, pkts[i].src_port,
+				pkts[i].dst_port, &b);
+
+		if (hit_a != hit_b || (hit_a && a != b))
+			mismatches++;
+	}
+
+	t0 = now_ns();
+	for (i = 0; i < num_pkts; i++)
+		sink += nw_split_port_rules_match(pkts[i].proto, pkts[i].src_port,
+				pkts[i].dst_port, &a) ? a + 1 : 0;
+	t_map = now_ns() - t0;
+
+	t0 = now_ns();
+	for (i = 0; i < num_pkts; i++)
+		sink += linear_match(pkts[i].proto, pkts[i].src_port,
+				pkts[i].dst_port, &b) ? b + 1 : 0;
+	t_lin = now_ns() - t0;
+
+	printf("%-8s %4d rules: port maps %6.1f ns, linear scan %6.1f ns per lookup%s\n",
+			name, n, t_map / num_pkts, t_lin / num_pkts,
+			mismatches ? ", RESULTS DIFFER" : "");
+	(void)sink;
+	return mismatches != 0;
+}
+
+int main(int argc, char *argv[])
+{
+	int max_rules = argc > 1 ? atoi(argv[1]) : BENCH_RULES;
+	int num_pkts = argc > 2 ? atoi(argv[2]) : BENCH_LOOKUPS;
+	pkt_t *pkts = NULL;
+	int n, fail = 0;
+
+	if (max_rules < 1 || max_rules > BENCH_RULES || num_pkts < 1) {
+		printf("rules 1..%d\n", BENCH_RULES);
+		return 1;
+	}
+
+	pkts = malloc(num_pkts * sizeof(*pkts));
+	if (!pkts)
+		return 1;
+
+	srand(1);
+	for (n = 4; n <= max_rules; n *= 4) {
+		make_rules(n, false);
+		make_pkts(pkts, num_pkts);
+		fail |= run("uniform", n, false, pkts, num_pkts);
+		fail |= run("mixed", n, true, pkts, num_pkts);
+	}
+	if (n / 4 != max_rules) {
+		make_rules(max_rules, false);
+		make_pkts(pkts, num_pkts);
+		fail |= run("uniform", max_rules, false, pkts, num_pkts);
+		fail |= run("mixed", max_rules, true, pkts, num_pkts);
+	}
+
+	free(pkts);
+	return fail;
+}
@@ -0,0 +1,274 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host side test of async RPC timeouts and late responses (rpc_slot.c).
+ * Drives the timer wheel with a simulated clock the way rpc_tx_thread
+ * does, and completes requests through the uid claim the way the RPC Rx
+ * task and rpc_async_timeout_handler() do.
+ *
+ * Checks that:
+ * - a request times out no earlier than its timeout, and at most two
+ *   ticks later, also after a wake up later than a whole wheel revolution
+ * - a response completing the request first cancels its timeout
+ * - a response arriving after the timeout, or for a recycled slot, does
+ *   not complete anything
+ * - the wheel asks for no wake up while it is empty
+ * - with random timeouts, responses and clock steps, every request
+ *   completes exactly once
+ *
+ * Build and run from the repo root:
+ *   gcc -O2 -pthread -Itools/bench/stub -Ihost -Ihost/drivers/rpc/core \
+ *       tools/bench/rpc_async_timeout_test.c host/drivers/rpc/core/rpc_slot.c \
+ *       tools/bench/stub/hosted_osi_posix.c -o rpc_async_timeout_test
+ *   ./rpc_async_timeout_test
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "rpc_slot.h"
+
+#define TEST_RANDOM_ROUNDS      200000
+#define TEST_LATE_MS            (2 * RPC_TW_TICK_MS)
+
+static uint32_t failures;
+
+#define CHECK(cond) do {                                              \
+	if (!(cond)) {                                                \
+		printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);    \
+		failures++;                                           \
+	}                                                             \
+} while (0)
+
+/* rpc_send_req() and process_rpc_tx_msg() of an async request */
+static uint32_t send_async(uint32_t timeout_ms, uint32_t now_ms)
+{
+	rpc_slot_t *slot = rpc_slot_alloc(1);
+	uint32_t uid = 0;
+
+	if (!slot)
+		return 0;
+
+	uid = rpc_slot_uid(slot);
+	rpc_slot_publish(slot, uid);
+	rpc_tw_add(slot, uid, timeout_ms, now_ms);
+	return uid;
+}
+
+/* RPC Rx task: returns 1 if the response completed its request */
+static int respond(uint32_t uid)
+{
+	rpc_slot_t *slot = rpc_slot_claim(uid);
+
+	if (!slot)
+		return 0;
+
+	rpc_tw_del(slot);
+	rpc_slot_free(slot);
+	return 1;
+}
+
+/* rpc_tx_thread wake up: returns the number of requests timed out */
+static int expire(uint32_t now_ms, uint32_t *timed_out)
+{
+	uint32_t expired[RPC_SLOT_MAX_ASYNC];
+	int n = 0, k = 0, done = 0;
+
+	if (rpc_tw_wait_ms(now_ms))
+		return 0;
+
+	n = rpc_tw_expire(now_ms, expired, RPC_SLOT_MAX_ASYNC);
+	for (k = 0; k < n; k++) {
+		rpc_slot_t *slot = rpc_slot_claim(expired[k]);
+
+		if (!slot)
+			continue;
+
+		rpc_slot_free(slot);
+		if (timed_out)
+			timed_out[done] = expired[k];
+		done++;
+	}
+	return done;
+}
+
+/* Step the clock tick by tick until uid times out, returns when */
+static uint32_t run_until_timeout(uint32_t uid, uint32_t now_ms, uint32_t limit_ms)
+{
+	uint32_t timed_out[RPC_SLOT_MAX_ASYNC];
+	int n = 0;
+
+	while (now_ms < limit_ms) {
+		int wait_ms = rpc_tw_wait_ms(now_ms);
+
+		now_ms += wait_ms > 0 ? (uint32_t)wait_ms : 1;
+		n = expire(now_ms, timed_out);
+		if (n == 1 && timed_out[0] == uid)
+			return now_ms;
+		CHECK(n == 0);
+	}
+	return 0;
+}
+
+static void test_timeout(void)
+{
+	uint32_t start = 123457;
+	uint32_t uid = send_async(1000, start);
+	uint32_t at = 0;
+
+	CHECK(uid);
+	CHECK(rpc_tw_wait_ms(start) > 0);
+	at = run_until_timeout(uid, start, start + 5000);
+	CHECK(at >= start + 1000);
+	CHECK(at <= start + 1000 + TEST_LATE_MS);
+
+	/* late response after timeout */
+	CHECK(!respond(uid));
+	CHECK(rpc_tw_wait_ms(at) == -1);
+}
+
+static void test_response_first(void)
+{
+	uint32_t start = 500;
+	uint32_t uid = send_async(1000, start);
+
+	CHECK(uid);
+	CHECK(respond(uid));
+	CHECK(rpc_tw_wait_ms(start) == -1);
+	CHECK(expire(start + 10000, NULL) == 0);
+	/* duplicate response */
+	CHECK(!respond(uid));
+}
+
+static void test_recycled_slot(void)
+{
+	uint32_t start = 9000;
+	uint32_t old_uid = send_async(1000, start);
+	uint32_t new_uid = 0;
+
+	CHECK(respond(old_uid));
+	new_uid = send_async(1000, start);
+	/* same slot, next generation */
+	CHECK((new_uid & RPC_SLOT_IDX_MASK) == (old_uid & RPC_SLOT_IDX_MASK));
+	CHECK(new_uid != old_uid);
+
+	CHECK(!respond(old_uid));
+	CHECK(respond(new_uid));
+}
+
+static void test_long_timeouts(void)
+{
+	uint32_t revolution_ms = RPC_TW_BUCKETS * RPC_TW_TICK_MS;
+	uint32_t start = 70000;
+	uint32_t timeout_ms = 3 * revolution_ms + 250;
+	uint32_t uid = send_async(timeout_ms, start);
+	uint32_t timed_out[RPC_SLOT_MAX_ASYNC];
+	uint32_t at = 0;
+
+	/* due in a later revolution: stays when its bucket is walked */
+	at = run_until_timeout(uid, start, start + 10 * revolution_ms);
+	CHECK(at >= start + timeout_ms);
+	CHECK(at <= start + timeout_ms + TEST_LATE_MS);
+
+	/* wake up only long after the timeout, e.g. a starved Tx task */
+	uid = send_async(1000, at);
+	CHECK(expire(at + 10 * revolution_ms, timed_out) == 1);
+	CHECK(timed_out[0] == uid);
+	CHECK(!respond(uid));
+
+	/* idle wheel catches up with the clock on the next request */
+	at += 100 * revolution_ms;
+	uid = send_async(1000, at);
+	CHECK(expire(at + 900, NULL) == 0);
+	CHECK(run_until_timeout(uid, at + 900, at + 5000) >= at + 1000);
+}
+
+static void test_random(void)
+{
+	uint32_t uid[RPC_SLOT_MAX_ASYNC] = { 0 };
+	uint32_t due[RPC_SLOT_MAX_ASYNC] = { 0 };
+	uint32_t timed_out[RPC_SLOT_MAX_ASYNC];
+	uint32_t now = 1000;
+	uint32_t sent = 0, answered = 0, expired = 0;
+	int i, k, n;
+
+	srand(1);
+	for (i = 0; i < TEST_RANDOM_ROUNDS; i++) {
+		int s = rand() % RPC_SLOT_MAX_ASYNC;
+
+		switch (rand() % 4) {
+		case 0:
+			if (!uid[s]) {
+				uint32_t t = 100 + rand() % 8000;
+
+				uid[s] = send_async(t, now);
+				if (uid[s]) {
+					due[s] = now + t;
+					sent++;
+				}
+			}
+			break;
+		case 1:
+			if (uid[s] && respond(uid[s])) {
+				CHECK((int32_t)(now - due[s]) <= TEST_LATE_MS);
+				uid[s] = 0;
+				answered++;
+			}
+			break;
+		default:
+			now += rand() % 150;
+			n = expire(now, timed_out);
+			for (k = 0; k < n; k++) {
+				int j;
+
+				for (j = 0; j < RPC_SLOT_MAX_ASYNC; j++)
+					if (uid[j] == timed_out[k])
+						break;
+				CHECK(j < RPC_SLOT_MAX_ASYNC);
+				if (j == RPC_SLOT_MAX_ASYNC)
+					continue;
+				CHECK((int32_t)(now - due[j]) >= 0);
+				CHECK((int32_t)(now - due[j]) <= TEST_LATE_MS + 150);
+				/* the response may still come, it must be dropped */
+				CHECK(!respond(uid[j]));
+				uid[j] = 0;
+				expired++;
+			}
+			break;
+		}
+	}
+
+	for (k = 0; k < RPC_SLOT_MAX_ASYNC; k++)
+		if (uid[k]) {
+			CHECK(respond(uid[k]));
+			answered++;
+		}
+
+	CHECK(sent == answered + expired);
+	CHECK(rpc_tw_wait_ms(now) == -1);
+	printf("random: %u requests, %u answered, %u timed out\n",
+			sent, answered, expired);
+}
+
+int main(void)
+{
+	if (rpc_slot_init())
+		return 1;
+
+	test_timeout();
+	test_response_first();
+	test_recycled_slot();
+	test_long_timeouts();
+	test_random();
+
+	if (failures) {
+		printf("%u checks failed\n", failures);
+		return 1;
+	}
+	printf("all checks passed\n");
+	return 0;
+}
@@ -0,0 +1,219 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host side stress test of the RPC slot table (rpc_slot.c).
+ * Caller threads issue sync requests the way rpc_send_req() and
+ * get_response() do: allocate a slot, publish its uid, hand the uid to
+ * the link and wait on the slot semaphore. A responder thread plays the
+ * co-processor and RPC Rx task: it claims the slot of each uid, stores
+ * the response and posts the semaphore. Every few requests it also
+ * replays an old uid, which must never complete anything.
+ *
+ * Reports RPC/s and latency percentiles, and fails on a response handed
+ * to the wrong caller, a lost completion or a late response accepted.
+ *
+ * Build and run from the repo root:
+ *   gcc -O2 -pthread -Itools/bench/stub -Ihost -Ihost/drivers/rpc/core \
+ *       tools/bench/rpc_slot_stress.c host/drivers/rpc/core/rpc_slot.c \
+ *       tools/bench/stub/hosted_osi_posix.c -o rpc_slot_stress
+ *   ./rpc_slot_stress [callers] [requests per caller]
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "rpc_slot.h"
+#include "port_esp_hosted_host_os.h"
+
+#define STRESS_CALLERS          8
+#define STRESS_REQUESTS         20000
+#define STRESS_RSP_TIMEOUT_MS   2000
+#define STRESS_REPLAY_EVERY     7
+#define LINK_DEPTH              (RPC_MAX_SLOTS * 2)
+
+/* uid FIFO between callers and the responder, like the serial link */
+static struct {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	uint32_t uid[LINK_DEPTH];
+	uint32_t head;
+	uint32_t tail;
+} link_q = { .lock = PTHREAD_MUTEX_INITIALIZER, .cond = PTHREAD_COND_INITIALIZER };
+
+/* response handed over through the slot, as rpc_slot_ctx[].app_resp */
+static uint32_t slot_resp[RPC_MAX_SLOTS];
+
+static unsigned num_callers = STRESS_CALLERS;
+static unsigned num_requests = STRESS_REQUESTS;
+static uint32_t *latency_us;
+static uint32_t errors;
+static uint32_t timeouts;
+static uint32_t replays_dropped;
+static uint32_t replays_accepted;
+static uint32_t slot_busy;
+
+static uint64_t now_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void link_send(uint32_t uid)
+{
+	pthread_mutex_lock(&link_q.lock);
+	/* bounded by the number of slots, the link never fills */
+	link_q.uid[link_q.head++ % LINK_DEPTH] = uid;
+	pthread_cond_signal(&link_q.cond);
+	pthread_mutex_unlock(&link_q.lock);
+}
+
+static uint32_t link_recv(void)
+{
+	uint32_t uid = 0;
+
+	pthread_mutex_lock(&link_q.lock);
+	while (link_q.head == link_q.tail)
+		pthread_cond_wait(&link_q.cond, &link_q.lock);
+	uid = link_q.uid[link_q.tail++ % LINK_DEPTH];
+	pthread_mutex_unlock(&link_q.lock);
+
+	return uid;
+}
+
+static void *responder(void *arg)
+{
+	uint32_t last_uid = 0;
+	uint32_t n = 0;
+	rpc_slot_t *slot = NULL;
+	uint32_t uid = 0;
+
+	(void)arg;
+	while ((uid = link_recv())) {
+		slot = rpc_slot_claim(uid);
+		if (slot) {
+			slot_resp[rpc_slot_idx(slot)] = uid;
+			g_h.funcs->_h_post_semaphore(slot->sem);
+		}
+
+		/* response for a request completed earlier */
+		if (last_uid && !(++n % STRESS_REPLAY_EVERY)) {
+			if (rpc_slot_claim(last_uid))
+				__atomic_fetch_add(&replays_accepted, 1, __ATOMIC_RELAXED);
+			else
+				__atomic_fetch_add(&replays_dropped, 1, __ATOMIC_RELAXED);
+		}
+		last_uid = uid;
+	}
+
+	return NULL;
+}
+
+/* rpc_send_req() and get_response() for a sync request */
+static void *caller(void *arg)
+{
+	uint32_t *lat = arg;
+	rpc_slot_t *slot = NULL;
+	uint64_t start = 0;
+	uint32_t uid = 0;
+	unsigned i = 0;
+
+	for (i = 0; i < num_requests; i++) {
+		start = now_us();
+		while (!(slot = rpc_slot_alloc(0))) {
+			__atomic_fetch_add(&slot_busy, 1, __ATOMIC_RELAXED);
+			sched_yield();
+		}
+
+		uid = rpc_slot_uid(slot);
+		rpc_slot_publish(slot, uid);
+		link_send(uid);
+
+		if (g_h.funcs->_h_get_semaphore(slot->sem, STRESS_RSP_TIMEOUT_MS)) {
+			if (rpc_slot_claim(uid)) {
+				__atomic_fetch_add(&timeouts, 1, __ATOMIC_RELAXED);
+				rpc_slot_free(slot);
+				continue;
+			}
+			/* claimed by the response just now */
+			g_h.funcs->_h_get_semaphore(slot->sem, HOSTED_BLOCKING);
+		}
+
+		if (slot_resp[rpc_slot_idx(slot)] != uid)
+			__atomic_fetch_add(&errors, 1, __ATOMIC_RELAXED);
+
+		rpc_slot_free(slot);
+		lat[i] = (uint32_t)(now_us() - start);
+	}
+
+	return NULL;
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+int main(int argc, char *argv[])
+{
+	pthread_t *callers = NULL;
+	pthread_t rsp_thread;
+	uint64_t start = 0;
+	double secs = 0;
+	size_t total = 0;
+	unsigned i = 0;
+
+	if (argc > 1)
+		num_callers = strtoul(argv[1], NULL, 0);
+	if (argc > 2)
+		num_requests = strtoul(argv[2], NULL, 0);
+	if (!num_callers || !num_requests)
+		return 1;
+
+	total = (size_t)num_callers * num_requests;
+	latency_us = calloc(total, sizeof(uint32_t));
+	callers = calloc(num_callers, sizeof(pthread_t));
+	if (!latency_us || !callers || rpc_slot_init())
+		return 1;
+
+	pthread_create(&rsp_thread, NULL, responder, NULL);
+
+	start = now_us();
+	for (i = 0; i < num_callers; i++)
+		pthread_create(&callers[i], NULL, caller, &latency_us[(size_t)i * num_requests]);
+	for (i = 0; i < num_callers; i++)
+		pthread_join(callers[i], NULL);
+	secs = (now_us() - start) / 1e6;
+
+	link_send(0);
+	pthread_join(rsp_thread, NULL);
+
+	qsort(latency_us, total, sizeof(uint32_t), cmp_u32);
+	printf("%u callers, %u sync slots: %zu requests in %.2f s, %.0f RPC/s\n",
+			num_callers, RPC_SLOT_MAX_SYNC, total, secs, total / secs);
+	printf("latency us: p50 %u  p99 %u  p99.9 %u  max %u\n",
+			latency_us[total / 2], latency_us[total * 99 / 100],
+			latency_us[total * 999 / 1000], latency_us[total - 1]);
+	printf("all slots busy: %u, timeouts: %u, late responses dropped: %u\n",
+			slot_busy, timeouts, replays_dropped);
+
+	if (errors || timeouts || replays_accepted) {
+		printf("FAILED: %u wrong responses, %u lost, %u late responses accepted\n",
+				errors, timeouts, replays_accepted);
+		return 1;
+	}
+
+	free(latency_us);
+	free(callers);
+	return 0;
+}
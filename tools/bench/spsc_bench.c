@@ -0,0 +1,185 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host side benchmark of the transport Rx queue hand-off: the lock-free
+ * SPSC ring (host/utils/hosted_spsc_ring.h), used the same way as in
+ * transport_drv.c, against a locked queue plus a semaphore post per item,
+ * which is what a FreeRTOS queue and counting semaphore amount to.
+ * Every item is checked to arrive once and in order.
+ *
+ * Build and run from the repo root:
+ *   gcc -O2 -pthread -Ihost/utils tools/bench/spsc_bench.c -o spsc_bench
+ *   ./spsc_bench [items] [queue size]
+ */
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "hosted_spsc_ring.h"
+
+#define BENCH_ITEMS         2000000
+#define BENCH_QUEUE_SIZE    20
+
+/* same size as interface_buffer_handle_t on a 32-bit target */
+typedef struct {
+	uint32_t seq;
+	uint32_t words[7];
+} bench_item_t;
+
+typedef struct {
+	const char *name;
+	void (*push)(const bench_item_t *item);
+	void (*pop)(bench_item_t *item);
+} bench_queue_t;
+
+static uint32_t num_items = BENCH_ITEMS;
+static uint32_t queue_size = BENCH_QUEUE_SIZE;
+static sem_t data_sem;
+
+/* -------- SPSC ring, as transport_rx_queue_item() / _dequeue_wait() */
+static hosted_spsc_ring_t ring;
+static sem_t space_sem;
+
+static void ring_push(const bench_item_t *item)
+{
+	bool was_empty = false;
+
+	while (hosted_spsc_ring_push(&ring, item, &was_empty))
+		sem_wait(&space_sem);
+
+	if (was_empty)
+		sem_post(&data_sem);
+}
+
+static void ring_pop(bench_item_t *item)
+{
+	bool was_full = false;
+
+	while (hosted_spsc_ring_pop(&ring, item, &was_full))
+		sem_wait(&data_sem);
+
+	if (was_full)
+		sem_post(&space_sem);
+}
+
+/* -------- Locked queue, one semaphore post per item */
+static pthread_mutex_t lq_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t lq_space = PTHREAD_COND_INITIALIZER;
+static bench_item_t *lq_items;
+static uint32_t lq_head;
+static uint32_t lq_tail;
+
+static void locked_push(const bench_item_t *item)
+{
+	pthread_mutex_lock(&lq_lock);
+	while (lq_head - lq_tail == queue_size)
+		pthread_cond_wait(&lq_space, &lq_lock);
+	lq_items[lq_head++ % queue_size] = *item;
+	pthread_mutex_unlock(&lq_lock);
+
+	sem_post(&data_sem);
+}
+
+static void locked_pop(bench_item_t *item)
+{
+	sem_wait(&data_sem);
+
+	pthread_mutex_lock(&lq_lock);
+	*item = lq_items[lq_tail++ % queue_size];
+	pthread_cond_signal(&lq_space);
+	pthread_mutex_unlock(&lq_lock);
+}
+
+static void *producer(void *arg)
+{
+	const bench_queue_t *q = arg;
+	bench_item_t item = { 0 };
+	uint32_t i = 0;
+
+	for (i = 0; i < num_items; i++) {
+		item.seq = i;
+		q->push(&item);
+	}
+
+	return NULL;
+}
+
+static double now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int run(const bench_queue_t *q)
+{
+	bench_item_t item = { 0 };
+	pthread_t thread;
+	double start = 0;
+	double ns = 0;
+	uint32_t i = 0;
+	int ret = 0;
+
+	sem_init(&data_sem, 0, 0);
+	start = now_ns();
+	pthread_create(&thread, NULL, producer, (void *)q);
+
+	for (i = 0; i < num_items; i++) {
+		q->pop(&item);
+		if (item.seq != i && !ret) {
+			printf("%s: got item %u, expected %u\n", q->name, item.seq, i);
+			ret = -1;
+		}
+	}
+
+	pthread_join(thread, NULL);
+	ns = (now_ns() - start) / num_items;
+	sem_destroy(&data_sem);
+
+	printf("%-8s %u items, queue size %u: %6.1f ns/item%s\n", q->name,
+			num_items, queue_size, ns, ret ? " (FAILED)" : "");
+	return ret;
+}
+
+int main(int argc, char *argv[])
+{
+	static const bench_queue_t queues[] = {
+		{ "spsc",   ring_push,   ring_pop },
+		{ "locked", locked_push, locked_pop },
+	};
+	uint8_t *ring_items = NULL;
+	size_t i = 0;
+	int ret = 0;
+
+	if (argc > 1)
+		num_items = strtoul(argv[1], NULL, 0);
+	if (argc > 2)
+		queue_size = strtoul(argv[2], NULL, 0);
+	if (!queue_size)
+		return 1;
+
+	ring_items = malloc(hosted_spsc_ring_capacity(queue_size) * sizeof(bench_item_t));
+	lq_items = malloc(queue_size * sizeof(bench_item_t));
+	if (!ring_items || !lq_items)
+		return 1;
+
+	hosted_spsc_ring_init(&ring, ring_items, queue_size, sizeof(bench_item_t));
+	sem_init(&space_sem, 0, 0);
+
+	for (i = 0; i < sizeof(queues) / sizeof(queues[0]); i++)
+		ret |= run(&queues[i]);
+
+	sem_destroy(&space_sem);
+	free(ring_items);
+	free(lq_items);
+
+	return ret ? 1 : 0;
+}
@@ -0,0 +1,14 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host build stand-in for the ESP-IDF header of the same name */
+
+#ifndef __BENCH_STUB_ESP_EVENT_BASE_H
+#define __BENCH_STUB_ESP_EVENT_BASE_H
+
+typedef const char *esp_event_base_t;
+
+#endif
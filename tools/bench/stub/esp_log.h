@@ -0,0 +1,14 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host build stand-in for the ESP-IDF header of the same name */
+
+#ifndef __BENCH_STUB_ESP_LOG_H
+#define __BENCH_STUB_ESP_LOG_H
+
+#include "port_esp_hosted_host_log.h"
+
+#endif
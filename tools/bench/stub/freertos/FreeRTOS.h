@@ -0,0 +1,21 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host build stand-in for the FreeRTOS header of the same name */
+
+#ifndef __BENCH_STUB_FREERTOS_H
+#define __BENCH_STUB_FREERTOS_H
+
+#include <stdint.h>
+
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdTRUE                                       1
+#define pdFALSE                                      0
+#define portMAX_DELAY                                ((TickType_t)UINT32_MAX)
+
+#endif
@@ -0,0 +1,40 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host build stand-in for the FreeRTOS header of the same name.
+ * Mutexes only, on pthreads */
+
+#ifndef __BENCH_STUB_FREERTOS_SEMPHR_H
+#define __BENCH_STUB_FREERTOS_SEMPHR_H
+
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "freertos/FreeRTOS.h"
+
+typedef pthread_mutex_t *SemaphoreHandle_t;
+
+static inline SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+	SemaphoreHandle_t m = malloc(sizeof(*m));
+
+	if (m)
+		pthread_mutex_init(m, NULL);
+	return m;
+}
+
+static inline BaseType_t xSemaphoreTake(SemaphoreHandle_t m, TickType_t ticks)
+{
+	(void)ticks;
+	return pthread_mutex_lock(m) ? pdFALSE : pdTRUE;
+}
+
+static inline BaseType_t xSemaphoreGive(SemaphoreHandle_t m)
+{
+	return pthread_mutex_unlock(m) ? pdFALSE : pdTRUE;
+}
+
+#endif
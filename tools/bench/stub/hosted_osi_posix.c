@@ -0,0 +1,191 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* The parts of the OS abstraction used by the host tools, on pthreads.
+ * Semantics follow the FreeRTOS port: a new semaphore is given once,
+ * timeouts are in ms, 0 does not block and a negative value blocks */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "port_esp_hosted_host_os.h"
+
+typedef struct {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	int count;
+	int max;
+} posix_sem_t;
+
+static void *posix_memcpy(void *dest, const void *src, uint32_t size)
+{
+	return memcpy(dest, src, size);
+}
+
+static void *posix_memset(void *buf, int val, size_t len)
+{
+	return memset(buf, val, len);
+}
+
+static void *posix_malloc(size_t size)
+{
+	return malloc(size);
+}
+
+static void *posix_calloc(size_t blk_no, size_t size)
+{
+	return calloc(blk_no, size);
+}
+
+static void posix_free(void *ptr)
+{
+	free(ptr);
+}
+
+static unsigned int posix_msleep(unsigned int ms)
+{
+	return usleep(ms * 1000);
+}
+
+static uint64_t posix_get_time_ms(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void *posix_create_semaphore(int max_count)
+{
+	posix_sem_t *sem = calloc(1, sizeof(posix_sem_t));
+	pthread_condattr_t attr;
+
+	if (!sem)
+		return NULL;
+
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&sem->cond, &attr);
+	pthread_condattr_destroy(&attr);
+	pthread_mutex_init(&sem->lock, NULL);
+	sem->max = max_count > 1 ? max_count : 1;
+	sem->count = 1;
+
+	return sem;
+}
+
+static int posix_post_semaphore(void *handle)
+{
+	posix_sem_t *sem = handle;
+
+	pthread_mutex_lock(&sem->lock);
+	if (sem->count < sem->max)
+		sem->count++;
+	pthread_cond_signal(&sem->cond);
+	pthread_mutex_unlock(&sem->lock);
+
+	return RET_OK;
+}
+
+static int posix_get_semaphore(void *handle, int timeout_ms)
+{
+	posix_sem_t *sem = handle;
+	struct timespec until;
+	int ret = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &until);
+	if (timeout_ms > 0) {
+		until.tv_sec += timeout_ms / 1000;
+		until.tv_nsec += (long)(timeout_ms % 1000) * 1000000;
+		if (until.tv_nsec >= 1000000000) {
+			until.tv_sec++;
+			until.tv_nsec -= 1000000000;
+		}
+	}
+
+	pthread_mutex_lock(&sem->lock);
+	while (!sem->count && timeout_ms && ret != ETIMEDOUT) {
+		if (timeout_ms < 0)
+			pthread_cond_wait(&sem->cond, &sem->lock);
+		else
+			ret = pthread_cond_timedwait(&sem->cond, &sem->lock, &until);
+	}
+	if (sem->count) {
+		sem->count--;
+		ret = RET_OK;
+	} else {
+		ret = RET_FAIL_TIMEOUT;
+	}
+	pthread_mutex_unlock(&sem->lock);
+
+	return ret;
+}
+
+static int posix_destroy_semaphore(void *handle)
+{
+	posix_sem_t *sem = handle;
+
+	pthread_cond_destroy(&sem->cond);
+	pthread_mutex_destroy(&sem->lock);
+	free(sem);
+
+	return RET_OK;
+}
+
+static void *posix_create_mutex(void)
+{
+	pthread_mutex_t *mutex = calloc(1, sizeof(pthread_mutex_t));
+
+	if (mutex)
+		pthread_mutex_init(mutex, NULL);
+
+	return mutex;
+}
+
+static int posix_lock_mutex(void *handle, int timeout_ms)
+{
+	(void)timeout_ms;
+	return pthread_mutex_lock(handle) ? RET_FAIL : RET_OK;
+}
+
+static int posix_unlock_mutex(void *handle)
+{
+	return pthread_mutex_unlock(handle) ? RET_FAIL : RET_OK;
+}
+
+static int posix_destroy_mutex(void *handle)
+{
+	pthread_mutex_destroy(handle);
+	free(handle);
+
+	return RET_OK;
+}
+
+hosted_osi_funcs_t g_hosted_osi_funcs = {
+	._h_memcpy                   =  posix_memcpy                   ,
+	._h_memset                   =  posix_memset                   ,
+	._h_malloc                   =  posix_malloc                   ,
+	._h_calloc                   =  posix_calloc                   ,
+	._h_free                     =  posix_free                     ,
+	._h_msleep                   =  posix_msleep                   ,
+	._h_unlock_mutex             =  posix_unlock_mutex             ,
+	._h_create_mutex             =  posix_create_mutex             ,
+	._h_lock_mutex               =  posix_lock_mutex               ,
+	._h_destroy_mutex            =  posix_destroy_mutex            ,
+	._h_post_semaphore           =  posix_post_semaphore           ,
+	._h_create_semaphore         =  posix_create_semaphore         ,
+	._h_get_semaphore            =  posix_get_semaphore            ,
+	._h_destroy_semaphore        =  posix_destroy_semaphore        ,
+	._h_get_time_ms              =  posix_get_time_ms              ,
+};
+
+struct hosted_config_t g_h = {
+	.funcs = &g_hosted_osi_funcs,
+};
@@ -0,0 +1,12 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host build stand-in for the lwIP header of the same name */
+
+#ifndef __BENCH_STUB_LWIP_OPT_H
+#define __BENCH_STUB_LWIP_OPT_H
+
+#endif
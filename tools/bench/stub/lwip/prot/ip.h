@@ -0,0 +1,16 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host build stand-in for the lwIP header of the same name */
+
+#ifndef __BENCH_STUB_LWIP_PROT_IP_H
+#define __BENCH_STUB_LWIP_PROT_IP_H
+
+#define IP_PROTO_ICMP                                1
+#define IP_PROTO_TCP                                 6
+#define IP_PROTO_UDP                                 17
+
+#endif
@@ -0,0 +1,21 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host build stand-in for the port config: only the options used by the
+ * sources built into the tools. Override with -D on the command line */
+
+#ifndef __BENCH_STUB_PORT_ESP_HOSTED_HOST_CONFIG_H
+#define __BENCH_STUB_PORT_ESP_HOSTED_HOST_CONFIG_H
+
+#ifndef H_MAX_SYNC_RPC_REQUESTS
+#define H_MAX_SYNC_RPC_REQUESTS                      16
+#endif
+
+#ifndef H_MAX_ASYNC_RPC_REQUESTS
+#define H_MAX_ASYNC_RPC_REQUESTS                     16
+#endif
+
+#endif
@@ -0,0 +1,27 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host build stand-in for the port OS header.
+ * hosted_osi_posix.c implements the OS abstraction with pthreads */
+
+#ifndef __BENCH_STUB_PORT_ESP_HOSTED_HOST_OS_H
+#define __BENCH_STUB_PORT_ESP_HOSTED_HOST_OS_H
+
+#include "port_esp_hosted_host_config.h"
+#include "esp_hosted_os_abstraction.h"
+
+#define HOSTED_BLOCKING                              -1
+#define HOSTED_NON_BLOCKING                          0
+#define HOSTED_BLOCK_MAX                             -1
+
+#define RET_OK                                       0
+#define RET_FAIL                                     -1
+#define RET_INVALID                                  -2
+#define RET_FAIL_MEM                                 -3
+#define RET_FAIL4                                    -4
+#define RET_FAIL_TIMEOUT                             -5
+
+#endif
@@ -0,0 +1,26 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host build stand-in for the co-processor sdkconfig.h: only the options
+ * used by the sources built into the tools. Override with -D */
+
+#ifndef __BENCH_STUB_SDKCONFIG_H
+#define __BENCH_STUB_SDKCONFIG_H
+
+#define CONFIG_LWIP_ENABLE                           1
+#define CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED      1
+
+#ifndef CONFIG_ESP_HOSTED_NW_SPLIT_MAX_PORT_RULES
+#define CONFIG_ESP_HOSTED_NW_SPLIT_MAX_PORT_RULES    64
+#endif
+
+#define CONFIG_ESP_HOSTED_HOST_POWER_SAVE_ENABLED    1
+
+#ifndef CONFIG_ESP_HOSTED_HOST_WAKE_FILTER_MAX_RULES
+#define CONFIG_ESP_HOSTED_HOST_WAKE_FILTER_MAX_RULES 8
+#endif
+
+#endif
@@ -0,0 +1,418 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host side replay of captured frames through the host wake up filter
+ * (slave/main/host_wake_filter.c). The filter is built into this file,
+ * with the capture time as its clock and no lock.
+ *
+ * Inputs are read in order, the rules stay set from one to the next:
+ * - pcap files (Ethernet link type), e.g. from tcpdump -w
+ * - text files, see tools/bench/captures/, with one item per line:
+ *     # comment
+ *     rule <l2|l3|l4|payload> <tcp|udp|icmp|any|proto> <port> <offset> <hex value>[/<hex mask>] [<limit>/<interval ms>]
+ *     reset
+ *     <time ms> <wake|hold|-> <hex frame>
+ *   Consecutive rule lines replace the rules, reset restores the defaults.
+ *   A frame expected to wake or hold the host fails the run if it does not.
+ *
+ * Every frame is matched the way the network split router does for a host
+ * bound packet while the host sleeps. Beyond the expectations, it checks
+ * that the frames of a TCP/UDP flow reported constant by
+ * host_wake_filter_flow_constant() all get the same result, as the
+ * router caches it per flow then.
+ *
+ * Build and run from the repo root:
+ *   gcc -O2 -Itools/bench/stub -Islave/main -Icommon \
+ *       tools/bench/wake_filter_replay.c -o wake_filter_replay
+ *   ./wake_filter_replay [-q] tools/bench/captures/default_rules.txt \
+ *       tools/bench/captures/host_rules.txt [capture.pcap]
+ */
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static uint32_t replay_now_ms;
+
+#define WAKE_NOW_MS()           replay_now_ms
+#define WAKE_LOCK_T             int
+#define WAKE_LOCK_INIT          0
+#define WAKE_LOCK(l)            (void)(l)
+#define WAKE_UNLOCK(l)          (void)(l)
+
+#include "host_wake_filter.c"
+
+#define REPLAY_MAX_FRAME        2048
+#define REPLAY_MAX_FLOWS        256
+#define REPLAY_LINE_LEN         (2 * REPLAY_MAX_FRAME + 256)
+
+#define PCAP_MAGIC_US           0xa1b2c3d4
+#define PCAP_MAGIC_NS           0xa1b23c4d
+#define PCAP_LINKTYPE_ETHERNET  1
+
+typedef struct {
+	uint32_t src_ip;
+	uint32_t dst_ip;
+	uint16_t src_port;
+	uint16_t dst_port;
+	uint8_t proto;
+	uint8_t constant;
+	uint8_t wake;
+	uint32_t frames;
+} replay_flow_t;
+
+static replay_flow_t flows[REPLAY_MAX_FLOWS];
+static int num_flows;
+
+static host_wake_rule_t pending_rules[WAKE_MAX_RULES];
+static int num_pending_rules = -1;      /* -1: no rule lines pending */
+
+static uint32_t frames, wakes, per_packet, failures;
+static int quiet;
+
+/* The network split router flushes its flow cache on rule changes */
+void nw_split_flow_cache_flush(void)
+{
+	num_flows = 0;
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+	return ((uint32_t)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+/* Flow of a first fragment TCP/UDP frame, NULL for other frames */
+static replay_flow_t *flow_of(const frame_info_t *fi, const uint8_t *frame)
+{
+	const uint8_t *ip = frame + ETH_HDR_LEN;
+	replay_flow_t *f = NULL;
+	int i;
+
+	if ((fi->ip_proto != IP_PROTO_NUM_TCP && fi->ip_proto != IP_PROTO_NUM_UDP) ||
+			fi->start[HOST_WAKE_LAYER_L4] < 0)
+		return NULL;
+
+	for (i = 0; i < num_flows; i++) {
+		f = &flows[i];
+		if (f->proto == fi->ip_proto && f->src_port == fi->src_port &&
+				f->dst_port == fi->dst_port && f->src_ip == get32(ip + 12) &&
+				f->dst_ip == get32(ip + 16))
+			return f;
+	}
+	if (num_flows == REPLAY_MAX_FLOWS)
+		return NULL;
+
+	f = &flows[num_flows++];
+	memset(f, 0, sizeof(*f));
+	f->proto = fi->ip_proto;
+	f->src_port = fi->src_port;
+	f->dst_port = fi->dst_port;
+	f->src_ip = get32(ip + 12);
+	f->dst_ip = get32(ip + 16);
+	return f;
+}
+
+static void apply_pending_rules(void)
+{
+	if (num_pending_rules < 0)
+		return;
+
+	if (host_wake_filter_set_rules(pending_rules, num_pending_rules) != ESP_OK) {
+		printf("failed to set %d rules\n", num_pending_rules);
+		failures++;
+	}
+	num_pending_rules = -1;
+}
+
+/* expect: 1 wake, 0 hold, -1 not checked */
+static void replay_frame(const char *src, uint32_t time_ms, const uint8_t *frame,
+		uint16_t len, int expect)
+{
+	frame_info_t fi = {0};
+	replay_flow_t *flow = NULL;
+	bool constant = true;
+	bool wake = false;
+
+	apply_pending_rules();
+	replay_now_ms = time_ms;
+	frames++;
+
+	parse_frame(frame, len, &fi);
+	flow = flow_of(&fi, frame);
+	if (flow) {
+		constant = host_wake_filter_flow_constant(fi.ip_proto, fi.src_port, fi.dst_port);
+		if (!constant)
+			per_packet++;
+	}
+	wake = host_wake_filter_match(frame, len);
+	if (wake)
+		wakes++;
+
+	if (!quiet) {
+		printf("%-28s %8u ms %4u B ", src, time_ms, len);
+		if (flow)
+			printf("%s %5u > %5u %-10s ", fi.ip_proto == IP_PROTO_NUM_TCP ? "tcp" : "udp",
+					fi.src_port, fi.dst_port, constant ? "per flow" : "per packet");
+		else
+			printf("%-36s ", fi.start[HOST_WAKE_LAYER_L3] < 0 ? "non IPv4" : "IPv4");
+		printf("%s\n", wake ? "WAKE" : "hold");
+	}
+
+	if (expect >= 0 && wake != expect) {
+		printf("%s: frame at %u ms: expected %s, got %s\n", src, time_ms,
+				expect ? "wake" : "hold", wake ? "wake" : "hold");
+		failures++;
+	}
+
+	if (!flow)
+		return;
+
+	/* first frame of a flow, or rules changed: the router would cache this */
+	if (!flow->frames || !flow->constant) {
+		flow->constant = constant;
+		flow->wake = wake;
+	} else if (wake != flow->wake) {
+		printf("%s: frame at %u ms: flow reported constant, but %s after %s\n",
+				src, time_ms, wake ? "wake" : "hold", flow->wake ? "wake" : "hold");
+		failures++;
+	}
+	flow->frames++;
+}
+
+static int hex_nibble(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	c = (char)tolower((unsigned char)c);
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	return -1;
+}
+
+/* Hex digits up to end, spaces and colons ignored. Returns bytes or -1 */
+static int parse_hex(const char *s, const char *end, uint8_t *out, int max)
+{
+	int n = 0, hi = -1, v;
+
+	for (; s < end && *s; s++) {
+		if (isspace((unsigned char)*s) || *s == ':')
+			continue;
+		v = hex_nibble(*s);
+		if (v < 0)
+			return -1;
+		if (hi < 0) {
+			hi = v;
+			continue;
+		}
+		if (n == max)
+			return -1;
+		out[n++] = (uint8_t)(hi << 4 | v);
+		hi = -1;
+	}
+	return hi < 0 ? n : -1;
+}
+
+static int parse_rule(char *args, host_wake_rule_t *r)
+{
+	static const char *layers[] = { "l2", "l3", "l4", "payload" };
+	char layer[16], proto[16], pattern[80];
+	unsigned port = 0, offset = 0, limit = 0, interval = 0;
+	char *mask = NULL;
+	int fields, n, i;
+
+	memset(r, 0, sizeof(*r));
+	fields = sscanf(args, "%15s %15s %u %u %79s %u/%u", layer, proto, &port, &offset,
+			pattern, &limit, &interval);
+	if (fields != 5 && fields != 7)
+		return -1;
+
+	for (i = 0; i < HOST_WAKE_LAYER_MAX; i++)
+		if (!strcmp(layer, layers[i]))
+			break;
+	if (i == HOST_WAKE_LAYER_MAX)
+		return -1;
+	r->layer = (uint8_t)i;
+
+	if (!strcmp(proto, "tcp"))
+		r->ip_proto = IP_PROTO_NUM_TCP;
+	else if (!strcmp(proto, "udp"))
+		r->ip_proto = IP_PROTO_NUM_UDP;
+	else if (!strcmp(proto, "icmp"))
+		r->ip_proto = 1;
+	else if (strcmp(proto, "any"))
+		r->ip_proto = (uint8_t)atoi(proto);
+
+	if (port > UINT16_MAX || offset > UINT16_MAX)
+		return -1;
+	r->port = (uint16_t)port;
+	r->offset = (uint16_t)offset;
+
+	mask = strchr(pattern, '/');
+	n = parse_hex(pattern, mask ? mask : pattern + strlen(pattern), r->value,
+			HOST_WAKE_FILTER_MAX_PATTERN_LEN);
+	if (n <= 0)
+		return -1;
+	r->len = (uint8_t)n;
+	if (mask) {
+		if (parse_hex(mask + 1, mask + strlen(mask), r->mask, n) != n)
+			return -1;
+	} else {
+		memset(r->mask, 0xff, n);
+	}
+
+	r->rate_limit = (uint16_t)limit;
+	r->rate_interval_ms = interval;
+	return 0;
+}
+
+static int replay_text(const char *path, FILE *fp)
+{
+	static char line[REPLAY_LINE_LEN];
+	uint8_t frame[REPLAY_MAX_FRAME];
+	char expect[8], src[64];
+	unsigned long time_ms = 0;
+	int lineno = 0, len, pos;
+	char *p;
+
+	while (fgets(line, sizeof(line), fp)) {
+		lineno++;
+		p = line;
+		while (isspace((unsigned char)*p))
+			p++;
+		if (!*p || *p == '#')
+			continue;
+
+		if (!strncmp(p, "rule ", 5)) {
+			if (num_pending_rules < 0)
+				num_pending_rules = 0;
+			if (num_pending_rules == WAKE_MAX_RULES ||
+					parse_rule(p + 5, &pending_rules[num_pending_rules])) {
+				printf("%s:%d: bad or too many rules\n", path, lineno);
+				return -1;
+			}
+			num_pending_rules++;
+			continue;
+		}
+
+		if (!strncmp(p, "reset", 5)) {
+			num_pending_rules = 0;
+			continue;
+		}
+
+		if (sscanf(p, "%lu %7s %n", &time_ms, expect, &pos) != 2 ||
+				(strcmp(expect, "wake") && strcmp(expect, "hold") && strcmp(expect, "-"))) {
+			printf("%s:%d: expected <time ms> <wake|hold|-> <hex frame>\n", path, lineno);
+			return -1;
+		}
+		len = parse_hex(p + pos, p + strlen(p), frame, sizeof(frame));
+		if (len <= 0) {
+			printf("%s:%d: bad frame\n", path, lineno);
+			return -1;
+		}
+
+		snprintf(src, sizeof(src), "%.50s:%d", strrchr(path, '/') ? strrchr(path, '/') + 1 : path,
+				lineno);
+		replay_frame(src, (uint32_t)time_ms, frame, (uint16_t)len,
+				!strcmp(expect, "wake") ? 1 : !strcmp(expect, "hold") ? 0 : -1);
+	}
+	return 0;
+}
+
+static uint32_t pcap_get32(const uint8_t *p, int swapped)
+{
+	return swapped ? ((uint32_t)p[3] << 24) | (p[2] << 16) | (p[1] << 8) | p[0] : get32(p);
+}
+
+static int replay_pcap(const char *path, FILE *fp, const uint8_t *hdr)
+{
+	uint8_t rec[16], frame[REPLAY_MAX_FRAME];
+	uint32_t magic = get32(hdr), incl_len = 0, n = 0;
+	int swapped = magic != PCAP_MAGIC_US && magic != PCAP_MAGIC_NS;
+	int nsec = pcap_get32(hdr, swapped) == PCAP_MAGIC_NS;
+	uint64_t t_ms = 0, t0_ms = 0;
+	char src[64];
+
+	if (pcap_get32(hdr + 20, swapped) != PCAP_LINKTYPE_ETHERNET) {
+		printf("%s: not an Ethernet capture\n", path);
+		return -1;
+	}
+
+	while (fread(rec, sizeof(rec), 1, fp) == 1) {
+		n++;
+		incl_len = pcap_get32(rec + 8, swapped);
+		if (incl_len > sizeof(frame)) {
+			printf("%s: record %u too long\n", path, n);
+			return -1;
+		}
+		if (fread(frame, 1, incl_len, fp) != incl_len)
+			break;
+
+		t_ms = (uint64_t)pcap_get32(rec, swapped) * 1000 +
+				pcap_get32(rec + 4, swapped) / (nsec ? 1000000 : 1000);
+		/* times from the first frame of the capture */
+		if (n == 1)
+			t0_ms = t_ms;
+		t_ms -= t0_ms;
+		snprintf(src, sizeof(src), "%.40s#%u", strrchr(path, '/') ? strrchr(path, '/') + 1 : path, n);
+		replay_frame(src, (uint32_t)t_ms, frame, (uint16_t)incl_len, -1);
+	}
+	return 0;
+}
+
+static int replay_file(const char *path)
+{
+	uint8_t hdr[24] = { 0 };
+	uint32_t magic = 0;
+	FILE *fp = fopen(path, "rb");
+	int ret = 0;
+
+	if (!fp) {
+		printf("%s: cannot open\n", path);
+		return -1;
+	}
+
+	if (fread(hdr, sizeof(hdr), 1, fp) == 1)
+		magic = get32(hdr);
+	if (magic == PCAP_MAGIC_US || magic == PCAP_MAGIC_NS ||
+			pcap_get32(hdr, 1) == PCAP_MAGIC_US || pcap_get32(hdr, 1) == PCAP_MAGIC_NS) {
+		ret = replay_pcap(path, fp, hdr);
+	} else {
+		rewind(fp);
+		ret = replay_text(path, fp);
+	}
+
+	fclose(fp);
+	return ret;
+}
+
+int main(int argc, char *argv[])
+{
+	int i;
+
+	for (i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-q")) {
+			quiet = 1;
+			continue;
+		}
+		if (replay_file(argv[i]))
+			return 1;
+	}
+
+	if (frames == 0) {
+		printf("usage: %s [-q] capture...\n", argv[0]);
+		return 1;
+	}
+
+	printf("%u frames: %u wake, %u hold, %u matched per packet\n",
+			frames, wakes, frames - wakes, per_packet);
+	if (failures) {
+		printf("%u checks failed\n", failures);
+		return 1;
+	}
+	return 0;
+}